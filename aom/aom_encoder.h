@@ -73,7 +73,14 @@ extern "C" {
  *  The available flags are specified by AOM_CODEC_USE_* defines.
  */
 #define AOM_CODEC_USE_PSNR 0x10000 /**< Calculate PSNR on each frame */
-/*!\brief Make the encoder output one  partition at a time. */
+/*!\brief Make the encoder output one  partition at a time.
+ *
+ * The partitions are split out of the frame once it has been fully encoded:
+ * all the partitions of a frame become available together, from the
+ * aom_codec_get_cx_data() calls that follow the aom_codec_encode() call
+ * that produced the frame. They are not emitted while the frame is still
+ * being encoded.
+ */
 #define AOM_CODEC_USE_OUTPUT_PARTITION 0x20000
 #define AOM_CODEC_USE_HIGHBITDEPTH 0x40000 /**< Use high bitdepth */
 
@@ -504,6 +504,10 @@ enum aome_enc_control_id {
    * This will set the maximum number of tile groups. This will be
    * overridden if an MTU size is set. The default value is 1.
    *
+   * With AOM_CODEC_USE_OUTPUT_PARTITION each tile group is returned in its
+   * own frame packet. The packets of a frame are only available once the
+   * whole frame has been encoded.
+   *
    * Experiment: TILE_GROUPS
    */
   AV1E_SET_NUM_TG,
@@ -595,6 +599,14 @@ enum aome_enc_control_id {
    * 0 : off, 1 : MAX_EXTREME_MV, 2 : MIN_EXTREME_MV
    */
   AV1E_ENABLE_MOTION_VECTOR_UNIT_TEST,
+
+  /*!\brief Codec control function to get per-stage encoder statistics.
+   *
+   * Fills in an aom_frame_stats_t covering all frames coded by the most
+   * recent call to aom_codec_encode(), including any invisible (alt-ref)
+   * frames produced along with the visible one.
+   */
+  AV1E_GET_FRAME_STATS,
 };
 
 /*!\brief aom 1-D scaling mode
@@ -658,6 +670,33 @@ typedef struct aom_scaling_mode {
   AOM_SCALING_MODE v_scaling_mode; /**< vertical scaling mode   */
 } aom_scaling_mode_t;
 
+/*!\brief Per-stage encoder statistics
+ *
+ * Returned by the AV1E_GET_FRAME_STATS control. Stage times are wall clock
+ * times in microseconds, summed over all recode iterations of the coded
+ * frames. Stages run on several threads report the time of the whole
+ * multi-threaded section.
+ */
+typedef struct aom_frame_stats {
+  unsigned int frames;           /**< Number of frames coded */
+  unsigned int encode_passes;    /**< Encode passes, including recodes */
+  int64_t total_us;              /**< Total time spent compressing */
+  int64_t temporal_filter_us;    /**< ARNR temporal filtering */
+  int64_t global_motion_us;      /**< Global motion search */
+  int64_t partition_search_us;   /**< Partition, mode and transform search */
+  int64_t loop_filter_search_us; /**< Deblocking level search and filtering */
+  int64_t cdef_search_us;        /**< CDEF strength search and filtering */
+  int64_t restoration_search_us; /**< Restoration search and filtering */
+  int64_t pack_bitstream_us;     /**< Bitstream packing */
+  uint64_t partition_evals;      /**< Blocks visited by partition search */
+  uint64_t mode_evals;           /**< Block mode (RD) evaluations */
+  uint64_t tx_search_evals;      /**< Luma transform type/size searches */
+  uint64_t tx_cache_lookups;     /**< Transform RD cache lookups */
+  uint64_t tx_cache_hits;        /**< Transform RD cache hits */
+  uint64_t mv_cache_lookups;     /**< Motion search cache lookups */
+  uint64_t mv_cache_hits;        /**< Motion search cache hits */
+} aom_frame_stats_t;
+
 /*!brief AV1 encoder content type */
 typedef enum {
   AOM_CONTENT_DEFAULT,
@@ -832,6 +871,9 @@ AOM_CTRL_USE_TYPE(AV1E_SET_SINGLE_TILE_DECODING, unsigned int)
 AOM_CTRL_USE_TYPE(AV1E_ENABLE_MOTION_VECTOR_UNIT_TEST, unsigned int)
 #define AOM_CTRL_AV1E_ENABLE_MOTION_VECTOR_UNIT_TEST
 
+AOM_CTRL_USE_TYPE(AV1E_GET_FRAME_STATS, aom_frame_stats_t *)
+#define AOM_CTRL_AV1E_GET_FRAME_STATS
+
 /*!\endcond */
 /*! @} - end defgroup aom_encoder */
 #ifdef __cplusplus
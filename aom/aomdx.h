@@ -156,6 +156,62 @@ enum aom_dec_control_id {
    */
   AV1_SET_INSPECTION_CALLBACK,
 
+  /** control function to get per-stage timing of the frames decoded by the
+   * last aom_codec_decode() call, see aom_frame_timing_t. Returns
+   * AOM_CODEC_INCAPABLE when frame parallel decoding is in use.
+   */
+  AV1D_GET_FRAME_TIMING,
+
+  /** control function to select what the decoder accounts for, see
+   * aom_accounting_mode_t. The per frame symbol type and superblock
+   * histograms are then read through the Accounting struct returned by
+   * AV1_GET_ACCOUNTING. When compiled without --enable-accounting, this
+   * returns AOM_CODEC_INCAPABLE.
+   */
+  AV1D_SET_ACCOUNTING_MODE,
+
+  /** control function to get the number of luma rows at the top of the last
+   * frame passed to the decoder that are reconstructed. When the frame is
+   * passed in fragments (see AOM_CODEC_USE_INPUT_FRAGMENTS) this grows as
+   * its tile groups are decoded, a superblock row at a time once every tile
+   * column of the row is decoded, and those rows can be read through
+   * AV1_GET_NEW_FRAME_IMAGE. Their post filtering may be partly done and is
+   * only complete once the whole frame is decoded, when this is the frame
+   * height.
+   */
+  AV1D_GET_DECODED_ROWS,
+
+  /** control function to decode only the tiles that overlap a region of the
+   * frame, given as an aom_region_t in luma pixels, in a stream that is not
+   * coded with large scale tiles. The other tiles are neither entropy decoded
+   * nor reconstructed and the loop filter, CDEF and loop restoration leave
+   * them out, so their pixels are undefined. Frames that adapt the frame
+   * context from their tiles (see AV1E_SET_FRAME_PARALLEL_DECODING) are still
+   * decoded whole, as are frames that read the motion vectors or the segment
+   * map of earlier frames, the first frame after the region moves, and frames
+   * the region does not fit in. A NULL region, or one with no width or
+   * height, decodes whole frames again. A region with negative values, or
+   * that is out of the last decoded frame, returns AOM_CODEC_INVALID_PARAM.
+   * Returns AOM_CODEC_INCAPABLE in frame parallel decode.
+   */
+  AV1D_SET_DECODE_REGION,
+
+  /** control function to get the area of the last decoded frame, as an
+   * aom_region_t, whose pixels are the same as when every frame is decoded
+   * whole. It is the decoded tiles less a margin the post filters read
+   * across, cut down to the valid area of each reference frame. The blocks
+   * that predict from outside the valid area of a reference frame, and the
+   * pixels their errors may spread to, are cut out as well.
+   */
+  AV1D_GET_VALID_REGION,
+
+  /** control function to get the number of times a frame worker let the
+   * others predict from the top rows of a frame, filtered and final, before
+   * the whole frame was. It only grows in frame parallel decode, and is read
+   * once the frames passed to the decoder are all returned.
+   */
+  AV1D_GET_ROW_PUBLISHES,
+
   AOM_DECODER_CTRL_ID_MAX,
 };
 
@@ -177,6 +233,53 @@ typedef struct aom_decrypt_init {
   void *decrypt_state;
 } aom_decrypt_init;
 
+/*!\brief Accounting modes for AV1D_SET_ACCOUNTING_MODE */
+typedef enum aom_accounting_mode {
+  /*! Disable accounting. */
+  AOM_ACCOUNTING_MODE_OFF,
+  /*! Record every run of symbols with its block position, and the
+   * histograms. This is the default. */
+  AOM_ACCOUNTING_MODE_SYMBOLS,
+  /*! Only accumulate the bits per symbol type and per superblock. */
+  AOM_ACCOUNTING_MODE_HISTOGRAM,
+} aom_accounting_mode_t;
+
+/*!\brief Per-stage decoder timing
+ *
+ * Returned by the AV1D_GET_FRAME_TIMING control. Times are wall clock times
+ * in microseconds, summed over all frames decoded by the last
+ * aom_codec_decode() call. Entropy decoding and reconstruction are
+ * interleaved block by block, so they are reported together as tile decode
+ * time.
+ */
+typedef struct aom_frame_timing {
+  unsigned int frames;       /**< Number of frames decoded */
+  int64_t total_us;          /**< Total time spent decoding */
+  int64_t header_us;         /**< Frame header parsing and setup */
+  int64_t tile_decode_us;    /**< Entropy decoding and reconstruction */
+  int64_t deblock_us;        /**< Deblocking filter */
+  int64_t cdef_us;           /**< CDEF */
+  int64_t superres_us;       /**< Super-resolution upscaling */
+  int64_t restoration_us;    /**< Loop restoration */
+  int64_t extend_borders_us; /**< Reference frame border extension */
+  int tile_rows;             /**< Number of tile rows of the last frame */
+  int tile_cols;             /**< Number of tile columns of the last frame */
+  /*! Decode time of each tile in raster order, tile_rows * tile_cols entries.
+   * Owned by the decoder and valid until the next aom_codec_decode() call. */
+  const int64_t *tile_us;
+} aom_frame_timing_t;
+
+/*!\brief Rectangle in luma pixels
+ *
+ * Used by the AV1D_SET_DECODE_REGION and AV1D_GET_VALID_REGION controls.
+ */
+typedef struct aom_region {
+  int x;      /**< Left column */
+  int y;      /**< Top row */
+  int width;  /**< Width, 0 for an empty region */
+  int height; /**< Height, 0 for an empty region */
+} aom_region_t;
+
 /*!\cond */
 /*!\brief AOM decoder control function parameter type
  *
@@ -213,6 +316,18 @@ AOM_CTRL_USE_TYPE(AV1_SET_DECODE_TILE_COL, int)
 #define AOM_CTRL_AV1_SET_DECODE_TILE_COL
 AOM_CTRL_USE_TYPE(AV1_SET_INSPECTION_CALLBACK, aom_inspect_init *)
 #define AOM_CTRL_AV1_SET_INSPECTION_CALLBACK
+AOM_CTRL_USE_TYPE(AV1D_GET_FRAME_TIMING, aom_frame_timing_t *)
+#define AOM_CTRL_AV1D_GET_FRAME_TIMING
+AOM_CTRL_USE_TYPE(AV1D_SET_ACCOUNTING_MODE, int)
+#define AOM_CTRL_AV1D_SET_ACCOUNTING_MODE
+AOM_CTRL_USE_TYPE(AV1D_GET_DECODED_ROWS, int *)
+#define AOM_CTRL_AV1D_GET_DECODED_ROWS
+AOM_CTRL_USE_TYPE(AV1D_SET_DECODE_REGION, aom_region_t *)
+#define AOM_CTRL_AV1D_SET_DECODE_REGION
+AOM_CTRL_USE_TYPE(AV1D_GET_VALID_REGION, aom_region_t *)
+#define AOM_CTRL_AV1D_GET_VALID_REGION
+AOM_CTRL_USE_TYPE(AV1D_GET_ROW_PUBLISHES, int *)
+#define AOM_CTRL_AV1D_GET_ROW_PUBLISHES
 /*!\endcond */
 /*! @} - end defgroup aom_decoder */
 
@@ -83,6 +83,7 @@ set(AOM_DSP_COMMON_INTRIN_AVX2
     "${AOM_ROOT}/aom_dsp/x86/inv_txfm_avx2.c"
     "${AOM_ROOT}/aom_dsp/x86/common_avx2.h"
     "${AOM_ROOT}/aom_dsp/x86/inv_txfm_common_avx2.h"
+    "${AOM_ROOT}/aom_dsp/x86/synonyms_avx2.h"
     "${AOM_ROOT}/aom_dsp/x86/txfm_common_avx2.h")
 
 if (NOT CONFIG_PARALLEL_DEBLOCKING)
@@ -445,10 +446,18 @@ if (CONFIG_LOOP_RESTORATION)
       ${AOM_DSP_COMMON_INTRIN_SSE2}
       "${AOM_ROOT}/aom_dsp/x86/aom_convolve_hip_sse2.c")
 
+  set(AOM_DSP_COMMON_INTRIN_AVX2
+      ${AOM_DSP_COMMON_INTRIN_AVX2}
+      "${AOM_ROOT}/aom_dsp/x86/aom_convolve_hip_avx2.c")
+
   if (CONFIG_HIGHBITDEPTH)
     set(AOM_DSP_COMMON_INTRIN_SSSE3
       ${AOM_DSP_COMMON_INTRIN_SSSE3}
         "${AOM_ROOT}/aom_dsp/x86/aom_highbd_convolve_hip_ssse3.c")
+
+    set(AOM_DSP_COMMON_INTRIN_AVX2
+        ${AOM_DSP_COMMON_INTRIN_AVX2}
+        "${AOM_ROOT}/aom_dsp/x86/aom_highbd_convolve_hip_avx2.c")
   endif ()
 endif ()
 
@@ -16,6 +16,7 @@ DSP_SRCS-yes += aom_dsp_common.h
 DSP_SRCS-$(HAVE_MSA)    += mips/macros_msa.h
 
 DSP_SRCS-$(ARCH_X86)$(ARCH_X86_64)   += x86/synonyms.h
+DSP_SRCS-$(ARCH_X86)$(ARCH_X86_64)   += x86/synonyms_avx2.h
 
 # bit reader
 DSP_SRCS-yes += prob.h
@@ -286,8 +287,10 @@ endif  # CONFIG_HIGHBITDEPTH
 
 ifeq ($(CONFIG_LOOP_RESTORATION),yes)
 DSP_SRCS-$(HAVE_SSE2)   += x86/aom_convolve_hip_sse2.c
+DSP_SRCS-$(HAVE_AVX2)   += x86/aom_convolve_hip_avx2.c
 ifeq ($(CONFIG_HIGHBITDEPTH),yes)
 DSP_SRCS-$(HAVE_SSSE3)  += x86/aom_highbd_convolve_hip_ssse3.c
+DSP_SRCS-$(HAVE_AVX2)   += x86/aom_highbd_convolve_hip_avx2.c
 endif
 endif  # CONFIG_LOOP_RESTORATION
 endif  # CONFIG_AV1
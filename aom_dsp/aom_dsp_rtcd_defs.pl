@@ -272,6 +272,141 @@ if (aom_config("CONFIG_HIGHBITDEPTH") eq "yes") {
   specialize qw/aom_highbd_dc_left_predictor_32x32 sse2/;
   specialize qw/aom_highbd_dc_top_predictor_32x32 sse2/;
   specialize qw/aom_highbd_dc_128_predictor_32x32 sse2/;
+  specialize qw/aom_highbd_v_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_dc_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_h_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_dc_left_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_dc_top_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_dc_128_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_v_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_dc_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_h_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_dc_left_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_dc_top_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_dc_128_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_v_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_dc_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_h_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_dc_left_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_dc_top_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_dc_128_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_v_predictor_32x8 sse2/;
+  specialize qw/aom_highbd_dc_predictor_32x8 sse2/;
+  specialize qw/aom_highbd_h_predictor_32x8 sse2/;
+  specialize qw/aom_highbd_dc_left_predictor_32x8 sse2/;
+  specialize qw/aom_highbd_dc_top_predictor_32x8 sse2/;
+  specialize qw/aom_highbd_dc_128_predictor_32x8 sse2/;
+  if (aom_config("CONFIG_TX64X64") eq "yes") {
+    specialize qw/aom_highbd_v_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_dc_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_h_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_dc_left_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_dc_top_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_dc_128_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_v_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_dc_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_h_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_dc_left_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_dc_top_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_dc_128_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_v_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_dc_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_h_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_dc_left_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_dc_top_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_dc_128_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_v_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_dc_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_h_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_dc_left_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_dc_top_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_dc_128_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_v_predictor_64x64 sse2/;
+    specialize qw/aom_highbd_dc_predictor_64x64 sse2/;
+    specialize qw/aom_highbd_h_predictor_64x64 sse2/;
+    specialize qw/aom_highbd_dc_left_predictor_64x64 sse2/;
+    specialize qw/aom_highbd_dc_top_predictor_64x64 sse2/;
+    specialize qw/aom_highbd_dc_128_predictor_64x64 sse2/;
+  }
+
+  specialize qw/aom_highbd_paeth_predictor_4x4 ssse3/;
+  specialize qw/aom_highbd_paeth_predictor_4x8 ssse3/;
+  specialize qw/aom_highbd_paeth_predictor_4x16 ssse3/;
+  specialize qw/aom_highbd_paeth_predictor_8x4 ssse3/;
+  specialize qw/aom_highbd_paeth_predictor_8x8 ssse3/;
+  specialize qw/aom_highbd_paeth_predictor_8x16 ssse3/;
+  specialize qw/aom_highbd_paeth_predictor_8x32 ssse3/;
+  specialize qw/aom_highbd_paeth_predictor_16x4 ssse3 avx2/;
+  specialize qw/aom_highbd_paeth_predictor_16x8 ssse3 avx2/;
+  specialize qw/aom_highbd_paeth_predictor_16x16 ssse3 avx2/;
+  specialize qw/aom_highbd_paeth_predictor_16x32 ssse3 avx2/;
+  specialize qw/aom_highbd_paeth_predictor_32x8 ssse3 avx2/;
+  specialize qw/aom_highbd_paeth_predictor_32x16 ssse3 avx2/;
+  specialize qw/aom_highbd_paeth_predictor_32x32 ssse3 avx2/;
+  specialize qw/aom_highbd_smooth_predictor_4x4 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_4x4 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_4x4 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_4x8 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_4x8 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_4x8 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_4x16 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_8x4 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_8x4 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_8x4 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_8x8 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_8x8 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_8x8 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_8x16 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_8x16 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_8x16 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_8x32 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_16x4 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_16x8 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_16x8 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_16x8 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_16x16 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_16x16 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_16x16 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_16x32 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_16x32 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_16x32 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_32x8 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_32x8 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_32x8 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_32x16 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_32x16 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_32x16 sse2/;
+  specialize qw/aom_highbd_smooth_predictor_32x32 sse2/;
+  specialize qw/aom_highbd_smooth_v_predictor_32x32 sse2/;
+  specialize qw/aom_highbd_smooth_h_predictor_32x32 sse2/;
+  if (aom_config("CONFIG_TX64X64") eq "yes") {
+    specialize qw/aom_highbd_paeth_predictor_16x64 ssse3 avx2/;
+    specialize qw/aom_highbd_paeth_predictor_32x64 ssse3 avx2/;
+    specialize qw/aom_highbd_paeth_predictor_64x16 ssse3 avx2/;
+    specialize qw/aom_highbd_paeth_predictor_64x32 ssse3 avx2/;
+    specialize qw/aom_highbd_paeth_predictor_64x64 ssse3 avx2/;
+    specialize qw/aom_highbd_smooth_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_smooth_v_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_smooth_h_predictor_16x64 sse2/;
+    specialize qw/aom_highbd_smooth_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_smooth_v_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_smooth_h_predictor_32x64 sse2/;
+    specialize qw/aom_highbd_smooth_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_smooth_v_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_smooth_h_predictor_64x16 sse2/;
+    specialize qw/aom_highbd_smooth_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_smooth_v_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_smooth_h_predictor_64x32 sse2/;
+    specialize qw/aom_highbd_smooth_predictor_64x64 sse2/;
+    specialize qw/aom_highbd_smooth_v_predictor_64x64 sse2/;
+    specialize qw/aom_highbd_smooth_h_predictor_64x64 sse2/;
+  }
   
   specialize qw/aom_highbd_d117_predictor_4x4 sse2/;
   specialize qw/aom_highbd_d117_predictor_8x8 ssse3/;
@@ -366,7 +501,7 @@ if (aom_config("CONFIG_LOOP_RESTORATION") eq "yes") {
   specialize qw/aom_convolve8_add_src ssse3/;
   specialize qw/aom_convolve8_add_src_horiz ssse3/;
   specialize qw/aom_convolve8_add_src_vert ssse3/;
-  specialize qw/aom_convolve8_add_src_hip sse2/;
+  specialize qw/aom_convolve8_add_src_hip sse2 avx2/;
 }  # CONFIG_LOOP_RESTORATION
 
 # TODO(any): These need to be extended to up to 128x128 block sizes
@@ -411,7 +546,7 @@ if (aom_config("CONFIG_HIGHBITDEPTH") eq "yes") {
     add_proto qw/void aom_highbd_convolve8_add_src_hip/, "const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst, ptrdiff_t dst_stride, const int16_t *filter_x, int x_step_q4, const int16_t *filter_y, int y_step_q4, int w, int h, int bps";
 
     specialize qw/aom_highbd_convolve8_add_src/, "$sse2_x86_64";
-    specialize qw/aom_highbd_convolve8_add_src_hip ssse3/;
+    specialize qw/aom_highbd_convolve8_add_src_hip ssse3 avx2/;
   }  # CONFIG_LOOP_RESTORATION
 }  # CONFIG_HIGHBITDEPTH
 
@@ -440,7 +575,9 @@ if (aom_config("CONFIG_PARALLEL_DEBLOCKING") eq "yes") {
 }
 
 add_proto qw/void aom_lpf_vertical_8_dual/, "uint8_t *s, int pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1";
-if (aom_config("CONFIG_PARALLEL_DEBLOCKING") ne "yes") {
+if (aom_config("CONFIG_PARALLEL_DEBLOCKING") eq "yes") {
+  specialize qw/aom_lpf_vertical_8_dual sse2/;
+} else {
   specialize qw/aom_lpf_vertical_8_dual sse2 neon_asm dspr2 msa/;
   $aom_lpf_vertical_8_dual_neon_asm=aom_lpf_vertical_8_dual_neon;
 }
@@ -453,7 +590,9 @@ if (aom_config("CONFIG_PARALLEL_DEBLOCKING") eq "yes") {
 }
 
 add_proto qw/void aom_lpf_vertical_4_dual/, "uint8_t *s, int pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1";
-if (aom_config("CONFIG_PARALLEL_DEBLOCKING") ne "yes") {
+if (aom_config("CONFIG_PARALLEL_DEBLOCKING") eq "yes") {
+  specialize qw/aom_lpf_vertical_4_dual sse2/;
+} else {
   specialize qw/aom_lpf_vertical_4_dual sse2 neon dspr2 msa/;
 }
 
@@ -481,7 +620,9 @@ if (aom_config("CONFIG_PARALLEL_DEBLOCKING") eq "yes") {
 }
 
 add_proto qw/void aom_lpf_horizontal_8_dual/, "uint8_t *s, int pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1";
-if (aom_config("CONFIG_PARALLEL_DEBLOCKING") ne "yes") {
+if (aom_config("CONFIG_PARALLEL_DEBLOCKING") eq "yes") {
+  specialize qw/aom_lpf_horizontal_8_dual sse2/;
+} else {
   specialize qw/aom_lpf_horizontal_8_dual sse2 neon_asm dspr2 msa/;
   $aom_lpf_horizontal_8_dual_neon_asm=aom_lpf_horizontal_8_dual_neon;
 }
@@ -494,7 +635,9 @@ if (aom_config("CONFIG_PARALLEL_DEBLOCKING") eq "yes") {
 }
 
 add_proto qw/void aom_lpf_horizontal_4_dual/, "uint8_t *s, int pitch, const uint8_t *blimit0, const uint8_t *limit0, const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1, const uint8_t *thresh1";
-if (aom_config("CONFIG_PARALLEL_DEBLOCKING") ne "yes") {
+if (aom_config("CONFIG_PARALLEL_DEBLOCKING") eq "yes") {
+  specialize qw/aom_lpf_horizontal_4_dual sse2/;
+} else {
   specialize qw/aom_lpf_horizontal_4_dual sse2 neon dspr2 msa/;
 }
 
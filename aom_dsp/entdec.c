@@ -77,7 +77,7 @@
 
 static void od_ec_dec_refill(od_ec_dec *dec) {
   int s;
-  od_ec_window dif;
+  od_ec_dec_window dif;
   int16_t cnt;
   const unsigned char *bptr;
   const unsigned char *end;
@@ -85,10 +85,25 @@ static void od_ec_dec_refill(od_ec_dec *dec) {
   cnt = dec->cnt;
   bptr = dec->bptr;
   end = dec->end;
-  s = OD_EC_WINDOW_SIZE - 9 - (cnt + 15);
+  s = OD_EC_DEC_WINDOW_SIZE - 9 - (cnt + 15);
+  if (s >= 0 && end - bptr >= (ptrdiff_t)sizeof(dif)) {
+    /*Away from the end of the buffer, read all the bytes that fit with a
+       single big-endian load instead of one byte at a time.*/
+    od_ec_dec_window bytes;
+    int nbytes;
+    int i;
+    bytes = 0;
+    for (i = 0; i < (int)sizeof(bytes); i++) bytes = bytes << 8 | bptr[i];
+    nbytes = (s >> 3) + 1;
+    OD_ASSERT(nbytes < (int)sizeof(bytes));
+    dif ^= bytes >> (OD_EC_DEC_WINDOW_SIZE - 8 * nbytes) << (s & 7);
+    bptr += nbytes;
+    cnt += 8 * nbytes;
+    s -= 8 * nbytes;
+  }
   for (; s >= 0 && bptr < end; s -= 8, bptr++) {
-    OD_ASSERT(s <= OD_EC_WINDOW_SIZE - 8);
-    dif ^= (od_ec_window)bptr[0] << s;
+    OD_ASSERT(s <= OD_EC_DEC_WINDOW_SIZE - 8);
+    dif ^= (od_ec_dec_window)bptr[0] << s;
     cnt += 8;
   }
   if (bptr >= end) {
@@ -108,8 +123,8 @@ static void od_ec_dec_refill(od_ec_dec *dec) {
   ret: The value to return.
   Return: ret.
           This allows the compiler to jump to this function via a tail-call.*/
-static int od_ec_dec_normalize(od_ec_dec *dec, od_ec_window dif, unsigned rng,
-                               int ret) {
+static int od_ec_dec_normalize(od_ec_dec *dec, od_ec_dec_window dif,
+                               unsigned rng, int ret) {
   int d;
   OD_ASSERT(rng <= 65535U);
   d = 16 - OD_ILOG_NZ(rng);
@@ -130,10 +145,12 @@ void od_ec_dec_init(od_ec_dec *dec, const unsigned char *buf,
   dec->eptr = buf + storage;
   dec->end_window = 0;
   dec->nend_bits = 0;
-  dec->tell_offs = 10 - (OD_EC_WINDOW_SIZE - 8);
+  /*Refills keep 8 * (bptr - buf) - cnt at 15 plus the bits consumed, so
+     od_ec_dec_tell() starts at 1 whatever the window size.*/
+  dec->tell_offs = -14;
   dec->end = buf + storage;
   dec->bptr = buf;
-  dec->dif = ((od_ec_window)1 << (OD_EC_WINDOW_SIZE - 1)) - 1;
+  dec->dif = ((od_ec_dec_window)1 << (OD_EC_DEC_WINDOW_SIZE - 1)) - 1;
   dec->rng = 0x8000;
   dec->cnt = -15;
   dec->error = 0;
@@ -144,8 +161,8 @@ void od_ec_dec_init(od_ec_dec *dec, const unsigned char *buf,
   f: The probability that the bit is one, scaled by 32768.
   Return: The value decoded (0 or 1).*/
 int od_ec_decode_bool_q15(od_ec_dec *dec, unsigned f) {
-  od_ec_window dif;
-  od_ec_window vw;
+  od_ec_dec_window dif;
+  od_ec_dec_window vw;
   unsigned r;
   unsigned r_new;
   unsigned v;
@@ -154,11 +171,11 @@ int od_ec_decode_bool_q15(od_ec_dec *dec, unsigned f) {
   OD_ASSERT(f < 32768U);
   dif = dec->dif;
   r = dec->rng;
-  OD_ASSERT(dif >> (OD_EC_WINDOW_SIZE - 16) < r);
+  OD_ASSERT(dif >> (OD_EC_DEC_WINDOW_SIZE - 16) < r);
   OD_ASSERT(32768U <= r);
   v = ((r >> 8) * (uint32_t)(f >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT));
   v += EC_MIN_PROB;
-  vw = (od_ec_window)v << (OD_EC_WINDOW_SIZE - 16);
+  vw = (od_ec_dec_window)v << (OD_EC_DEC_WINDOW_SIZE - 16);
   ret = 1;
   r_new = v;
   if (dif >= vw) {
@@ -179,7 +196,7 @@ int od_ec_decode_bool_q15(od_ec_dec *dec, unsigned f) {
          This should be at most 16.
   Return: The decoded symbol s.*/
 int od_ec_decode_cdf_q15(od_ec_dec *dec, const uint16_t *icdf, int nsyms) {
-  od_ec_window dif;
+  od_ec_dec_window dif;
   unsigned r;
   unsigned c;
   unsigned u;
@@ -190,10 +207,10 @@ int od_ec_decode_cdf_q15(od_ec_dec *dec, const uint16_t *icdf, int nsyms) {
   r = dec->rng;
   const int N = nsyms - 1;
 
-  OD_ASSERT(dif >> (OD_EC_WINDOW_SIZE - 16) < r);
+  OD_ASSERT(dif >> (OD_EC_DEC_WINDOW_SIZE - 16) < r);
   OD_ASSERT(icdf[nsyms - 1] == OD_ICDF(32768U));
   OD_ASSERT(32768U <= r);
-  c = (unsigned)(dif >> (OD_EC_WINDOW_SIZE - 16));
+  c = (unsigned)(dif >> (OD_EC_DEC_WINDOW_SIZE - 16));
   v = r;
   ret = -1;
   do {
@@ -205,7 +222,7 @@ int od_ec_decode_cdf_q15(od_ec_dec *dec, const uint16_t *icdf, int nsyms) {
   OD_ASSERT(v < u);
   OD_ASSERT(u <= r);
   r = u - v;
-  dif -= (od_ec_window)v << (OD_EC_WINDOW_SIZE - 16);
+  dif -= (od_ec_dec_window)v << (OD_EC_DEC_WINDOW_SIZE - 16);
   return od_ec_dec_normalize(dec, dif, r, ret);
 }
 
@@ -20,6 +20,17 @@ extern "C" {
 
 typedef struct od_ec_dec od_ec_dec;
 
+/*The decoder reads ahead through its own window, which only needs to be at
+   least as wide as od_ec_window.
+  A register wide window lets od_ec_dec_refill() run less often.*/
+#if SIZE_MAX > 0xFFFFFFFFU
+typedef uint64_t od_ec_dec_window;
+#else
+typedef od_ec_window od_ec_dec_window;
+#endif
+
+#define OD_EC_DEC_WINDOW_SIZE ((int)sizeof(od_ec_dec_window) * CHAR_BIT)
+
 #if defined(OD_ACCOUNTING) && OD_ACCOUNTING
 #define OD_ACC_STR , char *acc_str
 #define od_ec_dec_bits(dec, ftb, str) od_ec_dec_bits_(dec, ftb, str)
@@ -49,12 +60,12 @@ struct od_ec_dec {
   const unsigned char *bptr;
   /*The difference between the high end of the current range, (low + rng), and
      the coded value, minus 1.
-    This stores up to OD_EC_WINDOW_SIZE bits of that difference, but the
+    This stores up to OD_EC_DEC_WINDOW_SIZE bits of that difference, but the
      decoder only uses the top 16 bits of the window to decode the next symbol.
     As we shift up during renormalization, if we don't have enough bits left in
      the window to fill the top 16, we'll read in more bits of the coded
      value.*/
-  od_ec_window dif;
+  od_ec_dec_window dif;
   /*The number of values in the current range.*/
   uint16_t rng;
   /*The number of bits of data in the current value.*/
@@ -468,6 +468,20 @@ static double calc_ssim(const uint8_t *_src, int _systride, const uint8_t *_dst,
   return ret;
 }
 
+double aom_calc_fastssim_plane(const uint8_t *src, int src_stride,
+                               const uint8_t *dst, int dst_stride, int width,
+                               int height, uint32_t bd, uint32_t in_bd) {
+  assert(bd >= in_bd);
+  return calc_ssim(src, src_stride, dst, dst_stride, width, height, in_bd,
+                   bd - in_bd);
+}
+
+double aom_fastssim_score(const double plane_ssim[3]) {
+  const double ssimv =
+      plane_ssim[0] * .8 + .1 * (plane_ssim[1] + plane_ssim[2]);
+  return convert_ssim_db(ssimv, 1.0);
+}
+
 double aom_calc_fastssim(const YV12_BUFFER_CONFIG *source,
                          const YV12_BUFFER_CONFIG *dest, double *ssim_y,
                          double *ssim_u, double *ssim_v, uint32_t bd,
@@ -23,6 +23,10 @@
 
 #include "aom_dsp/entcode.h"
 
+#if HAVE_SSE2 && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -207,6 +211,51 @@ static INLINE void av1_tree_to_cdf(const aom_tree_index *tree,
 
 void av1_indices_from_tree(int *ind, int *inv, const aom_tree_index *tree);
 
+#if !CONFIG_LV_MAP_MULTI && HAVE_SSE2 && defined(__SSE2__)
+// Adapts one vector of CDF entries starting at cdf[i], the same way as the
+// scalar loop in update_cdf(). Lanes at or past the last entry (nsymbs - 1)
+// are stored back unchanged.
+// The entries before the last one are always below CDF_PROB_TOP, so their
+// differences from the targets fit in signed 16 bits.
+static INLINE __m128i update_cdf_lanes_sse2(__m128i c, int i, int val,
+                                            int nsymbs, __m128i rate,
+                                            int diff, int rate2) {
+  const __m128i idx =
+      _mm_add_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7), _mm_set1_epi16(i));
+  // tmp for entry i is AOM_ICDF((i + 1) << rate2), less diff from val on.
+  const __m128i after_val = _mm_cmpgt_epi16(idx, _mm_set1_epi16(val - 1));
+  const __m128i tmp = _mm_sub_epi16(
+      _mm_sub_epi16(_mm_set1_epi16(CDF_PROB_TOP),
+                    _mm_sll_epi16(_mm_add_epi16(idx, _mm_set1_epi16(1)),
+                                  _mm_cvtsi32_si128(rate2))),
+      _mm_and_si128(after_val, _mm_set1_epi16(diff)));
+  const __m128i valid = _mm_cmplt_epi16(idx, _mm_set1_epi16(nsymbs - 1));
+  const __m128i delta = _mm_sra_epi16(_mm_sub_epi16(tmp, c), rate);
+  return _mm_add_epi16(c, _mm_and_si128(delta, valid));
+}
+
+// Adapts the CDF eight or four entries at a time, as long as the loads stay
+// within the CDF_SIZE(nsymbs) array. Returns the index of the first entry left
+// for the scalar loop.
+static INLINE int update_cdf_sse2(aom_cdf_prob *cdf, int val, int nsymbs,
+                                  int rate, int diff, int rate2) {
+  const __m128i rate_v = _mm_cvtsi32_si128(rate);
+  int i = 0;
+  for (; i < nsymbs - 1 && i + 8 <= CDF_SIZE(nsymbs); i += 8) {
+    __m128i c = _mm_loadu_si128((const __m128i *)(cdf + i));
+    c = update_cdf_lanes_sse2(c, i, val, nsymbs, rate_v, diff, rate2);
+    _mm_storeu_si128((__m128i *)(cdf + i), c);
+  }
+  if (i < nsymbs - 1 && i + 4 <= CDF_SIZE(nsymbs)) {
+    __m128i c = _mm_loadl_epi64((const __m128i *)(cdf + i));
+    c = update_cdf_lanes_sse2(c, i, val, nsymbs, rate_v, diff, rate2);
+    _mm_storel_epi64((__m128i *)(cdf + i), c);
+    i += 4;
+  }
+  return AOMMIN(i, nsymbs - 1);
+}
+#endif
+
 static INLINE void update_cdf(aom_cdf_prob *cdf, int val, int nsymbs) {
   int rate = 4 + (cdf[nsymbs] > 31) + get_msb(nsymbs);
 #if CONFIG_LV_MAP
@@ -243,8 +292,17 @@ static INLINE void update_cdf(aom_cdf_prob *cdf, int val, int nsymbs) {
   tmp = AOM_ICDF(tmp0);
   diff = ((CDF_PROB_TOP - (nsymbs << rate2)) >> rate) << rate;
 
+  i = 0;
+#if HAVE_SSE2 && defined(__SSE2__)
+  // The scalar loop is as fast for the small alphabets.
+  if (nsymbs > 4) {
+    i = update_cdf_sse2(cdf, val, nsymbs, rate, diff, rate2);
+    tmp -= i * tmp0 + (val < i ? diff : 0);
+  }
+#endif
+
   // Single loop (faster)
-  for (i = 0; i < nsymbs - 1; ++i, tmp -= tmp0) {
+  for (; i < nsymbs - 1; ++i, tmp -= tmp0) {
     tmp -= (i == val ? diff : 0);
     cdf[i] += ((tmp - cdf[i]) >> rate);
   }
@@ -120,10 +120,11 @@ static double convert_score_db(double _score, double _weight, int bit_depth) {
   return 10 * (log10(pix_max * pix_max) - log10(_weight * _score));
 }
 
-static double calc_psnrhvs(const unsigned char *src, int _systride,
-                           const unsigned char *dst, int _dystride, double _par,
-                           int _w, int _h, int _step, const double _csf[8][8],
-                           uint32_t bit_depth, uint32_t _shift) {
+static void calc_psnrhvs(const unsigned char *src, int _systride,
+                         const unsigned char *dst, int _dystride, double _par,
+                         int _w, int _h, int _step, const double _csf[8][8],
+                         uint32_t bit_depth, uint32_t _shift, int _row_start,
+                         int _row_end, MetricsBand *band) {
   double ret;
   const uint8_t *_src8 = src;
   const uint8_t *_dst8 = dst;
@@ -159,7 +160,8 @@ static double calc_psnrhvs(const unsigned char *src, int _systride,
     for (y = 0; y < 8; y++)
       mask[x][y] =
           (_csf[x][y] * 0.3885746225901003) * (_csf[x][y] * 0.3885746225901003);
-  for (y = 0; y < _h - 7; y += _step) {
+  for (y = (_row_start + _step - 1) / _step * _step;
+       y < _row_end && y < _h - 7; y += _step) {
     for (x = 0; x < _w - 7; x += _step) {
       int i;
       int j;
@@ -245,34 +247,65 @@ static double calc_psnrhvs(const unsigned char *src, int _systride,
       }
     }
   }
+  band->sum = ret;
+  band->samples = pixels;
+}
+
+void aom_psnrhvs_band(const uint8_t *src, int src_stride, const uint8_t *dst,
+                      int dst_stride, int width, int height, int plane,
+                      int row_start, int row_end, uint32_t bd, uint32_t in_bd,
+                      MetricsBand *band) {
+  const double par = 1.0;
+  const int step = 7;
+  assert(bd == 8 || bd == 10 || bd == 12);
+  assert(bd >= in_bd);
+  calc_psnrhvs(src, src_stride, dst, dst_stride, par, width, height, step,
+               plane == 0 ? csf_y : plane == 1 ? csf_cb420 : csf_cr420, bd,
+               bd - in_bd, row_start, row_end, band);
+}
+
+double aom_psnrhvs_score(const double plane_error[3], uint32_t in_bd) {
+  const double psnrhvs =
+      plane_error[0] * .8 + .1 * (plane_error[1] + plane_error[2]);
+  return convert_score_db(psnrhvs, 1.0, in_bd);
+}
+
+// Returns the mean PSNR-HVS error of a plane, accumulated band by band.
+static double plane_psnrhvs(const uint8_t *src, int src_stride,
+                            const uint8_t *dst, int dst_stride, int width,
+                            int height, int plane, uint32_t bd,
+                            uint32_t in_bd) {
+  MetricsBand band;
+  double ret = 0;
+  int pixels = 0;
+  int row;
+  for (row = 0; row < height; row += METRICS_BAND_HEIGHT) {
+    aom_psnrhvs_band(src, src_stride, dst, dst_stride, width, height, plane,
+                     row, row + METRICS_BAND_HEIGHT, bd, in_bd, &band);
+    ret += band.sum;
+    pixels += band.samples;
+  }
   if (pixels <= 0) return 0;
-  ret /= pixels;
-  return ret;
+  return ret / pixels;
 }
 
 double aom_psnrhvs(const YV12_BUFFER_CONFIG *src, const YV12_BUFFER_CONFIG *dst,
                    double *y_psnrhvs, double *u_psnrhvs, double *v_psnrhvs,
                    uint32_t bd, uint32_t in_bd) {
-  double psnrhvs;
-  const double par = 1.0;
-  const int step = 7;
-  uint32_t bd_shift = 0;
+  double plane_error[3];
   aom_clear_system_state();
 
   assert(bd == 8 || bd == 10 || bd == 12);
   assert(bd >= in_bd);
 
-  bd_shift = bd - in_bd;
-
-  *y_psnrhvs = calc_psnrhvs(src->y_buffer, src->y_stride, dst->y_buffer,
-                            dst->y_stride, par, src->y_crop_width,
-                            src->y_crop_height, step, csf_y, bd, bd_shift);
-  *u_psnrhvs = calc_psnrhvs(src->u_buffer, src->uv_stride, dst->u_buffer,
-                            dst->uv_stride, par, src->uv_crop_width,
-                            src->uv_crop_height, step, csf_cb420, bd, bd_shift);
-  *v_psnrhvs = calc_psnrhvs(src->v_buffer, src->uv_stride, dst->v_buffer,
-                            dst->uv_stride, par, src->uv_crop_width,
-                            src->uv_crop_height, step, csf_cr420, bd, bd_shift);
-  psnrhvs = (*y_psnrhvs) * .8 + .1 * ((*u_psnrhvs) + (*v_psnrhvs));
-  return convert_score_db(psnrhvs, 1.0, in_bd);
+  *y_psnrhvs = plane_error[0] =
+      plane_psnrhvs(src->y_buffer, src->y_stride, dst->y_buffer, dst->y_stride,
+                    src->y_crop_width, src->y_crop_height, 0, bd, in_bd);
+  *u_psnrhvs = plane_error[1] = plane_psnrhvs(
+      src->u_buffer, src->uv_stride, dst->u_buffer, dst->uv_stride,
+      src->uv_crop_width, src->uv_crop_height, 1, bd, in_bd);
+  *v_psnrhvs = plane_error[2] = plane_psnrhvs(
+      src->v_buffer, src->uv_stride, dst->v_buffer, dst->uv_stride,
+      src->uv_crop_width, src->uv_crop_height, 2, bd, in_bd);
+  return aom_psnrhvs_score(plane_error, in_bd);
 }
@@ -122,45 +122,79 @@ static double highbd_ssim_8x8(const uint16_t *s, int sp, const uint16_t *r,
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
+void aom_ssim_band(const uint8_t *img1, int stride_img1, const uint8_t *img2,
+                   int stride_img2, int width, int height, int row_start,
+                   int row_end, MetricsBand *band) {
+  int i, j;
+
+  band->sum = 0;
+  band->samples = 0;
+  // sample point start with each 4x4 location
+  for (i = (row_start + 3) & ~3; i < row_end && i <= height - 8; i += 4) {
+    const uint8_t *const s = img1 + i * stride_img1;
+    const uint8_t *const r = img2 + i * stride_img2;
+    for (j = 0; j <= width - 8; j += 4) {
+      band->sum += ssim_8x8(s + j, stride_img1, r + j, stride_img2);
+      band->samples++;
+    }
+  }
+}
+
 static double aom_ssim2(const uint8_t *img1, const uint8_t *img2,
                         int stride_img1, int stride_img2, int width,
                         int height) {
-  int i, j;
+  MetricsBand band;
+  int row;
   int samples = 0;
   double ssim_total = 0;
 
-  // sample point start with each 4x4 location
-  for (i = 0; i <= height - 8;
-       i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
-    for (j = 0; j <= width - 8; j += 4) {
-      double v = ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
-      ssim_total += v;
-      samples++;
-    }
+  for (row = 0; row < height; row += METRICS_BAND_HEIGHT) {
+    aom_ssim_band(img1, stride_img1, img2, stride_img2, width, height, row,
+                  row + METRICS_BAND_HEIGHT, &band);
+    ssim_total += band.sum;
+    samples += band.samples;
   }
   ssim_total /= samples;
   return ssim_total;
 }
 
 #if CONFIG_HIGHBITDEPTH
-static double aom_highbd_ssim2(const uint8_t *img1, const uint8_t *img2,
-                               int stride_img1, int stride_img2, int width,
-                               int height, uint32_t bd, uint32_t shift) {
+void aom_highbd_ssim_band(const uint8_t *img1, int stride_img1,
+                          const uint8_t *img2, int stride_img2, int width,
+                          int height, int row_start, int row_end, uint32_t bd,
+                          uint32_t in_bd, MetricsBand *band) {
+  const uint32_t shift = bd - in_bd;
   int i, j;
-  int samples = 0;
-  double ssim_total = 0;
 
+  assert(bd >= in_bd);
+  band->sum = 0;
+  band->samples = 0;
   // sample point start with each 4x4 location
-  for (i = 0; i <= height - 8;
-       i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
+  for (i = (row_start + 3) & ~3; i < row_end && i <= height - 8; i += 4) {
+    const uint16_t *const s = CONVERT_TO_SHORTPTR(img1) + i * stride_img1;
+    const uint16_t *const r = CONVERT_TO_SHORTPTR(img2) + i * stride_img2;
     for (j = 0; j <= width - 8; j += 4) {
-      double v = highbd_ssim_8x8(CONVERT_TO_SHORTPTR(img1 + j), stride_img1,
-                                 CONVERT_TO_SHORTPTR(img2 + j), stride_img2, bd,
-                                 shift);
-      ssim_total += v;
-      samples++;
+      band->sum += highbd_ssim_8x8(s + j, stride_img1, r + j, stride_img2,
+                                   in_bd, shift);
+      band->samples++;
     }
   }
+}
+
+static double aom_highbd_ssim2(const uint8_t *img1, const uint8_t *img2,
+                               int stride_img1, int stride_img2, int width,
+                               int height, uint32_t bd, uint32_t in_bd) {
+  MetricsBand band;
+  int row;
+  int samples = 0;
+  double ssim_total = 0;
+
+  for (row = 0; row < height; row += METRICS_BAND_HEIGHT) {
+    aom_highbd_ssim_band(img1, stride_img1, img2, stride_img2, width, height,
+                         row, row + METRICS_BAND_HEIGHT, bd, in_bd, &band);
+    ssim_total += band.sum;
+    samples += band.samples;
+  }
   ssim_total /= samples;
   return ssim_total;
 }
@@ -427,7 +461,6 @@ double aom_highbd_calc_ssim(const YV12_BUFFER_CONFIG *source,
                             const YV12_BUFFER_CONFIG *dest, double *weight,
                             uint32_t bd, uint32_t in_bd) {
   assert(bd >= in_bd);
-  const uint32_t shift = bd - in_bd;
 
   double abc[3];
   for (int i = 0; i < 3; ++i) {
@@ -435,7 +468,7 @@ double aom_highbd_calc_ssim(const YV12_BUFFER_CONFIG *source,
     abc[i] = aom_highbd_ssim2(source->buffers[i], dest->buffers[i],
                               source->strides[is_uv], dest->strides[is_uv],
                               source->crop_widths[is_uv],
-                              source->crop_heights[is_uv], in_bd, shift);
+                              source->crop_heights[is_uv], bd, in_bd);
   }
 
   *weight = 1;
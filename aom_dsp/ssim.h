@@ -63,6 +63,42 @@ typedef struct {
   double ssimcd;
 } Metrics;
 
+// Window-based metrics are accumulated over horizontal bands of this many
+// rows. Full-plane scores are always assembled from bands of this height in
+// top-to-bottom order, so they do not depend on how bands were spread over
+// threads.
+#define METRICS_BAND_HEIGHT 64
+
+// Partial sum of a window-based metric over one band of rows.
+typedef struct {
+  double sum;
+  int samples;
+} MetricsBand;
+
+// Accumulate the SSIM of the 8x8 windows whose top row lies in
+// [row_start, row_end).
+void aom_ssim_band(const uint8_t *img1, int stride_img1, const uint8_t *img2,
+                   int stride_img2, int width, int height, int row_start,
+                   int row_end, MetricsBand *band);
+
+// Accumulate the PSNR-HVS error of the 8x8 blocks whose top row lies in
+// [row_start, row_end). plane selects the contrast sensitivity table.
+void aom_psnrhvs_band(const uint8_t *src, int src_stride, const uint8_t *dst,
+                      int dst_stride, int width, int height, int plane,
+                      int row_start, int row_end, uint32_t bd, uint32_t in_bd,
+                      MetricsBand *band);
+
+// Returns the PSNR-HVS of a frame, in dB, from its per-plane mean errors.
+double aom_psnrhvs_score(const double plane_error[3], uint32_t in_bd);
+
+// Returns the FastSSIM of a single plane.
+double aom_calc_fastssim_plane(const uint8_t *src, int src_stride,
+                               const uint8_t *dst, int dst_stride, int width,
+                               int height, uint32_t bd, uint32_t in_bd);
+
+// Returns the FastSSIM of a frame, in dB, from its per-plane scores.
+double aom_fastssim_score(const double plane_ssim[3]);
+
 double aom_get_ssim_metrics(uint8_t *img1, int img1_pitch, uint8_t *img2,
                             int img2_pitch, int width, int height, Ssimv *sv2,
                             Metrics *m, int do_inconsistency);
@@ -76,6 +112,11 @@ double aom_calc_fastssim(const YV12_BUFFER_CONFIG *source,
                          uint32_t in_bd);
 
 #if CONFIG_HIGHBITDEPTH
+void aom_highbd_ssim_band(const uint8_t *img1, int stride_img1,
+                          const uint8_t *img2, int stride_img2, int width,
+                          int height, int row_start, int row_end, uint32_t bd,
+                          uint32_t in_bd, MetricsBand *band);
+
 double aom_highbd_calc_ssim(const YV12_BUFFER_CONFIG *source,
                             const YV12_BUFFER_CONFIG *dest, double *weight,
                             uint32_t bd, uint32_t in_bd);
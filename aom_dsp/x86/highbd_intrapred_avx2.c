@@ -489,3 +489,72 @@ void aom_highbd_d63e_predictor_32x32_avx2(uint16_t *dst, ptrdiff_t stride,
   (void)bd;
   d63e_w32(above, dst, stride, 32);
 }
+
+// -----------------------------------------------------------------------------
+// PAETH_PRED
+
+// Return 16 16-bit pixels in one row
+static INLINE __m256i highbd_paeth_16x1_pred(const __m256i *left,
+                                             const __m256i *top,
+                                             const __m256i *topleft) {
+  const __m256i base =
+      _mm256_sub_epi16(_mm256_add_epi16(*top, *left), *topleft);
+
+  __m256i pl = _mm256_abs_epi16(_mm256_sub_epi16(base, *left));
+  __m256i pt = _mm256_abs_epi16(_mm256_sub_epi16(base, *top));
+  __m256i ptl = _mm256_abs_epi16(_mm256_sub_epi16(base, *topleft));
+
+  __m256i mask1 = _mm256_cmpgt_epi16(pl, pt);
+  mask1 = _mm256_or_si256(mask1, _mm256_cmpgt_epi16(pl, ptl));
+  __m256i mask2 = _mm256_cmpgt_epi16(pt, ptl);
+
+  pl = _mm256_andnot_si256(mask1, *left);
+
+  ptl = _mm256_and_si256(mask2, *topleft);
+  pt = _mm256_andnot_si256(mask2, *top);
+  pt = _mm256_or_si256(pt, ptl);
+  pt = _mm256_and_si256(mask1, pt);
+
+  return _mm256_or_si256(pl, pt);
+}
+
+// width is a multiple of 16.
+static INLINE void highbd_paeth_predictor_wxh(uint16_t *dst, ptrdiff_t stride,
+                                              const uint16_t *above,
+                                              const uint16_t *left, int width,
+                                              int height) {
+  const __m256i tl16 = _mm256_set1_epi16((int16_t)above[-1]);
+  int r, c;
+  for (c = 0; c < width; c += 16) {
+    const __m256i t16 = _mm256_loadu_si256((const __m256i *)(above + c));
+    uint16_t *d = dst + c;
+    for (r = 0; r < height; ++r, d += stride) {
+      const __m256i l16 = _mm256_set1_epi16((int16_t)left[r]);
+      const __m256i row = highbd_paeth_16x1_pred(&l16, &t16, &tl16);
+      _mm256_storeu_si256((__m256i *)d, row);
+    }
+  }
+}
+
+#define HIGHBD_PAETH_PRED_WXH(w, h)                                      \
+  void aom_highbd_paeth_predictor_##w##x##h##_avx2(                      \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,            \
+      const uint16_t *left, int bd) {                                    \
+    (void)bd;                                                            \
+    highbd_paeth_predictor_wxh(dst, stride, above, left, w, h);          \
+  }
+
+HIGHBD_PAETH_PRED_WXH(16, 4)
+HIGHBD_PAETH_PRED_WXH(16, 8)
+HIGHBD_PAETH_PRED_WXH(16, 16)
+HIGHBD_PAETH_PRED_WXH(16, 32)
+HIGHBD_PAETH_PRED_WXH(32, 8)
+HIGHBD_PAETH_PRED_WXH(32, 16)
+HIGHBD_PAETH_PRED_WXH(32, 32)
+#if CONFIG_TX64X64
+HIGHBD_PAETH_PRED_WXH(16, 64)
+HIGHBD_PAETH_PRED_WXH(32, 64)
+HIGHBD_PAETH_PRED_WXH(64, 16)
+HIGHBD_PAETH_PRED_WXH(64, 32)
+HIGHBD_PAETH_PRED_WXH(64, 64)
+#endif  // CONFIG_TX64X64
@@ -12,6 +12,7 @@
 #include <emmintrin.h>
 
 #include "./aom_dsp_rtcd.h"
+#include "aom_dsp/intrapred_common.h"
 
 // -----------------------------------------------------------------------------
 // H_PRED
@@ -1595,3 +1596,312 @@ void aom_highbd_d63e_predictor_8x16_sse2(uint16_t *dst, ptrdiff_t stride,
     D63E_STORE_8X4;
   } while (i < 10);
 }
+
+// -----------------------------------------------------------------------------
+// DC, DC_TOP, DC_LEFT, DC_128, V and H for the 1:4 and 64 wide/high sizes.
+
+static INLINE uint32_t sum_wxh_u16(const uint16_t *ref, int n) {
+  const __m128i one = _mm_set1_epi16(1);
+  __m128i sum = _mm_setzero_si128();
+  int i;
+  if (n == 4) {
+    sum = _mm_madd_epi16(_mm_loadl_epi64((const __m128i *)ref), one);
+  } else {
+    for (i = 0; i < n; i += 8) {
+      const __m128i r = _mm_loadu_si128((const __m128i *)(ref + i));
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(r, one));
+    }
+  }
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  return (uint32_t)_mm_cvtsi128_si32(sum);
+}
+
+static INLINE void dc_store_wxh(uint16_t *dst, ptrdiff_t stride, int width,
+                                int height, uint16_t value) {
+  const __m128i row = _mm_set1_epi16((int16_t)value);
+  int i, j;
+  for (i = 0; i < height; ++i, dst += stride) {
+    if (width == 4) {
+      _mm_storel_epi64((__m128i *)dst, row);
+    } else {
+      for (j = 0; j < width; j += 8)
+        _mm_storeu_si128((__m128i *)(dst + j), row);
+    }
+  }
+}
+
+static INLINE void dc_predictor_wxh(uint16_t *dst, ptrdiff_t stride,
+                                    const uint16_t *above,
+                                    const uint16_t *left, int width,
+                                    int height) {
+  const uint32_t count = width + height;
+  const uint32_t sum = sum_wxh_u16(above, width) + sum_wxh_u16(left, height);
+  dc_store_wxh(dst, stride, width, height, (sum + (count >> 1)) / count);
+}
+
+static INLINE void dc_top_predictor_wxh(uint16_t *dst, ptrdiff_t stride,
+                                        const uint16_t *above, int width,
+                                        int height) {
+  const uint32_t sum = sum_wxh_u16(above, width);
+  dc_store_wxh(dst, stride, width, height, (sum + (width >> 1)) / width);
+}
+
+static INLINE void dc_left_predictor_wxh(uint16_t *dst, ptrdiff_t stride,
+                                         const uint16_t *left, int width,
+                                         int height) {
+  const uint32_t sum = sum_wxh_u16(left, height);
+  dc_store_wxh(dst, stride, width, height, (sum + (height >> 1)) / height);
+}
+
+static INLINE void v_predictor_wxh(uint16_t *dst, ptrdiff_t stride,
+                                   const uint16_t *above, int width,
+                                   int height) {
+  int i, j;
+  if (width == 4) {
+    const __m128i row = _mm_loadl_epi64((const __m128i *)above);
+    for (i = 0; i < height; ++i, dst += stride)
+      _mm_storel_epi64((__m128i *)dst, row);
+    return;
+  }
+  for (j = 0; j < width; j += 8) {
+    const __m128i row = _mm_loadu_si128((const __m128i *)(above + j));
+    uint16_t *d = dst + j;
+    for (i = 0; i < height; ++i, d += stride)
+      _mm_storeu_si128((__m128i *)d, row);
+  }
+}
+
+static INLINE void h_predictor_wxh(uint16_t *dst, ptrdiff_t stride,
+                                   const uint16_t *left, int width,
+                                   int height) {
+  int i, j;
+  for (i = 0; i < height; ++i, dst += stride) {
+    const __m128i row = _mm_set1_epi16((int16_t)left[i]);
+    if (width == 4) {
+      _mm_storel_epi64((__m128i *)dst, row);
+    } else {
+      for (j = 0; j < width; j += 8)
+        _mm_storeu_si128((__m128i *)(dst + j), row);
+    }
+  }
+}
+
+#define HIGHBD_DC_V_H_PRED_WXH(w, h)                                         \
+  void aom_highbd_dc_predictor_##w##x##h##_sse2(                             \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                \
+      const uint16_t *left, int bd) {                                        \
+    (void)bd;                                                                \
+    dc_predictor_wxh(dst, stride, above, left, w, h);                        \
+  }                                                                          \
+  void aom_highbd_dc_top_predictor_##w##x##h##_sse2(                         \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                \
+      const uint16_t *left, int bd) {                                        \
+    (void)left;                                                              \
+    (void)bd;                                                                \
+    dc_top_predictor_wxh(dst, stride, above, w, h);                          \
+  }                                                                          \
+  void aom_highbd_dc_left_predictor_##w##x##h##_sse2(                        \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                \
+      const uint16_t *left, int bd) {                                        \
+    (void)above;                                                             \
+    (void)bd;                                                                \
+    dc_left_predictor_wxh(dst, stride, left, w, h);                          \
+  }                                                                          \
+  void aom_highbd_dc_128_predictor_##w##x##h##_sse2(                         \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                \
+      const uint16_t *left, int bd) {                                        \
+    (void)above;                                                             \
+    (void)left;                                                              \
+    dc_store_wxh(dst, stride, w, h, 1 << (bd - 1));                          \
+  }                                                                          \
+  void aom_highbd_v_predictor_##w##x##h##_sse2(                              \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                \
+      const uint16_t *left, int bd) {                                        \
+    (void)left;                                                              \
+    (void)bd;                                                                \
+    v_predictor_wxh(dst, stride, above, w, h);                               \
+  }                                                                          \
+  void aom_highbd_h_predictor_##w##x##h##_sse2(                              \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                \
+      const uint16_t *left, int bd) {                                        \
+    (void)above;                                                             \
+    (void)bd;                                                                \
+    h_predictor_wxh(dst, stride, left, w, h);                                \
+  }
+
+HIGHBD_DC_V_H_PRED_WXH(4, 16)
+HIGHBD_DC_V_H_PRED_WXH(16, 4)
+HIGHBD_DC_V_H_PRED_WXH(8, 32)
+HIGHBD_DC_V_H_PRED_WXH(32, 8)
+#if CONFIG_TX64X64
+HIGHBD_DC_V_H_PRED_WXH(16, 64)
+HIGHBD_DC_V_H_PRED_WXH(64, 16)
+HIGHBD_DC_V_H_PRED_WXH(32, 64)
+HIGHBD_DC_V_H_PRED_WXH(64, 32)
+HIGHBD_DC_V_H_PRED_WXH(64, 64)
+#endif  // CONFIG_TX64X64
+
+// -----------------------------------------------------------------------------
+// SMOOTH_PRED, SMOOTH_V_PRED, SMOOTH_H_PRED
+//
+// Each output pixel is a sum of (pixel, weight) pairs. The pixels of a pair
+// are interleaved in one vector and the matching weights in another, so that
+// _mm_madd_epi16 produces the 32-bit partial sums directly. Pixels are at most
+// 12 bits and weights at most 256, which keeps every product within range.
+
+// Loads 8 (or 4) smooth weights starting at weights[0] and interleaves them
+// with (scale - weight): out[0] covers columns 0-3, out[1] columns 4-7.
+static INLINE void load_weight_pairs(const uint8_t *weights, int n,
+                                     __m128i *out) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i scale = _mm_set1_epi16(1 << sm_weight_log2_scale);
+  const __m128i w =
+      n == 4 ? _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int *)weights), zero)
+             : _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)weights),
+                                 zero);
+  const __m128i w_inv = _mm_sub_epi16(scale, w);
+  out[0] = _mm_unpacklo_epi16(w, w_inv);
+  out[1] = _mm_unpackhi_epi16(w, w_inv);
+}
+
+static INLINE __m128i load_pixels_w(const uint16_t *ref, int width) {
+  return width == 4 ? _mm_loadl_epi64((const __m128i *)ref)
+                    : _mm_loadu_si128((const __m128i *)ref);
+}
+
+static INLINE void store_pixels_w(uint16_t *dst, int width, __m128i lo,
+                                  __m128i hi) {
+  const __m128i row = _mm_packs_epi32(lo, hi);
+  if (width == 4)
+    _mm_storel_epi64((__m128i *)dst, row);
+  else
+    _mm_storeu_si128((__m128i *)dst, row);
+}
+
+static INLINE __m128i weight_pair(uint8_t weight) {
+  return _mm_set1_epi32(weight | ((1 << sm_weight_log2_scale) - weight) << 16);
+}
+
+static INLINE void highbd_smooth_predictor_wxh(uint16_t *dst,
+                                               ptrdiff_t stride,
+                                               const uint16_t *above,
+                                               const uint16_t *left, int width,
+                                               int height) {
+  const uint8_t *const sm_weights_w = sm_weight_arrays + width;
+  const uint8_t *const sm_weights_h = sm_weight_arrays + height;
+  const __m128i below_pred = _mm_set1_epi16((int16_t)left[height - 1]);
+  const __m128i round = _mm_set1_epi32(1 << sm_weight_log2_scale);
+  const int right_pred = above[width - 1];
+  int r, c;
+  for (c = 0; c < width; c += 8) {
+    const __m128i a = load_pixels_w(above + c, width);
+    const __m128i ab_lo = _mm_unpacklo_epi16(a, below_pred);
+    const __m128i ab_hi = _mm_unpackhi_epi16(a, below_pred);
+    __m128i ww[2];
+    uint16_t *d = dst + c;
+    load_weight_pairs(sm_weights_w + c, width, ww);
+    for (r = 0; r < height; ++r, d += stride) {
+      const __m128i wh = weight_pair(sm_weights_h[r]);
+      const __m128i lr = _mm_set1_epi32(left[r] | (right_pred << 16));
+      __m128i lo = _mm_add_epi32(_mm_madd_epi16(ab_lo, wh),
+                                 _mm_madd_epi16(lr, ww[0]));
+      __m128i hi = _mm_add_epi32(_mm_madd_epi16(ab_hi, wh),
+                                 _mm_madd_epi16(lr, ww[1]));
+      lo = _mm_srai_epi32(_mm_add_epi32(lo, round), 1 + sm_weight_log2_scale);
+      hi = _mm_srai_epi32(_mm_add_epi32(hi, round), 1 + sm_weight_log2_scale);
+      store_pixels_w(d, width, lo, hi);
+    }
+  }
+}
+
+static INLINE void highbd_smooth_v_predictor_wxh(uint16_t *dst,
+                                                 ptrdiff_t stride,
+                                                 const uint16_t *above,
+                                                 const uint16_t *left,
+                                                 int width, int height) {
+  const uint8_t *const sm_weights = sm_weight_arrays + height;
+  const __m128i below_pred = _mm_set1_epi16((int16_t)left[height - 1]);
+  const __m128i round = _mm_set1_epi32(1 << (sm_weight_log2_scale - 1));
+  int r, c;
+  for (c = 0; c < width; c += 8) {
+    const __m128i a = load_pixels_w(above + c, width);
+    const __m128i ab_lo = _mm_unpacklo_epi16(a, below_pred);
+    const __m128i ab_hi = _mm_unpackhi_epi16(a, below_pred);
+    uint16_t *d = dst + c;
+    for (r = 0; r < height; ++r, d += stride) {
+      const __m128i wh = weight_pair(sm_weights[r]);
+      __m128i lo = _mm_add_epi32(_mm_madd_epi16(ab_lo, wh), round);
+      __m128i hi = _mm_add_epi32(_mm_madd_epi16(ab_hi, wh), round);
+      lo = _mm_srai_epi32(lo, sm_weight_log2_scale);
+      hi = _mm_srai_epi32(hi, sm_weight_log2_scale);
+      store_pixels_w(d, width, lo, hi);
+    }
+  }
+}
+
+static INLINE void highbd_smooth_h_predictor_wxh(uint16_t *dst,
+                                                 ptrdiff_t stride,
+                                                 const uint16_t *above,
+                                                 const uint16_t *left,
+                                                 int width, int height) {
+  const uint8_t *const sm_weights = sm_weight_arrays + width;
+  const __m128i round = _mm_set1_epi32(1 << (sm_weight_log2_scale - 1));
+  const int right_pred = above[width - 1];
+  int r, c;
+  for (c = 0; c < width; c += 8) {
+    __m128i ww[2];
+    uint16_t *d = dst + c;
+    load_weight_pairs(sm_weights + c, width, ww);
+    for (r = 0; r < height; ++r, d += stride) {
+      const __m128i lr = _mm_set1_epi32(left[r] | (right_pred << 16));
+      __m128i lo = _mm_add_epi32(_mm_madd_epi16(lr, ww[0]), round);
+      __m128i hi = _mm_add_epi32(_mm_madd_epi16(lr, ww[1]), round);
+      lo = _mm_srai_epi32(lo, sm_weight_log2_scale);
+      hi = _mm_srai_epi32(hi, sm_weight_log2_scale);
+      store_pixels_w(d, width, lo, hi);
+    }
+  }
+}
+
+#define HIGHBD_SMOOTH_PRED_WXH(w, h)                                          \
+  void aom_highbd_smooth_predictor_##w##x##h##_sse2(                          \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                 \
+      const uint16_t *left, int bd) {                                         \
+    (void)bd;                                                                 \
+    highbd_smooth_predictor_wxh(dst, stride, above, left, w, h);              \
+  }                                                                           \
+  void aom_highbd_smooth_v_predictor_##w##x##h##_sse2(                        \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                 \
+      const uint16_t *left, int bd) {                                         \
+    (void)bd;                                                                 \
+    highbd_smooth_v_predictor_wxh(dst, stride, above, left, w, h);            \
+  }                                                                           \
+  void aom_highbd_smooth_h_predictor_##w##x##h##_sse2(                        \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,                 \
+      const uint16_t *left, int bd) {                                         \
+    (void)bd;                                                                 \
+    highbd_smooth_h_predictor_wxh(dst, stride, above, left, w, h);            \
+  }
+
+HIGHBD_SMOOTH_PRED_WXH(4, 4)
+HIGHBD_SMOOTH_PRED_WXH(4, 8)
+HIGHBD_SMOOTH_PRED_WXH(4, 16)
+HIGHBD_SMOOTH_PRED_WXH(8, 4)
+HIGHBD_SMOOTH_PRED_WXH(8, 8)
+HIGHBD_SMOOTH_PRED_WXH(8, 16)
+HIGHBD_SMOOTH_PRED_WXH(8, 32)
+HIGHBD_SMOOTH_PRED_WXH(16, 4)
+HIGHBD_SMOOTH_PRED_WXH(16, 8)
+HIGHBD_SMOOTH_PRED_WXH(16, 16)
+HIGHBD_SMOOTH_PRED_WXH(16, 32)
+HIGHBD_SMOOTH_PRED_WXH(32, 8)
+HIGHBD_SMOOTH_PRED_WXH(32, 16)
+HIGHBD_SMOOTH_PRED_WXH(32, 32)
+#if CONFIG_TX64X64
+HIGHBD_SMOOTH_PRED_WXH(16, 64)
+HIGHBD_SMOOTH_PRED_WXH(32, 64)
+HIGHBD_SMOOTH_PRED_WXH(64, 16)
+HIGHBD_SMOOTH_PRED_WXH(64, 32)
+HIGHBD_SMOOTH_PRED_WXH(64, 64)
+#endif  // CONFIG_TX64X64
@@ -519,3 +519,87 @@ void aom_highbd_d153_predictor_32x32_ssse3(uint16_t *dst, ptrdiff_t stride,
     }
   }
 }
+
+// -----------------------------------------------------------------------------
+// PAETH_PRED
+
+// Return 8 16-bit pixels in one row. The base value top + left - topleft can
+// reach 2 * ((1 << 12) - 1), which still fits in a signed 16-bit lane.
+static INLINE __m128i highbd_paeth_8x1_pred(const __m128i *left,
+                                            const __m128i *top,
+                                            const __m128i *topleft) {
+  const __m128i base = _mm_sub_epi16(_mm_add_epi16(*top, *left), *topleft);
+
+  __m128i pl = _mm_abs_epi16(_mm_sub_epi16(base, *left));
+  __m128i pt = _mm_abs_epi16(_mm_sub_epi16(base, *top));
+  __m128i ptl = _mm_abs_epi16(_mm_sub_epi16(base, *topleft));
+
+  __m128i mask1 = _mm_cmpgt_epi16(pl, pt);
+  mask1 = _mm_or_si128(mask1, _mm_cmpgt_epi16(pl, ptl));
+  __m128i mask2 = _mm_cmpgt_epi16(pt, ptl);
+
+  pl = _mm_andnot_si128(mask1, *left);
+
+  ptl = _mm_and_si128(mask2, *topleft);
+  pt = _mm_andnot_si128(mask2, *top);
+  pt = _mm_or_si128(pt, ptl);
+  pt = _mm_and_si128(mask1, pt);
+
+  return _mm_or_si128(pl, pt);
+}
+
+static INLINE void highbd_paeth_predictor_wxh(uint16_t *dst, ptrdiff_t stride,
+                                              const uint16_t *above,
+                                              const uint16_t *left, int width,
+                                              int height) {
+  const __m128i tl16 = _mm_set1_epi16((int16_t)above[-1]);
+  int r, c;
+  if (width == 4) {
+    const __m128i t16 = _mm_loadl_epi64((const __m128i *)above);
+    for (r = 0; r < height; ++r, dst += stride) {
+      const __m128i l16 = _mm_set1_epi16((int16_t)left[r]);
+      const __m128i row = highbd_paeth_8x1_pred(&l16, &t16, &tl16);
+      _mm_storel_epi64((__m128i *)dst, row);
+    }
+    return;
+  }
+  for (c = 0; c < width; c += 8) {
+    const __m128i t16 = _mm_loadu_si128((const __m128i *)(above + c));
+    uint16_t *d = dst + c;
+    for (r = 0; r < height; ++r, d += stride) {
+      const __m128i l16 = _mm_set1_epi16((int16_t)left[r]);
+      const __m128i row = highbd_paeth_8x1_pred(&l16, &t16, &tl16);
+      _mm_storeu_si128((__m128i *)d, row);
+    }
+  }
+}
+
+#define HIGHBD_PAETH_PRED_WXH(w, h)                                      \
+  void aom_highbd_paeth_predictor_##w##x##h##_ssse3(                     \
+      uint16_t *dst, ptrdiff_t stride, const uint16_t *above,            \
+      const uint16_t *left, int bd) {                                    \
+    (void)bd;                                                            \
+    highbd_paeth_predictor_wxh(dst, stride, above, left, w, h);          \
+  }
+
+HIGHBD_PAETH_PRED_WXH(4, 4)
+HIGHBD_PAETH_PRED_WXH(4, 8)
+HIGHBD_PAETH_PRED_WXH(4, 16)
+HIGHBD_PAETH_PRED_WXH(8, 4)
+HIGHBD_PAETH_PRED_WXH(8, 8)
+HIGHBD_PAETH_PRED_WXH(8, 16)
+HIGHBD_PAETH_PRED_WXH(8, 32)
+HIGHBD_PAETH_PRED_WXH(16, 4)
+HIGHBD_PAETH_PRED_WXH(16, 8)
+HIGHBD_PAETH_PRED_WXH(16, 16)
+HIGHBD_PAETH_PRED_WXH(16, 32)
+HIGHBD_PAETH_PRED_WXH(32, 8)
+HIGHBD_PAETH_PRED_WXH(32, 16)
+HIGHBD_PAETH_PRED_WXH(32, 32)
+#if CONFIG_TX64X64
+HIGHBD_PAETH_PRED_WXH(16, 64)
+HIGHBD_PAETH_PRED_WXH(32, 64)
+HIGHBD_PAETH_PRED_WXH(64, 16)
+HIGHBD_PAETH_PRED_WXH(64, 32)
+HIGHBD_PAETH_PRED_WXH(64, 64)
+#endif  // CONFIG_TX64X64
@@ -897,6 +897,26 @@ void aom_highbd_lpf_vertical_4_dual_sse2(
     uint16_t *s, int p, const uint8_t *blimit0, const uint8_t *limit0,
     const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
     const uint8_t *thresh1, int bd) {
+#if CONFIG_PARALLEL_DEBLOCKING
+  // The two 4 row segments form a single 8x8 block around the edge.
+  DECLARE_ALIGNED(16, uint16_t, t_dst[8 * 8]);
+  uint16_t *src[1];
+  uint16_t *dst[1];
+
+  // Transpose 8x8
+  src[0] = s - 4;
+  dst[0] = t_dst;
+  highbd_transpose(src, p, dst, 8, 1);
+
+  // Loop filtering
+  aom_highbd_lpf_horizontal_4_dual_sse2(t_dst + 4 * 8, 8, blimit0, limit0,
+                                        thresh0, blimit1, limit1, thresh1, bd);
+
+  // Transpose back
+  src[0] = t_dst;
+  dst[0] = s - 4;
+  highbd_transpose(src, 8, dst, p, 1);
+#else
   DECLARE_ALIGNED(16, uint16_t, t_dst[16 * 8]);
   uint16_t *src[2];
   uint16_t *dst[2];
@@ -914,6 +934,7 @@ void aom_highbd_lpf_vertical_4_dual_sse2(
 
   // Transpose back
   highbd_transpose(src, 16, dst, p, 2);
+#endif  // CONFIG_PARALLEL_DEBLOCKING
 }
 
 void aom_highbd_lpf_vertical_8_sse2(uint16_t *s, int p, const uint8_t *blimit,
@@ -943,6 +964,26 @@ void aom_highbd_lpf_vertical_8_dual_sse2(
     uint16_t *s, int p, const uint8_t *blimit0, const uint8_t *limit0,
     const uint8_t *thresh0, const uint8_t *blimit1, const uint8_t *limit1,
     const uint8_t *thresh1, int bd) {
+#if CONFIG_PARALLEL_DEBLOCKING
+  // The two 4 row segments form a single 8x8 block around the edge.
+  DECLARE_ALIGNED(16, uint16_t, t_dst[8 * 8]);
+  uint16_t *src[1];
+  uint16_t *dst[1];
+
+  // Transpose 8x8
+  src[0] = s - 4;
+  dst[0] = t_dst;
+  highbd_transpose(src, p, dst, 8, 1);
+
+  // Loop filtering
+  aom_highbd_lpf_horizontal_8_dual_sse2(t_dst + 4 * 8, 8, blimit0, limit0,
+                                        thresh0, blimit1, limit1, thresh1, bd);
+
+  // Transpose back
+  src[0] = t_dst;
+  dst[0] = s - 4;
+  highbd_transpose(src, 8, dst, p, 1);
+#else
   DECLARE_ALIGNED(16, uint16_t, t_dst[16 * 8]);
   uint16_t *src[2];
   uint16_t *dst[2];
@@ -961,6 +1002,7 @@ void aom_highbd_lpf_vertical_8_dual_sse2(
 
   // Transpose back
   highbd_transpose(src, 16, dst, p, 2);
+#endif  // CONFIG_PARALLEL_DEBLOCKING
 }
 
 void aom_highbd_lpf_vertical_16_sse2(uint16_t *s, int p, const uint8_t *blimit,
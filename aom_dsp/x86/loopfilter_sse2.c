@@ -1003,10 +1003,12 @@ static INLINE void lpf_horz_edge_16_internal(PixelOutput pixel_num,
   }
 }
 
-void aom_lpf_horizontal_8_sse2(unsigned char *s, int p,
-                               const unsigned char *_blimit,
-                               const unsigned char *_limit,
-                               const unsigned char *_thresh) {
+// Filters up to 8 pixels of a horizontal edge. The limits are given per pixel
+// in the low 8 lanes of blimit, limit and thresh.
+static INLINE void lpf_horz_8_internal(PixelOutput pixel_num, unsigned char *s,
+                                       int p, const __m128i blimit,
+                                       const __m128i limit,
+                                       const __m128i thresh) {
   DECLARE_ALIGNED(16, unsigned char, flat_op2[16]);
   DECLARE_ALIGNED(16, unsigned char, flat_op1[16]);
   DECLARE_ALIGNED(16, unsigned char, flat_op0[16]);
@@ -1014,9 +1016,6 @@ void aom_lpf_horizontal_8_sse2(unsigned char *s, int p,
   DECLARE_ALIGNED(16, unsigned char, flat_oq1[16]);
   DECLARE_ALIGNED(16, unsigned char, flat_oq0[16]);
   const __m128i zero = _mm_set1_epi16(0);
-  const __m128i blimit = _mm_load_si128((const __m128i *)_blimit);
-  const __m128i limit = _mm_load_si128((const __m128i *)_limit);
-  const __m128i thresh = _mm_load_si128((const __m128i *)_thresh);
   __m128i mask, hev, flat;
   __m128i p3, p2, p1, p0, q0, q1, q2, q3;
   __m128i q3p3, q2p2, q1p1, q0p0, p1q1, p0q0;
@@ -1206,22 +1205,36 @@ void aom_lpf_horizontal_8_sse2(unsigned char *s, int p,
     p2 = _mm_and_si128(flat, p2);
     p2 = _mm_or_si128(work_a, p2);
 
+    if (pixel_num == FOUR_PIXELS) {
+      xx_storel_32(s - 3 * p, p2);
+      xx_storel_32(s - 2 * p, p1);
+      xx_storel_32(s - 1 * p, p0);
+      xx_storel_32(s + 0 * p, q0);
+      xx_storel_32(s + 1 * p, q1);
+      xx_storel_32(s + 2 * p, q2);
+    } else {
+      xx_storel_64(s - 3 * p, p2);
+      xx_storel_64(s - 2 * p, p1);
+      xx_storel_64(s - 1 * p, p0);
+      xx_storel_64(s + 0 * p, q0);
+      xx_storel_64(s + 1 * p, q1);
+      xx_storel_64(s + 2 * p, q2);
+    }
+  }
+}
+
+void aom_lpf_horizontal_8_sse2(unsigned char *s, int p,
+                               const unsigned char *_blimit,
+                               const unsigned char *_limit,
+                               const unsigned char *_thresh) {
+  const __m128i blimit = _mm_load_si128((const __m128i *)_blimit);
+  const __m128i limit = _mm_load_si128((const __m128i *)_limit);
+  const __m128i thresh = _mm_load_si128((const __m128i *)_thresh);
 #if CONFIG_PARALLEL_DEBLOCKING
-    xx_storel_32(s - 3 * p, p2);
-    xx_storel_32(s - 2 * p, p1);
-    xx_storel_32(s - 1 * p, p0);
-    xx_storel_32(s + 0 * p, q0);
-    xx_storel_32(s + 1 * p, q1);
-    xx_storel_32(s + 2 * p, q2);
+  lpf_horz_8_internal(FOUR_PIXELS, s, p, blimit, limit, thresh);
 #else
-    xx_storel_64(s - 3 * p, p2);
-    xx_storel_64(s - 2 * p, p1);
-    xx_storel_64(s - 1 * p, p0);
-    xx_storel_64(s + 0 * p, q0);
-    xx_storel_64(s + 1 * p, q1);
-    xx_storel_64(s + 2 * p, q2);
+  lpf_horz_8_internal(EIGHT_PIXELS, s, p, blimit, limit, thresh);
 #endif
-  }
 }
 
 void aom_lpf_horizontal_16_dual_sse2(unsigned char *s, int p,
@@ -1235,6 +1248,57 @@ void aom_lpf_horizontal_16_dual_sse2(unsigned char *s, int p,
 #endif
 }
 
+#if CONFIG_PARALLEL_DEBLOCKING
+// Packs the limits of two adjacent 4 pixel segments into lanes 0-7, repeated in
+// lanes 8-15 for the kernels that fold the q side onto the p side.
+static INLINE __m128i load_dual_limit(const uint8_t *l0, const uint8_t *l1) {
+  const __m128i l = _mm_unpacklo_epi32(xx_loadl_32(l0), xx_loadl_32(l1));
+  return _mm_unpacklo_epi64(l, l);
+}
+
+void aom_lpf_horizontal_8_dual_sse2(uint8_t *s, int p, const uint8_t *_blimit0,
+                                    const uint8_t *_limit0,
+                                    const uint8_t *_thresh0,
+                                    const uint8_t *_blimit1,
+                                    const uint8_t *_limit1,
+                                    const uint8_t *_thresh1) {
+  lpf_horz_8_internal(EIGHT_PIXELS, s, p, load_dual_limit(_blimit0, _blimit1),
+                      load_dual_limit(_limit0, _limit1),
+                      load_dual_limit(_thresh0, _thresh1));
+}
+
+void aom_lpf_horizontal_4_dual_sse2(unsigned char *s, int p,
+                                    const unsigned char *_blimit0,
+                                    const unsigned char *_limit0,
+                                    const unsigned char *_thresh0,
+                                    const unsigned char *_blimit1,
+                                    const unsigned char *_limit1,
+                                    const unsigned char *_thresh1) {
+  const __m128i zero = _mm_set1_epi16(0);
+  const __m128i limit =
+      _mm_unpacklo_epi64(load_dual_limit(_blimit0, _blimit1),
+                         load_dual_limit(_limit0, _limit1));
+  const __m128i thresh =
+      _mm_unpacklo_epi8(load_dual_limit(_thresh0, _thresh1), zero);
+  const __m128i ff = _mm_cmpeq_epi8(zero, zero);
+  __m128i q1p1, q0p0, p1p0, q1q0, ps1ps0, qs1qs0;
+  __m128i mask, hev;
+
+  q1p1 = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)(s - 2 * p)),
+                            _mm_loadl_epi64((__m128i *)(s + 1 * p)));
+  q0p0 = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)(s - 1 * p)),
+                            _mm_loadl_epi64((__m128i *)(s + 0 * p)));
+  p1p0 = _mm_unpacklo_epi64(q0p0, q1p1);
+  q1q0 = _mm_unpackhi_epi64(q0p0, q1p1);
+  FILTER_HEV_MASK4;
+  FILTER4;
+
+  _mm_storeh_pi((__m64 *)(s - 2 * p), _mm_castsi128_ps(ps1ps0));  // *op1
+  _mm_storel_epi64((__m128i *)(s - 1 * p), ps1ps0);               // *op0
+  _mm_storel_epi64((__m128i *)(s + 0 * p), qs1qs0);               // *oq0
+  _mm_storeh_pi((__m64 *)(s + 1 * p), _mm_castsi128_ps(qs1qs0));  // *oq1
+}
+#else
 void aom_lpf_horizontal_8_dual_sse2(uint8_t *s, int p, const uint8_t *_blimit0,
                                     const uint8_t *_limit0,
                                     const uint8_t *_thresh0,
@@ -1494,23 +1558,17 @@ void aom_lpf_horizontal_4_dual_sse2(unsigned char *s, int p,
       _mm_unpacklo_epi64(_mm_load_si128((const __m128i *)_thresh0),
                          _mm_load_si128((const __m128i *)_thresh1));
   const __m128i zero = _mm_set1_epi16(0);
-#if !CONFIG_PARALLEL_DEBLOCKING
   __m128i p3, p2, q2, q3;
-#endif  // !CONFIG_PARALLEL_DEBLOCKING
   __m128i p1, p0, q0, q1;
   __m128i mask, hev, flat;
-#if !CONFIG_PARALLEL_DEBLOCKING
   p3 = _mm_loadu_si128((__m128i *)(s - 4 * p));
   p2 = _mm_loadu_si128((__m128i *)(s - 3 * p));
-#endif  // !CONFIG_PARALLEL_DEBLOCKING
   p1 = _mm_loadu_si128((__m128i *)(s - 2 * p));
   p0 = _mm_loadu_si128((__m128i *)(s - 1 * p));
   q0 = _mm_loadu_si128((__m128i *)(s - 0 * p));
   q1 = _mm_loadu_si128((__m128i *)(s + 1 * p));
-#if !CONFIG_PARALLEL_DEBLOCKING
   q2 = _mm_loadu_si128((__m128i *)(s + 2 * p));
   q3 = _mm_loadu_si128((__m128i *)(s + 3 * p));
-#endif  // !CONFIG_PARALLEL_DEBLOCKING
   // filter_mask and hev_mask
   {
     const __m128i abs_p1p0 =
@@ -1523,9 +1581,7 @@ void aom_lpf_horizontal_4_dual_sse2(unsigned char *s, int p,
         _mm_or_si128(_mm_subs_epu8(p0, q0), _mm_subs_epu8(q0, p0));
     __m128i abs_p1q1 =
         _mm_or_si128(_mm_subs_epu8(p1, q1), _mm_subs_epu8(q1, p1));
-#if !CONFIG_PARALLEL_DEBLOCKING
     __m128i work;
-#endif  // !CONFIG_PARALLEL_DEBLOCKING
     flat = _mm_max_epu8(abs_p1p0, abs_q1q0);
     hev = _mm_subs_epu8(flat, thresh);
     hev = _mm_xor_si128(_mm_cmpeq_epi8(hev, zero), ff);
@@ -1536,7 +1592,6 @@ void aom_lpf_horizontal_4_dual_sse2(unsigned char *s, int p,
     mask = _mm_xor_si128(_mm_cmpeq_epi8(mask, zero), ff);
     // mask |= (abs(p0 - q0) * 2 + abs(p1 - q1) / 2  > blimit) * -1;
     mask = _mm_max_epu8(flat, mask);
-#if !CONFIG_PARALLEL_DEBLOCKING
     // mask |= (abs(p1 - p0) > limit) * -1;
     // mask |= (abs(q1 - q0) > limit) * -1;
     work = _mm_max_epu8(
@@ -1547,7 +1602,6 @@ void aom_lpf_horizontal_4_dual_sse2(unsigned char *s, int p,
         _mm_or_si128(_mm_subs_epu8(q2, q1), _mm_subs_epu8(q1, q2)),
         _mm_or_si128(_mm_subs_epu8(q3, q2), _mm_subs_epu8(q2, q3)));
     mask = _mm_max_epu8(work, mask);
-#endif  // !CONFIG_PARALLEL_DEBLOCKING
     mask = _mm_subs_epu8(mask, limit);
     mask = _mm_cmpeq_epi8(mask, zero);
   }
@@ -1620,6 +1674,7 @@ void aom_lpf_horizontal_4_dual_sse2(unsigned char *s, int p,
     _mm_storeu_si128((__m128i *)(s + 1 * p), q1);
   }
 }
+#endif  // CONFIG_PARALLEL_DEBLOCKING
 
 static INLINE void transpose8x16(unsigned char *in0, unsigned char *in1,
                                  int in_p, unsigned char *out, int out_p) {
@@ -1691,50 +1746,6 @@ static INLINE void transpose8x16(unsigned char *in0, unsigned char *in1,
   _mm_storeu_si128((__m128i *)(out + 7 * out_p), _mm_unpackhi_epi64(x7, x15));
 }
 
-#if CONFIG_PARALLEL_DEBLOCKING
-#define movq(p) _mm_loadl_epi64((const __m128i *)(p))
-#define punpcklbw(r0, r1) _mm_unpacklo_epi8(r0, r1)
-#define punpcklwd(r0, r1) _mm_unpacklo_epi16(r0, r1)
-#define punpckhwd(r0, r1) _mm_unpackhi_epi16(r0, r1)
-#define pshufd(r, imm) _mm_shuffle_epi32(r, imm)
-enum { ROTATE_DWORD_RIGHT = 0x39 };
-static INLINE void transpose16x4(uint8_t *pDst, const ptrdiff_t dstStride,
-                                 const uint8_t *pSrc,
-                                 const ptrdiff_t srcStride) {
-  for (uint32_t idx = 0; idx < 2; idx += 1) {
-    __m128i r0, r1, r2, r3;
-    // load data
-    r0 = movq(pSrc);
-    r1 = movq(pSrc + srcStride);
-    r2 = movq(pSrc + srcStride * 2);
-    r3 = movq(pSrc + srcStride * 3);
-    // transpose
-    r0 = punpcklbw(r0, r1);
-    r2 = punpcklbw(r2, r3);
-    r1 = punpckhwd(r0, r2);
-    r0 = punpcklwd(r0, r2);
-    // store data
-    xx_storel_32(pDst, r0);
-    r0 = pshufd(r0, ROTATE_DWORD_RIGHT);
-    xx_storel_32(pDst + dstStride, r0);
-    r0 = pshufd(r0, ROTATE_DWORD_RIGHT);
-    xx_storel_32(pDst + dstStride * 2, r0);
-    r0 = pshufd(r0, ROTATE_DWORD_RIGHT);
-    xx_storel_32(pDst + dstStride * 3, r0);
-    xx_storel_32(pDst + dstStride * 4, r1);
-    r1 = pshufd(r1, ROTATE_DWORD_RIGHT);
-    xx_storel_32(pDst + dstStride * 5, r1);
-    r1 = pshufd(r1, ROTATE_DWORD_RIGHT);
-    xx_storel_32(pDst + dstStride * 6, r1);
-    r1 = pshufd(r1, ROTATE_DWORD_RIGHT);
-    xx_storel_32(pDst + dstStride * 7, r1);
-    // advance the pointers
-    pDst += dstStride * 8;
-    pSrc += 8;
-  }
-}
-
-#endif  // CONFIG_PARALLEL_DEBLOCKING
 static INLINE void transpose(unsigned char *src[], int in_p,
                              unsigned char *dst[], int out_p,
                              int num_8x8_to_transpose) {
@@ -1813,18 +1824,35 @@ void aom_lpf_vertical_4_dual_sse2(uint8_t *s, int p, const uint8_t *blimit0,
                                   const uint8_t *limit0, const uint8_t *thresh0,
                                   const uint8_t *blimit1, const uint8_t *limit1,
                                   const uint8_t *thresh1) {
+#if CONFIG_PARALLEL_DEBLOCKING
+  // The two 4 row segments form a single 8x8 block around the edge.
+  DECLARE_ALIGNED(16, unsigned char, t_dst[8 * 8]);
+  unsigned char *src[1];
+  unsigned char *dst[1];
+
+  // Transpose 8x8
+  src[0] = s - 4;
+  dst[0] = t_dst;
+  transpose(src, p, dst, 8, 1);
+
+  // Loop filtering
+  aom_lpf_horizontal_4_dual_sse2(t_dst + 4 * 8, 8, blimit0, limit0, thresh0,
+                                 blimit1, limit1, thresh1);
+
+  // Transpose back
+  src[0] = t_dst;
+  dst[0] = s - 4;
+  transpose(src, 8, dst, p, 1);
+#else
   DECLARE_ALIGNED(16, unsigned char, t_dst[16 * 8]);
-#if !CONFIG_PARALLEL_DEBLOCKING
   unsigned char *src[2];
   unsigned char *dst[2];
-#endif  // !CONFIG_PARALLEL_DEBLOCKING
   // Transpose 8x16
   transpose8x16(s - 4, s - 4 + p * 8, p, t_dst, 16);
 
   // Loop filtering
   aom_lpf_horizontal_4_dual_sse2(t_dst + 4 * 16, 16, blimit0, limit0, thresh0,
                                  blimit1, limit1, thresh1);
-#if !CONFIG_PARALLEL_DEBLOCKING
   src[0] = t_dst;
   src[1] = t_dst + 8;
   dst[0] = s - 4;
@@ -1832,9 +1860,7 @@ void aom_lpf_vertical_4_dual_sse2(uint8_t *s, int p, const uint8_t *blimit0,
 
   // Transpose back
   transpose(src, 16, dst, p, 2);
-#else  // CONFIG_PARALLEL_DEBLOCKING
-  transpose16x4(s - 2, p, t_dst + 16 * 2, 16);
-#endif  // !CONFIG_PARALLEL_DEBLOCKING
+#endif  // CONFIG_PARALLEL_DEBLOCKING
 }
 
 void aom_lpf_vertical_8_sse2(unsigned char *s, int p,
@@ -1865,6 +1891,26 @@ void aom_lpf_vertical_8_dual_sse2(uint8_t *s, int p, const uint8_t *blimit0,
                                   const uint8_t *limit0, const uint8_t *thresh0,
                                   const uint8_t *blimit1, const uint8_t *limit1,
                                   const uint8_t *thresh1) {
+#if CONFIG_PARALLEL_DEBLOCKING
+  // The two 4 row segments form a single 8x8 block around the edge.
+  DECLARE_ALIGNED(16, unsigned char, t_dst[8 * 8]);
+  unsigned char *src[1];
+  unsigned char *dst[1];
+
+  // Transpose 8x8
+  src[0] = s - 4;
+  dst[0] = t_dst;
+  transpose(src, p, dst, 8, 1);
+
+  // Loop filtering
+  aom_lpf_horizontal_8_dual_sse2(t_dst + 4 * 8, 8, blimit0, limit0, thresh0,
+                                 blimit1, limit1, thresh1);
+
+  // Transpose back
+  src[0] = t_dst;
+  dst[0] = s - 4;
+  transpose(src, 8, dst, p, 1);
+#else
   DECLARE_ALIGNED(16, unsigned char, t_dst[16 * 8]);
   unsigned char *src[2];
   unsigned char *dst[2];
@@ -1883,6 +1929,7 @@ void aom_lpf_vertical_8_dual_sse2(uint8_t *s, int p, const uint8_t *blimit0,
 
   // Transpose back
   transpose(src, 16, dst, p, 2);
+#endif  // CONFIG_PARALLEL_DEBLOCKING
 }
 
 void aom_lpf_vertical_16_sse2(unsigned char *s, int p,
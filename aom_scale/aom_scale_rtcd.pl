@@ -34,5 +34,7 @@ if (aom_config("CONFIG_AV1") eq "yes") {
   specialize qw/aom_extend_frame_inner_borders dspr2/;
 
   add_proto qw/void aom_extend_frame_borders_y/, "struct yv12_buffer_config *ybf";
+
+  add_proto qw/void aom_extend_frame_borders_rows/, "struct yv12_buffer_config *ybf, int row_start, int row_end";
 }
 1;
@@ -173,6 +173,50 @@ void aom_extend_frame_borders_c(YV12_BUFFER_CONFIG *ybf) {
   extend_frame(ybf, ybf->border);
 }
 
+// Extends the left and right borders of luma rows [row_start, row_end) and
+// of the chroma rows they cover. The top border is filled along with row 0 and
+// the bottom border along with the last row, so extending all rows of a frame
+// in order gives the same result as aom_extend_frame_borders().
+void aom_extend_frame_borders_rows_c(YV12_BUFFER_CONFIG *ybf, int row_start,
+                                     int row_end) {
+  const int ss_x = ybf->uv_width < ybf->y_width;
+  const int ss_y = ybf->uv_height < ybf->y_height;
+  const int ext_size = ybf->border;
+
+  if (row_end > ybf->y_crop_height) row_end = ybf->y_crop_height;
+  if (row_start >= row_end) return;
+
+  for (int plane = 0; plane < 3; ++plane) {
+    const int is_uv = plane > 0;
+    const int shift_y = is_uv ? ss_y : 0;
+    const int crop_height = ybf->crop_heights[is_uv];
+    const int start = row_start >> shift_y;
+    const int end =
+        row_end == ybf->y_crop_height ? crop_height : row_end >> shift_y;
+    const int border_top = ext_size >> shift_y;
+    const int top = start == 0 ? border_top : 0;
+    const int left = ext_size >> (is_uv ? ss_x : 0);
+    const int bottom =
+        end == crop_height
+            ? border_top + ybf->heights[is_uv] - ybf->crop_heights[is_uv]
+            : 0;
+    const int right = left + ybf->widths[is_uv] - ybf->crop_widths[is_uv];
+    uint8_t *const src =
+        ybf->buffers[plane] + (ptrdiff_t)start * ybf->strides[is_uv];
+
+    if (start >= end) continue;
+#if CONFIG_HIGHBITDEPTH
+    if (ybf->flags & YV12_FLAG_HIGHBITDEPTH) {
+      extend_plane_high(src, ybf->strides[is_uv], ybf->crop_widths[is_uv],
+                        end - start, top, left, bottom, right);
+      continue;
+    }
+#endif
+    extend_plane(src, ybf->strides[is_uv], ybf->crop_widths[is_uv],
+                 end - start, top, left, bottom, right);
+  }
+}
+
 void aom_extend_frame_inner_borders_c(YV12_BUFFER_CONFIG *ybf) {
   const int inner_bw = (ybf->border > AOMINNERBORDERINPIXELS)
                            ? AOMINNERBORDERINPIXELS
@@ -1504,7 +1504,9 @@ static void initialize_encoder(struct stream_state *stream,
   if (global->test_decode != TEST_DECODE_OFF) {
     const AvxInterface *decoder = get_aom_decoder_by_name(global->codec->name);
     aom_codec_dec_cfg_t cfg = { 0, 0, 0, CONFIG_LOWBITDEPTH, 0 };
-    aom_codec_dec_init(&stream->decoder, decoder->codec_interface(), &cfg, 0);
+    // Decode each tile group as it comes out of the encoder.
+    aom_codec_dec_init(&stream->decoder, decoder->codec_interface(), &cfg,
+                       global->out_part ? AOM_CODEC_USE_INPUT_FRAGMENTS : 0);
 
 #if CONFIG_EXT_TILE
     if (strcmp(global->codec->name, "av1") == 0) {
@@ -1676,6 +1678,10 @@ static void get_cx_data(struct stream_state *stream,
         if (global->test_decode != TEST_DECODE_OFF && !stream->mismatch_seen) {
           aom_codec_decode(&stream->decoder, pkt->data.frame.buf,
                            (unsigned int)pkt->data.frame.sz, NULL, 0);
+          // The frame is complete after its last partition.
+          if (global->out_part && !stream->decoder.err &&
+              !(pkt->data.frame.flags & AOM_FRAME_IS_FRAGMENT))
+            aom_codec_decode(&stream->decoder, NULL, 0, NULL, 0);
           if (stream->decoder.err) {
             warn_or_exit_on_error(&stream->decoder,
                                   global->test_decode == TEST_DECODE_FATAL,
@@ -141,8 +141,13 @@ set(AOM_AV1_ENCODER_SOURCES
     "${AOM_ROOT}/av1/encoder/mbgraph.h"
     "${AOM_ROOT}/av1/encoder/mcomp.c"
     "${AOM_ROOT}/av1/encoder/mcomp.h"
+    "${AOM_ROOT}/av1/encoder/ml.c"
+    "${AOM_ROOT}/av1/encoder/ml.h"
     "${AOM_ROOT}/av1/encoder/palette.c"
     "${AOM_ROOT}/av1/encoder/palette.h"
+    "${AOM_ROOT}/av1/encoder/partition_model_weights.h"
+    "${AOM_ROOT}/av1/encoder/partition_strategy.c"
+    "${AOM_ROOT}/av1/encoder/partition_strategy.h"
     "${AOM_ROOT}/av1/encoder/picklpf.c"
     "${AOM_ROOT}/av1/encoder/picklpf.h"
     "${AOM_ROOT}/av1/encoder/ratectrl.c"
@@ -205,7 +210,8 @@ set(AOM_AV1_ENCODER_ASM_SSE2
 set(AOM_AV1_ENCODER_INTRIN_SSE2
     "${AOM_ROOT}/av1/encoder/x86/dct_intrin_sse2.c"
     "${AOM_ROOT}/av1/encoder/x86/highbd_block_error_intrin_sse2.c"
-    "${AOM_ROOT}/av1/encoder/x86/av1_quantize_sse2.c")
+    "${AOM_ROOT}/av1/encoder/x86/av1_quantize_sse2.c"
+    "${AOM_ROOT}/av1/encoder/x86/ml_sse2.c")
 
 set(AOM_AV1_ENCODER_ASM_SSSE3_X86_64
     "${AOM_ROOT}/av1/encoder/x86/av1_quantize_ssse3_x86_64.asm")
@@ -219,7 +225,8 @@ set(AOM_AV1_ENCODER_INTRIN_AVX2
     "${AOM_ROOT}/av1/encoder/x86/av1_quantize_avx2.c"
     "${AOM_ROOT}/av1/encoder/x86/av1_highbd_quantize_avx2.c"
     "${AOM_ROOT}/av1/encoder/x86/error_intrin_avx2.c"
-    "${AOM_ROOT}/av1/encoder/x86/hybrid_fwd_txfm_avx2.c")
+    "${AOM_ROOT}/av1/encoder/x86/hybrid_fwd_txfm_avx2.c"
+    "${AOM_ROOT}/av1/encoder/x86/ml_avx2.c")
 
 set(AOM_AV1_ENCODER_INTRIN_NEON
     "${AOM_ROOT}/av1/encoder/arm/neon/quantize_neon.c")
@@ -430,6 +437,10 @@ if (CONFIG_LOOP_RESTORATION)
       ${AOM_AV1_COMMON_INTRIN_SSE4_1}
       "${AOM_ROOT}/av1/common/x86/selfguided_sse4.c")
 
+  set(AOM_AV1_COMMON_INTRIN_AVX2
+      ${AOM_AV1_COMMON_INTRIN_AVX2}
+      "${AOM_ROOT}/av1/common/x86/selfguided_avx2.c")
+
   set(AOM_AV1_ENCODER_SOURCES
       ${AOM_AV1_ENCODER_SOURCES}
       "${AOM_ROOT}/av1/encoder/pickrst.c"
@@ -75,10 +75,14 @@ AV1_CX_SRCS-yes += encoder/rdopt.h
 AV1_CX_SRCS-yes += encoder/tokenize.h
 AV1_CX_SRCS-yes += encoder/treewriter.h
 AV1_CX_SRCS-yes += encoder/mcomp.c
+AV1_CX_SRCS-yes += encoder/ml.c
+AV1_CX_SRCS-yes += encoder/ml.h
 AV1_CX_SRCS-yes += encoder/encoder.c
 AV1_CX_SRCS-yes += encoder/k_means_template.h
 AV1_CX_SRCS-yes += encoder/palette.h
 AV1_CX_SRCS-yes += encoder/palette.c
+AV1_CX_SRCS-yes += encoder/partition_strategy.c
+AV1_CX_SRCS-yes += encoder/partition_strategy.h
 AV1_CX_SRCS-yes += encoder/picklpf.c
 AV1_CX_SRCS-yes += encoder/picklpf.h
 AV1_CX_SRCS-$(CONFIG_LOOP_RESTORATION) += encoder/pickrst.c
@@ -145,6 +149,8 @@ AV1_CX_SRCS-yes += encoder/wedge_utils.c
 AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/wedge_utils_sse2.c
 
 AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/error_intrin_avx2.c
+AV1_CX_SRCS-$(HAVE_SSE2) += encoder/x86/ml_sse2.c
+AV1_CX_SRCS-$(HAVE_AVX2) += encoder/x86/ml_avx2.c
 
 ifneq ($(CONFIG_HIGHBITDEPTH),yes)
 AV1_CX_SRCS-$(HAVE_NEON) += encoder/arm/neon/error_neon.c
@@ -160,6 +166,7 @@ AV1_CX_SRCS-$(HAVE_MSA) += encoder/mips/msa/temporal_filter_msa.c
 
 AV1_CX_SRCS-$(HAVE_SSE4_1) += encoder/x86/corner_match_sse4.c
 
+AV1_CX_SRCS-yes += encoder/partition_model_weights.h
 AV1_CX_SRCS-yes += encoder/tx_prune_model_weights.h
 
 AV1_CX_SRCS-yes := $(filter-out $(AV1_CX_SRCS_REMOVE-yes),$(AV1_CX_SRCS-yes))
@@ -724,6 +724,14 @@ static aom_codec_err_t ctrl_get_quantizer64(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_get_frame_stats(aom_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  aom_frame_stats_t *const arg = va_arg(args, aom_frame_stats_t *);
+  if (arg == NULL) return AOM_CODEC_INVALID_PARAM;
+  *arg = ctx->cpi->frame_stats;
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t update_extra_cfg(aom_codec_alg_priv_t *ctx,
                                         const struct av1_extracfg *extra_cfg) {
   const aom_codec_err_t res = validate_config(ctx, &ctx->cfg, extra_cfg);
@@ -1170,6 +1178,37 @@ static aom_codec_frame_flags_t get_frame_pkt_flags(const AV1_COMP *cpi,
 static uint32_t write_temporal_delimiter_obu() { return 0; }
 #endif
 
+// Returns a frame packet as one packet per tile group of its last frame, so
+// that each tile group can be sent as soon as it is available. The first
+// packet also holds the frame headers, and any superframe index and invisible
+// frames packed ahead of the last frame.
+static void add_tile_group_pkts(aom_codec_alg_priv_t *ctx,
+                                const aom_codec_cx_pkt_t *frame_pkt,
+                                size_t last_frame_offset) {
+  const AV1_COMP *const cpi = ctx->cpi;
+  struct aom_codec_pkt_list *const list = &ctx->pkt_list.head;
+  // Merge the trailing tile groups if the packet list cannot hold them all.
+  const int num_pkts =
+      AOMMIN(cpi->num_packed_tg, (int)(list->max - list->cnt));
+  uint8_t *const buf = (uint8_t *)frame_pkt->data.frame.buf;
+  size_t start = 0;
+
+  for (int i = 0; i < num_pkts; ++i) {
+    const int is_last = i == num_pkts - 1;
+    const size_t end = is_last
+                           ? frame_pkt->data.frame.sz
+                           : last_frame_offset + cpi->packed_tg_offset[i + 1];
+    aom_codec_cx_pkt_t pkt = *frame_pkt;
+
+    pkt.data.frame.buf = buf + start;
+    pkt.data.frame.sz = end - start;
+    pkt.data.frame.partition_id = i;
+    if (!is_last) pkt.data.frame.flags |= AOM_FRAME_IS_FRAGMENT;
+    aom_codec_pkt_list_add(list, &pkt);
+    start = end;
+  }
+}
+
 static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
                                       const aom_image_t *img,
                                       aom_codec_pts_t pts,
@@ -1271,9 +1310,11 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
     }
 
     size_t frame_size = 0;
+    size_t last_frame_offset = 0;
     unsigned int lib_flags = 0;
     int is_frame_visible = 0;
     int index_size = 0;
+    av1_zero(cpi->frame_stats);
     // invisible frames get packed with the next visible frame
     while (cx_data_sz - index_size >= ctx->cx_data_sz / 2 &&
            !is_frame_visible &&
@@ -1291,6 +1332,7 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
       if (frame_size) {
         if (ctx->pending_cx_data == 0) ctx->pending_cx_data = cx_data;
 
+        last_frame_offset = ctx->pending_cx_data_sz;
         ctx->pending_frame_sizes[ctx->pending_frame_count++] = frame_size;
         ctx->pending_cx_data_sz += frame_size;
 
@@ -1306,11 +1348,10 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
 #if !CONFIG_OBU
       // insert superframe index if needed
       if (ctx->pending_frame_count > 1) {
-#if CONFIG_DEBUG
-        assert(index_size >= write_superframe_index(ctx));
-#else
-        write_superframe_index(ctx);
-#endif
+        // The index goes in front of the frames.
+        const int index_sz = write_superframe_index(ctx);
+        assert(index_size >= index_sz);
+        last_frame_offset += index_sz;
       }
 #endif
       // Add the frame packet to the list of returned packets.
@@ -1336,6 +1377,7 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
       mem_put_le32(ctx->pending_cx_data, obu_size);
 #endif
       pkt.data.frame.sz += (obu_size + PRE_OBU_SIZE_BYTES);
+      last_frame_offset += obu_size + PRE_OBU_SIZE_BYTES;
 #endif
 
       pkt.data.frame.pts = ticks_to_timebase_units(timebase, dst_time_stamp);
@@ -1343,7 +1385,10 @@ static aom_codec_err_t encoder_encode(aom_codec_alg_priv_t *ctx,
       pkt.data.frame.duration = (uint32_t)ticks_to_timebase_units(
           timebase, dst_end_time_stamp - dst_time_stamp);
 
-      aom_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
+      if (ctx->base.init_flags & AOM_CODEC_USE_OUTPUT_PARTITION)
+        add_tile_group_pkts(ctx, &pkt, last_frame_offset);
+      else
+        aom_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
 
       ctx->pending_cx_data = NULL;
       ctx->pending_cx_data_sz = 0;
@@ -1639,6 +1684,7 @@ static aom_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { AV1_GET_REFERENCE, ctrl_get_reference },
   { AV1E_GET_ACTIVEMAP, ctrl_get_active_map },
   { AV1_GET_NEW_FRAME_IMAGE, ctrl_get_new_frame_image },
+  { AV1E_GET_FRAME_STATS, ctrl_get_frame_stats },
 
   { -1, NULL },
 };
@@ -1714,10 +1760,11 @@ CODEC_INTERFACE(aom_codec_av1_cx) = {
 #if CONFIG_HIGHBITDEPTH
   AOM_CODEC_CAP_HIGHBITDEPTH |
 #endif
-      AOM_CODEC_CAP_ENCODER | AOM_CODEC_CAP_PSNR,  // aom_codec_caps_t
-  encoder_init,                                    // aom_codec_init_fn_t
-  encoder_destroy,                                 // aom_codec_destroy_fn_t
-  encoder_ctrl_maps,                               // aom_codec_ctrl_fn_map_t
+      AOM_CODEC_CAP_ENCODER | AOM_CODEC_CAP_PSNR |
+      AOM_CODEC_CAP_OUTPUT_PARTITION,  // aom_codec_caps_t
+  encoder_init,                        // aom_codec_init_fn_t
+  encoder_destroy,                     // aom_codec_destroy_fn_t
+  encoder_ctrl_maps,                   // aom_codec_ctrl_fn_map_t
   {
       // NOLINT
       NULL,  // aom_codec_peek_si_fn_t
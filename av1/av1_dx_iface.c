@@ -9,6 +9,7 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -57,6 +58,7 @@ struct aom_codec_alg_priv {
   int skip_loop_filter;
   int decode_tile_row;
   int decode_tile_col;
+  aom_region_t decode_region;
 
   // Frame parallel related.
   int frame_parallel_decode;  // frame-based threading.
@@ -83,6 +85,9 @@ struct aom_codec_alg_priv {
   aom_inspect_cb inspect_cb;
   void *inspect_ctx;
 #endif
+#if CONFIG_ACCOUNTING
+  int accounting_mode;
+#endif
 };
 
 static aom_codec_err_t decoder_init(aom_codec_ctx_t *ctx,
@@ -100,6 +105,9 @@ static aom_codec_err_t decoder_init(aom_codec_ctx_t *ctx,
     ctx->priv = (aom_codec_priv_t *)priv;
     ctx->priv->init_flags = ctx->init_flags;
     priv->flushed = 0;
+#if CONFIG_ACCOUNTING
+    priv->accounting_mode = AOM_ACCOUNTING_MODE_SYMBOLS;
+#endif
     // Only do frame parallel decode when threads > 1.
     priv->frame_parallel_decode =
         (ctx->config.dec && (ctx->config.dec->threads > 1) &&
@@ -429,6 +437,8 @@ static int frame_worker_hook(void *arg1, void *arg2) {
       // Signal all the other threads that are waiting for this frame.
       av1_frameworker_lock_stats(worker);
       frame_worker_data->frame_context_ready = 1;
+      frame_worker_data->next_video_frame =
+          frame_worker_data->pbi->common.current_video_frame;
       lock_buffer_pool(pool);
       frame_worker_data->pbi->cur_buf->buf.corrupted = 1;
       unlock_buffer_pool(pool);
@@ -551,6 +561,37 @@ static INLINE void check_resync(aom_codec_alg_priv_t *const ctx,
     ctx->need_resync = 0;
 }
 
+// Passes the settings of the decoder instance on to the decoder used in serial
+// mode.
+static void setup_serial_decoder(aom_codec_alg_priv_t *ctx, AV1Decoder *pbi) {
+  // Set these even if already initialized.  The caller may have changed the
+  // decrypt config between frames.
+  pbi->decrypt_cb = ctx->decrypt_cb;
+  pbi->decrypt_state = ctx->decrypt_state;
+#if CONFIG_INSPECTION
+  pbi->inspect_cb = ctx->inspect_cb;
+  pbi->inspect_ctx = ctx->inspect_ctx;
+#endif
+#if CONFIG_ACCOUNTING
+  pbi->acct_enabled = ctx->accounting_mode != AOM_ACCOUNTING_MODE_OFF;
+  aom_accounting_set_mode(&pbi->accounting,
+                          ctx->accounting_mode == AOM_ACCOUNTING_MODE_SYMBOLS
+                              ? AOM_ACCOUNTING_SYMBOLS
+                              : AOM_ACCOUNTING_HISTOGRAM);
+#endif
+
+#if CONFIG_EXT_TILE
+  pbi->dec_tile_row = ctx->decode_tile_row;
+  pbi->dec_tile_col = ctx->decode_tile_col;
+#endif  // CONFIG_EXT_TILE
+  pbi->decode_region =
+      ctx->decode_region.width > 0 && ctx->decode_region.height > 0;
+  pbi->region.left = ctx->decode_region.x;
+  pbi->region.top = ctx->decode_region.y;
+  pbi->region.right = ctx->decode_region.x + ctx->decode_region.width;
+  pbi->region.bottom = ctx->decode_region.y + ctx->decode_region.height;
+}
+
 static aom_codec_err_t decode_one(aom_codec_alg_priv_t *ctx,
                                   const uint8_t **data, unsigned int data_sz,
                                   void *user_priv, int64_t deadline) {
@@ -577,20 +618,7 @@ static aom_codec_err_t decode_one(aom_codec_alg_priv_t *ctx,
     frame_worker_data->data_size = data_sz;
     frame_worker_data->user_priv = user_priv;
     frame_worker_data->received_frame = 1;
-
-    // Set these even if already initialized.  The caller may have changed the
-    // decrypt config between frames.
-    frame_worker_data->pbi->decrypt_cb = ctx->decrypt_cb;
-    frame_worker_data->pbi->decrypt_state = ctx->decrypt_state;
-#if CONFIG_INSPECTION
-    frame_worker_data->pbi->inspect_cb = ctx->inspect_cb;
-    frame_worker_data->pbi->inspect_ctx = ctx->inspect_ctx;
-#endif
-
-#if CONFIG_EXT_TILE
-    frame_worker_data->pbi->dec_tile_row = ctx->decode_tile_row;
-    frame_worker_data->pbi->dec_tile_col = ctx->decode_tile_col;
-#endif  // CONFIG_EXT_TILE
+    setup_serial_decoder(ctx, frame_worker_data->pbi);
 
     worker->had_error = 0;
     winterface->execute(worker);
@@ -675,6 +703,108 @@ static void wait_worker_and_cache_frame(aom_codec_alg_priv_t *ctx) {
   }
 }
 
+// Decodes the tile groups of the frame in data, which may hold only some of
+// them. With a superframe, the frames ahead of the last one are complete.
+static aom_codec_err_t decode_tile_groups(aom_codec_alg_priv_t *ctx,
+                                          const uint8_t **data,
+                                          unsigned int data_sz,
+                                          int *frame_done) {
+  FrameWorkerData *const frame_worker_data =
+      (FrameWorkerData *)ctx->frame_workers[0].data1;
+  AV1Decoder *const pbi = frame_worker_data->pbi;
+
+  // Determine the stream parameters from the first frame.
+  if (!ctx->si.h && !pbi->partial_frame) {
+    int is_intra_only = 0;
+    const aom_codec_err_t res =
+        decoder_peek_si_internal(*data, data_sz, &ctx->si, &is_intra_only,
+                                 ctx->decrypt_cb, ctx->decrypt_state);
+    if (res != AOM_CODEC_OK) return res;
+
+    if (!ctx->si.is_kf && !is_intra_only) return AOM_CODEC_ERROR;
+  }
+
+  if (av1_receive_partial_data(pbi, data_sz, data, frame_done)) {
+    pbi->cur_buf->buf.corrupted = 1;
+    pbi->need_resync = 1;
+    return update_error_state(ctx, &pbi->common.error);
+  }
+  if (*frame_done) check_resync(ctx, pbi);
+  return AOM_CODEC_OK;
+}
+
+// Decodes a fragment of the input, see AOM_CODEC_USE_INPUT_FRAGMENTS. Each
+// fragment holds whole tile groups, whose tiles are decoded right away; the
+// frame is output once its last tile group is decoded.
+static aom_codec_err_t decode_fragment(aom_codec_alg_priv_t *ctx,
+                                       const uint8_t *data,
+                                       unsigned int data_sz, void *user_priv) {
+  FrameWorkerData *const frame_worker_data =
+      (FrameWorkerData *)ctx->frame_workers[0].data1;
+  AV1Decoder *const pbi = frame_worker_data->pbi;
+  const uint8_t *data_start = data;
+  const uint8_t *const data_end = data + data_sz;
+  aom_codec_err_t res;
+  int frame_done = 0;
+
+  frame_worker_data->user_priv = user_priv;
+  frame_worker_data->received_frame = 1;
+  setup_serial_decoder(ctx, pbi);
+
+#if !CONFIG_OBU
+  // Only the first fragment of a frame can start with a superframe index, and
+  // then all but the last of its frames are within the fragment.
+  if (!pbi->partial_frame) {
+    uint32_t frame_sizes[8];
+    int frame_count = 0;
+    int index_size = 0;
+    res = av1_parse_superframe_index(data, data_sz, frame_sizes, &frame_count,
+                                     &index_size, ctx->decrypt_cb,
+                                     ctx->decrypt_state);
+    if (res != AOM_CODEC_OK) return res;
+
+    data_start += index_size;
+    for (int i = 0; i < frame_count - 1; ++i) {
+      const uint8_t *data_start_copy = data_start;
+      const uint32_t frame_size = frame_sizes[i];
+      if (frame_size > (uint32_t)(data_end - data_start)) {
+        set_error_detail(ctx, "Invalid frame size in index");
+        return AOM_CODEC_CORRUPT_FRAME;
+      }
+
+      frame_done = 0;
+      while (!frame_done && data_start_copy < data_start + frame_size) {
+        const unsigned int size =
+            (unsigned int)(data_start + frame_size - data_start_copy);
+        res = decode_tile_groups(ctx, &data_start_copy, size, &frame_done);
+        if (res != AOM_CODEC_OK) return res;
+      }
+      if (!frame_done) {
+        set_error_detail(ctx, "Frame ahead of the last one is incomplete");
+        return AOM_CODEC_CORRUPT_FRAME;
+      }
+      data_start += frame_size;
+    }
+  }
+#endif
+
+  while (data_start < data_end) {
+    const unsigned int size = (unsigned int)(data_end - data_start);
+    res = decode_tile_groups(ctx, &data_start, size, &frame_done);
+    if (res != AOM_CODEC_OK) return res;
+    if (!frame_done) continue;
+
+    // Account for suboptimal termination by the encoder.
+    while (data_start < data_end) {
+      const uint8_t marker =
+          read_marker(ctx->decrypt_cb, ctx->decrypt_state, data_start);
+      if (marker) break;
+      ++data_start;
+    }
+  }
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t decoder_decode(aom_codec_alg_priv_t *ctx,
                                       const uint8_t *data, unsigned int data_sz,
                                       void *user_priv, long deadline) {
@@ -686,6 +816,18 @@ static aom_codec_err_t decoder_decode(aom_codec_alg_priv_t *ctx,
 
   if (data == NULL && data_sz == 0) {
     ctx->flushed = 1;
+    // Every tile group of a frame passed in fragments must have arrived by
+    // the time the decoder is flushed.
+    if (ctx->frame_workers != NULL && !ctx->frame_parallel_decode) {
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)ctx->frame_workers[0].data1;
+      if (frame_worker_data->pbi->partial_frame) {
+        av1_drop_partial_frame(frame_worker_data->pbi);
+        ctx->need_resync = 1;
+        set_error_detail(ctx, "Frame is missing tile groups");
+        return AOM_CODEC_CORRUPT_FRAME;
+      }
+    }
     return AOM_CODEC_OK;
   }
 
@@ -697,6 +839,22 @@ static aom_codec_err_t decoder_decode(aom_codec_alg_priv_t *ctx,
     res = init_decoder(ctx);
     if (res != AOM_CODEC_OK) return res;
   }
+
+  if (!ctx->frame_parallel_decode) {
+    FrameWorkerData *const frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[0].data1;
+    // The timing of a frame passed in fragments covers all its fragments.
+    if (!frame_worker_data->pbi->partial_frame)
+      av1_reset_frame_timing(frame_worker_data->pbi);
+  }
+
+  if (ctx->base.init_flags & AOM_CODEC_USE_INPUT_FRAGMENTS) {
+    if (ctx->frame_parallel_decode) {
+      set_error_detail(ctx, "Not supported in frame parallel decode");
+      return AOM_CODEC_INCAPABLE;
+    }
+    return decode_fragment(ctx, data, data_sz, user_priv);
+  }
 #if !CONFIG_OBU
   int index_size = 0;
   res = av1_parse_superframe_index(data, data_sz, frame_sizes, &frame_count,
@@ -1004,7 +1162,11 @@ static aom_codec_err_t ctrl_get_new_frame_image(aom_codec_alg_priv_t *ctx,
     AVxWorker *const worker = ctx->frame_workers;
     FrameWorkerData *const frame_worker_data = (FrameWorkerData *)worker->data1;
 
-    if (av1_get_frame_to_show(frame_worker_data->pbi, &new_frame) == 0) {
+    // A frame passed in fragments can be read while it is decoded.
+    if (frame_worker_data->pbi->partial_frame) {
+      yuvconfig2image(new_img, &frame_worker_data->pbi->cur_buf->buf, NULL);
+      return AOM_CODEC_OK;
+    } else if (av1_get_frame_to_show(frame_worker_data->pbi, &new_frame) == 0) {
       yuvconfig2image(new_img, &new_frame, NULL);
       return AOM_CODEC_OK;
     } else {
@@ -1228,6 +1390,95 @@ static aom_codec_err_t ctrl_get_accounting(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_ERROR;
 #endif
 }
+
+static aom_codec_err_t ctrl_set_accounting_mode(aom_codec_alg_priv_t *ctx,
+                                                va_list args) {
+#if !CONFIG_ACCOUNTING
+  (void)ctx;
+  (void)args;
+  return AOM_CODEC_INCAPABLE;
+#else
+  const int mode = va_arg(args, int);
+  if (mode < AOM_ACCOUNTING_MODE_OFF || mode > AOM_ACCOUNTING_MODE_HISTOGRAM)
+    return AOM_CODEC_INVALID_PARAM;
+  ctx->accounting_mode = mode;
+  return AOM_CODEC_OK;
+#endif
+}
+
+static aom_codec_err_t ctrl_get_frame_timing(aom_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  aom_frame_timing_t *const timing = va_arg(args, aom_frame_timing_t *);
+
+  if (timing == NULL) return AOM_CODEC_INVALID_PARAM;
+  if (ctx->frame_parallel_decode) return AOM_CODEC_INCAPABLE;
+  if (ctx->frame_workers) {
+    FrameWorkerData *const frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[0].data1;
+    const AV1Decoder *const pbi = frame_worker_data->pbi;
+    *timing = pbi->frame_timing;
+    timing->tile_rows = pbi->tile_decode_us ? pbi->common.tile_rows : 0;
+    timing->tile_cols = pbi->tile_decode_us ? pbi->common.tile_cols : 0;
+    timing->tile_us = pbi->tile_decode_us;
+    return AOM_CODEC_OK;
+  }
+  return AOM_CODEC_ERROR;
+}
+
+static aom_codec_err_t ctrl_get_decoded_rows(aom_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  int *const rows = va_arg(args, int *);
+
+  if (rows == NULL) return AOM_CODEC_INVALID_PARAM;
+  if (ctx->frame_parallel_decode) return AOM_CODEC_INCAPABLE;
+  if (ctx->frame_workers) {
+    FrameWorkerData *const frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[0].data1;
+    *rows = frame_worker_data->pbi->decoded_rows;
+    return AOM_CODEC_OK;
+  }
+  return AOM_CODEC_ERROR;
+}
+
+static aom_codec_err_t ctrl_get_row_publishes(aom_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  int *const publishes = va_arg(args, int *);
+
+  if (publishes == NULL) return AOM_CODEC_INVALID_PARAM;
+  if (ctx->frame_workers) {
+    *publishes = 0;
+    for (int i = 0; i < ctx->num_frame_workers; ++i) {
+      FrameWorkerData *const frame_worker_data =
+          (FrameWorkerData *)ctx->frame_workers[i].data1;
+      *publishes += frame_worker_data->pbi->row_publishes;
+    }
+    return AOM_CODEC_OK;
+  }
+  return AOM_CODEC_ERROR;
+}
+
+static aom_codec_err_t ctrl_get_valid_region(aom_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  aom_region_t *const region = va_arg(args, aom_region_t *);
+
+  if (region == NULL) return AOM_CODEC_INVALID_PARAM;
+  if (ctx->frame_parallel_decode) return AOM_CODEC_INCAPABLE;
+  if (ctx->frame_workers) {
+    FrameWorkerData *const frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[0].data1;
+    const AV1_COMMON *const cm = &frame_worker_data->pbi->common;
+    if (cm->new_fb_idx < 0) return AOM_CODEC_ERROR;
+    const AV1PixelRect *const rect =
+        &cm->buffer_pool->frame_bufs[cm->new_fb_idx].valid_rect;
+    region->x = rect->left;
+    region->y = rect->top;
+    region->width = rect->right - rect->left;
+    region->height = rect->bottom - rect->top;
+    return AOM_CODEC_OK;
+  }
+  return AOM_CODEC_ERROR;
+}
+
 static aom_codec_err_t ctrl_set_decode_tile_row(aom_codec_alg_priv_t *ctx,
                                                 va_list args) {
   ctx->decode_tile_row = va_arg(args, int);
@@ -1240,6 +1491,48 @@ static aom_codec_err_t ctrl_set_decode_tile_col(aom_codec_alg_priv_t *ctx,
   return AOM_CODEC_OK;
 }
 
+static aom_codec_err_t ctrl_set_decode_region(aom_codec_alg_priv_t *ctx,
+                                              va_list args) {
+  const aom_region_t *const region = va_arg(args, aom_region_t *);
+
+  // Only support this function in serial decode.
+  if (ctx->frame_parallel_decode) {
+    set_error_detail(ctx, "Not supported in frame parallel decode");
+    return AOM_CODEC_INCAPABLE;
+  }
+
+  if (region == NULL) {
+    memset(&ctx->decode_region, 0, sizeof(ctx->decode_region));
+    return AOM_CODEC_OK;
+  }
+  if (region->x < 0 || region->y < 0 || region->width < 0 ||
+      region->height < 0 || region->width > INT_MAX - region->x ||
+      region->height > INT_MAX - region->y) {
+    set_error_detail(ctx, "Invalid decode region");
+    return AOM_CODEC_INVALID_PARAM;
+  }
+  // Check the region against the last frame decoded, if any.
+  if (ctx->frame_workers != NULL) {
+    FrameWorkerData *const frame_worker_data =
+        (FrameWorkerData *)ctx->frame_workers[0].data1;
+    const AV1_COMMON *const cm = &frame_worker_data->pbi->common;
+#if CONFIG_FRAME_SUPERRES
+    const int width = cm->superres_upscaled_width;
+    const int height = cm->superres_upscaled_height;
+#else
+    const int width = cm->width;
+    const int height = cm->height;
+#endif  // CONFIG_FRAME_SUPERRES
+    if (width > 0 && height > 0 && (region->x + region->width > width ||
+                                    region->y + region->height > height)) {
+      set_error_detail(ctx, "Decode region is out of the frame");
+      return AOM_CODEC_INVALID_PARAM;
+    }
+  }
+  ctx->decode_region = *region;
+  return AOM_CODEC_OK;
+}
+
 static aom_codec_err_t ctrl_set_inspection_callback(aom_codec_alg_priv_t *ctx,
                                                     va_list args) {
 #if !CONFIG_INSPECTION
@@ -1270,6 +1563,7 @@ static aom_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { AV1_SET_SKIP_LOOP_FILTER, ctrl_set_skip_loop_filter },
   { AV1_SET_DECODE_TILE_ROW, ctrl_set_decode_tile_row },
   { AV1_SET_DECODE_TILE_COL, ctrl_set_decode_tile_col },
+  { AV1D_SET_DECODE_REGION, ctrl_set_decode_region },
   { AV1_SET_INSPECTION_CALLBACK, ctrl_set_inspection_callback },
 
   // Getters
@@ -1280,6 +1574,11 @@ static aom_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { AV1D_GET_DISPLAY_SIZE, ctrl_get_render_size },
   { AV1D_GET_FRAME_SIZE, ctrl_get_frame_size },
   { AV1_GET_ACCOUNTING, ctrl_get_accounting },
+  { AV1D_SET_ACCOUNTING_MODE, ctrl_set_accounting_mode },
+  { AV1D_GET_FRAME_TIMING, ctrl_get_frame_timing },
+  { AV1D_GET_DECODED_ROWS, ctrl_get_decoded_rows },
+  { AV1D_GET_VALID_REGION, ctrl_get_valid_region },
+  { AV1D_GET_ROW_PUBLISHES, ctrl_get_row_publishes },
   { AV1_GET_NEW_FRAME_IMAGE, ctrl_get_new_frame_image },
   { AV1_GET_REFERENCE, ctrl_get_reference },
 
@@ -1292,8 +1591,9 @@ static aom_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
 CODEC_INTERFACE(aom_codec_av1_dx) = {
   "AOMedia Project AV1 Decoder" VERSION_STRING,
   AOM_CODEC_INTERNAL_ABI_VERSION,
-  AOM_CODEC_CAP_DECODER |
-      AOM_CODEC_CAP_EXTERNAL_FRAME_BUFFER,  // aom_codec_caps_t
+  AOM_CODEC_CAP_DECODER | AOM_CODEC_CAP_FRAME_THREADING |
+      AOM_CODEC_CAP_EXTERNAL_FRAME_BUFFER |
+      AOM_CODEC_CAP_INPUT_FRAGMENTS,        // aom_codec_caps_t
   decoder_init,                             // aom_codec_init_fn_t
   decoder_destroy,                          // aom_codec_destroy_fn_t
   decoder_ctrl_maps,                        // aom_codec_ctrl_fn_map_t
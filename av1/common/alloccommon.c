@@ -285,8 +285,30 @@ void av1_remove_common(AV1_COMMON *cm) {
 
   aom_free(cm->fc);
   cm->fc = NULL;
-  aom_free(cm->frame_contexts);
-  cm->frame_contexts = NULL;
+  av1_free_frame_contexts(cm);
+}
+
+int av1_alloc_frame_contexts(AV1_COMMON *cm) {
+  int i;
+  // All slots start out sharing a single zeroed buffer.
+  av1_free_frame_contexts(cm);
+  cm->fc_pool[0] = (FRAME_CONTEXT *)aom_memalign(32, sizeof(*cm->fc_pool[0]));
+  if (!cm->fc_pool[0]) return 1;
+  memset(cm->fc_pool[0], 0, sizeof(*cm->fc_pool[0]));
+  for (i = 0; i < FRAME_CONTEXTS; ++i) cm->frame_context_buf[i] = 0;
+  cm->fc_pool_refs[0] = FRAME_CONTEXTS;
+  cm->pre_fc = NULL;
+  cm->pre_fc_slot = -1;
+  return 0;
+}
+
+void av1_free_frame_contexts(AV1_COMMON *cm) {
+  int i;
+  for (i = 0; i < FRAME_CONTEXTS; ++i) {
+    aom_free(cm->fc_pool[i]);
+    cm->fc_pool[i] = NULL;
+    cm->fc_pool_refs[i] = 0;
+  }
 }
 
 void av1_init_context_buffers(AV1_COMMON *cm) {
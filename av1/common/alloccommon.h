@@ -27,6 +27,9 @@ int av1_alloc_context_buffers(struct AV1Common *cm, int width, int height);
 void av1_init_context_buffers(struct AV1Common *cm);
 void av1_free_context_buffers(struct AV1Common *cm);
 
+int av1_alloc_frame_contexts(struct AV1Common *cm);
+void av1_free_frame_contexts(struct AV1Common *cm);
+
 void av1_free_ref_frame_buffers(struct BufferPool *pool);
 #if CONFIG_LOOP_RESTORATION
 void av1_alloc_restoration_buffers(struct AV1Common *cm);
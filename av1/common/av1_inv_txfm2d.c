@@ -140,10 +140,12 @@ void av1_gen_inv_stage_range(int8_t *stage_range_col, int8_t *stage_range_row,
   }
 }
 
+// Only the first nz_rows rows of input may hold nonzero coefficients; the
+// row transforms of the others are known to be zero.
 static INLINE void inv_txfm2d_add_c(const int32_t *input, uint16_t *output,
                                     int stride, TXFM_2D_FLIP_CFG *cfg,
                                     int32_t *txfm_buf, int8_t fwd_shift,
-                                    int bd) {
+                                    int nz_rows, int bd) {
   // Note when assigning txfm_size_col, we use the txfm_size from the
   // row configuration and vice versa. This is intentionally done to
   // accurately perform rectangular transforms. When the transform is
@@ -182,8 +184,10 @@ static INLINE void inv_txfm2d_add_c(const int32_t *input, uint16_t *output,
   int32_t *buf_ptr = buf;
   int c, r;
 
+  assert(nz_rows > 0 && nz_rows <= txfm_size_row);
+
   // Rows
-  for (r = 0; r < txfm_size_row; ++r) {
+  for (r = 0; r < nz_rows; ++r) {
     txfm_func_row(input, buf_ptr, cos_bit_row, stage_range_row);
     round_shift_array(buf_ptr, txfm_size_col, -shift[0]);
     // Multiply everything by Sqrt2 if the transform is rectangular with
@@ -198,6 +202,8 @@ static INLINE void inv_txfm2d_add_c(const int32_t *input, uint16_t *output,
     input += txfm_size_col;
     buf_ptr += txfm_size_col;
   }
+  memset(buf_ptr, 0,
+         (txfm_size_row - nz_rows) * txfm_size_col * sizeof(*buf_ptr));
 
   // Columns
   for (c = 0; c < txfm_size_col; ++c) {
@@ -226,15 +232,91 @@ static INLINE void inv_txfm2d_add_c(const int32_t *input, uint16_t *output,
   }
 }
 
+static INLINE void inv_txfm2d_add_partial_facade(
+    const int32_t *input, uint16_t *output, int stride, int32_t *txfm_buf,
+    TX_TYPE tx_type, TX_SIZE tx_size, int nz_rows, int bd) {
+  TXFM_2D_FLIP_CFG cfg;
+  av1_get_inv_txfm_cfg(tx_type, tx_size, &cfg);
+  TX_SIZE tx_size_sqr = txsize_sqr_map[tx_size];
+  inv_txfm2d_add_c(input, output, stride, &cfg, txfm_buf,
+                   fwd_shift_sum[tx_size_sqr], nz_rows, bd);
+}
+
 static INLINE void inv_txfm2d_add_facade(const int32_t *input, uint16_t *output,
                                          int stride, int32_t *txfm_buf,
                                          TX_TYPE tx_type, TX_SIZE tx_size,
                                          int bd) {
+  inv_txfm2d_add_partial_facade(input, output, stride, txfm_buf, tx_type,
+                                tx_size, tx_size_high[tx_size], bd);
+}
+
+void av1_inv_txfm2d_add_partial(const int32_t *input, uint16_t *output,
+                                int stride, TX_TYPE tx_type, TX_SIZE tx_size,
+                                int nz_rows, int nz_cols, int bd) {
+  assert(tx_size_wide[tx_size] <= 32 && tx_size_high[tx_size] <= 32);
+  int txfm_buf[32 * 32 + 32 + 32];
+#if CONFIG_TXMG
+  if (tx_size_wide[tx_size] > tx_size_high[tx_size]) {
+    // Same rotation as the wide av1_inv_txfm2d_add_*_c(). Only the nonzero
+    // columns of input become rows that the transposed transform reads.
+    int32_t rinput[32 * 32];
+    uint16_t routput[32 * 32];
+    const int w = tx_size_wide[tx_size];
+    const int h = tx_size_high[tx_size];
+    transpose_int32(rinput, h, input, w, nz_cols, h);
+    transpose_uint16(routput, h, output, stride, w, h);
+    inv_txfm2d_add_partial_facade(rinput, routput, h, txfm_buf,
+                                  av1_rotate_tx_type(tx_type),
+                                  av1_rotate_tx_size(tx_size), nz_cols, bd);
+    transpose_uint16(output, stride, routput, h, h, w);
+    return;
+  }
+#endif  // CONFIG_TXMG
+  (void)nz_cols;
+  inv_txfm2d_add_partial_facade(input, output, stride, txfm_buf, tx_type,
+                                tx_size, nz_rows, bd);
+}
+
+int32_t av1_inv_txfm2d_dc_residual(int32_t dc, TX_SIZE tx_size, int bd) {
+  assert(tx_size_wide[tx_size] <= 32 && tx_size_high[tx_size] <= 32);
+#if CONFIG_TXMG
+  // Wide transforms are computed on their transpose, which rounds differently.
+  if (tx_size_wide[tx_size] > tx_size_high[tx_size])
+    tx_size = av1_rotate_tx_size(tx_size);
+#endif
   TXFM_2D_FLIP_CFG cfg;
-  av1_get_inv_txfm_cfg(tx_type, tx_size, &cfg);
-  TX_SIZE tx_size_sqr = txsize_sqr_map[tx_size];
-  inv_txfm2d_add_c(input, output, stride, &cfg, txfm_buf,
-                   fwd_shift_sum[tx_size_sqr], bd);
+  av1_get_inv_txfm_cfg(DCT_DCT, tx_size, &cfg);
+  const int txfm_size_col = cfg.row_cfg->txfm_size;
+  const int txfm_size_row = cfg.col_cfg->txfm_size;
+  const int rect_type = get_rect_tx_log_ratio(txfm_size_col, txfm_size_row);
+  const int rect_type2_shift =
+      (abs(rect_type) == 2 && AOMMAX(txfm_size_col, txfm_size_row) == 16);
+  const int8_t *shift = (txfm_size_col > txfm_size_row) ? cfg.row_cfg->shift
+                                                        : cfg.col_cfg->shift;
+  int8_t stage_range_row[MAX_TXFM_STAGE_NUM];
+  int8_t stage_range_col[MAX_TXFM_STAGE_NUM];
+  av1_gen_inv_stage_range(stage_range_col, stage_range_row, &cfg,
+                          fwd_shift_sum[txsize_sqr_map[tx_size]], bd);
+
+  // With only the DC coefficient set, every output of the row pass and then of
+  // the column pass is the same, so follow a single sample through
+  // inv_txfm2d_add_c().
+  int32_t temp_in[32] = { 0 };
+  int32_t temp_out[32];
+  temp_in[0] = dc;
+  inv_txfm_type_to_func(cfg.row_cfg->txfm_type)(
+      temp_in, temp_out, cfg.row_cfg->cos_bit, stage_range_row);
+  round_shift_array(temp_out, 1, -shift[0]);
+  if (abs(rect_type) == 1)
+    temp_out[0] = (int32_t)dct_const_round_shift(temp_out[0] * Sqrt2);
+  else if (rect_type2_shift)
+    round_shift_array(temp_out, 1, -rect_type2_shift);
+
+  temp_in[0] = temp_out[0];
+  inv_txfm_type_to_func(cfg.col_cfg->txfm_type)(
+      temp_in, temp_out, cfg.col_cfg->cos_bit, stage_range_col);
+  round_shift_array(temp_out, 1, -shift[1]);
+  return temp_out[0];
 }
 
 void av1_inv_txfm2d_add_4x8_c(const int32_t *input, uint16_t *output,
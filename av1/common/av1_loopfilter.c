@@ -9,6 +9,7 @@
  * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
  */
 
+#include <limits.h>
 #include <math.h>
 
 #include "./aom_config.h"
@@ -2129,30 +2130,69 @@ static TX_SIZE av1_get_transform_size(const MODE_INFO *const mi,
 }
 
 typedef struct AV1_DEBLOCKING_PARAMETERS {
-  // length of the filter applied to the outer edge
-  uint32_t filter_length;
-  // length of the filter applied to the inner edge
-  uint32_t filter_length_internal;
-  // deblocking limits
-  const uint8_t *lim;
-  const uint8_t *mblim;
-  const uint8_t *hev_thr;
+  // length of the filter applied to the edge, 0 if it is not filtered
+  uint8_t filter_length;
+  // filter level, selects the deblocking limits in lf_info.lfthr
+  uint8_t level;
 } AV1_DEBLOCKING_PARAMETERS;
 
-static void set_lpf_parameters(
-    AV1_DEBLOCKING_PARAMETERS *const params, const ptrdiff_t mode_step,
-    const AV1_COMMON *const cm, const EDGE_DIR edge_dir, const uint32_t x,
-    const uint32_t y, const int plane,
-    const struct macroblockd_plane *const plane_ptr) {
+// Transform size, filter level and skip flag of the block on one side of an
+// edge.
+typedef struct {
+  TX_SIZE tx_size;
+  uint8_t level;
+  uint8_t skip;
+} AV1_DEBLOCKING_BLOCK_INFO;
+
+static void get_lpf_block_info(const AV1_COMMON *const cm,
+                               const MODE_INFO *const mi,
+                               const EDGE_DIR edge_dir, const int mi_row,
+                               const int mi_col, const int plane,
+                               const struct macroblockd_plane *const plane_ptr,
+                               AV1_DEBLOCKING_BLOCK_INFO *const info) {
+  const MB_MODE_INFO *const mbmi = &mi->mbmi;
+  info->tx_size = av1_get_transform_size(
+      mi, edge_dir, mi_row, mi_col, plane, plane_ptr, plane_ptr->subsampling_x,
+      plane_ptr->subsampling_y);
+#if CONFIG_EXT_DELTA_Q
+#if CONFIG_LOOPFILTER_LEVEL
+  info->level = get_filter_level(cm, &cm->lf_info, edge_dir, plane, mbmi);
+#else
+#if CONFIG_LPF_SB
+  info->level = get_filter_level(cm, &cm->lf_info, mi_row, mi_col, mbmi);
+#else
+  info->level = get_filter_level(cm, &cm->lf_info, mbmi);
+#endif  // CONFIG_LPF_SB
+#endif
+#else
+  (void)cm;
+  info->level = get_filter_level(&cm->lf_info, mbmi);
+#endif  // CONFIG_EXT_DELTA_Q
+  info->skip = mbmi->skip && is_inter_block(mbmi);
+}
+
+// Sets the filter parameters of the edge at (x, y) and stores the block info
+// of the current position in curr. prev is the block info of the preceding
+// position in the filtering direction, or NULL if it has to be looked up.
+// Returns 0 if (x, y) is outside the plane or in a tile the decoder left out,
+// in which case curr is not set. Edges with such a tile are not filtered.
+static int set_lpf_parameters(AV1_DEBLOCKING_PARAMETERS *const params,
+                              const ptrdiff_t mode_step,
+                              const AV1_COMMON *const cm,
+                              const EDGE_DIR edge_dir, const uint32_t x,
+                              const uint32_t y, const int plane,
+                              const struct macroblockd_plane *const plane_ptr,
+                              AV1_DEBLOCKING_BLOCK_INFO *const curr,
+                              const AV1_DEBLOCKING_BLOCK_INFO *prev) {
   // reset to initial values
   params->filter_length = 0;
-  params->filter_length_internal = 0;
+  params->level = 0;
 
   // no deblocking is required
   const uint32_t width = plane_ptr->dst.width;
   const uint32_t height = plane_ptr->dst.height;
   if ((width <= x) || (height <= y)) {
-    return;
+    return 0;
   }
 
   const uint32_t scale_horz = plane_ptr->subsampling_x;
@@ -2160,373 +2200,494 @@ static void set_lpf_parameters(
   const int mi_row = (y << scale_vert) >> MI_SIZE_LOG2;
   const int mi_col = (x << scale_horz) >> MI_SIZE_LOG2;
   MODE_INFO **mi = cm->mi_grid_visible + mi_row * cm->mi_stride + mi_col;
+  if (mi[0] == NULL) return 0;
   const MB_MODE_INFO *mbmi = &mi[0]->mbmi;
 
-  {
-    const TX_SIZE ts =
-        av1_get_transform_size(mi[0], edge_dir, mi_row, mi_col, plane,
-                               plane_ptr, scale_horz, scale_vert);
+  get_lpf_block_info(cm, mi[0], edge_dir, mi_row, mi_col, plane, plane_ptr,
+                     curr);
 
-#if CONFIG_EXT_DELTA_Q
-#if CONFIG_LOOPFILTER_LEVEL
-    const uint32_t curr_level =
-        get_filter_level(cm, &cm->lf_info, edge_dir, plane, mbmi);
-#else
-#if CONFIG_LPF_SB
-    const uint32_t curr_level =
-        get_filter_level(cm, &cm->lf_info, mi_row, mi_col, mbmi);
-#else
-    const uint32_t curr_level = get_filter_level(cm, &cm->lf_info, mbmi);
-#endif  // CONFIG_LPF_SB
-#endif
-#else
-    const uint32_t curr_level = get_filter_level(&cm->lf_info, mbmi);
-#endif  // CONFIG_EXT_DELTA_Q
-
-    const int curr_skipped = mbmi->skip && is_inter_block(mbmi);
-    const uint32_t coord = (VERT_EDGE == edge_dir) ? (x) : (y);
-    uint32_t level = curr_level;
-    // prepare outer edge parameters. deblock the edge if it's an edge of a TU
-    if (coord) {
+  const uint32_t coord = (VERT_EDGE == edge_dir) ? (x) : (y);
+  // prepare outer edge parameters. deblock the edge if it's an edge of a TU
+  if (coord) {
 #if CONFIG_LOOPFILTERING_ACROSS_TILES
-      MODE_INFO *const mi_bound = cm->mi + mi_row * cm->mi_stride + mi_col;
-      if (!av1_disable_loopfilter_on_tile_boundary(cm) ||
-          ((VERT_EDGE == edge_dir) &&
-           (0 == (mi_bound->mbmi.boundary_info & TILE_LEFT_BOUNDARY))) ||
-          ((HORZ_EDGE == edge_dir) &&
-           (0 == (mi_bound->mbmi.boundary_info & TILE_ABOVE_BOUNDARY))))
+    MODE_INFO *const mi_bound = cm->mi + mi_row * cm->mi_stride + mi_col;
+    if (!av1_disable_loopfilter_on_tile_boundary(cm) ||
+        ((VERT_EDGE == edge_dir) &&
+         (0 == (mi_bound->mbmi.boundary_info & TILE_LEFT_BOUNDARY))) ||
+        ((HORZ_EDGE == edge_dir) &&
+         (0 == (mi_bound->mbmi.boundary_info & TILE_ABOVE_BOUNDARY))))
 #endif  // CONFIG_LOOPFILTERING_ACROSS_TILES
-      {
-        const int32_t tu_edge =
-            (coord & av1_transform_masks[edge_dir][ts]) ? (0) : (1);
-        if (tu_edge) {
-          const MODE_INFO *const mi_prev = *(mi - mode_step);
+    {
+      const int32_t tu_edge =
+          (coord & av1_transform_masks[edge_dir][curr->tx_size]) ? (0) : (1);
+      if (tu_edge) {
+        AV1_DEBLOCKING_BLOCK_INFO pv_info;
+        if (prev == NULL) {
+          if (*(mi - mode_step) == NULL) return 1;
           const int pv_row =
               (VERT_EDGE == edge_dir) ? (mi_row) : (mi_row - (1 << scale_vert));
           const int pv_col =
               (VERT_EDGE == edge_dir) ? (mi_col - (1 << scale_horz)) : (mi_col);
-          const TX_SIZE pv_ts =
-              av1_get_transform_size(mi_prev, edge_dir, pv_row, pv_col, plane,
-                                     plane_ptr, scale_horz, scale_vert);
-
-#if CONFIG_EXT_DELTA_Q
-#if CONFIG_LOOPFILTER_LEVEL
-          const uint32_t pv_lvl = get_filter_level(cm, &cm->lf_info, edge_dir,
-                                                   plane, &mi_prev->mbmi);
-#else
-#if CONFIG_LPF_SB
-          const uint32_t pv_lvl = get_filter_level(cm, &cm->lf_info, pv_row,
-                                                   pv_col, &mi_prev->mbmi);
-#else
-          const uint32_t pv_lvl =
-              get_filter_level(cm, &cm->lf_info, &mi_prev->mbmi);
-#endif  // CONFIG_LPF_SB
-#endif
-#else
-          const uint32_t pv_lvl =
-              get_filter_level(&cm->lf_info, &mi_prev->mbmi);
-#endif  // CONFIG_EXT_DELTA_Q
+          get_lpf_block_info(cm, *(mi - mode_step), edge_dir, pv_row, pv_col,
+                             plane, plane_ptr, &pv_info);
+          prev = &pv_info;
+        }
 
-          const int pv_skip =
-              mi_prev->mbmi.skip && is_inter_block(&mi_prev->mbmi);
-          const int32_t pu_edge =
-              (coord &
-               av1_prediction_masks[edge_dir]
-                                   [ss_size_lookup[mbmi->sb_type][scale_horz]
-                                                  [scale_vert]])
-                  ? (0)
-                  : (1);
-          // if the current and the previous blocks are skipped,
-          // deblock the edge if the edge belongs to a PU's edge only.
-          if ((curr_level || pv_lvl) &&
-              (!pv_skip || !curr_skipped || pu_edge)) {
-            const TX_SIZE min_ts = AOMMIN(ts, pv_ts);
-            if (TX_4X4 >= min_ts) {
-              params->filter_length = 4;
-            } else if (TX_8X8 == min_ts) {
+        const int32_t pu_edge =
+            (coord &
+             av1_prediction_masks[edge_dir]
+                                 [ss_size_lookup[mbmi->sb_type][scale_horz]
+                                                [scale_vert]])
+                ? (0)
+                : (1);
+        // if the current and the previous blocks are skipped,
+        // deblock the edge if the edge belongs to a PU's edge only.
+        if ((curr->level || prev->level) &&
+            (!prev->skip || !curr->skip || pu_edge)) {
+          const TX_SIZE min_ts = AOMMIN(curr->tx_size, prev->tx_size);
+          if (TX_4X4 >= min_ts) {
+            params->filter_length = 4;
+          } else if (TX_8X8 == min_ts) {
 #if PARALLEL_DEBLOCKING_5_TAP_CHROMA
-              if (plane != 0)
-                params->filter_length = 6;
-              else
+            if (plane != 0)
+              params->filter_length = 6;
+            else
 #endif
-                params->filter_length = 8;
-            } else {
-              params->filter_length = 16;
+              params->filter_length = 8;
+          } else {
+            params->filter_length = 16;
 #if PARALLEL_DEBLOCKING_15TAPLUMAONLY
-              // No wide filtering for chroma plane
-              if (plane != 0) {
+            // No wide filtering for chroma plane
+            if (plane != 0) {
 #if PARALLEL_DEBLOCKING_5_TAP_CHROMA
-                params->filter_length = 6;
+              params->filter_length = 6;
 #else
-                params->filter_length = 8;
-#endif
-              }
+              params->filter_length = 8;
 #endif
             }
+#endif
+          }
 
 #if PARALLEL_DEBLOCKING_DISABLE_15TAP
-            params->filter_length = (TX_4X4 >= AOMMIN(ts, pv_ts)) ? (4) : (8);
+          params->filter_length = (TX_4X4 >= min_ts) ? (4) : (8);
 #endif  // PARALLEL_DEBLOCKING_DISABLE_15TAP
 
-            // update the level if the current block is skipped,
-            // but the previous one is not
-            level = (curr_level) ? (curr_level) : (pv_lvl);
-          }
+          // update the level if the current block is skipped,
+          // but the previous one is not
+          params->level = (curr->level) ? (curr->level) : (prev->level);
         }
       }
-
-      // prepare common parameters
-      if (params->filter_length || params->filter_length_internal) {
-        const loop_filter_thresh *const limits = cm->lf_info.lfthr + level;
-        params->lim = limits->lim;
-        params->mblim = limits->mblim;
-        params->hev_thr = limits->hev_thr;
-      }
     }
   }
+  return 1;
 }
 
-static void av1_filter_block_plane_vert(
-    const AV1_COMMON *const cm, const int plane,
-    const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
-    const uint32_t mi_col) {
-  const int col_step = MI_SIZE >> MI_SIZE_LOG2;
-  const int row_step = MI_SIZE >> MI_SIZE_LOG2;
-  const uint32_t scale_horz = plane_ptr->subsampling_x;
-  const uint32_t scale_vert = plane_ptr->subsampling_y;
-  uint8_t *const dst_ptr = plane_ptr->dst.buf;
-  const int dst_stride = plane_ptr->dst.stride;
+// Filter parameters of every edge of one plane of a superblock, indexed by
+// the row and column of the 4x4 block the edge starts.
+typedef AV1_DEBLOCKING_PARAMETERS
+    AV1_DEBLOCKING_MAP[MAX_MIB_SIZE][MAX_MIB_SIZE];
+
+// mi_row_end clips the rows filtered below mi_row.
+static void get_filter_ranges(const AV1_COMMON *const cm,
+                              const MACROBLOCKD_PLANE *const plane_ptr,
+                              const uint32_t mi_row, const uint32_t mi_col,
+                              const int mi_row_end, int *y_range,
+                              int *x_range) {
 #if CONFIG_LPF_SB
-  int y_range = mi_row ? MAX_MIB_SIZE : MAX_MIB_SIZE - FILT_BOUNDARY_MI_OFFSET;
-  y_range = AOMMIN(y_range, cm->mi_rows);
-  y_range >>= scale_vert;
-
-  int x_range = mi_col ? MAX_MIB_SIZE : MAX_MIB_SIZE - FILT_BOUNDARY_MI_OFFSET;
-  x_range = AOMMIN(x_range, cm->mi_cols);
-  x_range >>= scale_horz;
+  (void)mi_row_end;
+  *y_range = mi_row ? MAX_MIB_SIZE : MAX_MIB_SIZE - FILT_BOUNDARY_MI_OFFSET;
+  *y_range = AOMMIN(*y_range, cm->mi_rows);
+  *y_range >>= plane_ptr->subsampling_y;
+
+  *x_range = mi_col ? MAX_MIB_SIZE : MAX_MIB_SIZE - FILT_BOUNDARY_MI_OFFSET;
+  *x_range = AOMMIN(*x_range, cm->mi_cols);
+  *x_range >>= plane_ptr->subsampling_x;
 #else
-  const int y_range = (MAX_MIB_SIZE >> scale_vert);
-  const int x_range = (MAX_MIB_SIZE >> scale_horz);
+  (void)cm;
+  (void)mi_col;
+  // Round up so that the last chroma row of an odd number of luma rows is
+  // kept.
+  *y_range = AOMMIN(MAX_MIB_SIZE, mi_row_end - (int)mi_row);
+  *y_range = (*y_range + plane_ptr->subsampling_y) >> plane_ptr->subsampling_y;
+  *x_range = (MAX_MIB_SIZE >> plane_ptr->subsampling_x);
 #endif  // CONFIG_LPF_SB
-  for (int y = 0; y < y_range; y += row_step) {
-    uint8_t *p = dst_ptr + y * MI_SIZE * dst_stride;
-    for (int x = 0; x < x_range; x += col_step) {
-      // inner loop always filter vertical edges in a MI block. If MI size
-      // is 8x8, it will filter the vertical edge aligned with a 8x8 block.
-      // If 4x4 trasnform is used, it will then filter the internal edge
-      //  aligned with a 4x4 block
-      const uint32_t curr_x = ((mi_col * MI_SIZE) >> scale_horz) + x * MI_SIZE;
-      const uint32_t curr_y = ((mi_row * MI_SIZE) >> scale_vert) + y * MI_SIZE;
-      AV1_DEBLOCKING_PARAMETERS params;
-      memset(&params, 0, sizeof(params));
+}
 
-      set_lpf_parameters(&params, ((ptrdiff_t)1 << scale_horz), cm, VERT_EDGE,
-                         curr_x, curr_y, plane, plane_ptr);
+// Builds the edge map of one plane of a superblock. The info of each block is
+// looked up once and reused as the previous block of the next edge, so only
+// the blocks bordering the superblock are looked up twice.
+static void build_edge_map(const AV1_COMMON *const cm, const EDGE_DIR edge_dir,
+                           const int plane,
+                           const MACROBLOCKD_PLANE *const plane_ptr,
+                           const uint32_t mi_row, const uint32_t mi_col,
+                           const int y_range, const int x_range,
+                           AV1_DEBLOCKING_MAP map) {
+  const uint32_t scale_horz = plane_ptr->subsampling_x;
+  const uint32_t scale_vert = plane_ptr->subsampling_y;
+  const ptrdiff_t mode_step = (VERT_EDGE == edge_dir)
+                                  ? ((ptrdiff_t)1 << scale_horz)
+                                  : (cm->mi_stride << scale_vert);
+  // Block info of the previous position in the filtering direction: the left
+  // neighbour in info[0] for vertical edges, the neighbour above column x in
+  // info[x] for horizontal edges.
+  AV1_DEBLOCKING_BLOCK_INFO info[MAX_MIB_SIZE];
+  int info_valid[MAX_MIB_SIZE] = { 0 };
+
+  for (int y = 0; y < y_range; ++y) {
+    const uint32_t curr_y = ((mi_row * MI_SIZE) >> scale_vert) + y * MI_SIZE;
+    for (int x = 0; x < x_range; ++x) {
+      const uint32_t curr_x = ((mi_col * MI_SIZE) >> scale_horz) + x * MI_SIZE;
+      const int idx = (VERT_EDGE == edge_dir) ? 0 : x;
+      const int first = (VERT_EDGE == edge_dir) ? (x == 0) : (y == 0);
+      AV1_DEBLOCKING_BLOCK_INFO curr;
+      info_valid[idx] = set_lpf_parameters(
+          &map[y][x], mode_step, cm, edge_dir, curr_x, curr_y, plane,
+          plane_ptr, &curr, (!first && info_valid[idx]) ? &info[idx] : NULL);
+      if (info_valid[idx]) info[idx] = curr;
+    }
+  }
+}
 
-      switch (params.filter_length) {
-        // apply 4-tap filtering
-        case 4:
+static void filter_vert_edge(const AV1_COMMON *const cm, const int plane,
+                             uint8_t *const p, const int dst_stride,
+                             const AV1_DEBLOCKING_PARAMETERS *const params) {
+  const loop_filter_thresh *const limits = cm->lf_info.lfthr + params->level;
+  (void)plane;
+  switch (params->filter_length) {
+    // apply 4-tap filtering
+    case 4:
 #if CONFIG_HIGHBITDEPTH
-          if (cm->use_highbitdepth)
-            aom_highbd_lpf_vertical_4(CONVERT_TO_SHORTPTR(p), dst_stride,
-                                      params.mblim, params.lim, params.hev_thr,
-                                      cm->bit_depth);
-          else
+      if (cm->use_highbitdepth)
+        aom_highbd_lpf_vertical_4(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                  limits->mblim, limits->lim, limits->hev_thr,
+                                  cm->bit_depth);
+      else
 #endif  // CONFIG_HIGHBITDEPTH
-            aom_lpf_vertical_4(p, dst_stride, params.mblim, params.lim,
-                               params.hev_thr);
-          break;
+        aom_lpf_vertical_4(p, dst_stride, limits->mblim, limits->lim,
+                           limits->hev_thr);
+      break;
 #if PARALLEL_DEBLOCKING_5_TAP_CHROMA
-        case 6:  // apply 6-tap filter for chroma plane only
-          assert(plane != 0);
+    case 6:  // apply 6-tap filter for chroma plane only
+      assert(plane != 0);
 #if CONFIG_HIGHBITDEPTH
-          if (cm->use_highbitdepth)
-            aom_highbd_lpf_vertical_6_c(CONVERT_TO_SHORTPTR(p), dst_stride,
-                                        params.mblim, params.lim,
-                                        params.hev_thr, cm->bit_depth);
-          else
+      if (cm->use_highbitdepth)
+        aom_highbd_lpf_vertical_6_c(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                    limits->mblim, limits->lim,
+                                    limits->hev_thr, cm->bit_depth);
+      else
 #endif  // CONFIG_HIGHBITDEPTH
-            aom_lpf_vertical_6_c(p, dst_stride, params.mblim, params.lim,
-                                 params.hev_thr);
-          break;
+        aom_lpf_vertical_6_c(p, dst_stride, limits->mblim, limits->lim,
+                             limits->hev_thr);
+      break;
 #endif
-        // apply 8-tap filtering
-        case 8:
+    // apply 8-tap filtering
+    case 8:
 #if CONFIG_HIGHBITDEPTH
-          if (cm->use_highbitdepth)
-            aom_highbd_lpf_vertical_8(CONVERT_TO_SHORTPTR(p), dst_stride,
-                                      params.mblim, params.lim, params.hev_thr,
-                                      cm->bit_depth);
-          else
+      if (cm->use_highbitdepth)
+        aom_highbd_lpf_vertical_8(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                  limits->mblim, limits->lim, limits->hev_thr,
+                                  cm->bit_depth);
+      else
 #endif  // CONFIG_HIGHBITDEPTH
-            aom_lpf_vertical_8(p, dst_stride, params.mblim, params.lim,
-                               params.hev_thr);
-          break;
-        // apply 16-tap filtering
-        case 16:
+        aom_lpf_vertical_8(p, dst_stride, limits->mblim, limits->lim,
+                           limits->hev_thr);
+      break;
+    // apply 16-tap filtering
+    case 16:
 #if CONFIG_HIGHBITDEPTH
-          if (cm->use_highbitdepth)
+      if (cm->use_highbitdepth)
 #if CONFIG_DEBLOCK_13TAP
-            // TODO(olah): Remove _c once SIMD for 13-tap is available
-            aom_highbd_lpf_vertical_16_c(CONVERT_TO_SHORTPTR(p), dst_stride,
-                                         params.mblim, params.lim,
-                                         params.hev_thr, cm->bit_depth);
+        // TODO(olah): Remove _c once SIMD for 13-tap is available
+        aom_highbd_lpf_vertical_16_c(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                     limits->mblim, limits->lim,
+                                     limits->hev_thr, cm->bit_depth);
 #else
-            aom_highbd_lpf_vertical_16(CONVERT_TO_SHORTPTR(p), dst_stride,
-                                       params.mblim, params.lim, params.hev_thr,
-                                       cm->bit_depth);
+        aom_highbd_lpf_vertical_16(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                   limits->mblim, limits->lim, limits->hev_thr,
+                                   cm->bit_depth);
 #endif
-          else
+      else
 #endif  // CONFIG_HIGHBITDEPTH
 #if CONFIG_DEBLOCK_13TAP
-            aom_lpf_vertical_16_c(p, dst_stride, params.mblim, params.lim,
-                                  params.hev_thr);
+        aom_lpf_vertical_16_c(p, dst_stride, limits->mblim, limits->lim,
+                              limits->hev_thr);
 #else
-          aom_lpf_vertical_16(p, dst_stride, params.mblim, params.lim,
-                              params.hev_thr);
+      aom_lpf_vertical_16(p, dst_stride, limits->mblim, limits->lim,
+                          limits->hev_thr);
 #endif
-          break;
-        // no filtering
-        default: break;
-      }
-      // process the internal edge
-      if (params.filter_length_internal) {
+      break;
+    // no filtering
+    default: break;
+  }
+}
+
+// Filters the vertical edges of two vertically adjacent 4x4 blocks, with a
+// single dual call when both take the 4 or the 8 tap filter.
+static void filter_vert_edge_pair(
+    const AV1_COMMON *const cm, const int plane, uint8_t *const p,
+    const int dst_stride, const AV1_DEBLOCKING_PARAMETERS *const params0,
+    const AV1_DEBLOCKING_PARAMETERS *const params1) {
+  const int filter_length = params0->filter_length;
+  if (filter_length != params1->filter_length ||
+      (filter_length != 4 && filter_length != 8)) {
+    filter_vert_edge(cm, plane, p, dst_stride, params0);
+    filter_vert_edge(cm, plane, p + MI_SIZE * dst_stride, dst_stride, params1);
+    return;
+  }
+
+  const loop_filter_thresh *const limits0 = cm->lf_info.lfthr + params0->level;
+  const loop_filter_thresh *const limits1 = cm->lf_info.lfthr + params1->level;
 #if CONFIG_HIGHBITDEPTH
-        if (cm->use_highbitdepth)
-          aom_highbd_lpf_vertical_4(CONVERT_TO_SHORTPTR(p + 4), dst_stride,
-                                    params.mblim, params.lim, params.hev_thr,
-                                    cm->bit_depth);
-        else
-#endif  // CONFIG_HIGHBITDEPTH
-          aom_lpf_vertical_4(p + 4, dst_stride, params.mblim, params.lim,
-                             params.hev_thr);
-      }
-      // advance the destination pointer
-      p += MI_SIZE;
-    }
+  if (cm->use_highbitdepth) {
+    if (filter_length == 4)
+      aom_highbd_lpf_vertical_4_dual(
+          CONVERT_TO_SHORTPTR(p), dst_stride, limits0->mblim, limits0->lim,
+          limits0->hev_thr, limits1->mblim, limits1->lim, limits1->hev_thr,
+          cm->bit_depth);
+    else
+      aom_highbd_lpf_vertical_8_dual(
+          CONVERT_TO_SHORTPTR(p), dst_stride, limits0->mblim, limits0->lim,
+          limits0->hev_thr, limits1->mblim, limits1->lim, limits1->hev_thr,
+          cm->bit_depth);
+    return;
   }
+#endif  // CONFIG_HIGHBITDEPTH
+  if (filter_length == 4)
+    aom_lpf_vertical_4_dual(p, dst_stride, limits0->mblim, limits0->lim,
+                            limits0->hev_thr, limits1->mblim, limits1->lim,
+                            limits1->hev_thr);
+  else
+    aom_lpf_vertical_8_dual(p, dst_stride, limits0->mblim, limits0->lim,
+                            limits0->hev_thr, limits1->mblim, limits1->lim,
+                            limits1->hev_thr);
 }
 
-static void av1_filter_block_plane_horz(
+static void av1_filter_block_plane_vert(
     const AV1_COMMON *const cm, const int plane,
     const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
-    const uint32_t mi_col) {
-  const int col_step = MI_SIZE >> MI_SIZE_LOG2;
-  const int row_step = MI_SIZE >> MI_SIZE_LOG2;
-  const uint32_t scale_horz = plane_ptr->subsampling_x;
-  const uint32_t scale_vert = plane_ptr->subsampling_y;
+    const uint32_t mi_col, const int mi_row_end) {
   uint8_t *const dst_ptr = plane_ptr->dst.buf;
   const int dst_stride = plane_ptr->dst.stride;
-#if CONFIG_LPF_SB
-  int y_range = mi_row ? MAX_MIB_SIZE : MAX_MIB_SIZE - FILT_BOUNDARY_MI_OFFSET;
-  y_range = AOMMIN(y_range, cm->mi_rows);
-  y_range >>= scale_vert;
-
-  int x_range = mi_col ? MAX_MIB_SIZE : MAX_MIB_SIZE - FILT_BOUNDARY_MI_OFFSET;
-  x_range = AOMMIN(x_range, cm->mi_cols);
-  x_range >>= scale_horz;
-#else
-  const int y_range = (MAX_MIB_SIZE >> scale_vert);
-  const int x_range = (MAX_MIB_SIZE >> scale_horz);
-#endif  // CONFIG_LPF_SB
-  for (int y = 0; y < y_range; y += row_step) {
+  int y_range, x_range;
+  AV1_DEBLOCKING_MAP map;
+  get_filter_ranges(cm, plane_ptr, mi_row, mi_col, mi_row_end, &y_range,
+                    &x_range);
+  build_edge_map(cm, VERT_EDGE, plane, plane_ptr, mi_row, mi_col, y_range,
+                 x_range, map);
+
+  // A vertical edge only changes the rows it crosses, so two rows of edges
+  // can be filtered side by side as long as the columns stay in order.
+  for (int y = 0; y < y_range; y += 2) {
     uint8_t *p = dst_ptr + y * MI_SIZE * dst_stride;
-    for (int x = 0; x < x_range; x += col_step) {
-      // inner loop always filter vertical edges in a MI block. If MI size
-      // is 8x8, it will first filter the vertical edge aligned with a 8x8
-      // block. If 4x4 trasnform is used, it will then filter the internal
-      // edge aligned with a 4x4 block
-      const uint32_t curr_x = ((mi_col * MI_SIZE) >> scale_horz) + x * MI_SIZE;
-      const uint32_t curr_y = ((mi_row * MI_SIZE) >> scale_vert) + y * MI_SIZE;
-      AV1_DEBLOCKING_PARAMETERS params;
-      memset(&params, 0, sizeof(params));
-
-      set_lpf_parameters(&params, (cm->mi_stride << scale_vert), cm, HORZ_EDGE,
-                         curr_x, curr_y, plane, plane_ptr);
+    for (int x = 0; x < x_range; ++x) {
+      if (y + 1 < y_range)
+        filter_vert_edge_pair(cm, plane, p, dst_stride, &map[y][x],
+                              &map[y + 1][x]);
+      else
+        filter_vert_edge(cm, plane, p, dst_stride, &map[y][x]);
+      // advance the destination pointer
+      p += MI_SIZE;
+    }
+  }
+}
 
-      switch (params.filter_length) {
-        // apply 4-tap filtering
-        case 4:
+static void filter_horz_edge(const AV1_COMMON *const cm, const int plane,
+                             uint8_t *const p, const int dst_stride,
+                             const AV1_DEBLOCKING_PARAMETERS *const params) {
+  const loop_filter_thresh *const limits = cm->lf_info.lfthr + params->level;
+  (void)plane;
+  switch (params->filter_length) {
+    // apply 4-tap filtering
+    case 4:
 #if CONFIG_HIGHBITDEPTH
-          if (cm->use_highbitdepth)
-            aom_highbd_lpf_horizontal_4(CONVERT_TO_SHORTPTR(p), dst_stride,
-                                        params.mblim, params.lim,
-                                        params.hev_thr, cm->bit_depth);
-          else
+      if (cm->use_highbitdepth)
+        aom_highbd_lpf_horizontal_4(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                    limits->mblim, limits->lim,
+                                    limits->hev_thr, cm->bit_depth);
+      else
 #endif  // CONFIG_HIGHBITDEPTH
-            aom_lpf_horizontal_4(p, dst_stride, params.mblim, params.lim,
-                                 params.hev_thr);
-          break;
+        aom_lpf_horizontal_4(p, dst_stride, limits->mblim, limits->lim,
+                             limits->hev_thr);
+      break;
 #if PARALLEL_DEBLOCKING_5_TAP_CHROMA
-        // apply 6-tap filtering
-        case 6: assert(plane != 0);
+    // apply 6-tap filtering
+    case 6: assert(plane != 0);
 #if CONFIG_HIGHBITDEPTH
-          if (cm->use_highbitdepth)
-            aom_highbd_lpf_horizontal_6_c(CONVERT_TO_SHORTPTR(p), dst_stride,
-                                          params.mblim, params.lim,
-                                          params.hev_thr, cm->bit_depth);
-          else
+      if (cm->use_highbitdepth)
+        aom_highbd_lpf_horizontal_6_c(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                      limits->mblim, limits->lim,
+                                      limits->hev_thr, cm->bit_depth);
+      else
 #endif  // CONFIG_HIGHBITDEPTH
-            aom_lpf_horizontal_6_c(p, dst_stride, params.mblim, params.lim,
-                                   params.hev_thr);
-          break;
+        aom_lpf_horizontal_6_c(p, dst_stride, limits->mblim, limits->lim,
+                               limits->hev_thr);
+      break;
 #endif
-        // apply 8-tap filtering
-        case 8:
+    // apply 8-tap filtering
+    case 8:
 #if CONFIG_HIGHBITDEPTH
-          if (cm->use_highbitdepth)
-            aom_highbd_lpf_horizontal_8(CONVERT_TO_SHORTPTR(p), dst_stride,
-                                        params.mblim, params.lim,
-                                        params.hev_thr, cm->bit_depth);
-          else
+      if (cm->use_highbitdepth)
+        aom_highbd_lpf_horizontal_8(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                    limits->mblim, limits->lim,
+                                    limits->hev_thr, cm->bit_depth);
+      else
 #endif  // CONFIG_HIGHBITDEPTH
-            aom_lpf_horizontal_8(p, dst_stride, params.mblim, params.lim,
-                                 params.hev_thr);
-          break;
-        // apply 16-tap filtering
-        case 16:
+        aom_lpf_horizontal_8(p, dst_stride, limits->mblim, limits->lim,
+                             limits->hev_thr);
+      break;
+    // apply 16-tap filtering
+    case 16:
 #if CONFIG_HIGHBITDEPTH
-          if (cm->use_highbitdepth)
+      if (cm->use_highbitdepth)
 #if CONFIG_DEBLOCK_13TAP
-            // TODO(olah): Remove _c once SIMD for 13-tap is available
-            aom_highbd_lpf_horizontal_16_dual_c(
-                CONVERT_TO_SHORTPTR(p), dst_stride, params.mblim, params.lim,
-                params.hev_thr, cm->bit_depth);
+        // TODO(olah): Remove _c once SIMD for 13-tap is available
+        aom_highbd_lpf_horizontal_16_dual_c(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                            limits->mblim, limits->lim,
+                                            limits->hev_thr, cm->bit_depth);
 #else
-            aom_highbd_lpf_horizontal_16_dual(
-                CONVERT_TO_SHORTPTR(p), dst_stride, params.mblim, params.lim,
-                params.hev_thr, cm->bit_depth);
+        aom_highbd_lpf_horizontal_16_dual(CONVERT_TO_SHORTPTR(p), dst_stride,
+                                          limits->mblim, limits->lim,
+                                          limits->hev_thr, cm->bit_depth);
 #endif
-          else
+      else
 #endif  // CONFIG_HIGHBITDEPTH
 #if CONFIG_DEBLOCK_13TAP
-            aom_lpf_horizontal_16_dual_c(p, dst_stride, params.mblim,
-                                         params.lim, params.hev_thr);
+        aom_lpf_horizontal_16_dual_c(p, dst_stride, limits->mblim, limits->lim,
+                                     limits->hev_thr);
 #else
-          aom_lpf_horizontal_16_dual(p, dst_stride, params.mblim, params.lim,
-                                     params.hev_thr);
+      aom_lpf_horizontal_16_dual(p, dst_stride, limits->mblim, limits->lim,
+                                 limits->hev_thr);
 #endif
-          break;
-        // no filtering
-        default: break;
-      }
-      // process the internal edge
-      if (params.filter_length_internal) {
+      break;
+    // no filtering
+    default: break;
+  }
+}
+
+// Filters the horizontal edges of two horizontally adjacent 4x4 blocks, with
+// a single dual call when both take the 4 or the 8 tap filter.
+static void filter_horz_edge_pair(
+    const AV1_COMMON *const cm, const int plane, uint8_t *const p,
+    const int dst_stride, const AV1_DEBLOCKING_PARAMETERS *const params0,
+    const AV1_DEBLOCKING_PARAMETERS *const params1) {
+  const int filter_length = params0->filter_length;
+  if (filter_length != params1->filter_length ||
+      (filter_length != 4 && filter_length != 8)) {
+    filter_horz_edge(cm, plane, p, dst_stride, params0);
+    filter_horz_edge(cm, plane, p + MI_SIZE, dst_stride, params1);
+    return;
+  }
+
+  const loop_filter_thresh *const limits0 = cm->lf_info.lfthr + params0->level;
+  const loop_filter_thresh *const limits1 = cm->lf_info.lfthr + params1->level;
 #if CONFIG_HIGHBITDEPTH
-        if (cm->use_highbitdepth)
-          aom_highbd_lpf_horizontal_4(CONVERT_TO_SHORTPTR(p + 4 * dst_stride),
-                                      dst_stride, params.mblim, params.lim,
-                                      params.hev_thr, cm->bit_depth);
-        else
+  if (cm->use_highbitdepth) {
+    if (filter_length == 4)
+      aom_highbd_lpf_horizontal_4_dual(
+          CONVERT_TO_SHORTPTR(p), dst_stride, limits0->mblim, limits0->lim,
+          limits0->hev_thr, limits1->mblim, limits1->lim, limits1->hev_thr,
+          cm->bit_depth);
+    else
+      aom_highbd_lpf_horizontal_8_dual(
+          CONVERT_TO_SHORTPTR(p), dst_stride, limits0->mblim, limits0->lim,
+          limits0->hev_thr, limits1->mblim, limits1->lim, limits1->hev_thr,
+          cm->bit_depth);
+    return;
+  }
 #endif  // CONFIG_HIGHBITDEPTH
-          aom_lpf_horizontal_4(p + 4 * dst_stride, dst_stride, params.mblim,
-                               params.lim, params.hev_thr);
-      }
+  if (filter_length == 4)
+    aom_lpf_horizontal_4_dual(p, dst_stride, limits0->mblim, limits0->lim,
+                              limits0->hev_thr, limits1->mblim, limits1->lim,
+                              limits1->hev_thr);
+  else
+    aom_lpf_horizontal_8_dual(p, dst_stride, limits0->mblim, limits0->lim,
+                              limits0->hev_thr, limits1->mblim, limits1->lim,
+                              limits1->hev_thr);
+}
+
+static void av1_filter_block_plane_horz(
+    const AV1_COMMON *const cm, const int plane,
+    const MACROBLOCKD_PLANE *const plane_ptr, const uint32_t mi_row,
+    const uint32_t mi_col, const int mi_row_end) {
+  uint8_t *const dst_ptr = plane_ptr->dst.buf;
+  const int dst_stride = plane_ptr->dst.stride;
+  int y_range, x_range;
+  AV1_DEBLOCKING_MAP map;
+  get_filter_ranges(cm, plane_ptr, mi_row, mi_col, mi_row_end, &y_range,
+                    &x_range);
+  build_edge_map(cm, HORZ_EDGE, plane, plane_ptr, mi_row, mi_col, y_range,
+                 x_range, map);
+
+  // A horizontal edge only changes the columns it crosses, so two columns of
+  // edges can be filtered side by side as long as the rows stay in order.
+  for (int y = 0; y < y_range; ++y) {
+    uint8_t *p = dst_ptr + y * MI_SIZE * dst_stride;
+    for (int x = 0; x < x_range; x += 2) {
+      if (x + 1 < x_range)
+        filter_horz_edge_pair(cm, plane, p, dst_stride, &map[y][x],
+                              &map[y][x + 1]);
+      else
+        filter_horz_edge(cm, plane, p, dst_stride, &map[y][x]);
       // advance the destination pointer
-      p += MI_SIZE;
+      p += 2 * MI_SIZE;
     }
   }
 }
+
+// The edges of the rows from mi_row_end down are left out.
+static void loop_filter_ver_sb_range(YV12_BUFFER_CONFIG *frame_buffer,
+                                     const AV1_COMMON *cm,
+                                     struct macroblockd_plane *planes,
+                                     int plane_start, int plane_end, int start,
+                                     int stop, int col_start, int col_end,
+                                     int mi_row_end) {
+  // filter all vertical edges in every super block
+  for (int mi_row = start; mi_row < stop; mi_row += MAX_MIB_SIZE) {
+    for (int mi_col = col_start; mi_col < col_end; mi_col += MAX_MIB_SIZE) {
+      av1_setup_dst_planes(planes, cm->sb_size, frame_buffer, mi_row, mi_col);
+      for (int plane = plane_start; plane < plane_end; ++plane) {
+        av1_filter_block_plane_vert(cm, plane, &planes[plane], mi_row, mi_col,
+                                    mi_row_end);
+      }
+    }
+  }
+}
+
+static void loop_filter_hor_sb_range(YV12_BUFFER_CONFIG *frame_buffer,
+                                     const AV1_COMMON *cm,
+                                     struct macroblockd_plane *planes,
+                                     int plane_start, int plane_end, int start,
+                                     int stop, int col_start, int col_end,
+                                     int mi_row_end) {
+  // filter all horizontal edges in every super block
+  for (int mi_row = start; mi_row < stop; mi_row += MAX_MIB_SIZE) {
+    for (int mi_col = col_start; mi_col < col_end; mi_col += MAX_MIB_SIZE) {
+      av1_setup_dst_planes(planes, cm->sb_size, frame_buffer, mi_row, mi_col);
+      for (int plane = plane_start; plane < plane_end; ++plane) {
+        av1_filter_block_plane_horz(cm, plane, &planes[plane], mi_row, mi_col,
+                                    mi_row_end);
+      }
+    }
+  }
+}
+
+void av1_loop_filter_ver_sb_range(YV12_BUFFER_CONFIG *frame_buffer,
+                                  const AV1_COMMON *cm,
+                                  struct macroblockd_plane *planes,
+                                  int plane_start, int plane_end, int start,
+                                  int stop, int col_start, int col_end) {
+  loop_filter_ver_sb_range(frame_buffer, cm, planes, plane_start, plane_end,
+                           start, stop, col_start, col_end, INT_MAX);
+}
+
+void av1_loop_filter_hor_sb_range(YV12_BUFFER_CONFIG *frame_buffer,
+                                  const AV1_COMMON *cm,
+                                  struct macroblockd_plane *planes,
+                                  int plane_start, int plane_end, int start,
+                                  int stop, int col_start, int col_end) {
+  loop_filter_hor_sb_range(frame_buffer, cm, planes, plane_start, plane_end,
+                           start, stop, col_start, col_end, INT_MAX);
+}
 #endif  // CONFIG_PARALLEL_DEBLOCKING
 
 void av1_loop_filter_rows(YV12_BUFFER_CONFIG *frame_buffer, AV1_COMMON *cm,
@@ -2535,28 +2696,20 @@ void av1_loop_filter_rows(YV12_BUFFER_CONFIG *frame_buffer, AV1_COMMON *cm,
                           int col_start, int col_end,
 #endif
                           int y_only) {
-#if CONFIG_LOOPFILTER_LEVEL
-  // y_only no longer has its original meaning.
-  // Here it means which plane to filter
-  // when y_only = {0, 1, 2}, it means we are searching for filter level for
-  // Y/U/V plane individually.
-  const int plane_start = y_only;
-  const int plane_end = plane_start + 1;
-#else
-  const int num_planes = y_only ? 1 : MAX_MB_PLANE;
-  const int plane_start = 0;
-  const int plane_end = num_planes;
-#endif  // CONFIG_LOOPFILTER_LEVEL
+  int plane_start, plane_end;
 #if !CONFIG_LPF_SB
 #if CONFIG_PARALLEL_DEBLOCKING
   const int col_start = 0;
   const int col_end = cm->mi_cols;
 #endif
 #endif  // CONFIG_LPF_SB
+
+  av1_loop_filter_planes(y_only, &plane_start, &plane_end);
+
+#if !CONFIG_PARALLEL_DEBLOCKING
   int mi_row, mi_col;
   int plane;
 
-#if !CONFIG_PARALLEL_DEBLOCKING
   for (int i = 0; i < MAX_MB_PLANE; ++i)
     memset(cm->top_txfm_context[i], TX_32X32, cm->mi_cols << TX_UNIT_WIDE_LOG2);
   for (mi_row = start; mi_row < stop; mi_row += cm->mib_size) {
@@ -2576,26 +2729,10 @@ void av1_loop_filter_rows(YV12_BUFFER_CONFIG *frame_buffer, AV1_COMMON *cm,
     }
   }
 #else
-
-  // filter all vertical edges in every 64x64 super block
-  for (mi_row = start; mi_row < stop; mi_row += MAX_MIB_SIZE) {
-    for (mi_col = col_start; mi_col < col_end; mi_col += MAX_MIB_SIZE) {
-      av1_setup_dst_planes(planes, cm->sb_size, frame_buffer, mi_row, mi_col);
-      for (plane = plane_start; plane < plane_end; ++plane) {
-        av1_filter_block_plane_vert(cm, plane, &planes[plane], mi_row, mi_col);
-      }
-    }
-  }
-
-  // filter all horizontal edges in every 64x64 super block
-  for (mi_row = start; mi_row < stop; mi_row += MAX_MIB_SIZE) {
-    for (mi_col = col_start; mi_col < col_end; mi_col += MAX_MIB_SIZE) {
-      av1_setup_dst_planes(planes, cm->sb_size, frame_buffer, mi_row, mi_col);
-      for (plane = plane_start; plane < plane_end; ++plane) {
-        av1_filter_block_plane_horz(cm, plane, &planes[plane], mi_row, mi_col);
-      }
-    }
-  }
+  av1_loop_filter_ver_sb_range(frame_buffer, cm, planes, plane_start, plane_end,
+                               start, stop, col_start, col_end);
+  av1_loop_filter_hor_sb_range(frame_buffer, cm, planes, plane_start, plane_end,
+                               start, stop, col_start, col_end);
 #endif  // !CONFIG_PARALLEL_DEBLOCKING
 }
 
@@ -2698,6 +2835,59 @@ void av1_loop_filter_frame(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
 #endif
 }
 
+#if !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+void av1_loop_filter_frame_rows(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                                MACROBLOCKD *xd, int frame_filter_level,
+#if CONFIG_LOOPFILTER_LEVEL
+                                int frame_filter_level_r,
+#endif
+                                int y_only, int start, int stop) {
+  int plane_start, plane_end;
+#if CONFIG_EXT_DELTA_Q
+#if CONFIG_LOOPFILTER_LEVEL
+  int orig_filter_level[2] = { cm->lf.filter_level[0], cm->lf.filter_level[1] };
+#else
+  int orig_filter_level = cm->lf.filter_level;
+#endif
+#endif
+
+#if CONFIG_LOOPFILTER_LEVEL
+  if (!frame_filter_level && !frame_filter_level_r) return;
+  av1_loop_filter_frame_init(cm, frame_filter_level, frame_filter_level_r,
+                             y_only);
+#else
+  if (!frame_filter_level) return;
+  av1_loop_filter_frame_init(cm, frame_filter_level, frame_filter_level);
+#endif
+
+#if CONFIG_EXT_DELTA_Q
+#if CONFIG_LOOPFILTER_LEVEL
+  cm->lf.filter_level[0] = frame_filter_level;
+  cm->lf.filter_level[1] = frame_filter_level_r;
+#else
+  cm->lf.filter_level = frame_filter_level;
+#endif
+#endif
+
+  // Unlike av1_loop_filter_rows(), stop the edges at stop, so that the rows
+  // below can be filtered by a later call.
+  av1_loop_filter_planes(y_only, &plane_start, &plane_end);
+  loop_filter_ver_sb_range(frame, cm, xd->plane, plane_start, plane_end, start,
+                           stop, 0, cm->mi_cols, stop);
+  loop_filter_hor_sb_range(frame, cm, xd->plane, plane_start, plane_end, start,
+                           stop, 0, cm->mi_cols, stop);
+
+#if CONFIG_EXT_DELTA_Q
+#if CONFIG_LOOPFILTER_LEVEL
+  cm->lf.filter_level[0] = orig_filter_level[0];
+  cm->lf.filter_level[1] = orig_filter_level[1];
+#else
+  cm->lf.filter_level = orig_filter_level;
+#endif
+#endif
+}
+#endif  // !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+
 void av1_loop_filter_data_reset(LFWorkerData *lf_data,
                                 YV12_BUFFER_CONFIG *frame_buffer,
                                 struct AV1Common *cm,
@@ -2707,6 +2897,7 @@ void av1_loop_filter_data_reset(LFWorkerData *lf_data,
   lf_data->start = 0;
   lf_data->stop = 0;
   lf_data->y_only = 0;
+  lf_data->col_start = 0;
   memcpy(lf_data->planes, planes, sizeof(lf_data->planes));
 }
 
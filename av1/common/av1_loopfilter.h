@@ -172,8 +172,56 @@ void av1_loop_filter_rows(YV12_BUFFER_CONFIG *frame_buffer,
                           struct AV1Common *cm,
                           struct macroblockd_plane *planes, int start, int stop,
                           int y_only);
+
+#if CONFIG_PARALLEL_DEBLOCKING
+// Apply the loop filter to [start, stop) mi rows of frame. Edges of the rows
+// from stop down are left alone, so calling this for consecutive bands from the
+// top down filters the same pixels as av1_loop_filter_frame().
+void av1_loop_filter_frame_rows(YV12_BUFFER_CONFIG *frame,
+                                struct AV1Common *cm, struct macroblockd *mbd,
+                                int filter_level,
+#if CONFIG_LOOPFILTER_LEVEL
+                                int filter_level_r,
+#endif
+                                int y_only, int start, int stop);
+#endif  // CONFIG_PARALLEL_DEBLOCKING
 #endif  // CONFIG_LPF_SB
 
+// Get the planes [*plane_start, *plane_end) filtered for a y_only argument.
+static INLINE void av1_loop_filter_planes(int y_only, int *plane_start,
+                                          int *plane_end) {
+#if CONFIG_LOOPFILTER_LEVEL
+  // y_only no longer has its original meaning.
+  // Here it means which plane to filter
+  // when y_only = {0, 1, 2}, it means we are searching for filter level for
+  // Y/U/V plane individually.
+  *plane_start = y_only;
+  *plane_end = y_only + 1;
+#else
+  *plane_start = 0;
+  *plane_end = y_only ? 1 : MAX_MB_PLANE;
+#endif  // CONFIG_LOOPFILTER_LEVEL
+}
+
+#if CONFIG_PARALLEL_DEBLOCKING
+// Filter the vertical (ver) or horizontal (hor) edges of the planes
+// [plane_start, plane_end) in the superblocks at mi rows [start, stop) and mi
+// columns [col_start, col_end). All vertical edges of a frame are filtered
+// before its horizontal edges. Within a pass, superblock rows (ver) and
+// superblock columns (hor) do not touch each other's pixels and may be
+// filtered in any order.
+void av1_loop_filter_ver_sb_range(YV12_BUFFER_CONFIG *frame_buffer,
+                                  const struct AV1Common *cm,
+                                  struct macroblockd_plane *planes,
+                                  int plane_start, int plane_end, int start,
+                                  int stop, int col_start, int col_end);
+void av1_loop_filter_hor_sb_range(YV12_BUFFER_CONFIG *frame_buffer,
+                                  const struct AV1Common *cm,
+                                  struct macroblockd_plane *planes,
+                                  int plane_start, int plane_end, int start,
+                                  int stop, int col_start, int col_end);
+#endif  // CONFIG_PARALLEL_DEBLOCKING
+
 typedef struct LoopFilterWorkerData {
   YV12_BUFFER_CONFIG *frame_buffer;
   struct AV1Common *cm;
@@ -182,6 +230,8 @@ typedef struct LoopFilterWorkerData {
   int start;
   int stop;
   int y_only;
+  // First mi column filtered by a horizontal edge worker.
+  int col_start;
 } LFWorkerData;
 
 void av1_loop_filter_data_reset(LFWorkerData *lf_data,
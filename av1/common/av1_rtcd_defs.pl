@@ -483,6 +483,11 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
   add_proto qw/void av1_wedge_compute_delta_squares/, "int16_t *d, const int16_t *a, const int16_t *b, int N";
   specialize qw/av1_wedge_compute_delta_squares sse2/;
 
+  add_proto qw/void av1_nn_fc_layer/, "const float *input, int num_inputs, const float *weights, const float *bias, int num_outputs, int apply_relu, float *output";
+  specialize qw/av1_nn_fc_layer sse2 avx2/;
+  add_proto qw/void av1_nn_fc_layer_batch/, "const float *input, int num_samples, int num_inputs, const float *weights, const float *bias, int num_outputs, int apply_relu, float *output";
+  specialize qw/av1_nn_fc_layer_batch sse2 avx2/;
+
 }
 # end encoder functions
 
@@ -568,10 +573,10 @@ if (aom_config("CONFIG_AV1_ENCODER") eq "yes") {
 
 if (aom_config("CONFIG_LOOP_RESTORATION") eq "yes") {
   add_proto qw/void apply_selfguided_restoration/, "const uint8_t *dat, int width, int height, int stride, int eps, const int *xqd, uint8_t *dst, int dst_stride, int32_t *tmpbuf, int bit_depth, int highbd";
-  specialize qw/apply_selfguided_restoration sse4_1/;
+  specialize qw/apply_selfguided_restoration sse4_1 avx2/;
 
   add_proto qw/void av1_selfguided_restoration/, "const uint8_t *dgd, int width, int height, int stride, int32_t *flt1, int32_t *flt2, int flt_stride, const sgr_params_type *params, int bit_depth, int highbd";
-  specialize qw/av1_selfguided_restoration sse4_1/;
+  specialize qw/av1_selfguided_restoration sse4_1 avx2/;
 }
 
 # CONVOLVE_ROUND/COMPOUND_ROUND functions
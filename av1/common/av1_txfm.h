@@ -266,6 +266,16 @@ void av1_get_fwd_txfm_cfg(TX_TYPE tx_type, TX_SIZE tx_size,
                           TXFM_2D_FLIP_CFG *cfg);
 void av1_get_inv_txfm_cfg(TX_TYPE tx_type, TX_SIZE tx_size,
                           TXFM_2D_FLIP_CFG *cfg);
+
+// Inverse transform and add for blocks whose nonzero coefficients all lie in
+// the top-left nz_rows x nz_cols corner. Sizes up to 32x32 only.
+void av1_inv_txfm2d_add_partial(const int32_t *input, uint16_t *output,
+                                int stride, TX_TYPE tx_type, TX_SIZE tx_size,
+                                int nz_rows, int nz_cols, int bd);
+
+// Returns the residual that the inverse DCT_DCT of a block whose only nonzero
+// coefficient is dc adds to every pixel. Sizes up to 32x32 only.
+int32_t av1_inv_txfm2d_dc_residual(int32_t dc, TX_SIZE tx_size, int bd);
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
@@ -24,7 +24,7 @@ PREDICTION_MODE av1_left_block_mode(const MODE_INFO *cur_mi,
     return get_y_mode(left_mi, b + 1);
   } else {
     assert(b == 1 || b == 3);
-    return cur_mi->bmi[b - 1].as_mode;
+    return get_y_mode(cur_mi, b - 1);
   }
 }
 
@@ -36,7 +36,7 @@ PREDICTION_MODE av1_above_block_mode(const MODE_INFO *cur_mi,
     return get_y_mode(above_mi, b + 2);
   } else {
     assert(b == 2 || b == 3);
-    return cur_mi->bmi[b - 2].as_mode;
+    return get_y_mode(cur_mi, b - 2);
   }
 }
 
@@ -174,17 +174,6 @@ static INLINE int is_masked_compound_type(COMPOUND_TYPE type) {
   return (type == COMPOUND_WEDGE || type == COMPOUND_SEG);
 }
 
-/* For keyframes, intra block modes are predicted by the (already decoded)
-   modes for the Y blocks to the left and above us; for interframes, there
-   is a single probability table. */
-
-typedef struct {
-  PREDICTION_MODE as_mode;
-  int_mv as_mv[2];  // first, second inter predictor motion vectors
-  int_mv pred_mv[2];
-  int_mv ref_mv[2];
-} b_mode_info;
-
 typedef int8_t MV_REFERENCE_FRAME;
 
 typedef struct {
@@ -269,9 +258,8 @@ typedef struct MB_MODE_INFO {
   BLOCK_SIZE sb_type;
   PREDICTION_MODE mode;
   TX_SIZE tx_size;
-  // TODO(jingning): This effectively assigned a separate entry for each
-  // 8x8 block. Apparently it takes much more space than needed.
-  TX_SIZE inter_tx_size[MAX_MIB_SIZE][MAX_MIB_SIZE];
+  // Transform size of each 8x8 unit of an inter block.
+  TX_SIZE inter_tx_size[INTER_TX_SIZE_BUF_LEN][INTER_TX_SIZE_BUF_LEN];
   TX_SIZE min_tx_size;
   int8_t skip;
 #if CONFIG_EXT_SKIP
@@ -307,19 +295,19 @@ typedef struct MB_MODE_INFO {
   // interintra members
   INTERINTRA_MODE interintra_mode;
   // TODO(debargha): Consolidate these flags
-  int use_wedge_interintra;
-  int interintra_wedge_index;
-  int interintra_wedge_sign;
+  int8_t use_wedge_interintra;
+  int8_t interintra_wedge_index;
+  int8_t interintra_wedge_sign;
   // interinter members
   COMPOUND_TYPE interinter_compound_type;
-  int wedge_index;
-  int wedge_sign;
+  int8_t wedge_index;
+  int8_t wedge_sign;
   SEG_MASK_TYPE mask_type;
   MOTION_MODE motion_mode;
 #if CONFIG_EXT_WARPED_MOTION
-  int wm_ctx;
+  int8_t wm_ctx;
 #endif  // CONFIG_EXT_WARPED_MOTION
-  int overlappable_neighbors[2];
+  uint8_t overlappable_neighbors[2];
   int_mv mv[2];
   int_mv pred_mv[2];
   uint8_t ref_mv_idx;
@@ -332,11 +320,11 @@ typedef struct MB_MODE_INFO {
 #endif  // CONFIG_NEW_QUANT
   /* deringing gain *per-superblock* */
   int8_t cdef_strength;
-  int current_q_index;
+  uint8_t current_q_index;
 #if CONFIG_EXT_DELTA_Q
-  int current_delta_lf_from_base;
+  int8_t current_delta_lf_from_base;
 #if CONFIG_LOOPFILTER_LEVEL
-  int curr_delta_lf[FRAME_LF_COUNT];
+  int8_t curr_delta_lf[FRAME_LF_COUNT];
 #endif  // CONFIG_LOOPFILTER_LEVEL
 #endif
 #if CONFIG_RD_DEBUG
@@ -344,14 +332,14 @@ typedef struct MB_MODE_INFO {
   int mi_row;
   int mi_col;
 #endif
-  int num_proj_ref[2];
+  uint8_t num_proj_ref[2];
   WarpedMotionParams wm_params[2];
 
 #if CONFIG_CFL
   // Index of the alpha Cb and alpha Cr combination
-  int cfl_alpha_idx;
+  uint8_t cfl_alpha_idx;
   // Joint sign of alpha Cb and alpha Cr
-  int cfl_alpha_signs;
+  int8_t cfl_alpha_signs;
 #endif
 
   BOUNDARY_TYPE boundary_info;
@@ -370,7 +358,6 @@ typedef struct MB_MODE_INFO {
 
 typedef struct MODE_INFO {
   MB_MODE_INFO mbmi;
-  b_mode_info bmi[4];
 } MODE_INFO;
 
 #if CONFIG_INTRABC
@@ -715,6 +702,9 @@ typedef struct macroblockd {
 #if CONFIG_JNT_COMP
   JNT_COMP_PARAMS jcp_param;
 #endif
+
+  // Set by the encoder while it searches the intra modes of a block.
+  struct intra_pred_cache *intra_pred_cache;
 } MACROBLOCKD;
 
 static INLINE int get_bitdepth_data_path_index(const MACROBLOCKD *xd) {
@@ -46,6 +46,29 @@ int sb_compute_cdef_list(const AV1_COMMON *const cm, int mi_row, int mi_col,
 #endif
 void av1_cdef_frame(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm, MACROBLOCKD *xd);
 
+// Pixels kept by av1_cdef_fb_row() from one row of 64x64 blocks to the next:
+// the deblocked lines below each row and the columns right of each block, and
+// which blocks of the previous row were filtered.
+typedef struct {
+  uint16_t *linebuf[3];
+  uint16_t *colbuf[3];
+  unsigned char *row_cdef;
+  unsigned char *prev_row_cdef;
+  unsigned char *curr_row_cdef;
+  int nplanes;
+} CdefRowBuffers;
+
+void av1_cdef_alloc_row_buffers(CdefRowBuffers *bufs, const AV1_COMMON *cm,
+                                const MACROBLOCKD *xd);
+void av1_cdef_free_row_buffers(CdefRowBuffers *bufs);
+
+// Applies CDEF to row fbr of 64x64 blocks. Calling it for every row from the
+// top down with the same bufs is the same as av1_cdef_frame(). The deblocked
+// pixels of the row and of the CDEF_VBORDER lines below it must be final, and
+// the rows below must not have been filtered yet.
+void av1_cdef_fb_row(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
+                     MACROBLOCKD *xd, CdefRowBuffers *bufs, int fbr);
+
 void av1_cdef_search(YV12_BUFFER_CONFIG *frame, const YV12_BUFFER_CONFIG *ref,
                      AV1_COMMON *cm, MACROBLOCKD *xd, int fast);
 
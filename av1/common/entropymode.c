@@ -3205,25 +3205,118 @@ static void set_default_lf_deltas(struct loopfilter *lf) {
   av1_copy(lf->last_mode_deltas, lf->mode_deltas);
 }
 
-void av1_setup_frame_contexts(AV1_COMMON *cm) {
+// Returns the index of an unreferenced pool buffer, allocating it if needed.
+static int get_free_fc_buf(AV1_COMMON *cm) {
+  int i;
+  for (i = 0; i < FRAME_CONTEXTS; ++i)
+    if (cm->fc_pool_refs[i] == 0 && cm->fc_pool[i] != NULL) return i;
+  for (i = 0; i < FRAME_CONTEXTS; ++i) {
+    if (cm->fc_pool_refs[i] == 0) {
+      cm->fc_pool[i] =
+          (FRAME_CONTEXT *)aom_memalign(32, sizeof(*cm->fc_pool[i]));
+      if (!cm->fc_pool[i]) {
+        aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                           "Failed to allocate frame context");
+        return -1;
+      }
+      return i;
+    }
+  }
+  // Fewer buffers than slots can be referenced when a slot is shared.
+  assert(0);
+  return -1;
+}
+
+void av1_store_frame_context(AV1_COMMON *cm, int idx,
+                             const FRAME_CONTEXT *fc) {
+  int buf = cm->frame_context_buf[idx];
+  if (cm->fc_pool_refs[buf] > 1) {
+    const int new_buf = get_free_fc_buf(cm);
+    if (new_buf < 0) return;
+    --cm->fc_pool_refs[buf];
+    buf = new_buf;
+    cm->fc_pool_refs[buf] = 1;
+    cm->frame_context_buf[idx] = buf;
+    // The other slots keep the shared buffer, and so does pre_fc unless it
+    // refers to slot idx.
+    if (cm->pre_fc_slot == idx) cm->pre_fc = cm->fc_pool[buf];
+  }
+  assert(cm->pre_fc_slot < 0 ||
+         cm->pre_fc == get_frame_context(cm, cm->pre_fc_slot));
+  *cm->fc_pool[buf] = *fc;
+}
+
+// Frees the pool buffers no slot refers to.
+static void free_unused_fc_bufs(AV1_COMMON *cm) {
+  int i;
+  for (i = 0; i < FRAME_CONTEXTS; ++i) {
+    if (cm->fc_pool_refs[i] == 0) {
+      aom_free(cm->fc_pool[i]);
+      cm->fc_pool[i] = NULL;
+    }
+  }
+}
+
+// Points every slot to a single copy of fc, and frees the other buffers.
+static void reset_frame_contexts(AV1_COMMON *cm, const FRAME_CONTEXT *fc) {
+  int buf = -1;
   int i;
+  for (i = 0; i < FRAME_CONTEXTS; ++i) {
+    if (buf < 0 && cm->fc_pool[i] != NULL) buf = i;
+    cm->fc_pool_refs[i] = 0;
+  }
+  if (buf < 0) buf = get_free_fc_buf(cm);
+  if (buf < 0) return;
+  *cm->fc_pool[buf] = *fc;
+  for (i = 0; i < FRAME_CONTEXTS; ++i) cm->frame_context_buf[i] = buf;
+  cm->fc_pool_refs[buf] = FRAME_CONTEXTS;
+  free_unused_fc_bufs(cm);
+  if (cm->pre_fc_slot >= 0) cm->pre_fc = cm->fc_pool[buf];
+}
+
+void av1_copy_frame_contexts(AV1_COMMON *dst, const AV1_COMMON *src) {
+  int i;
+  // Mirror the sharing of src so that only distinct contexts are copied.
+  for (i = 0; i < FRAME_CONTEXTS; ++i) {
+    dst->fc_pool_refs[i] = src->fc_pool_refs[i];
+    dst->frame_context_buf[i] = src->frame_context_buf[i];
+  }
+  for (i = 0; i < FRAME_CONTEXTS; ++i) {
+    if (src->fc_pool_refs[i] == 0) continue;
+    if (!dst->fc_pool[i]) {
+      dst->fc_pool[i] =
+          (FRAME_CONTEXT *)aom_memalign(32, sizeof(*dst->fc_pool[i]));
+      if (!dst->fc_pool[i]) {
+        aom_internal_error(&dst->error, AOM_CODEC_MEM_ERROR,
+                           "Failed to allocate frame context");
+        return;
+      }
+    }
+    *dst->fc_pool[i] = *src->fc_pool[i];
+  }
+  free_unused_fc_bufs(dst);
+  if (dst->pre_fc_slot >= 0)
+    dst->pre_fc = get_frame_context(dst, dst->pre_fc_slot);
+}
+
+void av1_setup_frame_contexts(AV1_COMMON *cm) {
 #if CONFIG_NO_FRAME_CONTEXT_SIGNALING
   if (cm->frame_type == KEY_FRAME) {
     // Reset all frame contexts, as all reference frames will be lost.
-    for (i = 0; i < FRAME_CONTEXTS; ++i) cm->frame_contexts[i] = *cm->fc;
+    reset_frame_contexts(cm, cm->fc);
   } else if (frame_is_intra_only(cm) || cm->error_resilient_mode) {
     // Store the frame context into a special slot (not associated with any
     // reference buffer), so that we can set up cm->pre_fc correctly later
-    cm->frame_contexts[FRAME_CONTEXT_DEFAULTS] = *cm->fc;
+    av1_store_frame_context(cm, FRAME_CONTEXT_DEFAULTS, cm->fc);
   }
 #else
   if (cm->frame_type == KEY_FRAME || cm->error_resilient_mode ||
       cm->reset_frame_context == RESET_FRAME_CONTEXT_ALL) {
     // Reset all frame contexts.
-    for (i = 0; i < FRAME_CONTEXTS; ++i) cm->frame_contexts[i] = *cm->fc;
+    reset_frame_contexts(cm, cm->fc);
   } else if (cm->reset_frame_context == RESET_FRAME_CONTEXT_CURRENT) {
     // Reset only the frame context specified in the frame header.
-    cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+    av1_store_frame_context(cm, cm->frame_context_idx, cm->fc);
   }
 #endif  // CONFIG_NO_FRAME_CONTEXT_SIGNALING
 }
@@ -530,6 +530,12 @@ extern const aom_tree_index av1_compound_type_tree[TREE_SIZE(COMPOUND_TYPES)];
 extern const aom_tree_index av1_motion_mode_tree[TREE_SIZE(MOTION_MODES)];
 
 void av1_setup_frame_contexts(struct AV1Common *cm);
+// Saves fc into frame context slot idx, unsharing the slot's buffer first.
+void av1_store_frame_context(struct AV1Common *cm, int idx,
+                             const FRAME_CONTEXT *fc);
+// Copies the saved frame contexts of src into dst.
+void av1_copy_frame_contexts(struct AV1Common *dst,
+                             const struct AV1Common *src);
 void av1_setup_past_independence(struct AV1Common *cm);
 
 void av1_adapt_intra_frame_probs(struct AV1Common *cm);
@@ -50,6 +50,9 @@ extern "C" {
 // Mask to extract MI offset within max MIB
 #define MAX_MIB_MASK (MAX_MIB_SIZE - 1)
 
+// Inter transform sizes are stored per 8x8 unit of a max superblock
+#define INTER_TX_SIZE_BUF_LEN (MAX_MIB_SIZE >> 1)
+
 // Maximum number of tile rows and tile columns
 #if CONFIG_EXT_TILE
 #define MAX_TILE_ROWS 1024
@@ -19,6 +19,7 @@
 #include "av1/common/blockd.h"
 #include "av1/common/enums.h"
 #include "av1/common/idct.h"
+#include "av1/common/scan.h"
 #if CONFIG_DAALA_TX4 || CONFIG_DAALA_TX8 || CONFIG_DAALA_TX16 || \
     CONFIG_DAALA_TX32 || CONFIG_DAALA_TX64
 #include "av1/common/daala_tx.h"
@@ -2525,6 +2526,89 @@ static InvTxfmFunc inv_txfm_func[2] = {
   av1_highbd_inv_txfm_add,
 };
 
+#if !CONFIG_DAALA_TX
+// A DC-only DCT_DCT block adds the same residual to every pixel, so it needs
+// neither the 2D transform nor, for low bitdepth, the copy through a 16-bit
+// buffer. Without CONFIG_TXMG low bitdepth blocks keep their own DC kernels.
+static int is_dc_only_dct(const TxfmParam *txfm_param) {
+  return txfm_param->eob == 1 && txfm_param->tx_type == DCT_DCT &&
+         !txfm_param->lossless && (txfm_param->is_hbd || CONFIG_TXMG) &&
+         tx_size_wide[txfm_param->tx_size] <= 32 &&
+         tx_size_high[txfm_param->tx_size] <= 32;
+}
+
+static void inv_txfm_dc_add(tran_low_t dc, uint8_t *dst, int stride,
+                            const TxfmParam *txfm_param) {
+  const int w = tx_size_wide[txfm_param->tx_size];
+  const int h = tx_size_high[txfm_param->tx_size];
+  const int bd = txfm_param->bd;
+  const int32_t residual =
+      av1_inv_txfm2d_dc_residual(dc, txfm_param->tx_size, bd);
+  if (txfm_param->is_hbd) {
+    uint16_t *dst16 = CONVERT_TO_SHORTPTR(dst);
+    for (int r = 0; r < h; ++r, dst16 += stride)
+      for (int c = 0; c < w; ++c)
+        dst16[c] = highbd_clip_pixel_add(dst16[c], residual, bd);
+  } else {
+    for (int r = 0; r < h; ++r, dst += stride)
+      for (int c = 0; c < w; ++c)
+        dst[c] = (uint8_t)highbd_clip_pixel_add(dst[c], residual, bd);
+  }
+}
+
+#if !CONFIG_ADAPT_SCAN
+// The full square DCT and ADST kernels have SIMD versions that are faster than
+// the sparse C path.
+static int has_simd_inv_txfm2d(TX_SIZE tx_size, TX_TYPE tx_type) {
+  if (tx_size == TX_32X32) return HAVE_AVX2 && tx_type == DCT_DCT;
+  return HAVE_SSE4_1 && tx_size <= TX_16X16 && tx_type < IDTX;
+}
+
+// With few enough coefficients, the scan order bounds the top-left corner they
+// lie in, and only the rows of that corner need a first pass transform. Wide
+// blocks are transformed on their transpose, where the columns become rows.
+static int inv_txfm_partial_add(const MACROBLOCKD *xd,
+                                const tran_low_t *dqcoeff, uint8_t *dst,
+                                int stride, const TxfmParam *txfm_param) {
+  const TX_SIZE tx_size = txfm_param->tx_size;
+  const int w = tx_size_wide[tx_size];
+  const int h = tx_size_high[tx_size];
+  if (txfm_param->lossless || !(txfm_param->is_hbd || CONFIG_TXMG) ||
+      w * h < 64 || w > 32 || h > 32 || txfm_param->eob > (w * h) >> 2 ||
+      has_simd_inv_txfm2d(tx_size, txfm_param->tx_type))
+    return 0;
+
+  const SCAN_ORDER *const sc = get_default_scan(
+      tx_size, txfm_param->tx_type, is_inter_block(&xd->mi[0]->mbmi));
+  const int bwl = tx_size_wide_log2[tx_size];
+  int max_row = 0, max_col = 0;
+  for (int i = 0; i < txfm_param->eob; ++i) {
+    max_row = AOMMAX(max_row, sc->scan[i] >> bwl);
+    max_col = AOMMAX(max_col, sc->scan[i] & (w - 1));
+  }
+  const int nz_rows = max_row + 1;
+  const int nz_cols = max_col + 1;
+  if ((CONFIG_TXMG && w > h) ? nz_cols == w : nz_rows == h) return 0;
+
+  const int32_t *src = cast_to_int32(dqcoeff);
+  if (txfm_param->is_hbd) {
+    av1_inv_txfm2d_add_partial(src, CONVERT_TO_SHORTPTR(dst), stride,
+                               txfm_param->tx_type, tx_size, nz_rows, nz_cols,
+                               txfm_param->bd);
+  } else {
+    DECLARE_ALIGNED(16, uint16_t, tmp[32 * 32]);
+    for (int r = 0; r < h; ++r)
+      for (int c = 0; c < w; ++c) tmp[r * w + c] = dst[r * stride + c];
+    av1_inv_txfm2d_add_partial(src, tmp, w, txfm_param->tx_type, tx_size,
+                               nz_rows, nz_cols, txfm_param->bd);
+    for (int r = 0; r < h; ++r)
+      for (int c = 0; c < w; ++c) dst[r * stride + c] = (uint8_t)tmp[r * w + c];
+  }
+  return 1;
+}
+#endif  // !CONFIG_ADAPT_SCAN
+#endif  // !CONFIG_DAALA_TX
+
 void av1_inverse_transform_block(const MACROBLOCKD *xd,
                                  const tran_low_t *dqcoeff, int plane,
                                  TX_TYPE tx_type, TX_SIZE tx_size, uint8_t *dst,
@@ -2537,6 +2621,15 @@ void av1_inverse_transform_block(const MACROBLOCKD *xd,
   init_txfm_param(xd, plane, tx_size, tx_type, eob, reduced_tx_set,
                   &txfm_param);
   assert(av1_ext_tx_used[txfm_param.tx_set_type][txfm_param.tx_type]);
+#if !CONFIG_DAALA_TX
+  if (is_dc_only_dct(&txfm_param)) {
+    inv_txfm_dc_add(dqcoeff[0], dst, stride, &txfm_param);
+    return;
+  }
+#if !CONFIG_ADAPT_SCAN
+  if (inv_txfm_partial_add(xd, dqcoeff, dst, stride, &txfm_param)) return;
+#endif  // !CONFIG_ADAPT_SCAN
+#endif  // !CONFIG_DAALA_TX
   inv_txfm_func[txfm_param.is_hbd](dqcoeff, dst, stride, &txfm_param);
 }
 
@@ -163,6 +163,9 @@ typedef struct {
 #if CONFIG_TEMPMV_SIGNALING
   uint8_t intra_only;
 #endif
+  // Luma area the decoder reconstructed the same as a full decode would, see
+  // AV1D_GET_VALID_REGION.
+  AV1PixelRect valid_rect;
   // The Following variables will only be used in frame parallel decode.
 
   // frame_worker_owner indicates which FrameWorker owns this buffer. NULL means
@@ -442,9 +445,17 @@ typedef struct AV1Common {
   MV_REFERENCE_FRAME comp_bwd_ref[BWD_REFS];
   REFERENCE_MODE reference_mode;
 
-  FRAME_CONTEXT *fc;              /* this frame entropy */
-  FRAME_CONTEXT *frame_contexts;  // FRAME_CONTEXTS
-  FRAME_CONTEXT *pre_fc;          // Context referenced in this frame
+  FRAME_CONTEXT *fc; /* this frame entropy */
+  // Saved frame contexts. Each of the FRAME_CONTEXTS slots refers to a
+  // buffer of fc_pool, and slots holding the same contexts share one buffer.
+  // A shared buffer is only copied when one of its slots is written, see
+  // av1_store_frame_context(). Pool buffers are allocated on first use and
+  // freed once no slot refers to them.
+  FRAME_CONTEXT *fc_pool[FRAME_CONTEXTS];
+  int fc_pool_refs[FRAME_CONTEXTS];
+  int frame_context_buf[FRAME_CONTEXTS];
+  FRAME_CONTEXT *pre_fc;  // Context referenced in this frame
+  int pre_fc_slot;        // Slot pre_fc refers to, or -1
 #if !CONFIG_NO_FRAME_CONTEXT_SIGNALING
   unsigned int frame_context_idx; /* Context to use/update */
 #endif
@@ -620,6 +631,26 @@ static INLINE YV12_BUFFER_CONFIG *get_frame_new_buffer(
   return &cm->buffer_pool->frame_bufs[cm->new_fb_idx].buf;
 }
 
+// Returns the saved frame context of slot idx. The buffer may be shared with
+// other slots, so it must only be written through av1_store_frame_context().
+static INLINE FRAME_CONTEXT *get_frame_context(const AV1_COMMON *cm, int idx) {
+  return cm->fc_pool[cm->frame_context_buf[idx]];
+}
+
+// Makes pre_fc refer to the saved frame context of slot idx. pre_fc keeps
+// following the slot when the slot is written or the contexts are reset.
+static INLINE void set_pre_frame_context(AV1_COMMON *cm, int idx) {
+  cm->pre_fc = get_frame_context(cm, idx);
+  cm->pre_fc_slot = idx;
+}
+
+// Loads the saved frame context of slot idx into cm->fc, and makes pre_fc
+// refer to it.
+static INLINE void load_frame_context(AV1_COMMON *cm, int idx) {
+  set_pre_frame_context(cm, idx);
+  *cm->fc = *cm->pre_fc;
+}
+
 static INLINE int get_free_fb(AV1_COMMON *cm) {
   RefCntBuffer *const frame_bufs = cm->buffer_pool->frame_bufs;
   int i;
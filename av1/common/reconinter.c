@@ -1463,14 +1463,14 @@ const uint8_t *av1_get_obmc_mask(int length) {
   }
 }
 
-static INLINE void increment_int_ptr(MACROBLOCKD *xd, int rel_mi_rc,
-                                     uint8_t mi_hw, MODE_INFO *mi,
-                                     void *fun_ctxt) {
+static INLINE void increment_uint8_ptr(MACROBLOCKD *xd, int rel_mi_rc,
+                                       uint8_t mi_hw, MODE_INFO *mi,
+                                       void *fun_ctxt) {
   (void)xd;
   (void)rel_mi_rc;
   (void)mi_hw;
   (void)mi;
-  ++*(int *)fun_ctxt;
+  ++*(uint8_t *)fun_ctxt;
 }
 
 void av1_count_overlappable_neighbors(const AV1_COMMON *cm, MACROBLOCKD *xd,
@@ -1482,9 +1482,9 @@ void av1_count_overlappable_neighbors(const AV1_COMMON *cm, MACROBLOCKD *xd,
 
   if (!is_motion_variation_allowed_bsize(mbmi->sb_type)) return;
 
-  foreach_overlappable_nb_above(cm, xd, mi_col, INT_MAX, increment_int_ptr,
+  foreach_overlappable_nb_above(cm, xd, mi_col, INT_MAX, increment_uint8_ptr,
                                 &mbmi->overlappable_neighbors[0]);
-  foreach_overlappable_nb_left(cm, xd, mi_row, INT_MAX, increment_int_ptr,
+  foreach_overlappable_nb_left(cm, xd, mi_row, INT_MAX, increment_uint8_ptr,
                                &mbmi->overlappable_neighbors[1]);
 }
 
@@ -2164,9 +2164,7 @@ static void build_inter_predictors_single_buf(MACROBLOCKD *xd, int plane,
 #else
   uint8_t *const dst = ext_dst + ext_dst_stride * y + x;
 #endif
-  const MV mv = mi->mbmi.sb_type < BLOCK_8X8
-                    ? average_split_mvs(pd, mi, ref, block)
-                    : mi->mbmi.mv[ref].as_mv;
+  const MV mv = mi->mbmi.mv[ref].as_mv;
 
   uint8_t *pre;
   int xs, ys, subpel_x, subpel_y;
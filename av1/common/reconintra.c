@@ -2073,12 +2073,12 @@ void av1_upsample_intra_edge_high_c(uint16_t *p, int sz, int bd) {
 
 #if CONFIG_HIGHBITDEPTH
 static void build_intra_predictors_high(
-    const MACROBLOCKD *xd, const uint8_t *ref8, int ref_stride, uint8_t *dst8,
-    int dst_stride, PREDICTION_MODE mode, TX_SIZE tx_size, int n_top_px,
-    int n_topright_px, int n_left_px, int n_bottomleft_px, int plane) {
+    const MACROBLOCKD *xd, const uint8_t *above_ref8, const uint8_t *left_ref8,
+    int left_stride, uint8_t *dst8, int dst_stride, PREDICTION_MODE mode,
+    TX_SIZE tx_size, int n_top_px, int n_topright_px, int n_left_px,
+    int n_bottomleft_px, int plane) {
   int i;
   uint16_t *dst = CONVERT_TO_SHORTPTR(dst8);
-  uint16_t *ref = CONVERT_TO_SHORTPTR(ref8);
   DECLARE_ALIGNED(16, uint16_t, left_data[MAX_TX_SIZE * 2 + 32]);
   DECLARE_ALIGNED(16, uint16_t, above_data[MAX_TX_SIZE * 2 + 32]);
   uint16_t *const above_row = above_data + 16;
@@ -2088,8 +2088,8 @@ static void build_intra_predictors_high(
   int need_left = extend_modes[mode] & NEED_LEFT;
   int need_above = extend_modes[mode] & NEED_ABOVE;
   int need_above_left = extend_modes[mode] & NEED_ABOVELEFT;
-  const uint16_t *above_ref = ref - ref_stride;
-  const uint16_t *left_ref = ref - 1;
+  const uint16_t *above_ref = CONVERT_TO_SHORTPTR(above_ref8);
+  const uint16_t *left_ref = CONVERT_TO_SHORTPTR(left_ref8);
 #if CONFIG_EXT_INTRA
   int p_angle = 0;
   const int is_dr_mode = av1_is_directional_mode(mode, xd->mi[0]->mbmi.sb_type);
@@ -2167,11 +2167,11 @@ static void build_intra_predictors_high(
     const int num_left_pixels_needed = txhpx + (need_bottom ? txwpx : 0);
     i = 0;
     if (n_left_px > 0) {
-      for (; i < n_left_px; i++) left_col[i] = left_ref[i * ref_stride];
+      for (; i < n_left_px; i++) left_col[i] = left_ref[i * left_stride];
       if (need_bottom && n_bottomleft_px > 0) {
         assert(i == txhpx);
         for (; i < txhpx + n_bottomleft_px; i++)
-          left_col[i] = left_ref[i * ref_stride];
+          left_col[i] = left_ref[i * left_stride];
       }
       if (i < num_left_pixels_needed)
         aom_memset16(&left_col[i], left_col[i - 1], num_left_pixels_needed - i);
@@ -2315,15 +2315,15 @@ static void build_intra_predictors_high(
 }
 #endif  // CONFIG_HIGHBITDEPTH
 
-static void build_intra_predictors(const MACROBLOCKD *xd, const uint8_t *ref,
-                                   int ref_stride, uint8_t *dst, int dst_stride,
+static void build_intra_predictors(const MACROBLOCKD *xd,
+                                   const uint8_t *above_ref,
+                                   const uint8_t *left_ref, int left_stride,
+                                   uint8_t *dst, int dst_stride,
                                    PREDICTION_MODE mode, TX_SIZE tx_size,
                                    int n_top_px, int n_topright_px,
                                    int n_left_px, int n_bottomleft_px,
                                    int plane) {
   int i;
-  const uint8_t *above_ref = ref - ref_stride;
-  const uint8_t *left_ref = ref - 1;
   DECLARE_ALIGNED(16, uint8_t, left_data[MAX_TX_SIZE * 2 + 32]);
   DECLARE_ALIGNED(16, uint8_t, above_data[MAX_TX_SIZE * 2 + 32]);
   uint8_t *const above_row = above_data + 16;
@@ -2412,11 +2412,11 @@ static void build_intra_predictors(const MACROBLOCKD *xd, const uint8_t *ref,
     const int num_left_pixels_needed = txhpx + (need_bottom ? txwpx : 0);
     i = 0;
     if (n_left_px > 0) {
-      for (; i < n_left_px; i++) left_col[i] = left_ref[i * ref_stride];
+      for (; i < n_left_px; i++) left_col[i] = left_ref[i * left_stride];
       if (need_bottom && n_bottomleft_px > 0) {
         assert(i == txhpx);
         for (; i < txhpx + n_bottomleft_px; i++)
-          left_col[i] = left_ref[i * ref_stride];
+          left_col[i] = left_ref[i * left_stride];
       }
       if (i < num_left_pixels_needed)
         memset(&left_col[i], left_col[i - 1], num_left_pixels_needed - i);
@@ -2556,6 +2556,94 @@ static void build_intra_predictors(const MACROBLOCKD *xd, const uint8_t *ref,
   }
 }
 
+void av1_reset_intra_pred_cache(INTRA_PRED_CACHE *cache) {
+  int plane, tx_size;
+  for (plane = 0; plane < MAX_MB_PLANE; ++plane)
+    for (tx_size = 0; tx_size < TX_SIZES_ALL; ++tx_size)
+      cache->edges[plane][tx_size].valid = 0;
+  cache->pred_valid = 0;
+}
+
+// Gathers the neighbours of the top-left transform block of a block into
+// edge. Returns 1 if edge already held them.
+static int load_intra_edges(const MACROBLOCKD *xd, INTRA_EDGE_BUFFER *edge,
+                            const uint8_t *ref, int ref_stride,
+                            TX_SIZE tx_size, int n_top_px, int n_topright_px,
+                            int n_left_px, int n_bottomleft_px) {
+  const int txwpx = tx_size_wide[tx_size];
+  const int txhpx = tx_size_high[tx_size];
+  int i;
+
+  if (edge->valid && edge->ref == ref && edge->n_top_px == n_top_px &&
+      edge->n_topright_px == n_topright_px && edge->n_left_px == n_left_px &&
+      edge->n_bottomleft_px == n_bottomleft_px)
+    return 1;
+
+  edge->valid = 1;
+  edge->ref = ref;
+  edge->n_top_px = n_top_px;
+  edge->n_topright_px = n_topright_px;
+  edge->n_left_px = n_left_px;
+  edge->n_bottomleft_px = n_bottomleft_px;
+
+#if CONFIG_HIGHBITDEPTH
+  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    const uint16_t *const above_ref = CONVERT_TO_SHORTPTR(ref) - ref_stride;
+    const uint16_t *const left_ref = CONVERT_TO_SHORTPTR(ref) - 1;
+    if (n_top_px > 0) {
+      memcpy(edge->above + 1, above_ref, n_top_px * sizeof(*above_ref));
+      memcpy(edge->above + 1 + txwpx, above_ref + txwpx,
+             n_topright_px * sizeof(*above_ref));
+      if (n_left_px > 0) edge->above[0] = above_ref[-1];
+    }
+    if (n_left_px > 0) {
+      for (i = 0; i < n_left_px; ++i) edge->left[i] = left_ref[i * ref_stride];
+      for (i = txhpx; i < txhpx + n_bottomleft_px; ++i)
+        edge->left[i] = left_ref[i * ref_stride];
+    }
+    return 0;
+  }
+#else
+  (void)xd;
+#endif  // CONFIG_HIGHBITDEPTH
+  {
+    const uint8_t *const above_ref = ref - ref_stride;
+    const uint8_t *const left_ref = ref - 1;
+    uint8_t *const above = (uint8_t *)edge->above;
+    uint8_t *const left = (uint8_t *)edge->left;
+    if (n_top_px > 0) {
+      memcpy(above + 1, above_ref, n_top_px);
+      memcpy(above + 1 + txwpx, above_ref + txwpx, n_topright_px);
+      if (n_left_px > 0) above[0] = above_ref[-1];
+    }
+    if (n_left_px > 0) {
+      for (i = 0; i < n_left_px; ++i) left[i] = left_ref[i * ref_stride];
+      for (i = txhpx; i < txhpx + n_bottomleft_px; ++i)
+        left[i] = left_ref[i * ref_stride];
+    }
+  }
+  return 0;
+}
+
+static void copy_intra_pred(const uint8_t *src, int src_stride, uint8_t *dst,
+                            int dst_stride, int w, int h, int use_hbd) {
+  int r;
+#if CONFIG_HIGHBITDEPTH
+  if (use_hbd) {
+    const uint16_t *src16 = CONVERT_TO_SHORTPTR(src);
+    uint16_t *dst16 = CONVERT_TO_SHORTPTR(dst);
+    for (r = 0; r < h; ++r)
+      memcpy(dst16 + r * dst_stride, src16 + r * src_stride,
+             w * sizeof(*src16));
+    return;
+  }
+#else
+  (void)use_hbd;
+#endif  // CONFIG_HIGHBITDEPTH
+  for (r = 0; r < h; ++r)
+    memcpy(dst + r * dst_stride, src + r * src_stride, w);
+}
+
 static void predict_intra_block_helper(const AV1_COMMON *cm,
                                        const MACROBLOCKD *xd, int wpx, int hpx,
                                        TX_SIZE tx_size, PREDICTION_MODE mode,
@@ -2641,23 +2729,94 @@ static void predict_intra_block_helper(const AV1_COMMON *cm,
     return;
   }
 
+  const int n_top_px = have_top ? AOMMIN(txwpx, xr + txwpx) : 0;
+  const int n_topright_px = have_top_right ? AOMMIN(txwpx, xr) : 0;
+  const int n_left_px = have_left ? AOMMIN(txhpx, yd + txhpx) : 0;
+  const int n_bottomleft_px = have_bottom_left ? AOMMIN(txhpx, yd) : 0;
 #if CONFIG_HIGHBITDEPTH
-  if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
-    build_intra_predictors_high(
-        xd, ref, ref_stride, dst, dst_stride, mode, tx_size,
-        have_top ? AOMMIN(txwpx, xr + txwpx) : 0,
-        have_top_right ? AOMMIN(txwpx, xr) : 0,
-        have_left ? AOMMIN(txhpx, yd + txhpx) : 0,
-        have_bottom_left ? AOMMIN(txhpx, yd) : 0, plane);
-    return;
+  const int use_hbd = (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) != 0;
+#else
+  const int use_hbd = 0;
+#endif  // CONFIG_HIGHBITDEPTH
+  INTRA_PRED_CACHE *const cache =
+      (row_off == 0 && col_off == 0) ? xd->intra_pred_cache : NULL;
+  const uint8_t *above_ref = ref - ref_stride;
+  const uint8_t *left_ref = ref - 1;
+  int left_stride = ref_stride;
+#if CONFIG_EXT_INTRA
+  const int angle_delta = mbmi->angle_delta[plane != 0];
+#else
+  const int angle_delta = 0;
+#endif  // CONFIG_EXT_INTRA
+#if CONFIG_FILTER_INTRA
+  const FILTER_INTRA_MODE_INFO *const fi = &mbmi->filter_intra_mode_info;
+  const int filter_intra_mode = fi->use_filter_intra_mode[plane != 0]
+                                    ? fi->filter_intra_mode[plane != 0] + 1
+                                    : 0;
+#else
+  const int filter_intra_mode = 0;
+#endif  // CONFIG_FILTER_INTRA
+
+  if (cache != NULL) {
+    INTRA_EDGE_BUFFER *const edge = &cache->edges[plane][tx_size];
+    const uint8_t *cached_pred = (const uint8_t *)cache->pred;
+    if (load_intra_edges(xd, edge, ref, ref_stride, tx_size, n_top_px,
+                         n_topright_px, n_left_px, n_bottomleft_px)) {
+      if (cache->pred_valid && cache->pred_plane == plane &&
+          cache->pred_tx_size == tx_size && cache->pred_mode == mode &&
+          cache->pred_angle_delta == angle_delta &&
+          cache->pred_filter_intra_mode == filter_intra_mode) {
+#if CONFIG_HIGHBITDEPTH
+        if (use_hbd) cached_pred = CONVERT_TO_BYTEPTR(cache->pred);
+#endif  // CONFIG_HIGHBITDEPTH
+        copy_intra_pred(cached_pred, txwpx, dst, dst_stride, txwpx, txhpx,
+                        use_hbd);
+        return;
+      }
+    }
+#if CONFIG_HIGHBITDEPTH
+    if (use_hbd) {
+      above_ref = CONVERT_TO_BYTEPTR(edge->above + 1);
+      left_ref = CONVERT_TO_BYTEPTR(edge->left);
+    } else {
+#endif  // CONFIG_HIGHBITDEPTH
+      above_ref = (const uint8_t *)edge->above + 1;
+      left_ref = (const uint8_t *)edge->left;
+#if CONFIG_HIGHBITDEPTH
+    }
+#endif  // CONFIG_HIGHBITDEPTH
+    left_stride = 1;
   }
-#endif
 
-  build_intra_predictors(xd, ref, ref_stride, dst, dst_stride, mode, tx_size,
-                         have_top ? AOMMIN(txwpx, xr + txwpx) : 0,
-                         have_top_right ? AOMMIN(txwpx, xr) : 0,
-                         have_left ? AOMMIN(txhpx, yd + txhpx) : 0,
-                         have_bottom_left ? AOMMIN(txhpx, yd) : 0, plane);
+#if CONFIG_HIGHBITDEPTH
+  if (use_hbd) {
+    build_intra_predictors_high(xd, above_ref, left_ref, left_stride, dst,
+                                dst_stride, mode, tx_size, n_top_px,
+                                n_topright_px, n_left_px, n_bottomleft_px,
+                                plane);
+  } else {
+#endif  // CONFIG_HIGHBITDEPTH
+    build_intra_predictors(xd, above_ref, left_ref, left_stride, dst,
+                           dst_stride, mode, tx_size, n_top_px, n_topright_px,
+                           n_left_px, n_bottomleft_px, plane);
+#if CONFIG_HIGHBITDEPTH
+  }
+#endif  // CONFIG_HIGHBITDEPTH
+
+  if (cache != NULL) {
+    uint8_t *cached_pred = (uint8_t *)cache->pred;
+#if CONFIG_HIGHBITDEPTH
+    if (use_hbd) cached_pred = CONVERT_TO_BYTEPTR(cache->pred);
+#endif  // CONFIG_HIGHBITDEPTH
+    copy_intra_pred(dst, dst_stride, cached_pred, txwpx, txwpx, txhpx,
+                    use_hbd);
+    cache->pred_valid = 1;
+    cache->pred_plane = plane;
+    cache->pred_tx_size = tx_size;
+    cache->pred_mode = mode;
+    cache->pred_angle_delta = angle_delta;
+    cache->pred_filter_intra_mode = filter_intra_mode;
+  }
 }
 
 void av1_predict_intra_block_facade(const AV1_COMMON *cm, MACROBLOCKD *xd,
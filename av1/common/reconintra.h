@@ -21,6 +21,38 @@ extern "C" {
 #endif
 
 void av1_init_intra_predictors(void);
+
+// Neighbouring pixels of the top-left transform block of a block. above[0]
+// holds the above-left pixel. Low bit depth frames store bytes.
+typedef struct {
+  const uint8_t *ref;
+  int valid;
+  int n_top_px;
+  int n_topright_px;
+  int n_left_px;
+  int n_bottomleft_px;
+  DECLARE_ALIGNED(16, uint16_t, above[MAX_TX_SIZE * 2 + 1]);
+  DECLARE_ALIGNED(16, uint16_t, left[MAX_TX_SIZE * 2]);
+} INTRA_EDGE_BUFFER;
+
+// Intra edges and the last prediction of the top-left transform block of
+// each plane, reused across the candidate modes of one block by the encoder's
+// RD search. Only the top-left transform block is cached, since all of its
+// neighbours lie outside the block. Whoever attaches the cache to a
+// MACROBLOCKD must reset it before the pixels around the block can change.
+typedef struct intra_pred_cache {
+  INTRA_EDGE_BUFFER edges[MAX_MB_PLANE][TX_SIZES_ALL];
+  int pred_valid;
+  int pred_plane;
+  TX_SIZE pred_tx_size;
+  PREDICTION_MODE pred_mode;
+  int pred_angle_delta;
+  int pred_filter_intra_mode;
+  DECLARE_ALIGNED(16, uint16_t, pred[MAX_TX_SQUARE]);
+} INTRA_PRED_CACHE;
+
+void av1_reset_intra_pred_cache(INTRA_PRED_CACHE *cache);
+
 void av1_predict_intra_block_facade(const AV1_COMMON *cm, MACROBLOCKD *xd,
                                     int plane, int block_idx, int blk_col,
                                     int blk_row, TX_SIZE tx_size);
@@ -10,6 +10,7 @@
  *
  */
 
+#include <limits.h>
 #include <math.h>
 
 #include "./aom_config.h"
@@ -150,59 +151,79 @@ static void GenSgrprojVtable() {
 
 void av1_loop_restoration_precal() { GenSgrprojVtable(); }
 
+// Extends rows [row_start, row_end) of a plane of the given size left and
+// right, and the plane top and bottom once its first and last rows are in.
 static void extend_frame_lowbd(uint8_t *data, int width, int height, int stride,
-                               int border_horz, int border_vert) {
+                               int border_horz, int border_vert,
+                               int row_start, int row_end) {
   uint8_t *data_p;
   int i;
-  for (i = 0; i < height; ++i) {
+  for (i = row_start; i < row_end; ++i) {
     data_p = data + i * stride;
     memset(data_p - border_horz, data_p[0], border_horz);
     memset(data_p + width, data_p[width - 1], border_horz);
   }
   data_p = data - border_horz;
-  for (i = -border_vert; i < 0; ++i) {
-    memcpy(data_p + i * stride, data_p, width + 2 * border_horz);
+  if (row_start == 0) {
+    for (i = -border_vert; i < 0; ++i) {
+      memcpy(data_p + i * stride, data_p, width + 2 * border_horz);
+    }
   }
-  for (i = height; i < height + border_vert; ++i) {
-    memcpy(data_p + i * stride, data_p + (height - 1) * stride,
-           width + 2 * border_horz);
+  if (row_end == height) {
+    for (i = height; i < height + border_vert; ++i) {
+      memcpy(data_p + i * stride, data_p + (height - 1) * stride,
+             width + 2 * border_horz);
+    }
   }
 }
 
 #if CONFIG_HIGHBITDEPTH
 static void extend_frame_highbd(uint16_t *data, int width, int height,
-                                int stride, int border_horz, int border_vert) {
+                                int stride, int border_horz, int border_vert,
+                                int row_start, int row_end) {
   uint16_t *data_p;
   int i, j;
-  for (i = 0; i < height; ++i) {
+  for (i = row_start; i < row_end; ++i) {
     data_p = data + i * stride;
     for (j = -border_horz; j < 0; ++j) data_p[j] = data_p[0];
     for (j = width; j < width + border_horz; ++j) data_p[j] = data_p[width - 1];
   }
   data_p = data - border_horz;
-  for (i = -border_vert; i < 0; ++i) {
-    memcpy(data_p + i * stride, data_p,
-           (width + 2 * border_horz) * sizeof(uint16_t));
+  if (row_start == 0) {
+    for (i = -border_vert; i < 0; ++i) {
+      memcpy(data_p + i * stride, data_p,
+             (width + 2 * border_horz) * sizeof(uint16_t));
+    }
   }
-  for (i = height; i < height + border_vert; ++i) {
-    memcpy(data_p + i * stride, data_p + (height - 1) * stride,
-           (width + 2 * border_horz) * sizeof(uint16_t));
+  if (row_end == height) {
+    for (i = height; i < height + border_vert; ++i) {
+      memcpy(data_p + i * stride, data_p + (height - 1) * stride,
+             (width + 2 * border_horz) * sizeof(uint16_t));
+    }
   }
 }
 #endif
 
-void extend_frame(uint8_t *data, int width, int height, int stride,
-                  int border_horz, int border_vert, int highbd) {
+static void extend_frame_rows(uint8_t *data, int width, int height, int stride,
+                              int border_horz, int border_vert, int row_start,
+                              int row_end, int highbd) {
 #if !CONFIG_HIGHBITDEPTH
   assert(highbd == 0);
   (void)highbd;
 #else
   if (highbd)
     extend_frame_highbd(CONVERT_TO_SHORTPTR(data), width, height, stride,
-                        border_horz, border_vert);
+                        border_horz, border_vert, row_start, row_end);
   else
 #endif
-  extend_frame_lowbd(data, width, height, stride, border_horz, border_vert);
+  extend_frame_lowbd(data, width, height, stride, border_horz, border_vert,
+                     row_start, row_end);
+}
+
+void extend_frame(uint8_t *data, int width, int height, int stride,
+                  int border_horz, int border_vert, int highbd) {
+  extend_frame_rows(data, width, height, stride, border_horz, border_vert, 0,
+                    height, highbd);
 }
 
 static void copy_tile_lowbd(int width, int height, const uint8_t *src,
@@ -1310,11 +1331,13 @@ void av1_loop_restoration_filter_unit(
 
 typedef struct {
   const RestorationInfo *rsi;
+  const AV1_COMMON *cm;
 #if CONFIG_STRIPED_LOOP_RESTORATION
   RestorationLineBuffers *rlbs;
-  const AV1_COMMON *cm;
   int tile_stripe0;
 #endif  // CONFIG_STRIPED_LOOP_RESTORATION
+  // Set if the decoder left out the current tile.
+  int skip_tile;
   int ss_x, ss_y;
   int highbd, bit_depth;
   uint8_t *data8, *dst8;
@@ -1323,14 +1346,14 @@ typedef struct {
 } FilterFrameCtxt;
 
 static void filter_frame_on_tile(int tile_row, int tile_col, void *priv) {
-  (void)tile_col;
-#if CONFIG_STRIPED_LOOP_RESTORATION
   FilterFrameCtxt *ctxt = (FilterFrameCtxt *)priv;
-  ctxt->tile_stripe0 =
-      (tile_row == 0) ? 0 : ctxt->cm->rst_end_stripe[tile_row - 1];
-#else
-  (void)tile_row;
-  (void)priv;
+  const AV1_COMMON *const cm = ctxt->cm;
+  TileInfo tile_info;
+  av1_tile_init(&tile_info, cm, tile_row, tile_col);
+  ctxt->skip_tile = cm->mi_grid_visible[tile_info.mi_row_start * cm->mi_stride +
+                                        tile_info.mi_col_start] == NULL;
+#if CONFIG_STRIPED_LOOP_RESTORATION
+  ctxt->tile_stripe0 = (tile_row == 0) ? 0 : cm->rst_end_stripe[tile_row - 1];
 #endif  // CONFIG_STRIPED_LOOP_RESTORATION
 }
 
@@ -1344,6 +1367,17 @@ static void filter_frame_on_unit(const RestorationTileLimits *limits,
   (void)tile_rect;
 #endif  // CONFIG_STRIPED_LOOP_RESTORATION
 
+  // The coefficients of the units of a tile left out were not read.
+  if (ctxt->skip_tile) {
+    copy_tile(limits->h_end - limits->h_start, limits->v_end - limits->v_start,
+              ctxt->data8 + limits->v_start * ctxt->data_stride +
+                  limits->h_start,
+              ctxt->data_stride,
+              ctxt->dst8 + limits->v_start * ctxt->dst_stride + limits->h_start,
+              ctxt->dst_stride, ctxt->highbd);
+    return;
+  }
+
   av1_loop_restoration_filter_unit(
       limits, &rsi->unit_info[rest_unit_idx],
 #if CONFIG_STRIPED_LOOP_RESTORATION
@@ -1356,6 +1390,32 @@ static void filter_frame_on_unit(const RestorationTileLimits *limits,
       ctxt->data_stride, ctxt->dst8, ctxt->dst_stride, ctxt->tmpbuf);
 }
 
+// Sets up ctxt to filter plane of frame into dst with the parameters in rsi,
+// except for the line buffers.
+static void init_filter_frame_ctxt(FilterFrameCtxt *ctxt, const AV1_COMMON *cm,
+                                   const RestorationInfo *rsi, int plane,
+                                   const YV12_BUFFER_CONFIG *frame,
+                                   const YV12_BUFFER_CONFIG *dst) {
+  const int is_uv = plane > 0;
+  ctxt->rsi = rsi;
+  ctxt->cm = cm;
+  ctxt->skip_tile = 0;
+  ctxt->ss_x = is_uv && cm->subsampling_x;
+  ctxt->ss_y = is_uv && cm->subsampling_y;
+#if CONFIG_HIGHBITDEPTH
+  ctxt->highbd = cm->use_highbitdepth;
+  ctxt->bit_depth = cm->bit_depth;
+#else
+  ctxt->highbd = 0;
+  ctxt->bit_depth = 8;
+#endif
+  ctxt->data8 = frame->buffers[plane];
+  ctxt->dst8 = dst->buffers[plane];
+  ctxt->data_stride = frame->strides[is_uv];
+  ctxt->dst_stride = dst->strides[is_uv];
+  ctxt->tmpbuf = cm->rst_tmpbuf;
+}
+
 void av1_loop_restoration_filter_frame(YV12_BUFFER_CONFIG *frame,
                                        AV1_COMMON *cm, RestorationInfo *rsi,
                                        int components_pattern,
@@ -1405,10 +1465,8 @@ void av1_loop_restoration_filter_frame(YV12_BUFFER_CONFIG *frame,
   RestorationLineBuffers rlbs;
 #endif  // CONFIG_STRIPED_LOOP_RESTORATION
 #if CONFIG_HIGHBITDEPTH
-  const int bit_depth = cm->bit_depth;
   const int highbd = cm->use_highbitdepth;
 #else
-  const int bit_depth = 8;
   const int highbd = 0;
 #endif
 
@@ -1432,20 +1490,10 @@ void av1_loop_restoration_filter_frame(YV12_BUFFER_CONFIG *frame,
                  highbd);
 
     FilterFrameCtxt ctxt;
-    ctxt.rsi = prsi;
+    init_filter_frame_ctxt(&ctxt, cm, prsi, plane, frame, dst);
 #if CONFIG_STRIPED_LOOP_RESTORATION
     ctxt.rlbs = &rlbs;
-    ctxt.cm = cm;
 #endif  // CONFIG_STRIPED_LOOP_RESTORATION
-    ctxt.ss_x = is_uv && cm->subsampling_x;
-    ctxt.ss_y = is_uv && cm->subsampling_y;
-    ctxt.highbd = highbd;
-    ctxt.bit_depth = bit_depth;
-    ctxt.data8 = frame->buffers[plane];
-    ctxt.dst8 = dst->buffers[plane];
-    ctxt.data_stride = frame->strides[is_uv];
-    ctxt.dst_stride = dst->strides[is_uv];
-    ctxt.tmpbuf = cm->rst_tmpbuf;
 
     av1_foreach_rest_unit_in_frame(cm, plane, filter_frame_on_tile,
                                    filter_frame_on_unit, &ctxt);
@@ -1461,53 +1509,76 @@ void av1_loop_restoration_filter_frame(YV12_BUFFER_CONFIG *frame,
   }
 }
 
+// Sets the vertical limits of the row of restoration units starting y0 rows
+// below the top of the tile and returns the height of the row before any
+// offset.
+static int get_rest_unit_row_limits(const AV1PixelRect *tile_rect, int y0,
+                                    int unit_size, int ss_y,
+                                    RestorationTileLimits *limits) {
+  const int tile_h = tile_rect->bottom - tile_rect->top;
+  const int ext_size = unit_size * 3 / 2;
+  const int remaining_h = tile_h - y0;
+  const int h = (remaining_h < ext_size) ? remaining_h : unit_size;
+
+  limits->v_start = tile_rect->top + y0;
+  limits->v_end = tile_rect->top + y0 + h;
+  assert(limits->v_end <= tile_rect->bottom);
+#if CONFIG_STRIPED_LOOP_RESTORATION
+  // Offset the tile upwards to align with the restoration processing stripe
+  const int voffset = RESTORATION_TILE_OFFSET >> ss_y;
+  limits->v_start = AOMMAX(tile_rect->top, limits->v_start - voffset);
+  if (limits->v_end < tile_rect->bottom) limits->v_end -= voffset;
+#else
+  (void)ss_y;
+#endif  // CONFIG_STRIPED_LOOP_RESTORATION
+  return h;
+}
+
+// Calls on_rest_unit for each unit of the row given by the vertical limits in
+// *limits, with unit_idx0 the index of the first one.
+static void foreach_rest_unit_in_row(RestorationTileLimits *limits,
+                                     const AV1PixelRect *tile_rect,
+                                     int unit_idx0, int unit_size,
+                                     rest_unit_visitor_t on_rest_unit,
+                                     void *priv) {
+  const int tile_w = tile_rect->right - tile_rect->left;
+  const int ext_size = unit_size * 3 / 2;
+
+  int x0 = 0, j = 0;
+  while (x0 < tile_w) {
+    int remaining_w = tile_w - x0;
+    int w = (remaining_w < ext_size) ? remaining_w : unit_size;
+
+    limits->h_start = tile_rect->left + x0;
+    limits->h_end = tile_rect->left + x0 + w;
+    assert(limits->h_end <= tile_rect->right);
+
+    on_rest_unit(limits, tile_rect, unit_idx0 + j, priv);
+
+    x0 += w;
+    ++j;
+  }
+}
+
 static void foreach_rest_unit_in_tile(const AV1PixelRect *tile_rect,
                                       int tile_row, int tile_col, int tile_cols,
                                       int hunits_per_tile, int units_per_tile,
                                       int unit_size, int ss_y,
                                       rest_unit_visitor_t on_rest_unit,
                                       void *priv) {
-  const int tile_w = tile_rect->right - tile_rect->left;
   const int tile_h = tile_rect->bottom - tile_rect->top;
-  const int ext_size = unit_size * 3 / 2;
 
   const int tile_idx = tile_col + tile_row * tile_cols;
   const int unit_idx0 = tile_idx * units_per_tile;
 
   int y0 = 0, i = 0;
   while (y0 < tile_h) {
-    int remaining_h = tile_h - y0;
-    int h = (remaining_h < ext_size) ? remaining_h : unit_size;
-
     RestorationTileLimits limits;
-    limits.v_start = tile_rect->top + y0;
-    limits.v_end = tile_rect->top + y0 + h;
-    assert(limits.v_end <= tile_rect->bottom);
-#if CONFIG_STRIPED_LOOP_RESTORATION
-    // Offset the tile upwards to align with the restoration processing stripe
-    const int voffset = RESTORATION_TILE_OFFSET >> ss_y;
-    limits.v_start = AOMMAX(tile_rect->top, limits.v_start - voffset);
-    if (limits.v_end < tile_rect->bottom) limits.v_end -= voffset;
-#else
-    (void)ss_y;
-#endif  // CONFIG_STRIPED_LOOP_RESTORATION
-
-    int x0 = 0, j = 0;
-    while (x0 < tile_w) {
-      int remaining_w = tile_w - x0;
-      int w = (remaining_w < ext_size) ? remaining_w : unit_size;
-
-      limits.h_start = tile_rect->left + x0;
-      limits.h_end = tile_rect->left + x0 + w;
-      assert(limits.h_end <= tile_rect->right);
-
-      const int unit_idx = unit_idx0 + i * hunits_per_tile + j;
-      on_rest_unit(&limits, tile_rect, unit_idx, priv);
-
-      x0 += w;
-      ++j;
-    }
-
+    const int h =
+        get_rest_unit_row_limits(tile_rect, y0, unit_size, ss_y, &limits);
+    foreach_rest_unit_in_row(&limits, tile_rect,
+                             unit_idx0 + i * hunits_per_tile, unit_size,
+                             on_rest_unit, priv);
     y0 += h;
     ++i;
   }
@@ -1540,6 +1611,98 @@ void av1_foreach_rest_unit_in_frame(const struct AV1Common *cm, int plane,
   }
 }
 
+int av1_loop_restoration_filter_rows(YV12_BUFFER_CONFIG *frame,
+                                     AV1_COMMON *cm, int plane, int ready_rows,
+                                     RestorationRowProgress *progress,
+                                     YV12_BUFFER_CONFIG *dst) {
+  const RestorationInfo *rsi = &cm->rst_info[plane];
+  const int is_uv = plane > 0;
+  const int ss_y = is_uv && cm->subsampling_y;
+  const int plane_width = frame->crop_widths[is_uv];
+  const int plane_height =
+      ALIGN_POWER_OF_TWO(frame->crop_heights[is_uv], 3 - ss_y);
+  const int done = ready_rows >= plane_height;
+#if CONFIG_HIGHBITDEPTH
+  const int highbd = cm->use_highbitdepth;
+#else
+  const int highbd = 0;
+#endif
+  assert(rsi->frame_restoration_type != RESTORE_NONE);
+
+  ready_rows = AOMMIN(ready_rows, plane_height);
+  if (ready_rows > progress->extended_rows) {
+    extend_frame_rows(frame->buffers[plane], plane_width, plane_height,
+                      frame->strides[is_uv], RESTORATION_BORDER,
+                      RESTORATION_BORDER, progress->extended_rows, ready_rows,
+                      highbd);
+    progress->extended_rows = ready_rows;
+  }
+
+#if CONFIG_STRIPED_LOOP_RESTORATION
+  RestorationLineBuffers rlbs;
+#endif  // CONFIG_STRIPED_LOOP_RESTORATION
+  FilterFrameCtxt ctxt;
+  init_filter_frame_ctxt(&ctxt, cm, rsi, plane, frame, dst);
+#if CONFIG_STRIPED_LOOP_RESTORATION
+  ctxt.rlbs = &rlbs;
+#endif  // CONFIG_STRIPED_LOOP_RESTORATION
+
+  // Filter whole rows of units, across all the tile columns, as long as the
+  // rows they read, up to RESTORATION_BORDER below them, are ready.
+  int next_top = plane_height;
+  TileInfo tile_info;
+  while (progress->tile_row < cm->tile_rows) {
+    av1_tile_set_row(&tile_info, cm, progress->tile_row);
+    av1_tile_set_col(&tile_info, cm, 0);
+    AV1PixelRect tile_rect = get_ext_tile_rect(&tile_info, cm, is_uv);
+    if (progress->y0 >= tile_rect.bottom - tile_rect.top) {
+      ++progress->tile_row;
+      progress->y0 = 0;
+      progress->unit_row = 0;
+      continue;
+    }
+
+    RestorationTileLimits limits;
+    const int h = get_rest_unit_row_limits(&tile_rect, progress->y0,
+                                           rsi->restoration_unit_size, ss_y,
+                                           &limits);
+    if (!done && limits.v_end + RESTORATION_BORDER > ready_rows) {
+      next_top = limits.v_start;
+      break;
+    }
+
+    for (int tile_col = 0; tile_col < cm->tile_cols; ++tile_col) {
+      const int tile_idx = tile_col + progress->tile_row * cm->tile_cols;
+      av1_tile_set_col(&tile_info, cm, tile_col);
+      tile_rect = get_ext_tile_rect(&tile_info, cm, is_uv);
+      filter_frame_on_tile(progress->tile_row, tile_col, &ctxt);
+      foreach_rest_unit_in_row(
+          &limits, &tile_rect,
+          tile_idx * rsi->units_per_tile +
+              progress->unit_row * rsi->horz_units_per_tile,
+          rsi->restoration_unit_size, filter_frame_on_unit, &ctxt);
+    }
+    progress->y0 += h;
+    ++progress->unit_row;
+  }
+
+  // The rows just above the next row of units may still be read as its
+  // context, so only the rows above those are copied back.
+  int copy_end =
+      next_top == plane_height ? plane_height : next_top - RESTORATION_BORDER;
+  copy_end = AOMMIN(copy_end, frame->crop_heights[is_uv]);
+  if (copy_end > progress->copied_rows) {
+    const int row = progress->copied_rows;
+    copy_tile(plane_width, copy_end - row,
+              dst->buffers[plane] + row * dst->strides[is_uv],
+              dst->strides[is_uv],
+              frame->buffers[plane] + row * frame->strides[is_uv],
+              frame->strides[is_uv], highbd);
+    progress->copied_rows = copy_end;
+  }
+  return progress->copied_rows;
+}
+
 #if CONFIG_MAX_TILE
 // Get the horizontal or vertical index of the tile containing mi_x. For a
 // horizontal index, mi_x should be the left-most column for some block in mi
@@ -1774,11 +1937,20 @@ static void save_cdef_boundary_lines(const YV12_BUFFER_CONFIG *frame,
                RESTORATION_EXTRA_HORZ, use_highbd);
 }
 
+// Returns 1 if the boundary lines that end at line_end are to be saved by a
+// call for rows [row_start, row_end).
+static INLINE int lines_in_range(int line_end, int row_start, int row_end) {
+  return line_end > row_start && line_end <= row_end;
+}
+
+// Saves the boundary lines of the stripes of a tile row whose last line is in
+// [row_start, row_end).
 static void save_tile_row_boundary_lines(const YV12_BUFFER_CONFIG *frame,
                                          int tile_row,
                                          const TileInfo *tile_info,
                                          int use_highbd, int plane,
-                                         AV1_COMMON *cm, int after_cdef) {
+                                         AV1_COMMON *cm, int after_cdef,
+                                         int row_start, int row_end) {
   const int is_uv = plane > 0;
   const int ss_y = is_uv && cm->subsampling_y;
   const int stripe_height = RESTORATION_PROC_UNIT_SIZE >> ss_y;
@@ -1837,11 +2009,12 @@ static void save_tile_row_boundary_lines(const YV12_BUFFER_CONFIG *frame,
 
     if (!after_cdef) {
       // Save deblocked context where needed.
-      if (use_deblock_above) {
+      if (use_deblock_above && lines_in_range(y0, row_start, row_end)) {
         save_deblock_boundary_lines(frame, cm, plane, y0 - RESTORATION_CTX_VERT,
                                     frame_stripe, use_highbd, 1, boundaries);
       }
-      if (use_deblock_below) {
+      if (use_deblock_below &&
+          lines_in_range(y1 + RESTORATION_CTX_VERT, row_start, row_end)) {
         save_deblock_boundary_lines(frame, cm, plane, y1, frame_stripe,
                                     use_highbd, 0, boundaries);
       }
@@ -1852,11 +2025,11 @@ static void save_tile_row_boundary_lines(const YV12_BUFFER_CONFIG *frame,
       //
       // In addition, we need to save copies of the outermost line within
       // the tile, rather than using data from outside the tile.
-      if (!use_deblock_above) {
+      if (!use_deblock_above && lines_in_range(y0 + 1, row_start, row_end)) {
         save_cdef_boundary_lines(frame, cm, plane, y0, frame_stripe, use_highbd,
                                  1, boundaries);
       }
-      if (!use_deblock_below) {
+      if (!use_deblock_below && lines_in_range(y1, row_start, row_end)) {
         save_cdef_boundary_lines(frame, cm, plane, y1 - 1, frame_stripe,
                                  use_highbd, 0, boundaries);
       }
@@ -1880,8 +2053,26 @@ void av1_loop_restoration_save_boundary_lines(const YV12_BUFFER_CONFIG *frame,
     for (int tile_row = 0; tile_row < cm->tile_rows; ++tile_row) {
       av1_tile_init(&tile_info, cm, tile_row, 0);
       save_tile_row_boundary_lines(frame, tile_row, &tile_info, use_highbd, p,
-                                   cm, after_cdef);
+                                   cm, after_cdef, 0, INT_MAX);
     }
   }
 }
+
+void av1_loop_restoration_save_boundary_rows(const YV12_BUFFER_CONFIG *frame,
+                                             AV1_COMMON *cm, int plane,
+                                             int row_start, int row_end,
+                                             int after_cdef) {
+#if CONFIG_HIGHBITDEPTH
+  const int use_highbd = cm->use_highbitdepth;
+#else
+  const int use_highbd = 0;
+#endif
+
+  TileInfo tile_info;
+  for (int tile_row = 0; tile_row < cm->tile_rows; ++tile_row) {
+    av1_tile_init(&tile_info, cm, tile_row, 0);
+    save_tile_row_boundary_lines(frame, tile_row, &tile_info, use_highbd, plane,
+                                 cm, after_cdef, row_start, row_end);
+  }
+}
 #endif  // CONFIG_STRIPED_LOOP_RESTORATION
@@ -327,6 +327,26 @@ void av1_loop_restoration_filter_frame(YV12_BUFFER_CONFIG *frame,
                                        YV12_BUFFER_CONFIG *dst);
 void av1_loop_restoration_precal();
 
+// Position of av1_loop_restoration_filter_rows() in a plane. Zero it before
+// the first call for a frame.
+typedef struct {
+  int tile_row;       // Tile row of the next row of units to filter
+  int y0;             // Top of that row of units, relative to the tile
+  int unit_row;       // Index of that row of units in the tile
+  int extended_rows;  // Rows extended by RESTORATION_BORDER pixels
+  int copied_rows;    // Rows filtered and copied back into the frame
+} RestorationRowProgress;
+
+// Filters the next rows of restoration units of plane, to the extent that the
+// first ready_rows rows of the plane in frame are final, through dst. The
+// whole plane is filtered once ready_rows reaches its height. Returns the
+// number of rows of the plane that are filtered in frame.
+int av1_loop_restoration_filter_rows(YV12_BUFFER_CONFIG *frame,
+                                     struct AV1Common *cm, int plane,
+                                     int ready_rows,
+                                     RestorationRowProgress *progress,
+                                     YV12_BUFFER_CONFIG *dst);
+
 typedef void (*rest_unit_visitor_t)(const RestorationTileLimits *limits,
                                     const AV1PixelRect *tile_rect,
                                     int rest_unit_idx, void *priv);
@@ -358,6 +378,13 @@ int av1_loop_restoration_corners_in_sb(const struct AV1Common *cm, int plane,
 void av1_loop_restoration_save_boundary_lines(const YV12_BUFFER_CONFIG *frame,
                                               struct AV1Common *cm,
                                               int after_cdef);
+
+// Like av1_loop_restoration_save_boundary_lines() for one plane, but only
+// saves the lines that end in rows [row_start, row_end) of the plane.
+void av1_loop_restoration_save_boundary_rows(const YV12_BUFFER_CONFIG *frame,
+                                             struct AV1Common *cm, int plane,
+                                             int row_start, int row_end,
+                                             int after_cdef);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -141,90 +141,45 @@ static INLINE void loop_filter_block_plane_hor(
   }
 }
 #endif
-// Row-based multi-threaded loopfilter hook
 #if CONFIG_PARALLEL_DEBLOCKING
+// Vertical edges never cross a superblock row, so each worker filters every
+// num_workers-th superblock row without any synchronization.
 static int loop_filter_ver_row_worker(AV1LfSync *const lf_sync,
                                       LFWorkerData *const lf_data) {
-  const int num_planes = lf_data->y_only ? 1 : MAX_MB_PLANE;
-  int mi_row, mi_col;
-#if !CONFIG_EXT_PARTITION_TYPES
-  enum lf_path path = get_loop_filter_path(lf_data->y_only, lf_data->planes);
-#endif
-  for (mi_row = lf_data->start; mi_row < lf_data->stop;
-       mi_row += lf_sync->num_workers * lf_data->cm->mib_size) {
-    MODE_INFO **const mi =
-        lf_data->cm->mi_grid_visible + mi_row * lf_data->cm->mi_stride;
-
-    for (mi_col = 0; mi_col < lf_data->cm->mi_cols;
-         mi_col += lf_data->cm->mib_size) {
-      LOOP_FILTER_MASK lfm;
-      int plane;
-
-      av1_setup_dst_planes(lf_data->planes, lf_data->cm->sb_size,
-                           lf_data->frame_buffer, mi_row, mi_col);
-      av1_setup_mask(lf_data->cm, mi_row, mi_col, mi + mi_col,
-                     lf_data->cm->mi_stride, &lfm);
-
-#if CONFIG_EXT_PARTITION_TYPES
-      for (plane = 0; plane < num_planes; ++plane)
-        av1_filter_block_plane_non420_ver(lf_data->cm, &lf_data->planes[plane],
-                                          mi + mi_col, mi_row, mi_col, plane);
-#else
+  int plane_start, plane_end;
+  int mi_row;
 
-      for (plane = 0; plane < num_planes; ++plane)
-        loop_filter_block_plane_ver(lf_data->cm, lf_data->planes, plane,
-                                    mi + mi_col, mi_row, mi_col, path, &lfm);
-#endif
-    }
+  av1_loop_filter_planes(lf_data->y_only, &plane_start, &plane_end);
+  for (mi_row = lf_data->start; mi_row < lf_data->stop;
+       mi_row += lf_sync->num_workers * MAX_MIB_SIZE) {
+    av1_loop_filter_ver_sb_range(lf_data->frame_buffer, lf_data->cm,
+                                 lf_data->planes, plane_start, plane_end,
+                                 mi_row, AOMMIN(mi_row + MAX_MIB_SIZE,
+                                                lf_data->stop),
+                                 0, lf_data->cm->mi_cols);
   }
   return 1;
 }
 
-static int loop_filter_hor_row_worker(AV1LfSync *const lf_sync,
+// Horizontal edges never cross a superblock column, so each worker filters
+// every num_workers-th superblock column, top to bottom.
+static int loop_filter_hor_col_worker(AV1LfSync *const lf_sync,
                                       LFWorkerData *const lf_data) {
-  const int num_planes = lf_data->y_only ? 1 : MAX_MB_PLANE;
-  const int sb_cols =
-      mi_cols_aligned_to_sb(lf_data->cm) >> lf_data->cm->mib_size_log2;
-  int mi_row, mi_col;
-#if !CONFIG_EXT_PARTITION_TYPES
-  enum lf_path path = get_loop_filter_path(lf_data->y_only, lf_data->planes);
-#endif
-
-  for (mi_row = lf_data->start; mi_row < lf_data->stop;
-       mi_row += lf_sync->num_workers * lf_data->cm->mib_size) {
-    MODE_INFO **const mi =
-        lf_data->cm->mi_grid_visible + mi_row * lf_data->cm->mi_stride;
-
-    for (mi_col = 0; mi_col < lf_data->cm->mi_cols;
-         mi_col += lf_data->cm->mib_size) {
-      const int r = mi_row >> lf_data->cm->mib_size_log2;
-      const int c = mi_col >> lf_data->cm->mib_size_log2;
-      LOOP_FILTER_MASK lfm;
-      int plane;
-
-      // TODO(wenhao.zhang@intel.com): For better parallelization, reorder
-      // the outer loop to column-based and remove the synchronizations here.
-      sync_read(lf_sync, r, c);
-
-      av1_setup_dst_planes(lf_data->planes, lf_data->cm->sb_size,
-                           lf_data->frame_buffer, mi_row, mi_col);
-      av1_setup_mask(lf_data->cm, mi_row, mi_col, mi + mi_col,
-                     lf_data->cm->mi_stride, &lfm);
-#if CONFIG_EXT_PARTITION_TYPES
-      for (plane = 0; plane < num_planes; ++plane)
-        av1_filter_block_plane_non420_hor(lf_data->cm, &lf_data->planes[plane],
-                                          mi + mi_col, mi_row, mi_col, plane);
-#else
-      for (plane = 0; plane < num_planes; ++plane)
-        loop_filter_block_plane_hor(lf_data->cm, lf_data->planes, plane,
-                                    mi + mi_col, mi_row, mi_col, path, &lfm);
-#endif
-      sync_write(lf_sync, r, c, sb_cols);
-    }
+  int plane_start, plane_end;
+  int mi_col;
+
+  av1_loop_filter_planes(lf_data->y_only, &plane_start, &plane_end);
+  for (mi_col = lf_data->col_start; mi_col < lf_data->cm->mi_cols;
+       mi_col += lf_sync->num_workers * MAX_MIB_SIZE) {
+    av1_loop_filter_hor_sb_range(lf_data->frame_buffer, lf_data->cm,
+                                 lf_data->planes, plane_start, plane_end,
+                                 lf_data->start, lf_data->stop, mi_col,
+                                 mi_col + MAX_MIB_SIZE);
   }
   return 1;
 }
 #else  //  CONFIG_PARALLEL_DEBLOCKING
+// Row-based multi-threaded loopfilter hook
 static int loop_filter_row_worker(AV1LfSync *const lf_sync,
                                   LFWorkerData *const lf_data) {
   const int num_planes = lf_data->y_only ? 1 : MAX_MB_PLANE;
@@ -289,24 +244,31 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                                 struct macroblockd_plane *planes, int start,
                                 int stop, int y_only, AVxWorker *workers,
                                 int nworkers, AV1LfSync *lf_sync) {
-#if CONFIG_EXT_PARTITION
-  printf(
-      "STOPPING: This code has not been modified to work with the "
-      "extended coding unit size experiment");
-  exit(EXIT_FAILURE);
-#endif  // CONFIG_EXT_PARTITION
-
   const AVxWorkerInterface *const winterface = aom_get_worker_interface();
   // Number of superblock rows and cols
   const int sb_rows = mi_rows_aligned_to_sb(cm) >> cm->mib_size_log2;
+#if CONFIG_PARALLEL_DEBLOCKING
+  const int sb_cols = mi_cols_aligned_to_sb(cm) >> cm->mib_size_log2;
+  // Superblock rows and columns are independent within each pass.
+  const int num_workers = AOMMIN(nworkers, AOMMAX(sb_rows, sb_cols));
+  int pass;
+#else
   // Decoder may allocate more threads than number of tiles based on user's
   // input.
   const int tile_cols = cm->tile_cols;
   const int num_workers = AOMMIN(nworkers, tile_cols);
+#endif  // CONFIG_PARALLEL_DEBLOCKING
   int i;
 
+#if !CONFIG_PARALLEL_DEBLOCKING && CONFIG_EXT_PARTITION
+  printf(
+      "STOPPING: This code has not been modified to work with the "
+      "extended coding unit size experiment");
+  exit(EXIT_FAILURE);
+#endif  // !CONFIG_PARALLEL_DEBLOCKING && CONFIG_EXT_PARTITION
+
   if (!lf_sync->sync_range || sb_rows != lf_sync->rows ||
-      num_workers > lf_sync->num_workers) {
+      num_workers != lf_sync->num_workers) {
     av1_loop_filter_dealloc(lf_sync);
     av1_loop_filter_alloc(lf_sync, cm, sb_rows, cm->width, num_workers);
   }
@@ -321,65 +283,38 @@ static void loop_filter_rows_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
 // then the number of workers used by the loopfilter should be revisited.
 
 #if CONFIG_PARALLEL_DEBLOCKING
-  // Initialize cur_sb_col to -1 for all SB rows.
-  memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * sb_rows);
-
-  // Filter all the vertical edges in the whole frame
-  for (i = 0; i < num_workers; ++i) {
-    AVxWorker *const worker = &workers[i];
-    LFWorkerData *const lf_data = &lf_sync->lfdata[i];
-
-    worker->hook = (AVxWorkerHook)loop_filter_ver_row_worker;
-    worker->data1 = lf_sync;
-    worker->data2 = lf_data;
-
-    // Loopfilter data
-    av1_loop_filter_data_reset(lf_data, frame, cm, planes);
-    lf_data->start = start + i * cm->mib_size;
-    lf_data->stop = stop;
-    lf_data->y_only = y_only;
-
-    // Start loopfiltering
-    if (i == num_workers - 1) {
-      winterface->execute(worker);
-    } else {
-      winterface->launch(worker);
+  // Filter all the vertical edges in the whole frame, then all the
+  // horizontal edges.
+  for (pass = 0; pass < 2; ++pass) {
+    for (i = 0; i < num_workers; ++i) {
+      AVxWorker *const worker = &workers[i];
+      LFWorkerData *const lf_data = &lf_sync->lfdata[i];
+
+      worker->hook = pass == 0 ? (AVxWorkerHook)loop_filter_ver_row_worker
+                               : (AVxWorkerHook)loop_filter_hor_col_worker;
+      worker->data1 = lf_sync;
+      worker->data2 = lf_data;
+
+      // Loopfilter data
+      av1_loop_filter_data_reset(lf_data, frame, cm, planes);
+      lf_data->start = pass == 0 ? start + i * MAX_MIB_SIZE : start;
+      lf_data->stop = stop;
+      lf_data->y_only = y_only;
+      lf_data->col_start = i * MAX_MIB_SIZE;
+
+      // Start loopfiltering
+      if (i == num_workers - 1) {
+        winterface->execute(worker);
+      } else {
+        winterface->launch(worker);
+      }
     }
-  }
-
-  // Wait till all rows are finished
-  for (i = 0; i < num_workers; ++i) {
-    winterface->sync(&workers[i]);
-  }
-
-  memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * sb_rows);
-  // Filter all the horizontal edges in the whole frame
-  for (i = 0; i < num_workers; ++i) {
-    AVxWorker *const worker = &workers[i];
-    LFWorkerData *const lf_data = &lf_sync->lfdata[i];
 
-    worker->hook = (AVxWorkerHook)loop_filter_hor_row_worker;
-    worker->data1 = lf_sync;
-    worker->data2 = lf_data;
-
-    // Loopfilter data
-    av1_loop_filter_data_reset(lf_data, frame, cm, planes);
-    lf_data->start = start + i * cm->mib_size;
-    lf_data->stop = stop;
-    lf_data->y_only = y_only;
-
-    // Start loopfiltering
-    if (i == num_workers - 1) {
-      winterface->execute(worker);
-    } else {
-      winterface->launch(worker);
+    // Wait till all rows or columns are finished
+    for (i = 0; i < num_workers; ++i) {
+      winterface->sync(&workers[i]);
     }
   }
-
-  // Wait till all rows are finished
-  for (i = 0; i < num_workers; ++i) {
-    winterface->sync(&workers[i]);
-  }
 #else   // CONFIG_PARALLEL_DEBLOCKING
   // Initialize cur_sb_col to -1 for all SB rows.
   memset(lf_sync->cur_sb_col, -1, sizeof(*lf_sync->cur_sb_col) * sb_rows);
@@ -422,8 +357,19 @@ void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
                               int y_only, int partial_frame, AVxWorker *workers,
                               int num_workers, AV1LfSync *lf_sync) {
   int start_mi_row, end_mi_row, mi_rows_to_filter;
+#if CONFIG_EXT_DELTA_Q
+#if CONFIG_LOOPFILTER_LEVEL
+  int orig_filter_level[2] = { cm->lf.filter_level[0], cm->lf.filter_level[1] };
+#else
+  int orig_filter_level = cm->lf.filter_level;
+#endif
+#endif
 
+#if CONFIG_LOOPFILTER_LEVEL
+  if (!frame_filter_level && !frame_filter_level_r) return;
+#else
   if (!frame_filter_level) return;
+#endif
 
   start_mi_row = 0;
   mi_rows_to_filter = cm->mi_rows;
@@ -439,8 +385,27 @@ void av1_loop_filter_frame_mt(YV12_BUFFER_CONFIG *frame, AV1_COMMON *cm,
 #else
   av1_loop_filter_frame_init(cm, frame_filter_level, frame_filter_level);
 #endif  // CONFIG_LOOPFILTER_LEVEL
+
+#if CONFIG_EXT_DELTA_Q
+#if CONFIG_LOOPFILTER_LEVEL
+  cm->lf.filter_level[0] = frame_filter_level;
+  cm->lf.filter_level[1] = frame_filter_level_r;
+#else
+  cm->lf.filter_level = frame_filter_level;
+#endif
+#endif
+
   loop_filter_rows_mt(frame, cm, planes, start_mi_row, end_mi_row, y_only,
                       workers, num_workers, lf_sync);
+
+#if CONFIG_EXT_DELTA_Q
+#if CONFIG_LOOPFILTER_LEVEL
+  cm->lf.filter_level[0] = orig_filter_level[0];
+  cm->lf.filter_level[1] = orig_filter_level[1];
+#else
+  cm->lf.filter_level = orig_filter_level;
+#endif
+#endif
 }
 
 // Set up nsync by width.
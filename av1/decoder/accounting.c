@@ -52,6 +52,20 @@ int aom_accounting_dictionary_lookup(Accounting *accounting, const char *str) {
   return dictionary->num_strs - 1;
 }
 
+/* Maps a symbol name to its id through a direct mapped cache keyed on the
+   string address. Different pointers to equal strings still resolve to the
+   same id through the dictionary. */
+static int accounting_symbol_id(Accounting *accounting, const char *str) {
+  const int idx =
+      (int)(((uintptr_t)str >> 2) & (AOM_ACCOUNTING_PTR_CACHE_SIZE - 1));
+  if (accounting->ptr_cache_str[idx] != str) {
+    accounting->ptr_cache_id[idx] =
+        aom_accounting_dictionary_lookup(accounting, str);
+    accounting->ptr_cache_str[idx] = str;
+  }
+  return accounting->ptr_cache_id[idx];
+}
+
 void aom_accounting_init(Accounting *accounting) {
   int i;
   accounting->num_syms_allocated = 1000;
@@ -61,6 +75,15 @@ void aom_accounting_init(Accounting *accounting) {
   assert(AOM_ACCOUNTING_HASH_SIZE > 2 * MAX_SYMBOL_TYPES);
   for (i = 0; i < AOM_ACCOUNTING_HASH_SIZE; i++)
     accounting->hash_dictionary[i] = -1;
+  for (i = 0; i < AOM_ACCOUNTING_PTR_CACHE_SIZE; i++)
+    accounting->ptr_cache_str[i] = NULL;
+  accounting->mode = AOM_ACCOUNTING_SYMBOLS;
+  accounting->hist.sb_bits = NULL;
+  accounting->hist.sb_samples = NULL;
+  accounting->hist.sb_rows = 0;
+  accounting->hist.sb_cols = 0;
+  accounting->sb_allocated = 0;
+  accounting->mib_size_log2 = 0;
   aom_accounting_reset(accounting);
 }
 
@@ -71,18 +94,57 @@ void aom_accounting_reset(Accounting *accounting) {
   accounting->context.x = -1;
   accounting->context.y = -1;
   accounting->last_tell_frac = 0;
+  memset(accounting->hist.bits, 0, sizeof(accounting->hist.bits));
+  memset(accounting->hist.samples, 0, sizeof(accounting->hist.samples));
+  if (accounting->hist.sb_bits) {
+    const int num_sbs = accounting->hist.sb_rows * accounting->hist.sb_cols;
+    memset(accounting->hist.sb_bits, 0, num_sbs * sizeof(uint32_t));
+    memset(accounting->hist.sb_samples, 0, num_sbs * sizeof(uint32_t));
+  }
 }
 
 void aom_accounting_clear(Accounting *accounting) {
   int i;
   AccountingDictionary *dictionary;
   free(accounting->syms.syms);
+  free(accounting->hist.sb_bits);
+  free(accounting->hist.sb_samples);
+  accounting->hist.sb_bits = NULL;
+  accounting->hist.sb_samples = NULL;
+  accounting->sb_allocated = 0;
   dictionary = &accounting->syms.dictionary;
   for (i = 0; i < dictionary->num_strs; i++) {
     free(dictionary->strs[i]);
   }
 }
 
+void aom_accounting_set_mode(Accounting *accounting, AccountingMode mode) {
+  accounting->mode = mode;
+}
+
+/* Sizes the superblock arena for the next frame. It only grows, so decoding
+   a sequence of same sized frames never reallocates. The counters are zeroed
+   by aom_accounting_reset(). */
+void aom_accounting_set_frame_size(Accounting *accounting, int mi_rows,
+                                   int mi_cols, int mib_size_log2) {
+  const int mask = (1 << mib_size_log2) - 1;
+  const int sb_rows = (mi_rows + mask) >> mib_size_log2;
+  const int sb_cols = (mi_cols + mask) >> mib_size_log2;
+  const int num_sbs = sb_rows * sb_cols;
+  if (num_sbs > accounting->sb_allocated) {
+    free(accounting->hist.sb_bits);
+    free(accounting->hist.sb_samples);
+    accounting->hist.sb_bits = malloc(num_sbs * sizeof(uint32_t));
+    accounting->hist.sb_samples = malloc(num_sbs * sizeof(uint32_t));
+    assert(accounting->hist.sb_bits != NULL);
+    assert(accounting->hist.sb_samples != NULL);
+    accounting->sb_allocated = num_sbs;
+  }
+  accounting->hist.sb_rows = sb_rows;
+  accounting->hist.sb_cols = sb_cols;
+  accounting->mib_size_log2 = mib_size_log2;
+}
+
 void aom_accounting_set_context(Accounting *accounting, int16_t x, int16_t y) {
   accounting->context.x = x;
   accounting->context.y = y;
@@ -91,25 +153,36 @@ void aom_accounting_set_context(Accounting *accounting, int16_t x, int16_t y) {
 void aom_accounting_record(Accounting *accounting, const char *str,
                            uint32_t bits) {
   AccountingSymbol sym;
+  const uint32_t id = accounting_symbol_id(accounting, str);
+  AccountingHistogram *const hist = &accounting->hist;
+  hist->bits[id] += bits;
+  hist->samples[id]++;
+  if (accounting->context.x >= 0 && accounting->context.y >= 0 &&
+      hist->sb_bits != NULL) {
+    const int sb_row = accounting->context.y >> accounting->mib_size_log2;
+    const int sb_col = accounting->context.x >> accounting->mib_size_log2;
+    if (sb_row < hist->sb_rows && sb_col < hist->sb_cols) {
+      hist->sb_bits[sb_row * hist->sb_cols + sb_col] += bits;
+      hist->sb_samples[sb_row * hist->sb_cols + sb_col]++;
+    }
+  }
+  if (accounting->mode != AOM_ACCOUNTING_SYMBOLS) return;
   // Reuse previous symbol if it has the same context and symbol id.
   if (accounting->syms.num_syms) {
     AccountingSymbol *last_sym;
     last_sym = &accounting->syms.syms[accounting->syms.num_syms - 1];
-    if (memcmp(&last_sym->context, &accounting->context,
+    if (id == last_sym->id &&
+        memcmp(&last_sym->context, &accounting->context,
                sizeof(AccountingSymbolContext)) == 0) {
-      uint32_t id;
-      id = aom_accounting_dictionary_lookup(accounting, str);
-      if (id == last_sym->id) {
-        last_sym->bits += bits;
-        last_sym->samples++;
-        return;
-      }
+      last_sym->bits += bits;
+      last_sym->samples++;
+      return;
     }
   }
   sym.context = accounting->context;
   sym.samples = 1;
   sym.bits = bits;
-  sym.id = aom_accounting_dictionary_lookup(accounting, str);
+  sym.id = id;
   assert(sym.id <= 255);
   if (accounting->syms.num_syms == accounting->num_syms_allocated) {
     accounting->num_syms_allocated *= 2;
@@ -11,6 +11,7 @@
 #ifndef AOM_ACCOUNTING_H_
 #define AOM_ACCOUNTING_H_
 #include <stdlib.h>
+#include "aom/aom_integer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,6 +27,17 @@ extern "C" {
    3 => 1/8th bits.*/
 #define AOM_ACCT_BITRES (3)
 
+/* Number of entries in the cache mapping symbol name pointers to ids. Must be
+   a power of two. */
+#define AOM_ACCOUNTING_PTR_CACHE_SIZE (512)
+
+typedef enum {
+  /** Record every run of symbols together with its block position. */
+  AOM_ACCOUNTING_SYMBOLS,
+  /** Only accumulate the per symbol type and per superblock counters. */
+  AOM_ACCOUNTING_HISTOGRAM,
+} AccountingMode;
+
 typedef struct {
   int16_t x;
   int16_t y;
@@ -58,6 +70,21 @@ typedef struct {
   AccountingDictionary dictionary;
 } AccountingSymbols;
 
+/** Per frame counters, indexed by dictionary id and by superblock. */
+typedef struct {
+  /** Bits per symbol type, in units of 1/8 bit. */
+  uint64_t bits[MAX_SYMBOL_TYPES];
+  /** Number of symbols read per symbol type. */
+  uint32_t samples[MAX_SYMBOL_TYPES];
+  /** Bits of the symbols read in each superblock, in raster order and in
+      units of 1/8 bit. Symbols read outside of a block are not included. */
+  uint32_t *sb_bits;
+  /** Number of symbols read in each superblock. */
+  uint32_t *sb_samples;
+  int sb_rows;
+  int sb_cols;
+} AccountingHistogram;
+
 typedef struct Accounting Accounting;
 
 struct Accounting {
@@ -67,11 +94,23 @@ struct Accounting {
   int16_t hash_dictionary[AOM_ACCOUNTING_HASH_SIZE];
   AccountingSymbolContext context;
   uint32_t last_tell_frac;
+  AccountingMode mode;
+  AccountingHistogram hist;
+  /** Number of superblocks the histogram arena can hold. */
+  int sb_allocated;
+  int mib_size_log2;
+  /** Symbol names are string literals or __func__, so their addresses are
+      stable and can be used to skip the string hash in the common case. */
+  const char *ptr_cache_str[AOM_ACCOUNTING_PTR_CACHE_SIZE];
+  int16_t ptr_cache_id[AOM_ACCOUNTING_PTR_CACHE_SIZE];
 };
 
 void aom_accounting_init(Accounting *accounting);
 void aom_accounting_reset(Accounting *accounting);
 void aom_accounting_clear(Accounting *accounting);
+void aom_accounting_set_mode(Accounting *accounting, AccountingMode mode);
+void aom_accounting_set_frame_size(Accounting *accounting, int mi_rows,
+                                   int mi_cols, int mib_size_log2);
 void aom_accounting_set_context(Accounting *accounting, int16_t x, int16_t y);
 int aom_accounting_dictionary_lookup(Accounting *accounting, const char *str);
 void aom_accounting_record(Accounting *accounting, const char *str,
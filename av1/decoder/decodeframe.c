@@ -69,6 +69,9 @@
 
 #define MAX_AV1_HEADER_SIZE 80
 #define ACCT_STR __func__
+// How far into the decoded tiles, in luma pixels, the loop filter, CDEF and
+// loop restoration can carry the contents of the tiles left out.
+#define DECODE_REGION_MARGIN 32
 
 #if CONFIG_CFL
 #include "av1/common/cfl.h"
@@ -278,12 +281,14 @@ static void decode_reconstruct_tx(AV1_COMMON *cm, MACROBLOCKD *const xd,
     ++cm->txb_count;
 #endif
 
-    inverse_transform_block(
-        xd, plane, tx_type, tx_size,
-        &pd->dst
-             .buf[(blk_row * pd->dst.stride + blk_col) << tx_size_wide_log2[0]],
-        pd->dst.stride, max_scan_line, eob, cm->reduced_tx_set_used);
-    *eob_total += eob;
+    if (eob) {
+      inverse_transform_block(
+          xd, plane, tx_type, tx_size,
+          &pd->dst.buf[(blk_row * pd->dst.stride + blk_col)
+                       << tx_size_wide_log2[0]],
+          pd->dst.stride, max_scan_line, eob, cm->reduced_tx_set_used);
+      *eob_total += eob;
+    }
   } else {
     const TX_SIZE sub_txs = sub_tx_size_map[1][tx_size];
     assert(IMPLIES(tx_size <= TX_4X4, sub_txs == tx_size));
@@ -384,6 +389,206 @@ static void decode_mbmi_block(AV1Decoder *const pbi, MACROBLOCKD *const xd,
   aom_merge_corrupted_flag(&xd->corrupted, reader_corrupted_flag);
 }
 
+// Grows r by the luma area that a warp with the affine model wm reads when it
+// covers the pixels of block: the area spanned by its mapped corners, plus
+// the taps of the warp filter, which reach twice as far in luma pixels for
+// subsampled chroma.
+static void add_warp_read_rect(const WarpedMotionParams *wm,
+                               const AV1PixelRect *block, AV1PixelRect *r) {
+  const int32_t *const mat = wm->wmmat;
+  const int ext = 2 * 8;
+  for (int i = 0; i < 4; ++i) {
+    const int64_t x = i & 1 ? block->right : block->left;
+    const int64_t y = i & 2 ? block->bottom : block->top;
+    const int64_t px =
+        clamp64((mat[2] * x + mat[3] * y + mat[0]) >> WARPEDMODEL_PREC_BITS,
+                INT_MIN / 2, INT_MAX / 2);
+    const int64_t py =
+        clamp64((mat[4] * x + mat[5] * y + mat[1]) >> WARPEDMODEL_PREC_BITS,
+                INT_MIN / 2, INT_MAX / 2);
+    r->left = AOMMIN(r->left, (int)px - ext);
+    r->top = AOMMIN(r->top, (int)py - ext);
+    r->right = AOMMAX(r->right, (int)px + 1 + ext);
+    r->bottom = AOMMAX(r->bottom, (int)py + 1 + ext);
+  }
+}
+
+// Grows read[] by the luma area of each reference frame that the inter
+// prediction of mi reads when it covers the pixels of block.
+static void add_ref_read_rects(const AV1_COMMON *const cm,
+                               const MODE_INFO *const mi,
+                               const AV1PixelRect *block, AV1PixelRect *read) {
+  const MB_MODE_INFO *const mbmi = &mi->mbmi;
+  if (!is_inter_block(mbmi)) return;
+
+  for (int ref = 0; ref < 1 + has_second_ref(mbmi); ++ref) {
+    const MV_REFERENCE_FRAME frame = mbmi->ref_frame[ref];
+    if (frame < LAST_FRAME) continue;
+    const RefBuffer *const ref_buf = &cm->frame_refs[frame - LAST_FRAME];
+    AV1PixelRect *const r = &read[frame - LAST_FRAME];
+    const WarpedMotionParams *const gm = &cm->global_motion[frame];
+    const int global_warp = is_global_mv_block(mi, -1, gm->wmtype);
+    // Scaled predictions and projective warps may reach anywhere in the
+    // reference.
+    if (av1_is_scaled(&ref_buf->sf) || (global_warp && gm->wmtype > AFFINE)) {
+      r->left = r->top = INT_MIN;
+      r->right = r->bottom = INT_MAX;
+      continue;
+    }
+    // Blocks fall back to the motion vector when the warp cannot be used.
+    if (mbmi->motion_mode == WARPED_CAUSAL)
+      add_warp_read_rect(&mbmi->wm_params[0], block, r);
+    if (global_warp) add_warp_read_rect(gm, block, r);
+    const MV mv = mbmi->mv[ref].as_mv;
+    // The full-pel area plus the taps of the subpel filter, which reach twice
+    // as far in luma pixels for subsampled chroma.
+    const int ext = 2 * AOM_INTERP_EXTEND;
+    r->left = AOMMIN(r->left, block->left + (mv.col >> 3) - ext);
+    r->top = AOMMIN(r->top, block->top + (mv.row >> 3) - ext);
+    r->right = AOMMAX(r->right, block->right + ((mv.col + 7) >> 3) + ext);
+    r->bottom = AOMMAX(r->bottom, block->bottom + ((mv.row + 7) >> 3) + ext);
+  }
+}
+
+// Sets read[] to the luma area of each reference frame that the inter
+// prediction of the current block reads, or to an empty area for the
+// references it does not use.
+static void get_ref_read_rects(const AV1_COMMON *const cm,
+                               const MACROBLOCKD *const xd, int mi_row,
+                               int mi_col, BLOCK_SIZE bsize,
+                               AV1PixelRect *read) {
+  const MB_MODE_INFO *const mbmi = &xd->mi[0]->mbmi;
+  AV1PixelRect block;
+  int i;
+
+  for (i = 0; i < INTER_REFS_PER_FRAME; ++i) {
+    read[i].left = read[i].top = INT_MAX;
+    read[i].right = read[i].bottom = INT_MIN;
+  }
+  block.left = mi_col * MI_SIZE;
+  block.top = mi_row * MI_SIZE;
+  block.right = (mi_col + mi_size_wide[bsize]) * MI_SIZE;
+  block.bottom = (mi_row + mi_size_high[bsize]) * MI_SIZE;
+  add_ref_read_rects(cm, xd->mi[0], &block, read);
+
+  // Sub8x8 chroma predictions use the motion of the blocks above and to the
+  // left that share the chroma block.
+  if (mi_size_high[bsize] == 1 || mi_size_wide[bsize] == 1) {
+    const int row_start = mi_size_high[bsize] == 1 && (mi_row & 1) ? -1 : 0;
+    const int col_start = mi_size_wide[bsize] == 1 && (mi_col & 1) ? -1 : 0;
+    AV1PixelRect chroma_block = block;
+    chroma_block.left += col_start * MI_SIZE;
+    chroma_block.top += row_start * MI_SIZE;
+    for (int row = row_start; row <= 0; ++row)
+      for (int col = col_start; col <= 0; ++col)
+        add_ref_read_rects(cm, xd->mi[row * xd->mi_stride + col],
+                           &chroma_block, read);
+  }
+
+  // OBMC blends in predictions made with the motion of the neighbors.
+  if (mbmi->motion_mode == OBMC_CAUSAL) {
+    if (xd->up_available) {
+      const int end_col = AOMMIN(mi_col + xd->n8_w, cm->mi_cols) - mi_col;
+      for (i = 0; i < end_col; ++i)
+        add_ref_read_rects(cm, xd->mi[-xd->mi_stride + i], &block, read);
+    }
+    if (xd->left_available) {
+      const int end_row = AOMMIN(mi_row + xd->n8_h, cm->mi_rows) - mi_row;
+      for (i = 0; i < end_row; ++i)
+        add_ref_read_rects(cm, xd->mi[i * xd->mi_stride - 1], &block, read);
+    }
+  }
+}
+
+// In frame parallel mode, waits until every reference frame read by the
+// inter prediction of the current block has progressed far enough.
+static void wait_for_ref_rows(AV1Decoder *const pbi,
+                              const AV1PixelRect *read) {
+  AV1_COMMON *const cm = &pbi->common;
+
+  for (int i = 0; i < INTER_REFS_PER_FRAME; ++i) {
+    if (read[i].left > read[i].right) continue;
+    RefCntBuffer *const ref =
+        &cm->buffer_pool->frame_bufs[cm->frame_refs[i].idx];
+    // Rows past the frame are only valid once the border is extended.
+    const int row =
+        read[i].bottom > ref->buf.y_crop_height ? INT_MAX : read[i].bottom;
+    av1_frameworker_wait(pbi->frame_worker_owner, ref, row);
+  }
+}
+
+// Shrinks the valid area of the new frame, see set_valid_rect(), to leave out
+// the current block, whose inter prediction reads outside the valid area of
+// a reference frame. The error spreads through intra prediction to the
+// right and down the tile, and up to the top of the superblock, so the area
+// keeps the larger of the part above the superblock row and the parts on
+// each side of the tile.
+static void cut_valid_rect(AV1Decoder *pbi, const TileInfo *tile, int mi_row) {
+  AV1_COMMON *const cm = &pbi->common;
+  AV1PixelRect *const rect = &pbi->cur_buf->valid_rect;
+  const int tile_left = tile->mi_col_start << MI_SIZE_LOG2;
+  const int tile_top = tile->mi_row_start << MI_SIZE_LOG2;
+  const int tile_right = tile->mi_col_end << MI_SIZE_LOG2;
+  const int tile_bottom = tile->mi_row_end << MI_SIZE_LOG2;
+
+  // Only the post filters read across tile edges.
+  if (tile_right + DECODE_REGION_MARGIN <= rect->left ||
+      tile_left >= rect->right + DECODE_REGION_MARGIN ||
+      tile_bottom + DECODE_REGION_MARGIN <= rect->top ||
+      tile_top >= rect->bottom + DECODE_REGION_MARGIN)
+    return;
+
+  AV1PixelRect cuts[4];
+  for (int i = 0; i < 4; ++i) cuts[i] = *rect;
+  cuts[0].bottom = AOMMIN(rect->bottom,
+                          ((mi_row & ~(cm->mib_size - 1)) << MI_SIZE_LOG2) -
+                              DECODE_REGION_MARGIN);
+  cuts[1].right = AOMMIN(rect->right, tile_left - DECODE_REGION_MARGIN);
+  cuts[2].left = AOMMAX(rect->left, tile_right + DECODE_REGION_MARGIN);
+  cuts[3].top = AOMMAX(rect->top, tile_bottom + DECODE_REGION_MARGIN);
+  int64_t best_area = -1;
+  for (int i = 0; i < 4; ++i) {
+    const int64_t area =
+        cuts[i].left < cuts[i].right && cuts[i].top < cuts[i].bottom
+            ? (int64_t)(cuts[i].right - cuts[i].left) *
+                  (cuts[i].bottom - cuts[i].top)
+            : 0;
+    if (area > best_area) {
+      best_area = area;
+      *rect = cuts[i];
+    }
+  }
+  if (best_area == 0) av1_zero(*rect);
+}
+
+// Checks that the inter prediction of the current block only reads the valid
+// area of its reference frames, and otherwise leaves it out of the valid area
+// of the new frame.
+static void check_ref_regions(AV1Decoder *const pbi, const MACROBLOCKD *xd,
+                              int mi_row, const AV1PixelRect *read) {
+  AV1_COMMON *const cm = &pbi->common;
+
+  for (int i = 0; i < INTER_REFS_PER_FRAME; ++i) {
+    if (read[i].left > read[i].right) continue;
+    const RefCntBuffer *const ref =
+        &cm->buffer_pool->frame_bufs[cm->frame_refs[i].idx];
+    const AV1PixelRect *const valid = &ref->valid_rect;
+    // Reads past the frame land in the border, which is extended from the
+    // pixels on the frame edge.
+    const int width = ref->buf.y_crop_width;
+    const int height = ref->buf.y_crop_height;
+    const int left = clamp(read[i].left, 0, width - 1);
+    const int top = clamp(read[i].top, 0, height - 1);
+    const int right = clamp(read[i].right, 1, width);
+    const int bottom = clamp(read[i].bottom, 1, height);
+    if (left < valid->left || top < valid->top || right > valid->right ||
+        bottom > valid->bottom) {
+      cut_valid_rect(pbi, &xd->tile, mi_row);
+      return;
+    }
+  }
+}
+
 static void decode_token_and_recon_block(AV1Decoder *const pbi,
                                          MACROBLOCKD *const xd, int mi_row,
                                          int mi_col, aom_reader *r,
@@ -402,7 +607,8 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
       mi_row, mi_col, bsize, cfl->subsampling_x, cfl->subsampling_y);
 #endif  // CONFIG_CFL
 
-  if (cm->delta_q_present_flag) {
+  // Skip blocks read no coefficients, so they do not need the dequantizers.
+  if (cm->delta_q_present_flag && !mbmi->skip) {
     for (int i = 0; i < MAX_SEGMENTS; i++) {
 #if CONFIG_EXT_DELTA_Q
       const int current_qindex =
@@ -491,6 +697,13 @@ static void decode_token_and_recon_block(AV1Decoder *const pbi,
       }
     }
 
+    if (cm->frame_parallel_decode || pbi->check_ref_regions) {
+      AV1PixelRect read[INTER_REFS_PER_FRAME];
+      get_ref_read_rects(cm, xd, mi_row, mi_col, bsize, read);
+      if (cm->frame_parallel_decode) wait_for_ref_rows(pbi, read);
+      if (pbi->check_ref_regions) check_ref_regions(pbi, xd, mi_row, read);
+    }
+
     av1_build_inter_predictors_sb(cm, xd, mi_row, mi_col, NULL, bsize);
 
     if (mbmi->motion_mode == OBMC_CAUSAL) {
@@ -1989,7 +2202,7 @@ static void get_tile_buffers(AV1Decoder *pbi, const uint8_t *data,
   const int tile_cols = cm->tile_cols;
   const int tile_rows = cm->tile_rows;
   int tc = 0;
-  int first_tile_in_tg = 0;
+  int first_tile_in_tg = startTile;
 #if !CONFIG_OBU
   struct aom_read_bit_buffer rb_tg_hdr;
   uint8_t clear_data[MAX_AV1_HEADER_SIZE];
@@ -2003,8 +2216,15 @@ static void get_tile_buffers(AV1Decoder *pbi, const uint8_t *data,
 #endif
 
 #if CONFIG_SIMPLE_BWD_ADAPT
+  // A frame decoded one tile group at a time carries on from the largest tile
+  // of the earlier tile groups.
   size_t max_tile_size = 0;
-  cm->largest_tile_id = 0;
+  if (startTile == 0)
+    cm->largest_tile_id = 0;
+  else
+    max_tile_size = tile_buffers[cm->largest_tile_id / tile_cols]
+                                [cm->largest_tile_id % tile_cols]
+                                    .size;
 #endif
   for (int r = 0; r < tile_rows; ++r) {
     for (int c = 0; c < tile_cols; ++c, ++tc) {
@@ -2073,6 +2293,416 @@ static void dec_setup_across_tile_boundary_info(
 }
 #endif  // CONFIG_LOOPFILTERING_ACROSS_TILES
 
+// Returns 1 if the reconstructed frame is still modified after all its tiles
+// are decoded, in which case decoding progress can only be published once the
+// whole frame is finished.
+static int frame_has_post_filter(const AV1Decoder *pbi) {
+  const AV1_COMMON *const cm = &pbi->common;
+#if CONFIG_EXT_TILE
+  if (cm->large_scale_tile) return 1;
+#endif  // CONFIG_EXT_TILE
+#if CONFIG_MONO_VIDEO
+  if (pbi->monochrome || cm->seq_params.monochrome) return 1;
+#endif  // CONFIG_MONO_VIDEO
+#if CONFIG_LPF_SB
+  return 1;
+#elif CONFIG_LOOPFILTER_LEVEL
+  if (cm->lf.filter_level[0] || cm->lf.filter_level[1]) return 1;
+#else
+  if (cm->lf.filter_level) return 1;
+#endif  // CONFIG_LPF_SB
+  if (!cm->all_lossless &&
+      (cm->cdef_bits || cm->cdef_strengths[0] || cm->cdef_uv_strengths[0]))
+    return 1;
+#if CONFIG_FRAME_SUPERRES
+  if (!av1_superres_unscaled(cm)) return 1;
+#endif  // CONFIG_FRAME_SUPERRES
+#if CONFIG_LOOP_RESTORATION
+  for (int plane = 0; plane < av1_num_planes(cm); ++plane)
+    if (cm->rst_info[plane].frame_restoration_type != RESTORE_NONE) return 1;
+#endif  // CONFIG_LOOP_RESTORATION
+  return 0;
+}
+
+// Extends the borders of the final rows decoded since the last call and lets
+// the frame workers waiting on this frame read luma rows up to row_end.
+static void publish_decoded_rows(AV1Decoder *pbi, int row_end) {
+  YV12_BUFFER_CONFIG *const buf = &pbi->cur_buf->buf;
+  row_end = AOMMIN(row_end, buf->y_crop_height);
+  if (row_end <= pbi->published_rows) return;
+  aom_extend_frame_borders_rows(buf, pbi->published_rows, row_end);
+  pbi->published_rows = row_end;
+  if (row_end < buf->y_crop_height) ++pbi->row_publishes;
+  av1_frameworker_broadcast(pbi->cur_buf, row_end == buf->y_crop_height
+                                              ? INT_MAX
+                                              : row_end);
+}
+
+static INLINE int row_filter_active(const AV1Decoder *pbi) {
+#if !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+  return pbi->row_filter.active;
+#else
+  (void)pbi;
+  return 0;
+#endif  // !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+}
+
+#if !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+static int frame_deblocks(const AV1_COMMON *cm) {
+#if CONFIG_INTRABC
+  if (cm->allow_intrabc && NO_FILTER_FOR_IBC) return 0;
+#endif  // CONFIG_INTRABC
+#if CONFIG_LOOPFILTER_LEVEL
+  return cm->lf.filter_level[0] || cm->lf.filter_level[1];
+#else
+  return cm->lf.filter_level != 0;
+#endif  // CONFIG_LOOPFILTER_LEVEL
+}
+
+static int frame_applies_cdef(const AV1_COMMON *cm) {
+#if CONFIG_INTRABC
+  if (cm->allow_intrabc && NO_FILTER_FOR_IBC) return 0;
+#endif  // CONFIG_INTRABC
+  return !cm->skip_loop_filter && !cm->all_lossless &&
+         (cm->cdef_bits || cm->cdef_strengths[0] || cm->cdef_uv_strengths[0]);
+}
+
+#if CONFIG_LOOP_RESTORATION
+static int frame_restores(const AV1_COMMON *cm) {
+  for (int plane = 0; plane < av1_num_planes(cm); ++plane)
+    if (cm->rst_info[plane].frame_restoration_type != RESTORE_NONE) return 1;
+  return 0;
+}
+#endif  // CONFIG_LOOP_RESTORATION
+
+// Sets up the post filters of the frame to run a few rows behind the decoded
+// superblock rows, see filter_decoded_rows(), unless the frame is only
+// filtered whole.
+static void init_row_filter(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  DecRowFilter *const rf = &pbi->row_filter;
+
+  rf->active = 0;
+#if CONFIG_EXT_TILE
+  if (cm->large_scale_tile) return;
+#endif  // CONFIG_EXT_TILE
+#if CONFIG_MONO_VIDEO
+  if (pbi->monochrome || cm->seq_params.monochrome) return;
+#endif  // CONFIG_MONO_VIDEO
+#if CONFIG_FRAME_SUPERRES
+  if (!av1_superres_unscaled(cm)) return;
+#endif  // CONFIG_FRAME_SUPERRES
+  // Tiles left out of a decode region or decoded out of order, and the
+  // multi-threaded loop filter, need the whole frame.
+  if (pbi->decode_region || pbi->inv_tile_order) return;
+  if (pbi->max_threads > 1 && frame_deblocks(cm)) return;
+
+  rf->active = 1;
+  rf->lf_mi_rows = 0;
+  rf->cdef_fb_rows = 0;
+#if CONFIG_LOOP_RESTORATION
+  av1_zero(rf->lr_saved_rows);
+  av1_zero(rf->lr_progress);
+  if (frame_restores(cm)) {
+    const YV12_BUFFER_CONFIG *const frame = get_frame_new_buffer(cm);
+    if (aom_realloc_frame_buffer(
+            &rf->lr_dst, frame->y_crop_width,
+            ALIGN_POWER_OF_TWO(frame->y_crop_height, 3), cm->subsampling_x,
+            cm->subsampling_y,
+#if CONFIG_HIGHBITDEPTH
+            cm->use_highbitdepth,
+#endif
+            AOM_BORDER_IN_PIXELS, cm->byte_alignment, NULL, NULL, NULL) < 0)
+      aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                         "Failed to allocate restoration dst buffer");
+  }
+#endif  // CONFIG_LOOP_RESTORATION
+}
+
+// Deblocks mi rows [start, stop) of frame.
+static void deblock_rows(AV1_COMMON *cm, MACROBLOCKD *xd,
+                         YV12_BUFFER_CONFIG *frame, int start, int stop) {
+#if CONFIG_LOOPFILTER_LEVEL
+  av1_loop_filter_frame_rows(frame, cm, xd, cm->lf.filter_level[0],
+                             cm->lf.filter_level[1], 0, start, stop);
+  av1_loop_filter_frame_rows(frame, cm, xd, cm->lf.filter_level_u,
+                             cm->lf.filter_level_u, 1, start, stop);
+  av1_loop_filter_frame_rows(frame, cm, xd, cm->lf.filter_level_v,
+                             cm->lf.filter_level_v, 2, start, stop);
+#else
+  av1_loop_filter_frame_rows(frame, cm, xd, cm->lf.filter_level, 0, start,
+                             stop);
+#endif  // CONFIG_LOOPFILTER_LEVEL
+}
+
+#if CONFIG_LOOP_RESTORATION && CONFIG_STRIPED_LOOP_RESTORATION
+// Saves the loop restoration boundary lines within the first luma_rows rows,
+// or the matching chroma rows, that were not saved yet.
+static void save_restoration_rows(AV1Decoder *pbi, int luma_rows,
+                                  int after_cdef) {
+  AV1_COMMON *const cm = &pbi->common;
+  DecRowFilter *const rf = &pbi->row_filter;
+  for (int plane = 0; plane < av1_num_planes(cm); ++plane) {
+    const int ss_y = plane > 0 && cm->subsampling_y;
+    const int rows = luma_rows >> ss_y;
+    int *const saved_rows = &rf->lr_saved_rows[after_cdef][plane];
+    if (cm->rst_info[plane].frame_restoration_type == RESTORE_NONE ||
+        rows <= *saved_rows)
+      continue;
+    av1_loop_restoration_save_boundary_rows(get_frame_new_buffer(cm), cm,
+                                            plane, *saved_rows, rows,
+                                            after_cdef);
+    *saved_rows = rows;
+  }
+}
+#endif  // CONFIG_LOOP_RESTORATION && CONFIG_STRIPED_LOOP_RESTORATION
+
+// Deblocks the first mi_rows decoded mi rows, then applies CDEF and loop
+// restoration to the rows whose input, including the rows each filter reads
+// below them, is final. In frame parallel decode, the rows that come out of
+// all the filters are published to the other frame workers.
+static void filter_decoded_rows(AV1Decoder *pbi, int mi_rows) {
+  AV1_COMMON *const cm = &pbi->common;
+  DecRowFilter *const rf = &pbi->row_filter;
+  YV12_BUFFER_CONFIG *const frame = get_frame_new_buffer(cm);
+  const int frame_rows = cm->mi_rows << MI_SIZE_LOG2;
+  const int done = mi_rows >= cm->mi_rows;
+  struct aom_usec_timer timer;
+
+  // The luma rows that are final so far, with the chroma rows in proportion.
+  int rows = AOMMIN(mi_rows, cm->mi_rows) << MI_SIZE_LOG2;
+
+  aom_usec_timer_start(&timer);
+  if (frame_deblocks(cm)) {
+    // Intra prediction of the next superblock row reads the unfiltered line
+    // above it, so deblocking stays a superblock row behind the decode.
+    const int lf_mi_rows = done ? mi_rows : mi_rows - cm->mib_size;
+    deblock_rows(cm, &pbi->mb, frame, rf->lf_mi_rows, lf_mi_rows);
+    rf->lf_mi_rows = lf_mi_rows;
+    // The horizontal edges at the top of the next rows change up to 6 luma
+    // and 2 chroma rows above them.
+    if (!done)
+      rows = AOMMAX(0, (lf_mi_rows << MI_SIZE_LOG2) - 2 * MI_SIZE);
+  }
+  aom_usec_timer_mark(&timer);
+  pbi->frame_timing.deblock_us += aom_usec_timer_elapsed(&timer);
+
+#if CONFIG_LOOP_RESTORATION && CONFIG_STRIPED_LOOP_RESTORATION
+  save_restoration_rows(pbi, done ? frame_rows : rows, 0);
+#endif  // CONFIG_LOOP_RESTORATION && CONFIG_STRIPED_LOOP_RESTORATION
+
+  if (frame_applies_cdef(cm)) {
+    const int nvfb = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const int fb_rows = MI_SIZE_64X64 << MI_SIZE_LOG2;
+    aom_usec_timer_start(&timer);
+    // Each row of 64x64 blocks reads CDEF_VBORDER rows below it, which are
+    // twice as many luma rows in subsampled chroma.
+    while (rf->cdef_fb_rows < nvfb &&
+           (done ||
+            (rf->cdef_fb_rows + 1) * fb_rows + 2 * CDEF_VBORDER <= rows)) {
+      if (rf->cdef_fb_rows == 0) {
+        av1_cdef_free_row_buffers(&rf->cdef_bufs);
+        av1_cdef_alloc_row_buffers(&rf->cdef_bufs, cm, &pbi->mb);
+      }
+      av1_cdef_fb_row(frame, cm, &pbi->mb, &rf->cdef_bufs, rf->cdef_fb_rows++);
+    }
+    rows = AOMMIN(rows, rf->cdef_fb_rows * fb_rows);
+    aom_usec_timer_mark(&timer);
+    pbi->frame_timing.cdef_us += aom_usec_timer_elapsed(&timer);
+  }
+  if (done) rows = frame_rows;
+
+#if CONFIG_LOOP_RESTORATION
+  if (frame_restores(cm)) {
+    int restored_rows = rows;
+#if CONFIG_STRIPED_LOOP_RESTORATION
+    save_restoration_rows(pbi, rows, 1);
+#endif  // CONFIG_STRIPED_LOOP_RESTORATION
+    aom_usec_timer_start(&timer);
+    for (int plane = 0; plane < av1_num_planes(cm); ++plane) {
+      const int ss_y = plane > 0 && cm->subsampling_y;
+      if (cm->rst_info[plane].frame_restoration_type == RESTORE_NONE) continue;
+      const int plane_rows = av1_loop_restoration_filter_rows(
+          frame, cm, plane, rows >> ss_y, &rf->lr_progress[plane],
+          &rf->lr_dst);
+      restored_rows = AOMMIN(restored_rows, plane_rows << ss_y);
+    }
+    rows = restored_rows;
+    aom_usec_timer_mark(&timer);
+    pbi->frame_timing.restoration_us += aom_usec_timer_elapsed(&timer);
+  }
+#endif  // CONFIG_LOOP_RESTORATION
+
+  if (cm->frame_parallel_decode)
+    publish_decoded_rows(pbi, done ? INT_MAX : rows);
+}
+#endif  // !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+
+// Sets [*start, *end) to the tiles whose span of luma pixels, given by the
+// tile bounds in tile_start, overlaps [lo, hi).
+static void get_tile_range(const int *tile_start, int num_tiles, int lo,
+                           int hi, int *start, int *end) {
+  *start = 0;
+  *end = 0;
+  for (int i = 0; i < num_tiles; ++i) {
+    if (tile_start[i + 1] <= lo)
+      *start = i + 1;
+    else if (tile_start[i] < hi)
+      *end = i + 1;
+  }
+  if (*end < *start) *end = *start;
+}
+
+static int same_region(const AV1PixelRect *a, const AV1PixelRect *b) {
+  return a->left == b->left && a->top == b->top && a->right == b->right &&
+         a->bottom == b->bottom;
+}
+
+// Picks the tiles of a normal tiled frame to decode: all of them, or only
+// those that overlap the region set with AV1D_SET_DECODE_REGION. A frame that
+// adapts the frame context from its tiles is always decoded whole, as the
+// frames after it depend on the symbols of every tile. So is a frame that
+// reads the motion vectors or the segment map of earlier frames, which are
+// not kept within the region, the first frame after the region moves, and a
+// frame the region does not fit in.
+static void get_tile_region(AV1Decoder *pbi, int *rows_start, int *rows_end,
+                            int *cols_start, int *cols_end) {
+  AV1_COMMON *const cm = &pbi->common;
+  int row_start[MAX_TILE_ROWS + 1];
+  int col_start[MAX_TILE_COLS + 1];
+  TileInfo tile_info;
+  const int region_moved = pbi->decode_region && pbi->last_decode_region &&
+                           !same_region(&pbi->region, &pbi->last_region);
+#if CONFIG_PARALLEL_DEBLOCKING
+  int skip_tiles = pbi->decode_region && cm->refresh_frame_context !=
+                                             REFRESH_FRAME_CONTEXT_BACKWARD;
+#else
+  // Only the parallel loop filter can step around the tiles left out.
+  int skip_tiles = 0;
+#endif  // CONFIG_PARALLEL_DEBLOCKING
+  pbi->last_decode_region = pbi->decode_region;
+  pbi->last_region = pbi->region;
+  if (!frame_is_intra_only(cm) &&
+      (cm->use_prev_frame_mvs || cm->use_ref_frame_mvs))
+    skip_tiles = 0;
+  if (cm->seg.enabled && cm->seg.temporal_update) skip_tiles = 0;
+  if (region_moved) skip_tiles = 0;
+#if CONFIG_FRAME_SUPERRES
+  if (!av1_superres_unscaled(cm)) skip_tiles = 0;
+#endif  // CONFIG_FRAME_SUPERRES
+  if (pbi->region.right > cm->width || pbi->region.bottom > cm->height)
+    skip_tiles = 0;
+#if CONFIG_DEPENDENT_HORZTILES
+  if (cm->dependent_horz_tiles) skip_tiles = 0;
+#endif  // CONFIG_DEPENDENT_HORZTILES
+
+  *rows_start = *cols_start = 0;
+  *rows_end = cm->tile_rows;
+  *cols_end = cm->tile_cols;
+  if (!skip_tiles) return;
+
+  for (int row = 0; row < cm->tile_rows; ++row) {
+    av1_tile_set_row(&tile_info, cm, row);
+    row_start[row] = tile_info.mi_row_start << MI_SIZE_LOG2;
+    row_start[row + 1] = tile_info.mi_row_end << MI_SIZE_LOG2;
+  }
+  for (int col = 0; col < cm->tile_cols; ++col) {
+    av1_tile_set_col(&tile_info, cm, col);
+    col_start[col] = tile_info.mi_col_start << MI_SIZE_LOG2;
+    col_start[col + 1] = tile_info.mi_col_end << MI_SIZE_LOG2;
+  }
+  get_tile_range(row_start, cm->tile_rows, pbi->region.top,
+                 pbi->region.bottom, rows_start, rows_end);
+  get_tile_range(col_start, cm->tile_cols, pbi->region.left,
+                 pbi->region.right, cols_start, cols_end);
+  if (*rows_start == *rows_end || *cols_start == *cols_end)
+    *rows_start = *rows_end = *cols_start = *cols_end = 0;
+}
+
+// Sets the area of the new frame that matches a full decode, before any of its
+// blocks are decoded: the decoded tiles, less a margin along their edges
+// inside the frame, and within the valid area of every reference frame. The
+// blocks that predict from outside those areas are cut out as they are
+// decoded, see check_ref_regions().
+static void set_valid_rect(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  const YV12_BUFFER_CONFIG *const buf = &pbi->cur_buf->buf;
+  AV1PixelRect *const rect = &pbi->cur_buf->valid_rect;
+  TileInfo first, last;
+
+  pbi->check_ref_regions = 0;
+  if (pbi->tile_rows_start == pbi->tile_rows_end) {
+    av1_zero(*rect);
+    return;
+  }
+  av1_tile_init(&first, cm, pbi->tile_rows_start, pbi->tile_cols_start);
+  av1_tile_init(&last, cm, pbi->tile_rows_end - 1, pbi->tile_cols_end - 1);
+  rect->left = first.mi_col_start << MI_SIZE_LOG2;
+  rect->top = first.mi_row_start << MI_SIZE_LOG2;
+  rect->right = last.mi_col_end << MI_SIZE_LOG2;
+  rect->bottom = last.mi_row_end << MI_SIZE_LOG2;
+  if (pbi->tile_cols_start > 0) rect->left += DECODE_REGION_MARGIN;
+  if (pbi->tile_rows_start > 0) rect->top += DECODE_REGION_MARGIN;
+  if (pbi->tile_cols_end < cm->tile_cols)
+    rect->right -= DECODE_REGION_MARGIN;
+  else
+    rect->right = buf->y_crop_width;
+  if (pbi->tile_rows_end < cm->tile_rows)
+    rect->bottom -= DECODE_REGION_MARGIN;
+  else
+    rect->bottom = buf->y_crop_height;
+
+  // Frame parallel decode always decodes whole frames, and the references
+  // may still be decoding.
+  if (!frame_is_intra_only(cm) && !cm->frame_parallel_decode) {
+    for (int i = 0; i < INTER_REFS_PER_FRAME; ++i) {
+      const RefBuffer *const ref = &cm->frame_refs[i];
+      if (ref->idx < 0) continue;
+      const RefCntBuffer *const ref_frame =
+          &cm->buffer_pool->frame_bufs[ref->idx];
+      const AV1PixelRect *const ref_rect = &ref_frame->valid_rect;
+      rect->left = AOMMAX(rect->left, ref_rect->left);
+      rect->top = AOMMAX(rect->top, ref_rect->top);
+      rect->right = AOMMIN(rect->right, ref_rect->right);
+      rect->bottom = AOMMIN(rect->bottom, ref_rect->bottom);
+      if (ref_rect->left > 0 || ref_rect->top > 0 ||
+          ref_rect->right < ref_frame->buf.y_crop_width ||
+          ref_rect->bottom < ref_frame->buf.y_crop_height)
+        pbi->check_ref_regions = 1;
+    }
+  }
+  if (rect->left >= rect->right || rect->top >= rect->bottom) {
+    av1_zero(*rect);
+    pbi->check_ref_regions = 0;
+  }
+}
+
+#if !CONFIG_LPF_SB
+// Creates the worker pool the loop filter is spread over. The last worker
+// runs on the calling thread.
+static void init_lf_workers(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  const int num_workers = pbi->max_threads;
+  int i;
+
+  if (pbi->num_tile_workers > 0) return;
+
+  CHECK_MEM_ERROR(cm, pbi->tile_workers,
+                  aom_malloc(num_workers * sizeof(*pbi->tile_workers)));
+  for (i = 0; i < num_workers; ++i) {
+    AVxWorker *const worker = &pbi->tile_workers[i];
+    ++pbi->num_tile_workers;
+
+    winterface->init(worker);
+    if (i < num_workers - 1 && !winterface->reset(worker)) {
+      aom_internal_error(&cm->error, AOM_CODEC_ERROR,
+                         "Loop filter thread creation failed");
+    }
+  }
+}
+#endif  // !CONFIG_LPF_SB
+
 static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
                                    const uint8_t *data_end, int startTile,
                                    int endTile) {
@@ -2110,16 +2740,28 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
     allow_update_cdf = 0;
   } else {
 #endif  // CONFIG_EXT_TILE
-    tile_rows_start = 0;
-    tile_rows_end = tile_rows;
-    tile_cols_start = 0;
-    tile_cols_end = tile_cols;
+    // The tiles to decode are picked once per frame, with its first tile
+    // group.
+    if (startTile == 0) {
+      get_tile_region(pbi, &tile_rows_start, &tile_rows_end,
+                      &tile_cols_start, &tile_cols_end);
+    } else {
+      tile_rows_start = pbi->tile_rows_start;
+      tile_rows_end = pbi->tile_rows_end;
+      tile_cols_start = pbi->tile_cols_start;
+      tile_cols_end = pbi->tile_cols_end;
+    }
     inv_col_order = pbi->inv_tile_order;
     inv_row_order = pbi->inv_tile_order;
     allow_update_cdf = 1;
 #if CONFIG_EXT_TILE
   }
 #endif  // CONFIG_EXT_TILE
+  pbi->tile_rows_start = tile_rows_start;
+  pbi->tile_rows_end = tile_rows_end;
+  pbi->tile_cols_start = tile_cols_start;
+  pbi->tile_cols_end = tile_cols_end;
+  if (startTile == 0) set_valid_rect(pbi);
 
 #if !CONFIG_LOOPFILTER_LEVEL
   if (cm->lf.filter_level && !cm->skip_loop_filter &&
@@ -2154,15 +2796,13 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
 
   if (pbi->tile_data == NULL || n_tiles != pbi->allocated_tiles) {
     aom_free(pbi->tile_data);
+    aom_free(pbi->tile_decode_us);
     CHECK_MEM_ERROR(cm, pbi->tile_data,
                     aom_memalign(32, n_tiles * (sizeof(*pbi->tile_data))));
+    CHECK_MEM_ERROR(cm, pbi->tile_decode_us,
+                    aom_calloc(n_tiles, sizeof(*pbi->tile_decode_us)));
     pbi->allocated_tiles = n_tiles;
   }
-#if CONFIG_ACCOUNTING
-  if (pbi->acct_enabled) {
-    aom_accounting_reset(&pbi->accounting);
-  }
-#endif
   // Load all tile information into tile_data.
   for (tile_row = tile_rows_start; tile_row < tile_rows_end; ++tile_row) {
     for (tile_col = tile_cols_start; tile_col < tile_cols_end; ++tile_col) {
@@ -2203,20 +2843,31 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
   }
 
   for (tile_row = tile_rows_start; tile_row < tile_rows_end; ++tile_row) {
-    const int row = inv_row_order ? tile_rows - 1 - tile_row : tile_row;
+    const int row =
+        inv_row_order ? tile_rows_start + tile_rows_end - 1 - tile_row
+                      : tile_row;
     int mi_row = 0;
     TileInfo tile_info;
 
+    if ((tile_row + 1) * tile_cols <= startTile ||
+        tile_row * tile_cols > endTile)
+      continue;
+
     av1_tile_set_row(&tile_info, cm, row);
 
     for (tile_col = tile_cols_start; tile_col < tile_cols_end; ++tile_col) {
-      const int col = inv_col_order ? tile_cols - 1 - tile_col : tile_col;
+      const int col =
+          inv_col_order ? tile_cols_start + tile_cols_end - 1 - tile_col
+                        : tile_col;
       TileData *const td = pbi->tile_data + tile_cols * row + col;
+      struct aom_usec_timer tile_timer;
 
       if (tile_row * cm->tile_cols + tile_col < startTile ||
           tile_row * cm->tile_cols + tile_col > endTile)
         continue;
 
+      aom_usec_timer_start(&tile_timer);
+
 #if CONFIG_ACCOUNTING
       if (pbi->acct_enabled) {
         td->bit_reader.accounting->last_tell_frac =
@@ -2275,51 +2926,93 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
         if (pbi->mb.corrupted)
           aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
                              "Failed to decode tile data");
+        // The tile columns left of the last one are already decoded down to
+        // the end of the tile row, so the superblock row is complete.
+        if (tile_col == tile_cols_end - 1) {
+          const int mi_row_end =
+              AOMMIN(mi_row + cm->mib_size, tile_info.mi_row_end);
+#if !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+          if (row_filter_active(pbi)) filter_decoded_rows(pbi, mi_row_end);
+#endif  // !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+          if (!inv_row_order)
+            pbi->decoded_rows = AOMMIN(mi_row_end << MI_SIZE_LOG2,
+                                       pbi->cur_buf->buf.y_crop_height);
+        }
       }
-    }
 
-#if !CONFIG_OBU
-    assert(mi_row > 0);
-#endif
+      aom_usec_timer_mark(&tile_timer);
+      pbi->tile_decode_us[tile_cols * row + col] +=
+          aom_usec_timer_elapsed(&tile_timer);
+      pbi->frame_timing.tile_decode_us += aom_usec_timer_elapsed(&tile_timer);
+    }
 
-    // After loopfiltering, the last 7 row pixels in each superblock row may
-    // still be changed by the longest loopfilter of the next superblock row.
-    if (cm->frame_parallel_decode)
-      av1_frameworker_broadcast(pbi->cur_buf, mi_row << cm->mib_size_log2);
+    // Without post filters the rows of a finished tile row are final, so
+    // other frame workers may start predicting from them right away. Frames
+    // filtered by row publish their rows as they are filtered.
+    if (cm->frame_parallel_decode && !inv_row_order &&
+        !row_filter_active(pbi) && !frame_has_post_filter(pbi) &&
+        (tile_row + 1) * tile_cols - 1 <= endTile)
+      publish_decoded_rows(pbi, tile_info.mi_row_end << MI_SIZE_LOG2);
   }
 
+  struct aom_usec_timer lf_timer;
+  aom_usec_timer_start(&lf_timer);
+  // Frames filtered by row are deblocked already.
+  if (!row_filter_active(pbi)
 #if CONFIG_INTRABC
-  if (!(cm->allow_intrabc && NO_FILTER_FOR_IBC))
+      && !(cm->allow_intrabc && NO_FILTER_FOR_IBC)
 #endif  // CONFIG_INTRABC
-  {
+          ) {
 // Loopfilter the whole frame.
 #if CONFIG_LPF_SB
     av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
                           cm->lf.filter_level, 0, 0, 0, 0);
 #else
-#if CONFIG_OBU
-    if (endTile == cm->tile_rows * cm->tile_cols - 1)
-#endif
+    if (endTile == n_tiles - 1)
 #if CONFIG_LOOPFILTER_LEVEL
       if (cm->lf.filter_level[0] || cm->lf.filter_level[1]) {
-        av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
-                              cm->lf.filter_level[0], cm->lf.filter_level[1], 0,
-                              0);
-        av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
-                              cm->lf.filter_level_u, cm->lf.filter_level_u, 1,
-                              0);
-        av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
-                              cm->lf.filter_level_v, cm->lf.filter_level_v, 2,
-                              0);
+        if (pbi->max_threads > 1) {
+          init_lf_workers(pbi);
+          av1_loop_filter_frame_mt(get_frame_new_buffer(cm), cm, pbi->mb.plane,
+                                   cm->lf.filter_level[0],
+                                   cm->lf.filter_level[1], 0, 0,
+                                   pbi->tile_workers, pbi->num_tile_workers,
+                                   &pbi->lf_row_sync);
+          av1_loop_filter_frame_mt(get_frame_new_buffer(cm), cm, pbi->mb.plane,
+                                   cm->lf.filter_level_u, cm->lf.filter_level_u,
+                                   1, 0, pbi->tile_workers,
+                                   pbi->num_tile_workers, &pbi->lf_row_sync);
+          av1_loop_filter_frame_mt(get_frame_new_buffer(cm), cm, pbi->mb.plane,
+                                   cm->lf.filter_level_v, cm->lf.filter_level_v,
+                                   2, 0, pbi->tile_workers,
+                                   pbi->num_tile_workers, &pbi->lf_row_sync);
+        } else {
+          av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
+                                cm->lf.filter_level[0], cm->lf.filter_level[1],
+                                0, 0);
+          av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
+                                cm->lf.filter_level_u, cm->lf.filter_level_u, 1,
+                                0);
+          av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
+                                cm->lf.filter_level_v, cm->lf.filter_level_v, 2,
+                                0);
+        }
       }
 #else
-    av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
-                          cm->lf.filter_level, 0, 0);
+    if (pbi->max_threads > 1) {
+      init_lf_workers(pbi);
+      av1_loop_filter_frame_mt(get_frame_new_buffer(cm), cm, pbi->mb.plane,
+                               cm->lf.filter_level, 0, 0, pbi->tile_workers,
+                               pbi->num_tile_workers, &pbi->lf_row_sync);
+    } else {
+      av1_loop_filter_frame(get_frame_new_buffer(cm), cm, &pbi->mb,
+                            cm->lf.filter_level, 0, 0);
+    }
 #endif  // CONFIG_LOOPFILTER_LEVEL
 #endif  // CONFIG_LPF_SB
   }
-  if (cm->frame_parallel_decode)
-    av1_frameworker_broadcast(pbi->cur_buf, INT_MAX);
+  aom_usec_timer_mark(&lf_timer);
+  pbi->frame_timing.deblock_us += aom_usec_timer_elapsed(&lf_timer);
 
 #if CONFIG_EXT_TILE
   if (cm->large_scale_tile) {
@@ -2332,16 +3025,20 @@ static const uint8_t *decode_tiles(AV1Decoder *pbi, const uint8_t *data,
     }
   } else {
 #endif  // CONFIG_EXT_TILE
-#if !CONFIG_OBU
     {
-      // Get last tile data.
-      TileData *const td = pbi->tile_data + tile_cols * tile_rows - 1;
+      const int end_row = endTile / tile_cols;
+      const int end_col = endTile % tile_cols;
+      // A tile left out has not been read, so its buffer tells where the data
+      // ends.
+      if (end_row < tile_rows_start || end_row >= tile_rows_end ||
+          end_col < tile_cols_start || end_col >= tile_cols_end) {
+        const TileBufferDec *const buf = &tile_buffers[end_row][end_col];
+        return buf->data + buf->size;
+      }
+      // Get the data of the last tile decoded.
+      TileData *const td = pbi->tile_data + endTile;
       return aom_reader_find_end(&td->bit_reader);
     }
-#else
-  TileData *const td = pbi->tile_data + endTile;
-  return aom_reader_find_end(&td->bit_reader);
-#endif
 #if CONFIG_EXT_TILE
   }
 #endif  // CONFIG_EXT_TILE
@@ -3488,15 +4185,12 @@ size_t av1_decode_frame_headers_and_setup(AV1Decoder *pbi, const uint8_t *data,
 #if CONFIG_NO_FRAME_CONTEXT_SIGNALING
   if (cm->error_resilient_mode || frame_is_intra_only(cm)) {
     // use the default frame context values
-    *cm->fc = cm->frame_contexts[FRAME_CONTEXT_DEFAULTS];
-    cm->pre_fc = &cm->frame_contexts[FRAME_CONTEXT_DEFAULTS];
+    load_frame_context(cm, FRAME_CONTEXT_DEFAULTS);
   } else {
-    *cm->fc = cm->frame_contexts[cm->frame_refs[0].idx];
-    cm->pre_fc = &cm->frame_contexts[cm->frame_refs[0].idx];
+    load_frame_context(cm, cm->frame_refs[0].idx);
   }
 #else
-  *cm->fc = cm->frame_contexts[cm->frame_context_idx];
-  cm->pre_fc = &cm->frame_contexts[cm->frame_context_idx];
+  load_frame_context(cm, cm->frame_context_idx);
 #endif  // CONFIG_NO_FRAME_CONTEXT_SIGNALING
   if (!cm->fc->initialized)
     aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
@@ -3540,21 +4234,34 @@ static void setup_frame_info(AV1Decoder *pbi) {
     FrameWorkerData *const frame_worker_data = worker->data1;
     if (cm->refresh_frame_context == REFRESH_FRAME_CONTEXT_FORWARD) {
 #if CONFIG_NO_FRAME_CONTEXT_SIGNALING
-      cm->frame_contexts[cm->new_fb_idx] = *cm->fc;
+      av1_store_frame_context(cm, cm->new_fb_idx, cm->fc);
 #else
-      cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+      av1_store_frame_context(cm, cm->frame_context_idx, cm->fc);
 #endif  // CONFIG_NO_FRAME_CONTEXT_SIGNALING
     }
     av1_frameworker_lock_stats(worker);
     pbi->cur_buf->row = -1;
     pbi->cur_buf->col = -1;
     frame_worker_data->frame_context_ready = 1;
+    frame_worker_data->next_video_frame =
+        cm->current_video_frame + cm->show_frame;
     // Signal the main thread that context is ready.
     av1_frameworker_signal_stats(worker);
     av1_frameworker_unlock_stats(worker);
   }
 
   dec_setup_frame_boundary_info(cm);
+#if CONFIG_ACCOUNTING
+  // The symbols of all the tile groups of the frame are counted together.
+  if (pbi->acct_enabled) {
+    aom_accounting_set_frame_size(&pbi->accounting, cm->mi_rows, cm->mi_cols,
+                                  cm->mib_size_log2);
+    aom_accounting_reset(&pbi->accounting);
+  }
+#endif
+#if !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+  init_row_filter(pbi);
+#endif  // !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
 }
 
 void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
@@ -3563,15 +4270,17 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
                                     int endTile, int initialize_flag) {
   AV1_COMMON *const cm = &pbi->common;
   MACROBLOCKD *const xd = &pbi->mb;
+  struct aom_usec_timer timer;
 
   if (initialize_flag) setup_frame_info(pbi);
 
 #if CONFIG_OBU
   *p_data_end = decode_tiles(pbi, data, data_end, startTile, endTile);
 #else
-  *p_data_end =
-      decode_tiles(pbi, data + pbi->uncomp_hdr_size + pbi->first_partition_size,
-                   data_end, startTile, endTile);
+  // Later tile groups start with a copy of the frame headers, which
+  // decode_tiles() skips itself.
+  if (!startTile) data += pbi->uncomp_hdr_size + pbi->first_partition_size;
+  *p_data_end = decode_tiles(pbi, data, data_end, startTile, endTile);
 #endif
 
 #if CONFIG_MONO_VIDEO
@@ -3599,39 +4308,54 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
     return;
   }
 
+  // Frames filtered by row went through all the post filters with their
+  // last superblock row.
+  const int filter_frame = !row_filter_active(pbi);
+
 #if CONFIG_STRIPED_LOOP_RESTORATION
 #if CONFIG_FRAME_SUPERRES && CONFIG_HORZONLY_FRAME_SUPERRES
   if (!av1_superres_unscaled(cm)) aom_extend_frame_borders(&pbi->cur_buf->buf);
 #endif
-  if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-      cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-      cm->rst_info[2].frame_restoration_type != RESTORE_NONE) {
+  if (filter_frame &&
+      (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+       cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+       cm->rst_info[2].frame_restoration_type != RESTORE_NONE)) {
     av1_loop_restoration_save_boundary_lines(&pbi->cur_buf->buf, cm, 0);
   }
 #endif
 
-  if (!cm->skip_loop_filter &&
+  if (filter_frame && !cm->skip_loop_filter &&
 #if CONFIG_INTRABC
       !(cm->allow_intrabc && NO_FILTER_FOR_IBC) &&
 #endif  // CONFIG_INTRABC
       !cm->all_lossless &&
       (cm->cdef_bits || cm->cdef_strengths[0] || cm->cdef_uv_strengths[0])) {
+    aom_usec_timer_start(&timer);
     av1_cdef_frame(&pbi->cur_buf->buf, cm, &pbi->mb);
+    aom_usec_timer_mark(&timer);
+    pbi->frame_timing.cdef_us += aom_usec_timer_elapsed(&timer);
   }
 
 #if CONFIG_FRAME_SUPERRES
+  aom_usec_timer_start(&timer);
   superres_post_decode(pbi);
+  aom_usec_timer_mark(&timer);
+  pbi->frame_timing.superres_us += aom_usec_timer_elapsed(&timer);
 #endif  // CONFIG_FRAME_SUPERRES
 
 #if CONFIG_LOOP_RESTORATION
-  if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-      cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-      cm->rst_info[2].frame_restoration_type != RESTORE_NONE) {
+  if (filter_frame &&
+      (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+       cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+       cm->rst_info[2].frame_restoration_type != RESTORE_NONE)) {
 #if CONFIG_STRIPED_LOOP_RESTORATION
     av1_loop_restoration_save_boundary_lines(&pbi->cur_buf->buf, cm, 1);
 #endif
+    aom_usec_timer_start(&timer);
     av1_loop_restoration_filter_frame((YV12_BUFFER_CONFIG *)xd->cur_buf, cm,
                                       cm->rst_info, 7, NULL);
+    aom_usec_timer_mark(&timer);
+    pbi->frame_timing.restoration_us += aom_usec_timer_elapsed(&timer);
   }
 #endif  // CONFIG_LOOP_RESTORATION
 
@@ -3698,10 +4422,10 @@ void av1_decode_tg_tiles_and_wrapup(AV1Decoder *pbi, const uint8_t *data,
     if (!cm->frame_parallel_decode ||
         cm->refresh_frame_context != REFRESH_FRAME_CONTEXT_FORWARD) {
 #if CONFIG_NO_FRAME_CONTEXT_SIGNALING
-      cm->frame_contexts[cm->new_fb_idx] = *cm->fc;
+      av1_store_frame_context(cm, cm->new_fb_idx, cm->fc);
 #else
     if (!cm->error_resilient_mode)
-      cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+      av1_store_frame_context(cm, cm->frame_context_idx, cm->fc);
 #endif
     }
 #if CONFIG_EXT_TILE
@@ -3755,10 +4479,14 @@ static uint32_t read_sequence_header_obu(AV1Decoder *pbi,
 static uint32_t read_frame_header_obu(AV1Decoder *pbi, const uint8_t *data,
                                       const uint8_t *data_end,
                                       const uint8_t **p_data_end) {
+  struct aom_usec_timer timer;
   size_t header_size;
 
+  aom_usec_timer_start(&timer);
   header_size =
       av1_decode_frame_headers_and_setup(pbi, data, data_end, p_data_end);
+  aom_usec_timer_mark(&timer);
+  pbi->frame_timing.header_us += aom_usec_timer_elapsed(&timer);
   return (uint32_t)(pbi->uncomp_hdr_size + header_size);
 }
 
@@ -3785,12 +4513,17 @@ static uint32_t read_one_tile_group_obu(AV1Decoder *pbi,
   uint32_t header_size, tg_payload_size;
 
   header_size = read_tile_group_header(pbi, rb, &startTile, &endTile);
+  // Tile groups must be received in order
+  if (startTile != pbi->next_tile || endTile < startTile ||
+      endTile >= cm->tile_rows * cm->tile_cols)
+    aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
+                       "Tile group out of order or past last tile in frame");
   data += header_size;
   av1_decode_tg_tiles_and_wrapup(pbi, data, data_end, p_data_end, startTile,
                                  endTile, is_first_tg);
+  pbi->next_tile = endTile + 1;
   tg_payload_size = (uint32_t)(*p_data_end - data);
 
-  // TODO(shan):  For now, assume all tile groups received in order
   *is_last_tg = endTile == cm->tile_rows * cm->tile_cols - 1;
 
   return header_size + tg_payload_size;
@@ -3842,17 +4575,18 @@ static size_t read_metadata(const uint8_t *data, size_t sz) {
   return sz;
 }
 
-void av1_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
-                                const uint8_t *data_end,
-                                const uint8_t **p_data_end) {
+int av1_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
+                               const uint8_t *data_end,
+                               const uint8_t **p_data_end) {
   AV1_COMMON *const cm = &pbi->common;
   int frame_decoding_finished = 0;
-  int is_first_tg_obu_received = 1;
-  int frame_header_received = 0;
-  int frame_header_size = 0;
+  // A frame passed in pieces carries on from the tile groups already decoded.
+  int is_first_tg_obu_received = pbi->next_tile == 0;
+  int frame_header_received = pbi->partial_frame;
 
   // decode frame as a series of OBUs
-  while (!frame_decoding_finished && !cm->error.error_code) {
+  while (!frame_decoding_finished && !cm->error.error_code &&
+         data < data_end) {
     struct aom_read_bit_buffer rb;
     uint8_t clear_data[80];
     size_t obu_size, obu_header_size, obu_payload_size = 0;
@@ -3882,11 +4616,14 @@ void av1_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
       case OBU_FRAME_HEADER:
         // Only decode first frame header received
         if (!frame_header_received) {
-          frame_header_size = obu_payload_size =
+          obu_payload_size =
               read_frame_header_obu(pbi, data, data_end, p_data_end);
           frame_header_received = 1;
+          pbi->partial_frame = !cm->show_existing_frame;
+          pbi->next_tile = 0;
         } else {
-          obu_payload_size = frame_header_size;
+          obu_payload_size =
+              (uint32_t)(pbi->uncomp_hdr_size + pbi->first_partition_size);
         }
         if (cm->show_existing_frame) frame_decoding_finished = 1;
         break;
@@ -3904,5 +4641,58 @@ void av1_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
     }
     data += obu_payload_size;
   }
+  return frame_decoding_finished;
 }
 #endif
+
+int av1_decode_partial_frame(AV1Decoder *pbi, const uint8_t *data,
+                             const uint8_t *data_end,
+                             const uint8_t **p_data_end) {
+#if CONFIG_OBU
+  return av1_decode_frame_from_obus(pbi, data, data_end, p_data_end);
+#else
+  AV1_COMMON *const cm = &pbi->common;
+  int end_tile;
+
+  if (!pbi->partial_frame) {
+    struct aom_usec_timer timer;
+    aom_usec_timer_start(&timer);
+    av1_decode_frame_headers_and_setup(pbi, data, data_end, p_data_end);
+    aom_usec_timer_mark(&timer);
+    pbi->frame_timing.header_us += aom_usec_timer_elapsed(&timer);
+    if (cm->show_existing_frame) return 1;
+    pbi->partial_frame = 1;
+  } else {
+    // Read the tile range from the copy of the frame headers that starts
+    // every later tile group.
+    struct aom_read_bit_buffer rb;
+    uint8_t clear_data[MAX_AV1_HEADER_SIZE];
+    if (!read_is_valid(data, pbi->uncomp_hdr_size + pbi->first_partition_size,
+                       data_end))
+      aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
+                         "Truncated tile group header");
+    init_read_bit_buffer(pbi, &rb, data, data_end, clear_data);
+    rb.bit_offset = pbi->tg_size_bit_offset;
+    read_tile_group_range(pbi, &rb);
+  }
+  if (pbi->tg_start != pbi->next_tile)
+    aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
+                       "Tile groups must arrive in order");
+
+  end_tile = pbi->tg_start + pbi->tg_size - 1;
+  av1_decode_tg_tiles_and_wrapup(pbi, data, data_end, p_data_end,
+                                 pbi->tg_start, end_tile, !pbi->tg_start);
+  pbi->next_tile = end_tile + 1;
+  if (end_tile == cm->tile_rows * cm->tile_cols - 1) return 1;
+
+  {
+    // Only the last tile of the frame has no size, so this tile group ends
+    // exactly where its last tile does.
+    const TileBufferDec *const buf =
+        &pbi->tile_buffers[end_tile / cm->tile_cols][end_tile % cm->tile_cols];
+    *p_data_end = buf->data + buf->size;
+  }
+  return 0;
+#endif  // CONFIG_OBU
+}
+
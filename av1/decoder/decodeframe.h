@@ -49,11 +49,20 @@ void av1_decode_tg_tiles_and_wrapup(struct AV1Decoder *pbi, const uint8_t *data,
 
 #if CONFIG_OBU
 // replaces av1_decode_frame
-void av1_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
-                                const uint8_t *data_end,
-                                const uint8_t **p_data_end);
+// Returns 1 once the last tile group of the frame is decoded.
+int av1_decode_frame_from_obus(struct AV1Decoder *pbi, const uint8_t *data,
+                               const uint8_t *data_end,
+                               const uint8_t **p_data_end);
 #endif
 
+// Decodes the tile groups of a frame that are in [data, data_end). The frame
+// may be passed in several pieces, each holding whole tile groups in order;
+// the first piece starts with the frame headers. Returns 1 once the last tile
+// group of the frame is decoded.
+int av1_decode_partial_frame(struct AV1Decoder *pbi, const uint8_t *data,
+                             const uint8_t *data_end,
+                             const uint8_t **p_data_end);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
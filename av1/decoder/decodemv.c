@@ -187,7 +187,7 @@ static UV_PREDICTION_MODE read_intra_mode_uv(FRAME_CONTEXT *ec_ctx,
 
 #if CONFIG_CFL
 static int read_cfl_alphas(FRAME_CONTEXT *const ec_ctx, aom_reader *r,
-                           int *signs_out) {
+                           int8_t *signs_out) {
   const int joint_sign =
       aom_read_symbol(r, ec_ctx->cfl_sign_cdf, CFL_JOINT_SIGNS, "cfl:signs");
   int idx = 0;
@@ -427,8 +427,8 @@ static void read_tx_size_vartx(AV1_COMMON *cm, MACROBLOCKD *xd,
                                    xd->left_txfm_context + blk_row,
                                    mbmi->sb_type, tx_size);
   TX_SIZE(*const inter_tx_size)
-  [MAX_MIB_SIZE] =
-      (TX_SIZE(*)[MAX_MIB_SIZE]) & mbmi->inter_tx_size[tx_row][tx_col];
+  [INTER_TX_SIZE_BUF_LEN] =
+      (TX_SIZE(*)[INTER_TX_SIZE_BUF_LEN]) & mbmi->inter_tx_size[tx_row][tx_col];
   if (blk_row >= max_blocks_high || blk_col >= max_blocks_wide) return;
   assert(tx_size > TX_4X4);
 
@@ -1815,8 +1815,12 @@ static int read_is_inter_block(AV1_COMMON *const cm, MACROBLOCKD *const xd,
 
 static void fpm_sync(void *const data, int mi_row) {
   AV1Decoder *const pbi = (AV1Decoder *)data;
-  av1_frameworker_wait(pbi->frame_worker_owner, pbi->common.prev_frame,
-                       mi_row << pbi->common.mib_size_log2);
+  const AV1_COMMON *const cm = &pbi->common;
+  // The temporal candidates of a block are taken from the co-located
+  // superblock row and the one below it.
+  const int sb_row = mi_row >> cm->mib_size_log2;
+  av1_frameworker_wait(pbi->frame_worker_owner, cm->prev_frame,
+                       (sb_row + 2) << (cm->mib_size_log2 + MI_SIZE_LOG2));
 }
 
 #if DEC_MISMATCH_DEBUG
@@ -89,11 +89,10 @@ AV1Decoder *av1_decoder_create(BufferPool *const pool) {
 
   CHECK_MEM_ERROR(cm, cm->fc,
                   (FRAME_CONTEXT *)aom_memalign(32, sizeof(*cm->fc)));
-  CHECK_MEM_ERROR(cm, cm->frame_contexts,
-                  (FRAME_CONTEXT *)aom_memalign(
-                      32, FRAME_CONTEXTS * sizeof(*cm->frame_contexts)));
+  if (av1_alloc_frame_contexts(cm))
+    aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                       "Failed to allocate frame contexts");
   memset(cm->fc, 0, sizeof(*cm->fc));
-  memset(cm->frame_contexts, 0, FRAME_CONTEXTS * sizeof(*cm->frame_contexts));
 
   pbi->need_resync = 1;
   once(initialize_dec);
@@ -141,6 +140,7 @@ void av1_decoder_remove(AV1Decoder *pbi) {
   aom_get_worker_interface()->end(&pbi->lf_worker);
   aom_free(pbi->lf_worker.data1);
   aom_free(pbi->tile_data);
+  aom_free(pbi->tile_decode_us);
   for (i = 0; i < pbi->num_tile_workers; ++i) {
     AVxWorker *const worker = &pbi->tile_workers[i];
     aom_get_worker_interface()->end(worker);
@@ -152,6 +152,13 @@ void av1_decoder_remove(AV1Decoder *pbi) {
     av1_loop_filter_dealloc(&pbi->lf_row_sync);
   }
 
+#if !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+  av1_cdef_free_row_buffers(&pbi->row_filter.cdef_bufs);
+#if CONFIG_LOOP_RESTORATION
+  aom_free_frame_buffer(&pbi->row_filter.lr_dst);
+#endif  // CONFIG_LOOP_RESTORATION
+#endif  // !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+
 #if CONFIG_ACCOUNTING
   aom_accounting_clear(&pbi->accounting);
 #endif
@@ -199,8 +206,13 @@ aom_codec_err_t av1_set_reference_dec(AV1_COMMON *cm, int idx,
     aom_internal_error(&cm->error, AOM_CODEC_ERROR,
                        "Incorrect buffer dimensions");
   } else {
+    RefCntBuffer *const buf =
+        &cm->buffer_pool->frame_bufs[cm->ref_frame_map[idx]];
     // Overwrite the reference frame buffer.
     aom_yv12_copy_frame(sd, ref_buf);
+    buf->valid_rect.left = buf->valid_rect.top = 0;
+    buf->valid_rect.right = ref_buf->y_crop_width;
+    buf->valid_rect.bottom = ref_buf->y_crop_height;
   }
 
   return cm->error.error_code;
@@ -252,14 +264,11 @@ static void swap_frame_buffers(AV1Decoder *pbi) {
   }
 }
 
-int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
-                                const uint8_t **psource) {
-  AV1_COMMON *volatile const cm = &pbi->common;
-  BufferPool *volatile const pool = cm->buffer_pool;
-  RefCntBuffer *volatile const frame_bufs = cm->buffer_pool->frame_bufs;
-  const uint8_t *source = *psource;
-  int retcode = 0;
-  cm->error.error_code = AOM_CODEC_OK;
+// Finds a buffer for the next frame and resets the decoding progress.
+static int start_frame(AV1Decoder *pbi, size_t size) {
+  AV1_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+  RefCntBuffer *const frame_bufs = cm->buffer_pool->frame_bufs;
 
   if (size == 0) {
     // This is used to signal that we are missing frames.
@@ -308,62 +317,65 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
   } else {
     pbi->cur_buf = &frame_bufs[cm->new_fb_idx];
   }
+  pbi->published_rows = 0;
+  pbi->decoded_rows = 0;
+  pbi->partial_frame = 0;
+  pbi->next_tile = 0;
+  return 0;
+}
 
-  if (setjmp(cm->error.jmp)) {
-    const AVxWorkerInterface *const winterface = aom_get_worker_interface();
-    int i;
-
-    cm->error.setjmp = 0;
-    pbi->ready_for_new_data = 1;
+// Releases the buffers held by a frame that failed to decode.
+static void release_frame_buffers(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  BufferPool *const pool = cm->buffer_pool;
+  RefCntBuffer *const frame_bufs = cm->buffer_pool->frame_bufs;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  int i;
 
-    // Synchronize all threads immediately as a subsequent decode call may
-    // cause a resize invalidating some allocations.
-    winterface->sync(&pbi->lf_worker);
-    for (i = 0; i < pbi->num_tile_workers; ++i) {
-      winterface->sync(&pbi->tile_workers[i]);
-    }
+  pbi->ready_for_new_data = 1;
+  pbi->partial_frame = 0;
 
-    lock_buffer_pool(pool);
-    // Release all the reference buffers if worker thread is holding them.
-    if (pbi->hold_ref_buf == 1) {
-      int ref_index = 0, mask;
-      for (mask = pbi->refresh_frame_flags; mask; mask >>= 1) {
-        const int old_idx = cm->ref_frame_map[ref_index];
-        // Current thread releases the holding of reference frame.
-        decrease_ref_count(old_idx, frame_bufs, pool);
-
-        // Release the reference frame holding in the reference map for the
-        // decoding of the next frame.
-        if (mask & 1) decrease_ref_count(old_idx, frame_bufs, pool);
-        ++ref_index;
-      }
+  // Synchronize all threads immediately as a subsequent decode call may
+  // cause a resize invalidating some allocations.
+  winterface->sync(&pbi->lf_worker);
+  for (i = 0; i < pbi->num_tile_workers; ++i) {
+    winterface->sync(&pbi->tile_workers[i]);
+  }
 
+  lock_buffer_pool(pool);
+  // Release all the reference buffers if worker thread is holding them.
+  if (pbi->hold_ref_buf == 1) {
+    int ref_index = 0, mask;
+    for (mask = pbi->refresh_frame_flags; mask; mask >>= 1) {
+      const int old_idx = cm->ref_frame_map[ref_index];
       // Current thread releases the holding of reference frame.
-      for (; ref_index < REF_FRAMES && !cm->show_existing_frame; ++ref_index) {
-        const int old_idx = cm->ref_frame_map[ref_index];
-        decrease_ref_count(old_idx, frame_bufs, pool);
-      }
-      pbi->hold_ref_buf = 0;
+      decrease_ref_count(old_idx, frame_bufs, pool);
+
+      // Release the reference frame holding in the reference map for the
+      // decoding of the next frame.
+      if (mask & 1) decrease_ref_count(old_idx, frame_bufs, pool);
+      ++ref_index;
     }
-    // Release current frame.
-    decrease_ref_count(cm->new_fb_idx, frame_bufs, pool);
-    unlock_buffer_pool(pool);
 
-    aom_clear_system_state();
-    return -1;
+    // Current thread releases the holding of reference frame.
+    for (; ref_index < REF_FRAMES && !cm->show_existing_frame; ++ref_index) {
+      const int old_idx = cm->ref_frame_map[ref_index];
+      decrease_ref_count(old_idx, frame_bufs, pool);
+    }
+    pbi->hold_ref_buf = 0;
   }
+  // Release current frame.
+  decrease_ref_count(cm->new_fb_idx, frame_bufs, pool);
+  unlock_buffer_pool(pool);
 
-  cm->error.setjmp = 1;
+  aom_clear_system_state();
+}
 
-#if !CONFIG_OBU
-  av1_decode_frame_headers_and_setup(pbi, source, source + size, psource);
-  if (!cm->show_existing_frame) {
-    av1_decode_tg_tiles_and_wrapup(pbi, source, source + size, psource, 0,
-                                   cm->tile_rows * cm->tile_cols - 1, 1);
-  }
-#else
-  av1_decode_frame_from_obus(pbi, source, source + size, psource);
-#endif
+// Updates the reference buffers and the decoder state once all tiles of the
+// frame are decoded.
+static void finish_frame(AV1Decoder *pbi) {
+  AV1_COMMON *const cm = &pbi->common;
+  struct aom_usec_timer stage_timer;
 
 #if TXCOEFF_TIMER
   cm->cum_txcoeff_timer += cm->txcoeff_timer;
@@ -374,8 +386,10 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
   cm->txb_count = 0;
 #endif
 
+  pbi->partial_frame = 0;
   swap_frame_buffers(pbi);
 
+  aom_usec_timer_start(&stage_timer);
 #if CONFIG_EXT_TILE
   // For now, we only extend the frame borders when the whole frame is decoded.
   // Later, if needed, extend the border for the decoded tile on the frame
@@ -385,7 +399,12 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
     // TODO(debargha): Fix encoder side mv range, so that we can use the
     // inner border extension. As of now use the larger extension.
     // aom_extend_frame_inner_borders(cm->frame_to_show);
-    aom_extend_frame_borders(cm->frame_to_show);
+    // Frames published row by row have already been extended.
+    if (pbi->published_rows < cm->frame_to_show->y_crop_height)
+      aom_extend_frame_borders(cm->frame_to_show);
+  aom_usec_timer_mark(&stage_timer);
+  pbi->frame_timing.extend_borders_us += aom_usec_timer_elapsed(&stage_timer);
+  pbi->decoded_rows = cm->frame_to_show->y_crop_height;
 
   aom_clear_system_state();
 
@@ -414,8 +433,12 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
     if (cm->show_frame) {
       cm->current_video_frame++;
     }
+    // The frame is now filtered and border-extended, so inter prediction
+    // from any of its rows is safe.
+    pbi->cur_buf->row = INT_MAX;
     frame_worker_data->frame_decoded = 1;
     frame_worker_data->frame_context_ready = 1;
+    frame_worker_data->next_video_frame = cm->current_video_frame;
     av1_frameworker_signal_stats(worker);
     av1_frameworker_unlock_stats(worker);
   } else {
@@ -427,15 +450,104 @@ int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
       cm->current_video_frame++;
     }
   }
+  ++pbi->frame_timing.frames;
+}
+
+int av1_receive_compressed_data(AV1Decoder *pbi, size_t size,
+                                const uint8_t **psource) {
+  AV1_COMMON *volatile const cm = &pbi->common;
+  const uint8_t *source = *psource;
+  int retcode = 0;
+  cm->error.error_code = AOM_CODEC_OK;
+
+  if (start_frame(pbi, size)) return AOM_CODEC_MEM_ERROR;
+
+  if (setjmp(cm->error.jmp)) {
+    cm->error.setjmp = 0;
+    release_frame_buffers(pbi);
+    return -1;
+  }
+
+  cm->error.setjmp = 1;
+
+  struct aom_usec_timer frame_timer;
+  aom_usec_timer_start(&frame_timer);
+
+#if !CONFIG_OBU
+  struct aom_usec_timer stage_timer;
+  aom_usec_timer_start(&stage_timer);
+  av1_decode_frame_headers_and_setup(pbi, source, source + size, psource);
+  aom_usec_timer_mark(&stage_timer);
+  pbi->frame_timing.header_us += aom_usec_timer_elapsed(&stage_timer);
+  if (!cm->show_existing_frame) {
+    av1_decode_tg_tiles_and_wrapup(pbi, source, source + size, psource, 0,
+                                   cm->tile_rows * cm->tile_cols - 1, 1);
+  }
+#else
+  if (!av1_decode_frame_from_obus(pbi, source, source + size, psource))
+    aom_internal_error(&cm->error, AOM_CODEC_CORRUPT_FRAME,
+                       "Data ended before all tiles were read.");
+#endif
+
+  finish_frame(pbi);
+
+  aom_usec_timer_mark(&frame_timer);
+  pbi->frame_timing.total_us += aom_usec_timer_elapsed(&frame_timer);
 
   cm->error.setjmp = 0;
   return retcode;
 }
 
+int av1_receive_partial_data(AV1Decoder *pbi, size_t size,
+                             const uint8_t **psource, int *frame_done) {
+  AV1_COMMON *volatile const cm = &pbi->common;
+  const uint8_t *source = *psource;
+  struct aom_usec_timer timer;
+  cm->error.error_code = AOM_CODEC_OK;
+  *frame_done = 0;
+
+  if (!pbi->partial_frame && start_frame(pbi, size))
+    return AOM_CODEC_MEM_ERROR;
+
+  if (setjmp(cm->error.jmp)) {
+    cm->error.setjmp = 0;
+    release_frame_buffers(pbi);
+    return -1;
+  }
+
+  cm->error.setjmp = 1;
+  aom_usec_timer_start(&timer);
+
+  if (av1_decode_partial_frame(pbi, source, source + size, psource)) {
+    finish_frame(pbi);
+    *frame_done = 1;
+  }
+
+  aom_usec_timer_mark(&timer);
+  pbi->frame_timing.total_us += aom_usec_timer_elapsed(&timer);
+
+  cm->error.setjmp = 0;
+  return 0;
+}
+
+void av1_drop_partial_frame(AV1Decoder *pbi) {
+  if (!pbi->partial_frame) return;
+  pbi->cur_buf->buf.corrupted = 1;
+  pbi->need_resync = 1;
+  release_frame_buffers(pbi);
+}
+
+void av1_reset_frame_timing(AV1Decoder *pbi) {
+  av1_zero(pbi->frame_timing);
+  if (pbi->tile_decode_us)
+    memset(pbi->tile_decode_us, 0,
+           pbi->allocated_tiles * sizeof(*pbi->tile_decode_us));
+}
+
 int av1_get_raw_frame(AV1Decoder *pbi, YV12_BUFFER_CONFIG *sd) {
   AV1_COMMON *const cm = &pbi->common;
   int ret = -1;
-  if (pbi->ready_for_new_data == 1) return ret;
+  if (pbi->ready_for_new_data == 1 || pbi->partial_frame) return ret;
 
   pbi->ready_for_new_data = 1;
 
@@ -15,10 +15,12 @@
 #include "./aom_config.h"
 
 #include "aom/aom_codec.h"
+#include "aom/aomdx.h"
 #include "aom_dsp/bitreader.h"
 #include "aom_scale/yv12config.h"
 #include "aom_util/aom_thread.h"
 
+#include "av1/common/cdef.h"
 #include "av1/common/thread_common.h"
 #include "av1/common/onyxc_int.h"
 #include "av1/decoder/dthread.h"
@@ -51,6 +53,25 @@ typedef struct TileBufferDec {
   int col;                      // only used with multi-threaded decoding
 } TileBufferDec;
 
+#if !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+// Progress of the post filters when they run a few rows behind the decoded
+// superblock rows, so that frame parallel decode can publish filtered rows
+// before the whole frame is decoded.
+typedef struct DecRowFilter {
+  int active;        // Set if the post filters of the frame run by row.
+  int lf_mi_rows;    // Deblocked mi rows
+  int cdef_fb_rows;  // Rows of 64x64 blocks filtered by CDEF
+  CdefRowBuffers cdef_bufs;
+#if CONFIG_LOOP_RESTORATION
+  // Rows of each plane whose loop restoration boundary lines are saved,
+  // before and after CDEF.
+  int lr_saved_rows[2][MAX_MB_PLANE];
+  RestorationRowProgress lr_progress[MAX_MB_PLANE];
+  YV12_BUFFER_CONFIG lr_dst;
+#endif  // CONFIG_LOOP_RESTORATION
+} DecRowFilter;
+#endif  // !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+
 typedef struct AV1Decoder {
   DECLARE_ALIGNED(16, MACROBLOCKD, mb);
 
@@ -63,6 +84,22 @@ typedef struct AV1Decoder {
   // TODO(hkuang): Combine this with cur_buf in macroblockd as they are
   // the same.
   RefCntBuffer *cur_buf;  //  Current decoding frame buffer.
+  // Luma rows of cur_buf that are final, border-extended and published to
+  // the other frame workers in frame parallel mode.
+  int published_rows;
+  // Number of times rows of a frame were published before the whole frame
+  // was, see AV1D_GET_ROW_PUBLISHES.
+  int row_publishes;
+#if !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+  DecRowFilter row_filter;
+#endif  // !CONFIG_LPF_SB && CONFIG_PARALLEL_DEBLOCKING
+  // Luma rows at the top of cur_buf that are reconstructed, before any post
+  // filtering, see AV1D_GET_DECODED_ROWS.
+  int decoded_rows;
+  // Set while a frame passed in pieces, see av1_receive_partial_data(), has
+  // tile groups left to decode.
+  int partial_frame;
+  int next_tile;  // First tile of the current frame not decoded yet
 
   AVxWorker *frame_worker_owner;  // frame_worker that owns this pbi.
   AVxWorker lf_worker;
@@ -72,6 +109,7 @@ typedef struct AV1Decoder {
 
   TileData *tile_data;
   int allocated_tiles;
+  int64_t *tile_decode_us;  // Per-tile decode time, allocated_tiles entries.
 
   TileBufferDec tile_buffers[MAX_TILE_ROWS][MAX_TILE_COLS];
 
@@ -94,6 +132,20 @@ typedef struct AV1Decoder {
   int tile_col_size_bytes;
   int dec_tile_row, dec_tile_col;  // always -1 for non-VR tile encoding
 #endif                             // CONFIG_EXT_TILE
+  // Only the tiles that overlap region, in luma pixels, are decoded when
+  // decode_region is set, see AV1D_SET_DECODE_REGION.
+  int decode_region;
+  AV1PixelRect region;
+  // Region the last frame was decoded with, as a frame is decoded whole when
+  // the region moves.
+  int last_decode_region;
+  AV1PixelRect last_region;
+  // Tiles decoded in the current frame, as half-open ranges.
+  int tile_rows_start, tile_rows_end;
+  int tile_cols_start, tile_cols_end;
+  // Set when some reference frames are only valid in part, so the blocks that
+  // predict from the rest are left out of the valid area of the new frame.
+  int check_ref_regions;
 #if CONFIG_ACCOUNTING
   int acct_enabled;
   Accounting accounting;
@@ -107,11 +159,28 @@ typedef struct AV1Decoder {
   aom_inspect_cb inspect_cb;
   void *inspect_ctx;
 #endif
+  // Per-stage timing of the frames decoded by the current aom_codec_decode()
+  // call, see AV1D_GET_FRAME_TIMING.
+  aom_frame_timing_t frame_timing;
 } AV1Decoder;
 
 int av1_receive_compressed_data(struct AV1Decoder *pbi, size_t size,
                                 const uint8_t **dest);
 
+// Decodes a piece of a frame holding one or more whole tile groups, so that
+// tiles are decoded as soon as they arrive. The first piece of a frame starts
+// with its headers. *frame_done is set once the last tile group is decoded
+// and the frame is finished.
+int av1_receive_partial_data(struct AV1Decoder *pbi, size_t size,
+                             const uint8_t **source, int *frame_done);
+
+// Drops a frame passed to av1_receive_partial_data() that is missing tile
+// groups.
+void av1_drop_partial_frame(struct AV1Decoder *pbi);
+
+// Clear the statistics returned by AV1D_GET_FRAME_TIMING.
+void av1_reset_frame_timing(struct AV1Decoder *pbi);
+
 int av1_get_raw_frame(struct AV1Decoder *pbi, YV12_BUFFER_CONFIG *sd);
 
 int av1_get_frame_to_show(struct AV1Decoder *pbi, YV12_BUFFER_CONFIG *frame);
@@ -154,6 +154,7 @@ void av1_frameworker_copy_context(AVxWorker *const dst_worker,
                                    ? src_cm->current_frame_seg_map
                                    : src_cm->last_frame_seg_map;
   dst_worker_data->pbi->need_resync = src_worker_data->pbi->need_resync;
+  dst_cm->current_video_frame = src_worker_data->next_video_frame;
   av1_frameworker_unlock_stats(src_worker);
 
   dst_cm->bit_depth = src_cm->bit_depth;
@@ -169,12 +170,29 @@ void av1_frameworker_copy_context(AVxWorker *const dst_worker,
       !src_cm->show_existing_frame ? src_cm->height : src_cm->last_height;
   dst_cm->subsampling_x = src_cm->subsampling_x;
   dst_cm->subsampling_y = src_cm->subsampling_y;
+  dst_cm->color_space = src_cm->color_space;
+  dst_cm->transfer_function = src_cm->transfer_function;
+  dst_cm->chroma_sample_position = src_cm->chroma_sample_position;
+  dst_cm->color_range = src_cm->color_range;
+  // Sequence level state that is only signaled on intra frames.
+  set_sb_size(dst_cm, src_cm->sb_size);
+  dst_cm->allow_screen_content_tools = src_cm->allow_screen_content_tools;
+#if CONFIG_AMVR
+  dst_cm->seq_force_integer_mv = src_cm->seq_force_integer_mv;
+#endif
   dst_cm->frame_type = src_cm->frame_type;
+  dst_cm->intra_only = src_cm->intra_only;
   dst_cm->last_show_frame = !src_cm->show_existing_frame
                                 ? src_cm->show_frame
                                 : src_cm->last_show_frame;
   for (i = 0; i < REF_FRAMES; ++i)
     dst_cm->ref_frame_map[i] = src_cm->next_ref_frame_map[i];
+  dst_cm->seq_params = src_cm->seq_params;
+  dst_cm->current_frame_id = src_cm->current_frame_id;
+  memcpy(dst_cm->ref_frame_id, src_cm->ref_frame_id,
+         sizeof(dst_cm->ref_frame_id));
+  memcpy(dst_cm->valid_for_referencing, src_cm->valid_for_referencing,
+         sizeof(dst_cm->valid_for_referencing));
 
   memcpy(dst_cm->lf_info.lfthr, src_cm->lf_info.lfthr,
          (MAX_LOOP_FILTER + 1) * sizeof(loop_filter_thresh));
@@ -188,8 +206,7 @@ void av1_frameworker_copy_context(AVxWorker *const dst_worker,
   memcpy(dst_cm->lf.ref_deltas, src_cm->lf.ref_deltas, TOTAL_REFS_PER_FRAME);
   memcpy(dst_cm->lf.mode_deltas, src_cm->lf.mode_deltas, MAX_MODE_LF_DELTAS);
   dst_cm->seg = src_cm->seg;
-  memcpy(dst_cm->frame_contexts, src_cm->frame_contexts,
-         FRAME_CONTEXTS * sizeof(dst_cm->frame_contexts[0]));
+  av1_copy_frame_contexts(dst_cm, src_cm);
 #else
   (void)dst_worker;
   (void)src_worker;
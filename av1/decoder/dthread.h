@@ -47,6 +47,9 @@ typedef struct FrameWorkerData {
 
   int frame_context_ready;  // Current frame's context is ready to read.
   int frame_decoded;        // Finished decoding current frame.
+  // current_video_frame of the frame after the current one, valid once
+  // frame_context_ready is set.
+  unsigned int next_video_frame;
 } FrameWorkerData;
 
 void av1_frameworker_lock_stats(AVxWorker *const worker);
@@ -1771,11 +1771,7 @@ static void dump_mode_info(MODE_INFO *mi) {
   printf("&& mi->mbmi.mi_col == %d\n", mi->mbmi.mi_col);
   printf("&& mi->mbmi.sb_type == %d\n", mi->mbmi.sb_type);
   printf("&& mi->mbmi.tx_size == %d\n", mi->mbmi.tx_size);
-  if (mi->mbmi.sb_type >= BLOCK_8X8) {
-    printf("&& mi->mbmi.mode == %d\n", mi->mbmi.mode);
-  } else {
-    printf("&& mi->bmi[0].as_mode == %d\n", mi->bmi[0].as_mode);
-  }
+  printf("&& mi->mbmi.mode == %d\n", mi->mbmi.mode);
 }
 static int rd_token_stats_mismatch(RD_STATS *rd_stats, TOKEN_STATS *token_stats,
                                    int plane) {
@@ -3297,17 +3293,20 @@ static uint32_t write_tiles(AV1_COMP *const cpi, uint8_t *const dst,
         const int is_last_col = (tile_col == tile_cols - 1);
         const int is_last_tile = is_last_col && is_last_row;
 
-        if ((!mtu_size && tile_count > tg_size) ||
+        // A fixed size tile group ends once it holds tg_size tiles, while an
+        // MTU sized one ends with the tile that made it exceed the MTU.
+        if ((!mtu_size && tile_count == tg_size) ||
             (mtu_size && tile_count && curr_tg_data_size >= mtu_size)) {
           // New tile group
           tg_count++;
           // We've exceeded the packet size
-          if (tile_count > 1) {
+          if (mtu_size && tile_count > 1) {
             /* The last tile exceeded the packet size. The tile group size
                should therefore be tile_count-1.
                Move the last tile and insert headers before it
              */
             uint32_t old_total_size = total_size - tile_size - 4;
+            cpi->packed_tg_offset[tg_count - 1] = old_total_size;
             memmove(dst + old_total_size + hdr_size, dst + old_total_size,
                     (tile_size + 4) * sizeof(uint8_t));
             // Copy uncompressed header
@@ -3329,7 +3328,9 @@ static uint32_t write_tiles(AV1_COMP *const cpi, uint8_t *const dst,
             tile_count = 1;
             curr_tg_data_size = hdr_size + tile_size + 4;
           } else {
-            // We exceeded the packet size in just one tile
+            cpi->packed_tg_offset[tg_count - 1] = total_size;
+            // The tile group is full, or we exceeded the packet size in just
+            // one tile
             // Copy uncompressed header
             memmove(dst + total_size, dst,
                     uncompressed_hdr_size * sizeof(uint8_t));
@@ -3394,6 +3395,7 @@ static uint32_t write_tiles(AV1_COMP *const cpi, uint8_t *const dst,
         total_size += tile_size;
       }
     }
+    cpi->num_packed_tg = tg_count;
     // Write the final tile group size
     if (n_log2_tiles) {
       aom_wb_overwrite_literal(
@@ -4788,6 +4790,10 @@ static uint32_t write_tiles_in_tg_obus(AV1_COMP *const cpi, uint8_t *const dst,
         int is_last_tile_in_tg = 0;
 
         if (new_tg) {
+          if (tile_idx) {
+            // The first tile group starts with the frame headers.
+            cpi->packed_tg_offset[cpi->num_packed_tg++] = total_size;
+          }
           if (insert_frame_header_obu_flag && tile_idx) {
             // insert a copy of frame header OBU (including
             // PRE_OBU_SIZE_BYTES-byte size),
@@ -4911,6 +4917,9 @@ void av1_pack_bitstream(AV1_COMP *const cpi, uint8_t *dst, size_t *size) {
   bitstream_queue_reset_write();
 #endif
 
+  cpi->num_packed_tg = 1;
+  cpi->packed_tg_offset[0] = 0;
+
 #if CONFIG_OBU
   // The TD is now written outside the frame encode loop
 
@@ -4946,6 +4955,8 @@ void av1_pack_bitstream(AV1_COMP *const cpi, uint8_t *dst, size_t *size) {
         cpi, data, &max_tile_size, &max_tile_col_size,
         frame_header_location - PRE_OBU_SIZE_BYTES,
         obu_size + PRE_OBU_SIZE_BYTES, 1 /* cm->error_resilient_mode */);
+    for (int i = 1; i < cpi->num_packed_tg; ++i)
+      cpi->packed_tg_offset[i] += (uint32_t)(data - dst);
   }
 
 #endif
@@ -15,6 +15,7 @@
 #include "av1/common/entropymv.h"
 #include "av1/common/entropy.h"
 #include "av1/common/mvref_common.h"
+#include "av1/common/reconintra.h"
 #include "av1/encoder/hash.h"
 #if CONFIG_DIST_8X8
 #include "aom/aomcx.h"
@@ -120,11 +121,55 @@ typedef struct {
   float kmeans_data_buf[2 * MAX_PALETTE_SQUARE];
 } PALETTE_BUFFER;
 
+// Search effort counters, summed into AV1_COMP::frame_stats after each pass
+// over the tiles of a frame.
+typedef struct {
+  unsigned int partition_evals;
+  unsigned int mode_evals;
+  unsigned int tx_search_evals;
+  unsigned int tx_cache_lookups;
+  unsigned int tx_cache_hits;
+  unsigned int mv_cache_lookups;
+  unsigned int mv_cache_hits;
+} SEARCH_COUNTS;
+
+// Result of a single reference translational motion search. The key holds
+// every input the search depends on within a superblock, so a hit returns
+// exactly what repeating the search would.
+typedef struct {
+  uint32_t generation;
+  int16_t mi_row;
+  int16_t mi_col;
+  uint8_t bsize;
+  int8_t ref;
+  int step_param;
+  int errorperbit;
+  int sadperbit;
+  int_mv ref_mv;
+  int_mv start_mv;
+  int **mvcost;
+  // Sub-pel result, or INVALID_MV while the entry holds no result.
+  int_mv best_mv;
+  unsigned int pred_sse;
+  // Full-pel and exhaustive searches run to get the result.
+  int m_search_count;
+  int ex_search_count;
+} MV_SEARCH_RESULT;
+
+// Direct-mapped cache of motion search results, shared by all the partition
+// shapes tried within one superblock. Entries from an earlier superblock are
+// invalidated by bumping the generation.
+#define MV_SEARCH_CACHE_SIZE 256
+typedef struct {
+  MV_SEARCH_RESULT entries[MV_SEARCH_CACHE_SIZE];
+  uint32_t generation;
+} MV_SEARCH_CACHE;
+
 typedef struct {
   TX_TYPE tx_type;
   TX_SIZE tx_size;
   TX_SIZE min_tx_size;
-  TX_SIZE inter_tx_size[MAX_MIB_SIZE][MAX_MIB_SIZE];
+  TX_SIZE inter_tx_size[INTER_TX_SIZE_BUF_LEN][INTER_TX_SIZE_BUF_LEN];
   uint8_t blk_skip[MAX_MIB_SIZE * MAX_MIB_SIZE * 8];
 #if CONFIG_TXK_SEL
   TX_TYPE txk_type[MAX_SB_SQUARE / (TX_SIZE_W_MIN * TX_SIZE_H_MIN)];
@@ -202,6 +247,7 @@ struct macroblock {
   int *ex_search_count_ptr;
 
   unsigned int txb_split_count;
+  SEARCH_COUNTS search_counts;
 
   // These are set to their default values at the beginning, and then adjusted
   // further in the encoding process.
@@ -261,6 +307,12 @@ struct macroblock {
   av1_coeff_cost token_head_costs[TX_SIZES];
   av1_coeff_cost token_tail_costs[TX_SIZES];
 
+  // Copy of the CDFs that the cost tables in this struct were last built
+  // from, so av1_fill_rate_tables() only rebuilds tables whose CDFs changed.
+  // Its contents are only meaningful while cost_cdfs_valid is set.
+  FRAME_CONTEXT *cost_cdfs;
+  int cost_cdfs_valid;
+
   // mode costs
   int intra_inter_cost[INTRA_INTER_CONTEXTS][2];
 
@@ -335,6 +387,10 @@ struct macroblock {
   int_mv best_mv;
   // Store the second best motion vector during full-pixel motion search
   int_mv second_best_mv;
+  // Motion search results of the current superblock.
+  MV_SEARCH_CACHE mv_search_cache;
+  // Intra edges and prediction of the block whose intra modes are searched.
+  INTRA_PRED_CACHE intra_pred_cache;
 
   // use default transform and skip transform type search for intra modes
   int use_default_intra_tx_type;
@@ -52,6 +52,7 @@
 #endif
 #include "av1/encoder/ethread.h"
 #include "av1/encoder/extend.h"
+#include "av1/encoder/partition_strategy.h"
 #if CONFIG_LPF_SB
 #include "av1/encoder/picklpf.h"
 #endif
@@ -595,16 +596,6 @@ static void update_state(const AV1_COMP *const cpi, TileDataEnc *tile_data,
         // TODO(sarahparker): global motion stats need to be handled per-tile
         // to be compatible with tile-based threading.
         update_global_motion_used(mbmi->mode, bsize, mbmi, rdc);
-      } else {
-        const int num_4x4_w = num_4x4_blocks_wide_lookup[bsize];
-        const int num_4x4_h = num_4x4_blocks_high_lookup[bsize];
-        int idx, idy;
-        for (idy = 0; idy < 2; idy += num_4x4_h) {
-          for (idx = 0; idx < 2; idx += num_4x4_w) {
-            const int j = idy * 2 + idx;
-            update_global_motion_used(mi->bmi[j].as_mode, bsize, mbmi, rdc);
-          }
-        }
       }
       if (cm->interp_filter == SWITCHABLE &&
           mbmi->motion_mode != WARPED_CAUSAL &&
@@ -831,6 +822,7 @@ static void rd_pick_sb_modes(const AV1_COMP *const cpi, TileDataEnc *tile_data,
   int i, orig_rdmult;
 
   aom_clear_system_state();
+  ++x->search_counts.mode_evals;
 
   set_offsets(cpi, tile_info, x, mi_row, mi_col, bsize);
   mbmi = &xd->mi[0]->mbmi;
@@ -2437,6 +2429,44 @@ static int64_t dist_8x8_yuv(const AV1_COMP *const cpi, MACROBLOCK *const x,
 }
 #endif  // CONFIG_DIST_8X8
 
+// Collect the inputs of the learned partition pruning models. Must be called
+// right after the PARTITION_NONE search, while x->source_variance still
+// refers to bsize.
+static void get_partition_prune_features(const AV1_COMMON *const cm,
+                                         const MACROBLOCK *const x,
+                                         BLOCK_SIZE bsize,
+                                         const RD_STATS *none_rdc,
+                                         int none_skippable, float *features) {
+  const MACROBLOCKD *const xd = &x->e_mbd;
+  const BLOCK_SIZE above_bsize =
+      xd->above_mi ? xd->above_mi->mbmi.sb_type : bsize;
+  const BLOCK_SIZE left_bsize = xd->left_mi ? xd->left_mi->mbmi.sb_type : bsize;
+  av1_get_partition_prune_features(bsize, above_bsize, left_bsize,
+                                   x->source_variance, none_rdc,
+                                   none_skippable, xd->bd, cm->base_qindex,
+                                   features);
+}
+
+// Returns the entry of cpi->recode_partition for the square block at
+// (mi_row, mi_col).
+static uint8_t *get_recode_partition(const AV1_COMP *const cpi, int mi_row,
+                                     int mi_col, BLOCK_SIZE bsize) {
+  const int level = b_width_log2_lookup[bsize];
+  const int mask = (1 << level) - 1;
+  const int cols = (cpi->common.mi_cols + mask) >> level;
+  return cpi->recode_partition + cpi->recode_partition_offset[level] +
+         (mi_row >> level) * cols + (mi_col >> level);
+}
+
+// Returns whether a partition type is searched. When the partition picked by
+// the first recode iteration is reused, only that type is searched and the
+// pruning heuristics are bypassed.
+static INLINE int search_partition_type(PARTITION_TYPE reuse_partition,
+                                        PARTITION_TYPE type, int allowed) {
+  return reuse_partition == PARTITION_INVALID ? allowed
+                                              : reuse_partition == type;
+}
+
 // TODO(jingning,jimbankoski,rbultje): properly skip partition types that are
 // unlikely to be selected depending on previous rate-distortion optimization
 // results, for encoding speed-up.
@@ -2470,6 +2500,11 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
       pl >= 0 ? x->partition_cost[pl] : x->partition_cost[0];
 
   int do_rectangular_split = 1;
+  const int ml_prune_level = cpi->sf.ml_prune_partition_search;
+  float ml_features[PARTITION_RECT_PRUNE_FEATURES];
+  int ml_features_valid = 0;
+  int64_t none_rdcost = INT64_MAX;
+  int64_t split_rdcost = INT64_MAX;
 #if CONFIG_EXT_PARTITION_TYPES
   int64_t split_rd[4] = { 0, 0, 0, 0 };
   int64_t horz_rd[4] = { 0, 0 };
@@ -2492,6 +2527,7 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
   debug("Pick RD partition for (mi_row, mi_col)-(%d,%d)", mi_row, mi_col);
 
   if (none_rd) *none_rd = 0;
+  ++x->search_counts.partition_evals;
 
 #if CONFIG_FP_MB_STATS
   unsigned int src_diff_var = UINT_MAX;
@@ -2501,6 +2537,10 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
   int partition_none_allowed = has_rows && has_cols;
   int partition_horz_allowed = has_cols && yss <= xss && bsize_at_least_8x8;
   int partition_vert_allowed = has_rows && xss <= yss && bsize_at_least_8x8;
+  const PARTITION_TYPE reuse_partition =
+      cpi->reuse_recode_partition && bsize_at_least_8x8
+          ? (PARTITION_TYPE)*get_recode_partition(cpi, mi_row, mi_col, bsize)
+          : PARTITION_INVALID;
 
   // ADI :  If the reference tree structure from a higher quality does not split further down, then do not split.
   #ifdef ADI_READ_MODE
@@ -2649,7 +2689,8 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
 #endif
 
   // PARTITION_NONE
-  if (partition_none_allowed) {
+  if (search_partition_type(reuse_partition, PARTITION_NONE,
+                            partition_none_allowed)) {
     rd_pick_sb_modes(cpi, tile_data, x, mi_row, mi_col, &this_rdc,
 #if CONFIG_EXT_PARTITION_TYPES
                      PARTITION_NONE,
@@ -2665,6 +2706,13 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
         this_rdc.rdcost = RDCOST(x->rdmult, this_rdc.rate, this_rdc.dist);
       }
 
+      if (ml_prune_level && bsize_at_least_8x8) {
+        get_partition_prune_features(cm, x, bsize, &this_rdc,
+                                     ctx_none->skippable, ml_features);
+        ml_features_valid = 1;
+        none_rdcost = this_rdc.rdcost;
+      }
+
       if (this_rdc.rdcost < best_rdc.rdcost) {
         // Adjust dist breakout threshold according to the partition size.
         const int64_t dist_breakout_thr =
@@ -2746,10 +2794,15 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
 
   int64_t temp_best_rdcost = best_rdc.rdcost;
 
+  if (ml_features_valid && do_square_split &&
+      av1_ml_prune_split(ml_features, ml_prune_level))
+    do_square_split = 0;
+
   // PARTITION_SPLIT
   // TODO(jingning): use the motion vectors given by the above search as
   // the starting point of motion search in the following partition type check.
-  if (do_square_split) {
+  if (search_partition_type(reuse_partition, PARTITION_SPLIT,
+                            do_square_split)) {
     int reached_last_index = 0;
     subsize = get_subsize(bsize, PARTITION_SPLIT);
     int idx;
@@ -2803,6 +2856,7 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
     if (reached_last_index && sum_rdc.rdcost < best_rdc.rdcost) {
       sum_rdc.rate += partition_cost[PARTITION_SPLIT];
       sum_rdc.rdcost = RDCOST(x->rdmult, sum_rdc.rate, sum_rdc.dist);
+      split_rdcost = sum_rdc.rdcost;
 
       if (sum_rdc.rdcost < best_rdc.rdcost) {
         best_rdc = sum_rdc;
@@ -2818,9 +2872,20 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
     restore_context(x, &x_ctx, mi_row, mi_col, bsize);
   }  // if (do_split)
 
+  if (ml_features_valid && do_rectangular_split &&
+      (partition_horz_allowed || partition_vert_allowed) &&
+      av1_ml_prune_rect(ml_features, none_rdcost, split_rdcost,
+                        best_rdc.rdcost != INT64_MAX &&
+                            split_rdcost == best_rdc.rdcost,
+                        ml_prune_level))
+    do_rectangular_split = 0;
+
   // PARTITION_HORZ
-  if (partition_horz_allowed &&
-      (do_rectangular_split || av1_active_h_edge(cpi, mi_row, mi_step))) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_HORZ,
+          partition_horz_allowed &&
+              (do_rectangular_split ||
+               av1_active_h_edge(cpi, mi_row, mi_step)))) {
     subsize = get_subsize(bsize, PARTITION_HORZ);
     if (cpi->sf.adaptive_motion_search) load_pred_mv(x, ctx_none);
     if (cpi->sf.adaptive_pred_interp_filter && bsize == BLOCK_8X8 &&
@@ -2903,8 +2968,11 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
   }
 
   // PARTITION_VERT
-  if (partition_vert_allowed &&
-      (do_rectangular_split || av1_active_v_edge(cpi, mi_col, mi_step))) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_VERT,
+          partition_vert_allowed &&
+              (do_rectangular_split ||
+               av1_active_v_edge(cpi, mi_col, mi_step)))) {
     subsize = get_subsize(bsize, PARTITION_VERT);
 
     if (cpi->sf.adaptive_motion_search) load_pred_mv(x, ctx_none);
@@ -3044,7 +3112,9 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
 
 // PARTITION_HORZ_A
 #if CONFIG_EXT_PARTITION_TYPES_AB
-  if (partition_horz_allowed && horzab_partition_allowed) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_HORZ_A,
+          partition_horz_allowed && horzab_partition_allowed)) {
     rd_test_partition3(
         cpi, td, tile_data, tp, pc_tree, &best_rdc, pc_tree->horizontala,
         ctx_none, mi_row, mi_col, bsize, PARTITION_HORZ_A, mi_row, mi_col,
@@ -3054,7 +3124,9 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
     restore_context(x, &x_ctx, mi_row, mi_col, bsize);
   }
 #else
-  if (partition_horz_allowed && horza_partition_allowed) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_HORZ_A,
+          partition_horz_allowed && horza_partition_allowed)) {
     subsize = get_subsize(bsize, PARTITION_HORZ_A);
     rd_test_partition3(cpi, td, tile_data, tp, pc_tree, &best_rdc,
                        pc_tree->horizontala, ctx_none, mi_row, mi_col, bsize,
@@ -3066,7 +3138,9 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
 #endif
 // PARTITION_HORZ_B
 #if CONFIG_EXT_PARTITION_TYPES_AB
-  if (partition_horz_allowed && horzab_partition_allowed) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_HORZ_B,
+          partition_horz_allowed && horzab_partition_allowed)) {
     rd_test_partition3(
         cpi, td, tile_data, tp, pc_tree, &best_rdc, pc_tree->horizontalb,
         ctx_none, mi_row, mi_col, bsize, PARTITION_HORZ_B, mi_row, mi_col,
@@ -3079,7 +3153,9 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
   (void)horz_rd;
   (void)split_rd;
 #else
-  if (partition_horz_allowed && horzb_partition_allowed) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_HORZ_B,
+          partition_horz_allowed && horzb_partition_allowed)) {
     subsize = get_subsize(bsize, PARTITION_HORZ_B);
     rd_test_partition3(cpi, td, tile_data, tp, pc_tree, &best_rdc,
                        pc_tree->horizontalb, ctx_none, mi_row, mi_col, bsize,
@@ -3101,7 +3177,9 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
 
 // PARTITION_VERT_A
 #if CONFIG_EXT_PARTITION_TYPES_AB
-  if (partition_vert_allowed && vertab_partition_allowed) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_VERT_A,
+          partition_vert_allowed && vertab_partition_allowed)) {
     rd_test_partition3(
         cpi, td, tile_data, tp, pc_tree, &best_rdc, pc_tree->verticala,
         ctx_none, mi_row, mi_col, bsize, PARTITION_VERT_A, mi_row, mi_col,
@@ -3111,7 +3189,9 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
     restore_context(x, &x_ctx, mi_row, mi_col, bsize);
   }
 #else
-  if (partition_vert_allowed && verta_partition_allowed) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_VERT_A,
+          partition_vert_allowed && verta_partition_allowed)) {
     subsize = get_subsize(bsize, PARTITION_VERT_A);
     rd_test_partition3(cpi, td, tile_data, tp, pc_tree, &best_rdc,
                        pc_tree->verticala, ctx_none, mi_row, mi_col, bsize,
@@ -3123,7 +3203,9 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
 #endif
 // PARTITION_VERT_B
 #if CONFIG_EXT_PARTITION_TYPES_AB
-  if (partition_vert_allowed && vertab_partition_allowed) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_VERT_B,
+          partition_vert_allowed && vertab_partition_allowed)) {
     rd_test_partition3(
         cpi, td, tile_data, tp, pc_tree, &best_rdc, pc_tree->verticalb,
         ctx_none, mi_row, mi_col, bsize, PARTITION_VERT_B, mi_row, mi_col,
@@ -3133,7 +3215,9 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
     restore_context(x, &x_ctx, mi_row, mi_col, bsize);
   }
 #else
-  if (partition_vert_allowed && vertb_partition_allowed) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_VERT_B,
+          partition_vert_allowed && vertb_partition_allowed)) {
     subsize = get_subsize(bsize, PARTITION_VERT_B);
     rd_test_partition3(cpi, td, tile_data, tp, pc_tree, &best_rdc,
                        pc_tree->verticalb, ctx_none, mi_row, mi_col, bsize,
@@ -3153,8 +3237,11 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
                                 pc_tree->partitioning == PARTITION_SPLIT ||
                                 pc_tree->partitioning == PARTITION_NONE);
   }
-  if (partition_horz4_allowed && has_rows &&
-      (do_rectangular_split || av1_active_h_edge(cpi, mi_row, mi_step))) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_HORZ_4,
+          partition_horz4_allowed && has_rows &&
+              (do_rectangular_split ||
+               av1_active_h_edge(cpi, mi_row, mi_step)))) {
     const int quarter_step = mi_size_high[bsize] / 4;
     PICK_MODE_CONTEXT *ctx_prev = ctx_none;
 
@@ -3195,8 +3282,11 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
                                 pc_tree->partitioning == PARTITION_SPLIT ||
                                 pc_tree->partitioning == PARTITION_NONE);
   }
-  if (partition_vert4_allowed && has_cols &&
-      (do_rectangular_split || av1_active_v_edge(cpi, mi_row, mi_step))) {
+  if (search_partition_type(
+          reuse_partition, PARTITION_VERT_4,
+          partition_vert4_allowed && has_cols &&
+              (do_rectangular_split ||
+               av1_active_v_edge(cpi, mi_row, mi_step)))) {
     const int quarter_step = mi_size_wide[bsize] / 4;
     PICK_MODE_CONTEXT *ctx_prev = ctx_none;
 
@@ -3236,6 +3326,10 @@ static void rd_pick_partition(const AV1_COMP *const cpi, ThreadData *td,
   (void)best_rd;
   *rd_cost = best_rdc;
 
+  if (cpi->record_recode_partition && bsize_at_least_8x8)
+    *get_recode_partition(cpi, mi_row, mi_col, bsize) =
+        best_rdc.rate < INT_MAX ? pc_tree->partitioning : PARTITION_INVALID;
+
   if (best_rdc.rate < INT_MAX && best_rdc.dist < INT64_MAX &&
       pc_tree->index != 3) {
     if (bsize == cm->sb_size) {
@@ -3440,15 +3534,7 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
     MODE_INFO **mi = cm->mi_grid_visible + idx_str;
     PC_TREE *const pc_root = td->pc_root[cm->mib_size_log2 - MIN_MIB_SIZE_LOG2];
 
-#if CONFIG_LV_MAP
-    av1_fill_coeff_costs(&td->mb, xd->tile_ctx);
-#else
-    av1_fill_token_costs_from_cdf(x->token_head_costs,
-                                  x->e_mbd.tile_ctx->coef_head_cdfs);
-    av1_fill_token_costs_from_cdf(x->token_tail_costs,
-                                  x->e_mbd.tile_ctx->coef_tail_cdfs);
-#endif
-    av1_fill_mode_rates(cm, x, xd->tile_ctx);
+    av1_fill_rate_tables(cm, x, xd->tile_ctx);
 
     if (sf->adaptive_pred_interp_filter) {
       for (i = 0; i < leaf_nodes; ++i) {
@@ -3468,6 +3554,10 @@ static void encode_rd_sb_row(AV1_COMP *cpi, ThreadData *td,
 #endif
 
     av1_zero(x->pred_mv);
+    if (++x->mv_search_cache.generation == 0) {
+      av1_zero(x->mv_search_cache);
+      x->mv_search_cache.generation = 1;
+    }
     pc_root->index = 0;
 
     if (seg->enabled) {
@@ -4083,6 +4173,17 @@ static void enforce_max_ref_frames(AV1_COMP *cpi) {
 }
 #endif  // CONFIG_FRAME_MARKER
 
+static void accumulate_search_counts(aom_frame_stats_t *stats,
+                                     const SEARCH_COUNTS *counts) {
+  stats->partition_evals += counts->partition_evals;
+  stats->mode_evals += counts->mode_evals;
+  stats->tx_search_evals += counts->tx_search_evals;
+  stats->tx_cache_lookups += counts->tx_cache_lookups;
+  stats->tx_cache_hits += counts->tx_cache_hits;
+  stats->mv_cache_lookups += counts->mv_cache_lookups;
+  stats->mv_cache_hits += counts->mv_cache_hits;
+}
+
 static void encode_frame_internal(AV1_COMP *cpi) {
   ThreadData *const td = &cpi->td;
   MACROBLOCK *const x = &td->mb;
@@ -4206,6 +4307,7 @@ static void encode_frame_internal(AV1_COMP *cpi) {
   av1_zero(cpi->gmparams_cost);
   if (cpi->common.frame_type == INTER_FRAME && cpi->source &&
       !cpi->global_motion_search_done) {
+    struct aom_usec_timer gm_timer;
     YV12_BUFFER_CONFIG *ref_buf[TOTAL_REFS_PER_FRAME];
     int frame;
     double params_by_motion[RANSAC_NUM_MOTIONS * (MAX_PARAMDIM - 1)];
@@ -4217,6 +4319,7 @@ static void encode_frame_internal(AV1_COMP *cpi) {
     };
     int num_refs_using_gm = 0;
 
+    aom_usec_timer_start(&gm_timer);
     for (frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame) {
       ref_buf[frame] = get_ref_frame_buffer(cpi, frame);
       int pframe;
@@ -4323,6 +4426,8 @@ static void encode_frame_internal(AV1_COMP *cpi) {
           cpi->gmtype_cost[IDENTITY];
     }
     cpi->global_motion_search_done = 1;
+    aom_usec_timer_mark(&gm_timer);
+    cpi->frame_stats.global_motion_us += aom_usec_timer_elapsed(&gm_timer);
   }
   memcpy(cm->cur_frame->global_motion, cm->global_motion,
          TOTAL_REFS_PER_FRAME * sizeof(WarpedMotionParams));
@@ -4413,6 +4518,8 @@ static void encode_frame_internal(AV1_COMP *cpi) {
       cm->use_prev_frame_mvs ? cm->prev_mip + cm->mi_stride + 1 : NULL;
 
   x->txb_split_count = 0;
+  av1_zero(x->search_counts);
+  x->cost_cdfs_valid = 0;
   av1_zero(x->blk_skip_drl);
 
 #if CONFIG_MFMV
@@ -4483,6 +4590,9 @@ static void encode_frame_internal(AV1_COMP *cpi) {
 
     aom_usec_timer_mark(&emr_timer);
     cpi->time_encode_sb_row += aom_usec_timer_elapsed(&emr_timer);
+    cpi->frame_stats.partition_search_us += aom_usec_timer_elapsed(&emr_timer);
+    accumulate_search_counts(&cpi->frame_stats, &x->search_counts);
+    ++cpi->frame_stats.encode_passes;
   }
 
 #if CONFIG_INTRABC
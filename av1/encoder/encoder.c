@@ -359,23 +359,20 @@ static void setup_frame(AV1_COMP *cpi) {
     set_use_reference_buffer(cm, 0);
 #endif  // CONFIG_REFERENCE_BUFFER
 #if CONFIG_NO_FRAME_CONTEXT_SIGNALING
-    cm->pre_fc = &cm->frame_contexts[FRAME_CONTEXT_DEFAULTS];
+    set_pre_frame_context(cm, FRAME_CONTEXT_DEFAULTS);
 #else
-    cm->pre_fc = &cm->frame_contexts[cm->frame_context_idx];
+    set_pre_frame_context(cm, cm->frame_context_idx);
 #endif  // CONFIG_NO_FRAME_CONTEXT_SIGNALING
   } else {
 #if CONFIG_NO_FRAME_CONTEXT_SIGNALING
     if (frame_is_intra_only(cm) || cm->error_resilient_mode) {
-      *cm->fc = cm->frame_contexts[FRAME_CONTEXT_DEFAULTS];
-      cm->pre_fc = &cm->frame_contexts[FRAME_CONTEXT_DEFAULTS];
+      load_frame_context(cm, FRAME_CONTEXT_DEFAULTS);
     } else {
       assert(cm->frame_refs[0].idx >= 0);
-      *cm->fc = cm->frame_contexts[cm->frame_refs[0].idx];
-      cm->pre_fc = &cm->frame_contexts[cm->frame_refs[0].idx];
+      load_frame_context(cm, cm->frame_refs[0].idx);
     }
 #else
-    *cm->fc = cm->frame_contexts[cm->frame_context_idx];
-    cm->pre_fc = &cm->frame_contexts[cm->frame_context_idx];
+    load_frame_context(cm, cm->frame_context_idx);
 #endif  // CONFIG_NO_FRAME_CONTEXT_SIGNALING
     av1_zero(cpi->interp_filter_selected[0]);
   }
@@ -516,6 +513,9 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
   aom_free(cpi->td.mb.mask_buf);
   cpi->td.mb.mask_buf = NULL;
 
+  aom_free(cpi->td.mb.cost_cdfs);
+  cpi->td.mb.cost_cdfs = NULL;
+
 #if CONFIG_MFMV
   aom_free(cm->tpl_mvs);
   cm->tpl_mvs = NULL;
@@ -540,6 +540,10 @@ static void dealloc_compressor_data(AV1_COMP *cpi) {
   aom_free(cpi->tile_tok[0][0]);
   cpi->tile_tok[0][0] = 0;
 
+  aom_free(cpi->recode_partition);
+  cpi->recode_partition = NULL;
+  cpi->recode_partition_size = 0;
+
   av1_free_pc_tree(&cpi->td);
 
   aom_free(cpi->td.mb.palette_buffer);
@@ -2577,11 +2581,10 @@ AV1_COMP *av1_create_compressor(AV1EncoderConfig *oxcf,
 
   CHECK_MEM_ERROR(cm, cm->fc,
                   (FRAME_CONTEXT *)aom_memalign(32, sizeof(*cm->fc)));
-  CHECK_MEM_ERROR(cm, cm->frame_contexts,
-                  (FRAME_CONTEXT *)aom_memalign(
-                      32, FRAME_CONTEXTS * sizeof(*cm->frame_contexts)));
+  if (av1_alloc_frame_contexts(cm))
+    aom_internal_error(&cm->error, AOM_CODEC_MEM_ERROR,
+                       "Failed to allocate frame contexts");
   memset(cm->fc, 0, sizeof(*cm->fc));
-  memset(cm->frame_contexts, 0, FRAME_CONTEXTS * sizeof(*cm->frame_contexts));
 
   cpi->resize_state = 0;
   cpi->resize_avg_qp = 0;
@@ -2762,6 +2765,9 @@ AV1_COMP *av1_create_compressor(AV1EncoderConfig *oxcf,
                   (int32_t *)aom_memalign(
                       16, MAX_SB_SQUARE * sizeof(*cpi->td.mb.mask_buf)));
 
+  CHECK_MEM_ERROR(cm, cpi->td.mb.cost_cdfs,
+                  aom_memalign(32, sizeof(*cpi->td.mb.cost_cdfs)));
+
   av1_set_speed_features_framesize_independent(cpi);
   av1_set_speed_features_framesize_dependent(cpi);
 
@@ -3283,6 +3289,7 @@ void av1_remove_compressor(AV1_COMP *cpi) {
       aom_free(thread_data->td->left_pred_buf);
       aom_free(thread_data->td->wsrc_buf);
       aom_free(thread_data->td->mask_buf);
+      aom_free(thread_data->td->cost_cdfs);
       aom_free(thread_data->td->counts);
       av1_free_pc_tree(thread_data->td);
       aom_free(thread_data->td);
@@ -3290,6 +3297,11 @@ void av1_remove_compressor(AV1_COMP *cpi) {
   }
   aom_free(cpi->tile_thr_data);
   aom_free(cpi->workers);
+#if CONFIG_INTERNAL_STATS
+  for (t = 0; t < cpi->num_metrics_workers; ++t)
+    aom_get_worker_interface()->end(&cpi->metrics_workers[t]);
+  aom_free(cpi->metrics_workers);
+#endif  // CONFIG_INTERNAL_STATS
 
   if (cpi->num_workers > 1) av1_loop_filter_dealloc(&cpi->lf_row_sync);
 
@@ -4644,9 +4656,18 @@ static void superres_post_encode(AV1_COMP *cpi) {
 }
 #endif  // CONFIG_FRAME_SUPERRES
 
+static void pack_bitstream(AV1_COMP *cpi, uint8_t *dest, size_t *size) {
+  struct aom_usec_timer timer;
+  aom_usec_timer_start(&timer);
+  av1_pack_bitstream(cpi, dest, size);
+  aom_usec_timer_mark(&timer);
+  cpi->frame_stats.pack_bitstream_us += aom_usec_timer_elapsed(&timer);
+}
+
 static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
   MACROBLOCKD *xd = &cpi->td.mb.e_mbd;
   struct loopfilter *lf = &cm->lf;
+  struct aom_usec_timer stage_timer;
   int no_loopfilter = 0;
 #if CONFIG_LOOP_RESTORATION
   int no_restoration = 0;
@@ -4682,6 +4703,7 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
     no_cdef = 1;
   }
 
+  aom_usec_timer_start(&stage_timer);
   if (no_loopfilter) {
 #if CONFIG_LOOPFILTER_LEVEL
     lf->filter_level[0] = 0;
@@ -4717,18 +4739,40 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
                           0);
 #else
 #if CONFIG_LOOPFILTER_LEVEL
-    av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level[0],
-                          lf->filter_level[1], 0, 0);
-    av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level_u,
-                          lf->filter_level_u, 1, 0);
-    av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level_v,
-                          lf->filter_level_v, 2, 0);
-
+    if (cpi->num_workers > 1) {
+      av1_loop_filter_frame_mt(cm->frame_to_show, cm, xd->plane,
+                               lf->filter_level[0], lf->filter_level[1], 0, 0,
+                               cpi->workers, cpi->num_workers,
+                               &cpi->lf_row_sync);
+      av1_loop_filter_frame_mt(cm->frame_to_show, cm, xd->plane,
+                               lf->filter_level_u, lf->filter_level_u, 1, 0,
+                               cpi->workers, cpi->num_workers,
+                               &cpi->lf_row_sync);
+      av1_loop_filter_frame_mt(cm->frame_to_show, cm, xd->plane,
+                               lf->filter_level_v, lf->filter_level_v, 2, 0,
+                               cpi->workers, cpi->num_workers,
+                               &cpi->lf_row_sync);
+    } else {
+      av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level[0],
+                            lf->filter_level[1], 0, 0);
+      av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level_u,
+                            lf->filter_level_u, 1, 0);
+      av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level_v,
+                            lf->filter_level_v, 2, 0);
+    }
 #else
-    av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level, 0, 0);
+    if (cpi->num_workers > 1)
+      av1_loop_filter_frame_mt(cm->frame_to_show, cm, xd->plane,
+                               lf->filter_level, 0, 0, cpi->workers,
+                               cpi->num_workers, &cpi->lf_row_sync);
+    else
+      av1_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level, 0, 0);
 #endif  // CONFIG_LOOPFILTER_LEVEL
 #endif  // CONFIG_LPF_SB
   }
+  aom_usec_timer_mark(&stage_timer);
+  cpi->frame_stats.loop_filter_search_us +=
+      aom_usec_timer_elapsed(&stage_timer);
 
 #if CONFIG_STRIPED_LOOP_RESTORATION
 #if CONFIG_FRAME_SUPERRES && CONFIG_HORZONLY_FRAME_SUPERRES
@@ -4743,12 +4787,15 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
     cm->cdef_strengths[0] = 0;
     cm->nb_cdef_strengths = 1;
   } else {
+    aom_usec_timer_start(&stage_timer);
     // Find CDEF parameters
     av1_cdef_search(cm->frame_to_show, cpi->source, cm, xd,
                     cpi->sf.fast_cdef_search);
 
     // Apply the filter
     av1_cdef_frame(cm->frame_to_show, cm, xd);
+    aom_usec_timer_mark(&stage_timer);
+    cpi->frame_stats.cdef_search_us += aom_usec_timer_elapsed(&stage_timer);
   }
 
 #if CONFIG_FRAME_SUPERRES
@@ -4764,6 +4811,7 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
 #if CONFIG_STRIPED_LOOP_RESTORATION
     av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
 #endif
+    aom_usec_timer_start(&stage_timer);
     av1_pick_filter_restoration(cpi->source, cpi);
     if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
         cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
@@ -4771,6 +4819,9 @@ static void loopfilter_frame(AV1_COMP *cpi, AV1_COMMON *cm) {
       av1_loop_restoration_filter_frame(cm->frame_to_show, cm, cm->rst_info, 7,
                                         NULL);
     }
+    aom_usec_timer_mark(&stage_timer);
+    cpi->frame_stats.restoration_search_us +=
+        aom_usec_timer_elapsed(&stage_timer);
   }
 #endif  // CONFIG_LOOP_RESTORATION
   // TODO(debargha): Fix mv search range on encoder side
@@ -4836,12 +4887,32 @@ static void encode_without_recode_loop(AV1_COMP *cpi) {
   aom_clear_system_state();
 }
 
+// Sizes cpi->recode_partition for the current frame size.
+static void alloc_recode_partition(AV1_COMP *cpi) {
+  AV1_COMMON *const cm = &cpi->common;
+  int size = 0;
+  int level;
+  for (level = 0; level < MAX_SB_SIZE_LOG2 - 1; ++level) {
+    const int mask = (1 << level) - 1;
+    cpi->recode_partition_offset[level] = size;
+    size += ((cm->mi_rows + mask) >> level) * ((cm->mi_cols + mask) >> level);
+  }
+  if (size > cpi->recode_partition_size) {
+    aom_free(cpi->recode_partition);
+    CHECK_MEM_ERROR(cm, cpi->recode_partition, aom_malloc(size));
+    cpi->recode_partition_size = size;
+  }
+}
+
 static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
                                     uint8_t *dest) {
   AV1_COMMON *const cm = &cpi->common;
   RATE_CONTROL *const rc = &cpi->rc;
   int bottom_index, top_index;
   int loop_count = 0;
+  // Whether the coding context still holds the snapshot saved for the last
+  // iteration.
+  int context_saved = 0;
   int loop_at_this_size = 0;
   int loop = 0;
 #if !CONFIG_XIPHRC
@@ -4915,6 +4986,7 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
     if (frame_is_intra_only(cm) || cm->error_resilient_mode) {
       av1_default_coef_probs(cm);
       av1_setup_frame_contexts(cm);
+      context_saved = 0;
     }
 #endif  // CONFIG_Q_ADAPT_PROBS
 
@@ -4926,8 +4998,20 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
       av1_setup_in_frame_q_adj(cpi);
     }
 
+    // Partitions picked by the first iteration are kept for the next ones.
+    // The frame size does not change within the loop.
+    if (cpi->sf.recode_reuse_partition && loop_count == 0)
+      alloc_recode_partition(cpi);
+    cpi->record_recode_partition =
+        cpi->sf.recode_reuse_partition && loop_count == 0;
+    cpi->reuse_recode_partition =
+        cpi->sf.recode_reuse_partition && loop_count > 0;
+
     // transform / motion compensation build reconstruction frame
-    save_coding_context(cpi);
+    // The frame context is a full copy, so it is only saved again when the
+    // previous iteration did not leave the snapshot in place.
+    if (!context_saved) save_coding_context(cpi);
+    context_saved = 0;
     debug("Entering av_encode_frame - %d\n", loop_count);
     av1_encode_frame(cpi);
 
@@ -4942,10 +5026,11 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
     // to recode.
     if (cpi->sf.recode_loop >= ALLOW_RECODE_KFARFGF) {
       restore_coding_context(cpi);
-      av1_pack_bitstream(cpi, dest, size);
+      pack_bitstream(cpi, dest, size);
 
       rc->projected_frame_size = (int)(*size) << 3;
       restore_coding_context(cpi);
+      context_saved = 1;
 
       if (frame_over_shoot_limit == 0) frame_over_shoot_limit = 1;
     }
@@ -5102,6 +5187,9 @@ static void encode_with_recode_loop(AV1_COMP *cpi, size_t *size,
 #endif
     }
   } while (loop);
+
+  cpi->record_recode_partition = 0;
+  cpi->reuse_recode_partition = 0;
 }
 
 static int get_ref_frame_flags(const AV1_COMP *cpi) {
@@ -5452,7 +5540,7 @@ static void encode_frame_to_data_rate(AV1_COMP *cpi, size_t *size,
     restore_coding_context(cpi);
 
     // Build the bitstream
-    av1_pack_bitstream(cpi, dest, size);
+    pack_bitstream(cpi, dest, size);
 
     // Set up frame to show to get ready for stats collection.
     cm->frame_to_show = get_frame_new_buffer(cm);
@@ -5695,7 +5783,7 @@ static void encode_frame_to_data_rate(AV1_COMP *cpi, size_t *size,
 #endif
 
   // Build the bitstream
-  av1_pack_bitstream(cpi, dest, size);
+  pack_bitstream(cpi, dest, size);
 
   if (skip_adapt) {
     aom_free(tile_ctxs);
@@ -6088,10 +6176,6 @@ static void check_src_altref(AV1_COMP *cpi,
 }
 
 #if CONFIG_INTERNAL_STATS
-extern double av1_get_blockiness(const unsigned char *img1, int img1_pitch,
-                                 const unsigned char *img2, int img2_pitch,
-                                 int width, int height);
-
 static void adjust_image_stat(double y, double u, double v, double all,
                               ImageStat *s) {
   s->stat[Y] += y;
@@ -6121,64 +6205,37 @@ static void compute_internal_stats(AV1_COMP *cpi, int frame_bytes) {
   if (cm->show_frame) {
     const YV12_BUFFER_CONFIG *orig = cpi->source;
     const YV12_BUFFER_CONFIG *recon = cpi->common.frame_to_show;
-    double y, u, v, frame_all;
+    FrameMetrics metrics;
+    double frame_all;
 
     cpi->count++;
+    av1_calc_frame_metrics_mt(cpi, orig, recon, bit_depth, in_bit_depth,
+                              &metrics);
+    aom_clear_system_state();
     if (cpi->b_calculate_psnr) {
-      PSNR_STATS psnr;
-      double frame_ssim2 = 0.0, weight = 0.0;
-      aom_clear_system_state();
-// TODO(yaowu): unify these two versions into one.
-#if CONFIG_HIGHBITDEPTH
-      aom_calc_highbd_psnr(orig, recon, &psnr, bit_depth, in_bit_depth);
-#else
-      aom_calc_psnr(orig, recon, &psnr);
-#endif  // CONFIG_HIGHBITDEPTH
+      const PSNR_STATS *const psnr = &metrics.psnr;
+      const double frame_ssim2 =
+          metrics.ssim[0] * .8 + .1 * (metrics.ssim[1] + metrics.ssim[2]);
+      const double weight = 1.0;
 
-      adjust_image_stat(psnr.psnr[1], psnr.psnr[2], psnr.psnr[3], psnr.psnr[0],
-                        &cpi->psnr);
-      cpi->total_sq_error += psnr.sse[0];
-      cpi->total_samples += psnr.samples[0];
-      samples = psnr.samples[0];
-// TODO(yaowu): unify these two versions into one.
-#if CONFIG_HIGHBITDEPTH
-      if (cm->use_highbitdepth)
-        frame_ssim2 =
-            aom_highbd_calc_ssim(orig, recon, &weight, bit_depth, in_bit_depth);
-      else
-        frame_ssim2 = aom_calc_ssim(orig, recon, &weight);
-#else
-      frame_ssim2 = aom_calc_ssim(orig, recon, &weight);
-#endif  // CONFIG_HIGHBITDEPTH
+      adjust_image_stat(psnr->psnr[1], psnr->psnr[2], psnr->psnr[3],
+                        psnr->psnr[0], &cpi->psnr);
+      cpi->total_sq_error += psnr->sse[0];
+      cpi->total_samples += psnr->samples[0];
+      samples = psnr->samples[0];
 
       cpi->worst_ssim = AOMMIN(cpi->worst_ssim, frame_ssim2);
       cpi->summed_quality += frame_ssim2 * weight;
       cpi->summed_weights += weight;
-
-#if 0
-      {
-        FILE *f = fopen("q_used.stt", "a");
-        double y2 = psnr.psnr[1];
-        double u2 = psnr.psnr[2];
-        double v2 = psnr.psnr[3];
-        double frame_psnr2 = psnr.psnr[0];
-        fprintf(f, "%5d : Y%f7.3:U%f7.3:V%f7.3:F%f7.3:S%7.3f\n",
-                cm->current_video_frame, y2, u2, v2,
-                frame_psnr2, frame_ssim2);
-        fclose(f);
-      }
-#endif
     }
     if (cpi->b_calculate_blockiness) {
 #if CONFIG_HIGHBITDEPTH
       if (!cm->use_highbitdepth)
 #endif
       {
-        const double frame_blockiness =
-            av1_get_blockiness(orig->y_buffer, orig->y_stride, recon->y_buffer,
-                               recon->y_stride, orig->y_width, orig->y_height);
-        cpi->worst_blockiness = AOMMAX(cpi->worst_blockiness, frame_blockiness);
-        cpi->total_blockiness += frame_blockiness;
+        cpi->worst_blockiness =
+            AOMMAX(cpi->worst_blockiness, metrics.blockiness);
+        cpi->total_blockiness += metrics.blockiness;
       }
 
       if (cpi->b_calculate_consistency) {
@@ -6186,26 +6243,23 @@ static void compute_internal_stats(AV1_COMP *cpi, int frame_bytes) {
         if (!cm->use_highbitdepth)
 #endif
         {
-          const double this_inconsistency = aom_get_ssim_metrics(
-              orig->y_buffer, orig->y_stride, recon->y_buffer, recon->y_stride,
-              orig->y_width, orig->y_height, cpi->ssim_vars, &cpi->metrics, 1);
-
           const double peak = (double)((1 << in_bit_depth) - 1);
           const double consistency =
               aom_sse_to_psnr(samples, peak, cpi->total_inconsistency);
           if (consistency > 0.0)
             cpi->worst_consistency =
                 AOMMIN(cpi->worst_consistency, consistency);
-          cpi->total_inconsistency += this_inconsistency;
+          cpi->total_inconsistency += metrics.inconsistency;
         }
       }
     }
 
-    frame_all =
-        aom_calc_fastssim(orig, recon, &y, &u, &v, bit_depth, in_bit_depth);
-    adjust_image_stat(y, u, v, frame_all, &cpi->fastssim);
-    frame_all = aom_psnrhvs(orig, recon, &y, &u, &v, bit_depth, in_bit_depth);
-    adjust_image_stat(y, u, v, frame_all, &cpi->psnrhvs);
+    frame_all = aom_fastssim_score(metrics.fastssim);
+    adjust_image_stat(metrics.fastssim[0], metrics.fastssim[1],
+                      metrics.fastssim[2], frame_all, &cpi->fastssim);
+    frame_all = aom_psnrhvs_score(metrics.psnrhvs, in_bit_depth);
+    adjust_image_stat(metrics.psnrhvs[0], metrics.psnrhvs[1],
+                      metrics.psnrhvs[2], frame_all, &cpi->psnrhvs);
   }
 }
 #endif  // CONFIG_INTERNAL_STATS
@@ -6470,6 +6524,8 @@ int av1_get_compressed_data(AV1_COMP *cpi, unsigned int *frame_flags,
       cpi->alt_ref_source = source;
 
       if (oxcf->arnr_max_frames > 0) {
+        struct aom_usec_timer tf_timer;
+        aom_usec_timer_start(&tf_timer);
 // Produce the filtered ARF frame.
 #if CONFIG_BGSPRITE
         int bgsprite_ret = av1_background_sprite(cpi, arf_src_index);
@@ -6483,6 +6539,9 @@ int av1_get_compressed_data(AV1_COMP *cpi, unsigned int *frame_flags,
                               arf_src_index);
         aom_extend_frame_borders(&cpi->alt_ref_buffer);
         force_src_buffer = &cpi->alt_ref_buffer;
+        aom_usec_timer_mark(&tf_timer);
+        cpi->frame_stats.temporal_filter_us +=
+            aom_usec_timer_elapsed(&tf_timer);
       }
 
       cm->show_frame = 0;
@@ -6520,6 +6579,8 @@ int av1_get_compressed_data(AV1_COMP *cpi, unsigned int *frame_flags,
       cpi->alt_ref_source = source;
 
       if (oxcf->arnr_max_frames > 0) {
+        struct aom_usec_timer tf_timer;
+        aom_usec_timer_start(&tf_timer);
         // Produce the filtered ARF frame.
         av1_temporal_filter(cpi,
 #if CONFIG_BGSPRITE
@@ -6528,6 +6589,9 @@ int av1_get_compressed_data(AV1_COMP *cpi, unsigned int *frame_flags,
                             arf_src_index);
         aom_extend_frame_borders(&cpi->alt_ref_buffer);
         force_src_buffer = &cpi->alt_ref_buffer;
+        aom_usec_timer_mark(&tf_timer);
+        cpi->frame_stats.temporal_filter_us +=
+            aom_usec_timer_elapsed(&tf_timer);
       }
 
       cm->show_frame = 0;
@@ -6736,10 +6800,10 @@ int av1_get_compressed_data(AV1_COMP *cpi, unsigned int *frame_flags,
   if (!cm->large_scale_tile) {
 #endif  // CONFIG_EXT_TILE
 #if CONFIG_NO_FRAME_CONTEXT_SIGNALING
-    cm->frame_contexts[cm->new_fb_idx] = *cm->fc;
+    av1_store_frame_context(cm, cm->new_fb_idx, cm->fc);
 #else
   if (!cm->error_resilient_mode)
-    cm->frame_contexts[cm->frame_context_idx] = *cm->fc;
+    av1_store_frame_context(cm, cm->frame_context_idx, cm->fc);
 #endif  // CONFIG_NO_FRAME_CONTEXT_SIGNALING
 #if CONFIG_EXT_TILE
   }
@@ -6771,6 +6835,8 @@ int av1_get_compressed_data(AV1_COMP *cpi, unsigned int *frame_flags,
 
   aom_usec_timer_mark(&cmptimer);
   cpi->time_compress_data += aom_usec_timer_elapsed(&cmptimer);
+  cpi->frame_stats.total_us += aom_usec_timer_elapsed(&cmptimer);
+  if (*size > 0) ++cpi->frame_stats.frames;
 
   if (cpi->b_calculate_psnr && oxcf->pass != 1 && cm->show_frame)
     generate_psnr_packet(cpi);
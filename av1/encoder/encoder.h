@@ -345,6 +345,7 @@ typedef struct ThreadData {
   uint8_t *above_pred_buf;
   uint8_t *left_pred_buf;
   PALETTE_BUFFER *palette_buffer;
+  FRAME_CONTEXT *cost_cdfs;
 #if CONFIG_INTRABC
   int intrabc_used_this_tile;
 #endif  // CONFIG_INTRABC
@@ -399,6 +400,17 @@ typedef struct AV1_COMP {
 
   // For a still frame, this flag is set to 1 to skip partition search.
   int partition_search_skippable_frame;
+
+  // Partition type picked for every square block by the first iteration of
+  // the recode loop, see sf.recode_reuse_partition. Holds one plane per square
+  // block size, from 4x4 up, starting at recode_partition_offset[log2(bw/4)].
+  uint8_t *recode_partition;
+  int recode_partition_offset[MAX_SB_SIZE_LOG2 - 1];
+  int recode_partition_size;
+  // Set while encoding the first iteration / a later iteration of the recode
+  // loop with sf.recode_reuse_partition.
+  int record_recode_partition;
+  int reuse_recode_partition;
 #if CONFIG_AMVR
   double csm_rate_array[32];
   double m_rate_array[32];
@@ -503,6 +515,9 @@ typedef struct AV1_COMP {
   uint64_t time_compress_data;
   uint64_t time_pick_lpf;
   uint64_t time_encode_sb_row;
+  // Per-stage statistics of the frames coded by the current
+  // aom_codec_encode() call, see AV1E_GET_FRAME_STATS.
+  aom_frame_stats_t frame_stats;
 
 #if CONFIG_FP_MB_STATS
   int use_fp_mb_stats;
@@ -539,6 +554,10 @@ typedef struct AV1_COMP {
   double worst_consistency;
   Ssimv *ssim_vars;
   Metrics metrics;
+
+  // Threads used to compute the metrics above.
+  int num_metrics_workers;
+  AVxWorker *metrics_workers;
 #endif
   int b_calculate_psnr;
 
@@ -573,6 +592,11 @@ typedef struct AV1_COMP {
   unsigned int tok_count[MAX_TILE_ROWS][MAX_TILE_COLS];
 
   TileBufferEnc tile_buffers[MAX_TILE_ROWS][MAX_TILE_COLS];
+  // Number of tile groups in the last packed frame, and the byte offset at
+  // which each one starts. The first tile group also carries the frame
+  // headers, so it always starts at offset 0.
+  int num_packed_tg;
+  uint32_t packed_tg_offset[MAX_TILE_ROWS * MAX_TILE_COLS];
 
   int resize_state;
   int resize_avg_qp;
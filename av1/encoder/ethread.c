@@ -13,6 +13,12 @@
 #include "av1/encoder/encoder.h"
 #include "av1/encoder/ethread.h"
 #include "aom_dsp/aom_dsp_common.h"
+#if CONFIG_INTERNAL_STATS
+#include "aom_dsp/psnr.h"
+#include "aom_dsp/ssim.h"
+#include "aom_mem/aom_mem.h"
+#include "aom_ports/system_state.h"
+#endif  // CONFIG_INTERNAL_STATS
 
 static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
   for (int i = 0; i < REFERENCE_MODES; i++)
@@ -32,6 +38,17 @@ static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
 #endif  // CONFIG_EXT_SKIP
 }
 
+static void accumulate_search_counts(SEARCH_COUNTS *counts,
+                                     const SEARCH_COUNTS *counts_t) {
+  counts->partition_evals += counts_t->partition_evals;
+  counts->mode_evals += counts_t->mode_evals;
+  counts->tx_search_evals += counts_t->tx_search_evals;
+  counts->tx_cache_lookups += counts_t->tx_cache_lookups;
+  counts->tx_cache_hits += counts_t->tx_cache_hits;
+  counts->mv_cache_lookups += counts_t->mv_cache_lookups;
+  counts->mv_cache_hits += counts_t->mv_cache_hits;
+}
+
 static int enc_worker_hook(EncWorkerData *const thread_data, void *unused) {
   AV1_COMP *const cpi = thread_data->cpi;
   const AV1_COMMON *const cm = &cpi->common;
@@ -111,6 +128,9 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
             cm, thread_data->td->mask_buf,
             (int32_t *)aom_memalign(
                 16, MAX_SB_SQUARE * sizeof(*thread_data->td->mask_buf)));
+        CHECK_MEM_ERROR(
+            cm, thread_data->td->cost_cdfs,
+            aom_memalign(32, sizeof(*thread_data->td->cost_cdfs)));
         // Allocate frame counters in thread data.
         CHECK_MEM_ERROR(cm, thread_data->td->counts,
                         aom_calloc(1, sizeof(*thread_data->td->counts)));
@@ -150,6 +170,7 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
       thread_data->td->mb.left_pred_buf = thread_data->td->left_pred_buf;
       thread_data->td->mb.wsrc_buf = thread_data->td->wsrc_buf;
       thread_data->td->mb.mask_buf = thread_data->td->mask_buf;
+      thread_data->td->mb.cost_cdfs = thread_data->td->cost_cdfs;
     }
     if (thread_data->td->counts != &cpi->common.counts) {
       memcpy(thread_data->td->counts, &cpi->common.counts,
@@ -189,6 +210,250 @@ void av1_encode_tiles_mt(AV1_COMP *cpi) {
       av1_accumulate_frame_counts(&cm->counts, thread_data->td->counts);
       accumulate_rd_opt(&cpi->td, thread_data->td);
       cpi->td.mb.txb_split_count += thread_data->td->mb.txb_split_count;
+      accumulate_search_counts(&cpi->td.mb.search_counts,
+                               &thread_data->td->mb.search_counts);
+    }
+  }
+}
+
+#if CONFIG_INTERNAL_STATS
+extern double av1_get_blockiness(const unsigned char *img1, int img1_pitch,
+                                 const unsigned char *img2, int img2_pitch,
+                                 int width, int height);
+
+typedef enum {
+  METRICS_JOB_PSNR,
+  METRICS_JOB_FASTSSIM,
+  METRICS_JOB_BLOCKINESS,
+  METRICS_JOB_CONSISTENCY,
+  METRICS_JOB_BAND,
+} METRICS_JOB_TYPE;
+
+typedef struct {
+  METRICS_JOB_TYPE type;
+  int plane;
+  int row_start;
+  MetricsBand ssim;
+  MetricsBand psnrhvs;
+  double value;
+} MetricsJob;
+
+typedef struct {
+  AV1_COMP *cpi;
+  const YV12_BUFFER_CONFIG *orig;
+  const YV12_BUFFER_CONFIG *recon;
+  uint32_t bd;
+  uint32_t in_bd;
+  int use_highbitdepth;
+  MetricsJob *jobs;
+  int num_jobs;
+  PSNR_STATS psnr;
+} MetricsFrameData;
+
+typedef struct {
+  MetricsFrameData *frame;
+  int start;
+  int step;
+} MetricsWorkerData;
+
+static void run_metrics_job(MetricsFrameData *const frame,
+                            MetricsJob *const job) {
+  const YV12_BUFFER_CONFIG *const orig = frame->orig;
+  const YV12_BUFFER_CONFIG *const recon = frame->recon;
+  const int plane = job->plane;
+  const int is_uv = plane > 0;
+  const uint8_t *const src = orig->buffers[plane];
+  const uint8_t *const dst = recon->buffers[plane];
+  const int src_stride = orig->strides[is_uv];
+  const int dst_stride = recon->strides[is_uv];
+  const int width = orig->crop_widths[is_uv];
+  const int height = orig->crop_heights[is_uv];
+
+  aom_clear_system_state();
+  switch (job->type) {
+    case METRICS_JOB_PSNR:
+#if CONFIG_HIGHBITDEPTH
+      aom_calc_highbd_psnr(orig, recon, &frame->psnr, frame->bd, frame->in_bd);
+#else
+      aom_calc_psnr(orig, recon, &frame->psnr);
+#endif  // CONFIG_HIGHBITDEPTH
+      break;
+    case METRICS_JOB_FASTSSIM:
+      job->value =
+          aom_calc_fastssim_plane(src, src_stride, dst, dst_stride, width,
+                                  height, frame->bd, frame->in_bd);
+      break;
+    case METRICS_JOB_BLOCKINESS:
+      job->value = av1_get_blockiness(src, src_stride, dst, dst_stride,
+                                      width, height);
+      break;
+    case METRICS_JOB_CONSISTENCY:
+      job->value = aom_get_ssim_metrics(
+          (uint8_t *)src, src_stride, (uint8_t *)dst, dst_stride, width,
+          height, frame->cpi->ssim_vars, &frame->cpi->metrics, 1);
+      break;
+    case METRICS_JOB_BAND: {
+      // Both window-based metrics walk the same rows, so do them in one pass
+      // while the band is still in cache.
+      const int row_end = job->row_start + METRICS_BAND_HEIGHT;
+      if (frame->cpi->b_calculate_psnr) {
+#if CONFIG_HIGHBITDEPTH
+        if (frame->use_highbitdepth)
+          aom_highbd_ssim_band(src, src_stride, dst, dst_stride, width, height,
+                               job->row_start, row_end, frame->bd,
+                               frame->in_bd, &job->ssim);
+        else
+#endif  // CONFIG_HIGHBITDEPTH
+          aom_ssim_band(src, src_stride, dst, dst_stride, width, height,
+                        job->row_start, row_end, &job->ssim);
+      }
+      aom_psnrhvs_band(src, src_stride, dst, dst_stride, width, height, plane,
+                       job->row_start, row_end, frame->bd, frame->in_bd,
+                       &job->psnrhvs);
+      break;
     }
+    default: assert(0);
   }
 }
+
+static int metrics_worker_hook(MetricsWorkerData *const thread_data,
+                               void *unused) {
+  MetricsFrameData *const frame = thread_data->frame;
+  int j;
+
+  (void)unused;
+
+  for (j = thread_data->start; j < frame->num_jobs; j += thread_data->step)
+    run_metrics_job(frame, &frame->jobs[j]);
+
+  return 0;
+}
+
+static void add_metrics_job(MetricsFrameData *frame, METRICS_JOB_TYPE type,
+                            int plane, int row_start) {
+  MetricsJob *const job = &frame->jobs[frame->num_jobs++];
+  memset(job, 0, sizeof(*job));
+  job->type = type;
+  job->plane = plane;
+  job->row_start = row_start;
+}
+
+void av1_calc_frame_metrics_mt(AV1_COMP *cpi, const YV12_BUFFER_CONFIG *orig,
+                               const YV12_BUFFER_CONFIG *recon, uint32_t bd,
+                               uint32_t in_bd, FrameMetrics *metrics) {
+  AV1_COMMON *const cm = &cpi->common;
+  const AVxWorkerInterface *const winterface = aom_get_worker_interface();
+  const int num_workers = AOMMAX(cpi->oxcf.max_threads, 1);
+  MetricsFrameData frame;
+  MetricsWorkerData *thread_data;
+  MetricsBand ssim[3], psnrhvs[3];
+  int num_bands = 0;
+  int plane, row, i;
+
+  memset(&frame, 0, sizeof(frame));
+  frame.cpi = cpi;
+  frame.orig = orig;
+  frame.recon = recon;
+  frame.bd = bd;
+  frame.in_bd = in_bd;
+#if CONFIG_HIGHBITDEPTH
+  frame.use_highbitdepth = cm->use_highbitdepth;
+#endif  // CONFIG_HIGHBITDEPTH
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int height = orig->crop_heights[plane > 0];
+    num_bands += (height + METRICS_BAND_HEIGHT - 1) / METRICS_BAND_HEIGHT;
+  }
+  CHECK_MEM_ERROR(cm, frame.jobs,
+                  aom_malloc((num_bands + 6) * sizeof(*frame.jobs)));
+  CHECK_MEM_ERROR(cm, thread_data,
+                  aom_malloc(num_workers * sizeof(*thread_data)));
+
+  // Queue the long whole-plane jobs first so they start early and the short
+  // band jobs fill in around them.
+  add_metrics_job(&frame, METRICS_JOB_FASTSSIM, 0, 0);
+  if (cpi->b_calculate_blockiness && !frame.use_highbitdepth) {
+    add_metrics_job(&frame, METRICS_JOB_BLOCKINESS, 0, 0);
+    if (cpi->b_calculate_consistency)
+      add_metrics_job(&frame, METRICS_JOB_CONSISTENCY, 0, 0);
+  }
+  add_metrics_job(&frame, METRICS_JOB_FASTSSIM, 1, 0);
+  add_metrics_job(&frame, METRICS_JOB_FASTSSIM, 2, 0);
+  if (cpi->b_calculate_psnr) add_metrics_job(&frame, METRICS_JOB_PSNR, 0, 0);
+  for (plane = 0; plane < 3; ++plane) {
+    const int height = orig->crop_heights[plane > 0];
+    for (row = 0; row < height; row += METRICS_BAND_HEIGHT)
+      add_metrics_job(&frame, METRICS_JOB_BAND, plane, row);
+  }
+
+  // Only run once to create the metrics threads.
+  if (cpi->num_metrics_workers == 0 && num_workers > 1) {
+    CHECK_MEM_ERROR(cm, cpi->metrics_workers,
+                    aom_malloc(num_workers * sizeof(*cpi->metrics_workers)));
+    for (i = 0; i < num_workers; ++i) {
+      AVxWorker *const worker = &cpi->metrics_workers[i];
+      ++cpi->num_metrics_workers;
+      winterface->init(worker);
+      if (i < num_workers - 1 && !winterface->reset(worker))
+        aom_internal_error(&cm->error, AOM_CODEC_ERROR,
+                           "Metrics thread creation failed");
+    }
+  }
+
+  if (cpi->num_metrics_workers > 1) {
+    const int n = AOMMIN(cpi->num_metrics_workers, num_workers);
+    for (i = 0; i < n; ++i) {
+      AVxWorker *const worker = &cpi->metrics_workers[i];
+      thread_data[i].frame = &frame;
+      thread_data[i].start = i;
+      thread_data[i].step = n;
+      worker->hook = (AVxWorkerHook)metrics_worker_hook;
+      worker->data1 = &thread_data[i];
+      worker->data2 = NULL;
+      if (i == n - 1)
+        winterface->execute(worker);
+      else
+        winterface->launch(worker);
+    }
+    for (i = 0; i < n; ++i) winterface->sync(&cpi->metrics_workers[i]);
+  } else {
+    thread_data[0].frame = &frame;
+    thread_data[0].start = 0;
+    thread_data[0].step = 1;
+    metrics_worker_hook(&thread_data[0], NULL);
+  }
+
+  // Fold the job results back together in queue order.
+  aom_clear_system_state();
+  memset(metrics, 0, sizeof(*metrics));
+  memset(ssim, 0, sizeof(ssim));
+  memset(psnrhvs, 0, sizeof(psnrhvs));
+  metrics->psnr = frame.psnr;
+  for (i = 0; i < frame.num_jobs; ++i) {
+    const MetricsJob *const job = &frame.jobs[i];
+    switch (job->type) {
+      case METRICS_JOB_FASTSSIM:
+        metrics->fastssim[job->plane] = job->value;
+        break;
+      case METRICS_JOB_BLOCKINESS: metrics->blockiness = job->value; break;
+      case METRICS_JOB_CONSISTENCY: metrics->inconsistency = job->value; break;
+      case METRICS_JOB_BAND:
+        ssim[job->plane].sum += job->ssim.sum;
+        ssim[job->plane].samples += job->ssim.samples;
+        psnrhvs[job->plane].sum += job->psnrhvs.sum;
+        psnrhvs[job->plane].samples += job->psnrhvs.samples;
+        break;
+      default: break;
+    }
+  }
+  for (plane = 0; plane < 3; ++plane) {
+    if (ssim[plane].samples > 0)
+      metrics->ssim[plane] = ssim[plane].sum / ssim[plane].samples;
+    if (psnrhvs[plane].samples > 0)
+      metrics->psnrhvs[plane] = psnrhvs[plane].sum / psnrhvs[plane].samples;
+  }
+
+  aom_free(thread_data);
+  aom_free(frame.jobs);
+}
+#endif  // CONFIG_INTERNAL_STATS
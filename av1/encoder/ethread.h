@@ -12,6 +12,12 @@
 #ifndef AV1_ENCODER_ETHREAD_H_
 #define AV1_ENCODER_ETHREAD_H_
 
+#include "./aom_config.h"
+#if CONFIG_INTERNAL_STATS
+#include "aom_dsp/psnr.h"
+#endif
+#include "aom_scale/yv12config.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -27,6 +33,27 @@ typedef struct EncWorkerData {
 
 void av1_encode_tiles_mt(struct AV1_COMP *cpi);
 
+#if CONFIG_INTERNAL_STATS
+// Quality metrics of one reconstructed frame, per plane where applicable.
+typedef struct FrameMetrics {
+  PSNR_STATS psnr;
+  double ssim[3];
+  double fastssim[3];
+  double psnrhvs[3];
+  double blockiness;
+  double inconsistency;
+} FrameMetrics;
+
+// Computes the internal quality metrics of recon against orig on up to
+// oxcf.max_threads threads. SSIM and PSNR-HVS are evaluated together over
+// row bands of each plane; PSNR, FastSSIM, blockiness and consistency run
+// as whole-plane jobs. The results do not depend on the thread count.
+void av1_calc_frame_metrics_mt(struct AV1_COMP *cpi,
+                               const YV12_BUFFER_CONFIG *orig,
+                               const YV12_BUFFER_CONFIG *recon, uint32_t bd,
+                               uint32_t in_bd, FrameMetrics *metrics);
+#endif  // CONFIG_INTERNAL_STATS
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
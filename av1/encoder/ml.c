@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+
+#include "./av1_rtcd.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "av1/encoder/ml.h"
+
+// Largest batch evaluated in one go by av1_nn_predict_batch(). Larger batches
+// are split up so the intermediate buffers can live on the stack.
+#define NN_MAX_BATCH 16
+
+void av1_nn_fc_layer_c(const float *input, int num_inputs,
+                       const float *weights, const float *bias,
+                       int num_outputs, int apply_relu, float *output) {
+  for (int i = 0; i < num_outputs; ++i) {
+    const float *cur_weights = weights + i * num_inputs;
+    float val = 0.0f;
+    for (int j = 0; j < num_inputs; ++j) val += cur_weights[j] * input[j];
+    val += bias[i];
+    output[i] = apply_relu ? AOMMAX(val, 0.0f) : val;
+  }
+}
+
+void av1_nn_fc_layer_batch_c(const float *input, int num_samples,
+                             int num_inputs, const float *weights,
+                             const float *bias, int num_outputs,
+                             int apply_relu, float *output) {
+  for (int i = 0; i < num_outputs; ++i) {
+    const float *cur_weights = weights + i * num_inputs;
+    for (int s = 0; s < num_samples; ++s) {
+      const float *cur_input = input + s * num_inputs;
+      float val = 0.0f;
+      for (int j = 0; j < num_inputs; ++j)
+        val += cur_weights[j] * cur_input[j];
+      val += bias[i];
+      output[s * num_outputs + i] = apply_relu ? AOMMAX(val, 0.0f) : val;
+    }
+  }
+}
+
+void av1_nn_init_packed(NN_CONFIG *nn_config, const float *params,
+                        int num_inputs, int num_hidden_layers,
+                        const int *num_hidden_nodes, int num_outputs) {
+  assert(num_hidden_layers <= NN_MAX_HIDDEN_LAYERS);
+  nn_config->num_inputs = num_inputs;
+  nn_config->num_outputs = num_outputs;
+  nn_config->num_hidden_layers = num_hidden_layers;
+  int layer_inputs = num_inputs;
+  for (int layer = 0; layer <= num_hidden_layers; ++layer) {
+    const int layer_outputs =
+        layer < num_hidden_layers ? num_hidden_nodes[layer] : num_outputs;
+    assert(layer_outputs <= NN_MAX_NODES_PER_LAYER);
+    if (layer < num_hidden_layers)
+      nn_config->num_hidden_nodes[layer] = layer_outputs;
+    nn_config->weights[layer] = params;
+    params += layer_inputs * layer_outputs;
+    nn_config->bias[layer] = params;
+    params += layer_outputs;
+    layer_inputs = layer_outputs;
+  }
+}
+
+void av1_nn_predict(const float *features, const NN_CONFIG *nn_config,
+                    float *output) {
+  float buf[2][NN_MAX_NODES_PER_LAYER];
+  const int num_layers = nn_config->num_hidden_layers;
+  const float *input = features;
+  int num_inputs = nn_config->num_inputs;
+  assert(num_layers <= NN_MAX_HIDDEN_LAYERS);
+
+  for (int layer = 0; layer <= num_layers; ++layer) {
+    const int last = layer == num_layers;
+    const int num_nodes =
+        last ? nn_config->num_outputs : nn_config->num_hidden_nodes[layer];
+    float *dst = last ? output : buf[layer & 1];
+    assert(num_nodes <= NN_MAX_NODES_PER_LAYER);
+    av1_nn_fc_layer(input, num_inputs, nn_config->weights[layer],
+                    nn_config->bias[layer], num_nodes, !last, dst);
+    input = dst;
+    num_inputs = num_nodes;
+  }
+}
+
+void av1_nn_predict_batch(const float *features, int num_samples,
+                          const NN_CONFIG *nn_config, float *output) {
+  float buf[2][NN_MAX_BATCH * NN_MAX_NODES_PER_LAYER];
+  const int num_layers = nn_config->num_hidden_layers;
+  assert(num_layers <= NN_MAX_HIDDEN_LAYERS);
+
+  for (int start = 0; start < num_samples; start += NN_MAX_BATCH) {
+    const int batch = AOMMIN(num_samples - start, NN_MAX_BATCH);
+    const float *input = features + start * nn_config->num_inputs;
+    int num_inputs = nn_config->num_inputs;
+    for (int layer = 0; layer <= num_layers; ++layer) {
+      const int last = layer == num_layers;
+      const int num_nodes =
+          last ? nn_config->num_outputs : nn_config->num_hidden_nodes[layer];
+      float *dst = last ? output + start * num_nodes : buf[layer & 1];
+      assert(num_nodes <= NN_MAX_NODES_PER_LAYER);
+      av1_nn_fc_layer_batch(input, batch, num_inputs,
+                            nn_config->weights[layer], nn_config->bias[layer],
+                            num_nodes, !last, dst);
+      input = dst;
+      num_inputs = num_nodes;
+    }
+  }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_ML_H_
+#define AV1_ENCODER_ML_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NN_MAX_HIDDEN_LAYERS 4
+#define NN_MAX_NODES_PER_LAYER 128
+
+// Descriptor of a fully-connected network with ReLU hidden layers and a
+// linear output layer. The weights of each layer are stored row by row, one
+// row of (number of inputs to the layer) values per output node.
+typedef struct {
+  int num_inputs;
+  int num_outputs;
+  int num_hidden_layers;
+  int num_hidden_nodes[NN_MAX_HIDDEN_LAYERS];
+  const float *weights[NN_MAX_HIDDEN_LAYERS + 1];
+  const float *bias[NN_MAX_HIDDEN_LAYERS + 1];
+} NN_CONFIG;
+
+// Fill in nn_config for a model whose parameters are packed into a single
+// array as (weights, bias) of each layer in turn, input layer first.
+void av1_nn_init_packed(NN_CONFIG *nn_config, const float *params,
+                        int num_inputs, int num_hidden_layers,
+                        const int *num_hidden_nodes, int num_outputs);
+
+// Run a forward pass of the network on one feature vector.
+void av1_nn_predict(const float *features, const NN_CONFIG *nn_config,
+                    float *output);
+
+// Run a forward pass on num_samples feature vectors stored back to back,
+// writing num_outputs scores per sample to output. Each weight row of a layer
+// is applied to all the samples before moving on to the next one, so the
+// weights are only streamed once per batch rather than once per sample.
+void av1_nn_predict_batch(const float *features, int num_samples,
+                          const NN_CONFIG *nn_config, float *output);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_ML_H_
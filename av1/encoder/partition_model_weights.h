@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_PARTITION_MODEL_WEIGHTS_H_
+#define AV1_ENCODER_PARTITION_MODEL_WEIGHTS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Logistic regression models used by the ml_prune_partition_search speed
+// feature. Each is stored as one weight per feature followed by the bias, and
+// outputs the log-odds that the pruned partition types would not have been
+// chosen. The features are, in order:
+//   0: log2 of the number of pixels in the block
+//   1: log(1 + per-pixel source variance)
+//   2: log(1 + PARTITION_NONE rate per pixel)
+//   3: log(1 + PARTITION_NONE distortion per pixel)
+//   4: whether the PARTITION_NONE result is skippable
+//   5: base_qindex / MAXQ
+//   6: log2 width of the block minus that of the block above
+//   7: log2 height of the block minus that of the block to the left
+// The rectangular partition model also uses:
+//   8: log of the PARTITION_SPLIT to PARTITION_NONE rd cost ratio, clamped
+//      to [-3, 3] (3 if PARTITION_SPLIT was not fully searched)
+//   9: whether PARTITION_SPLIT is the best partition so far
+// The feature counts are in partition_strategy.h.
+
+static const float av1_partition_split_prune_weights[] = {
+  -0.77930f, -0.11364f, -0.70476f, -0.36597f, 0.28188f, 1.91244f, -0.40883f,
+  -0.44020f, 13.33773f,
+};
+
+// Indexed by ml_prune_partition_search - 1.
+static const float av1_partition_split_prune_thresh[2] = { 3.93f, 3.56f };
+
+static const float av1_partition_rect_prune_weights[] = {
+  0.34686f, -0.04306f, -0.25292f, -0.57225f, 1.32751f, 2.93696f, -0.12298f,
+  -0.15796f, 0.83044f, 1.39853f, -0.53689f,
+};
+
+static const float av1_partition_rect_prune_thresh[2] = { 4.10f, 2.47f };
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_PARTITION_MODEL_WEIGHTS_H_
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include <math.h>
+
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/system_state.h"
+#include "av1/common/common_data.h"
+#include "av1/common/quant_common.h"
+#include "av1/encoder/ml.h"
+#include "av1/encoder/partition_model_weights.h"
+#include "av1/encoder/partition_strategy.h"
+
+void av1_get_partition_prune_features(BLOCK_SIZE bsize, BLOCK_SIZE above_bsize,
+                                      BLOCK_SIZE left_bsize,
+                                      unsigned int source_variance,
+                                      const RD_STATS *none_rdc,
+                                      int none_skippable, int bit_depth,
+                                      int base_qindex, float *features) {
+  const int num_pels_log2 = num_pels_log2_lookup[bsize];
+  const float num_pels = (float)(1 << num_pels_log2);
+  const int dist_shift = 2 * (bit_depth - 8);
+
+  aom_clear_system_state();
+  features[0] = (float)num_pels_log2;
+  features[1] = logf(1.0f + source_variance);
+  features[2] = logf(1.0f + none_rdc->rate / num_pels);
+  features[3] = logf(1.0f + (none_rdc->dist >> dist_shift) / num_pels);
+  features[4] = (float)none_skippable;
+  features[5] = base_qindex / (float)MAXQ;
+  features[6] =
+      (float)(b_width_log2_lookup[bsize] - b_width_log2_lookup[above_bsize]);
+  features[7] =
+      (float)(b_height_log2_lookup[bsize] - b_height_log2_lookup[left_bsize]);
+}
+
+int av1_ml_prune_split(const float *features, int level) {
+  NN_CONFIG nn_config;
+  float score;
+  assert(level >= 1 && level <= 2);
+  av1_nn_init_packed(&nn_config, av1_partition_split_prune_weights,
+                     PARTITION_SPLIT_PRUNE_FEATURES, 0, NULL, 1);
+  av1_nn_predict(features, &nn_config, &score);
+  return score > av1_partition_split_prune_thresh[level - 1];
+}
+
+int av1_ml_prune_rect(float *features, int64_t none_rdcost,
+                      int64_t split_rdcost, int split_is_best, int level) {
+  NN_CONFIG nn_config;
+  float score;
+  assert(level >= 1 && level <= 2);
+  aom_clear_system_state();
+  if (split_rdcost < INT64_MAX && none_rdcost > 0) {
+    const float ratio = logf((float)split_rdcost / none_rdcost);
+    features[PARTITION_SPLIT_PRUNE_FEATURES] =
+        AOMMAX(AOMMIN(ratio, 3.0f), -3.0f);
+  } else {
+    features[PARTITION_SPLIT_PRUNE_FEATURES] = 3.0f;
+  }
+  features[PARTITION_SPLIT_PRUNE_FEATURES + 1] = (float)split_is_best;
+  av1_nn_init_packed(&nn_config, av1_partition_rect_prune_weights,
+                     PARTITION_RECT_PRUNE_FEATURES, 0, NULL, 1);
+  av1_nn_predict(features, &nn_config, &score);
+  return score > av1_partition_rect_prune_thresh[level - 1];
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#ifndef AV1_ENCODER_PARTITION_STRATEGY_H_
+#define AV1_ENCODER_PARTITION_STRATEGY_H_
+
+#include "av1/common/blockd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of inputs of the split and rectangular partition pruning models,
+// whose features are listed in partition_model_weights.h.
+#define PARTITION_SPLIT_PRUNE_FEATURES 8
+#define PARTITION_RECT_PRUNE_FEATURES 10
+
+// Collect the inputs of the learned partition pruning models, see
+// partition_model_weights.h, from the PARTITION_NONE search of a block.
+// above_bsize and left_bsize are the sizes of the neighbouring blocks, or
+// bsize where there is no neighbour.
+void av1_get_partition_prune_features(BLOCK_SIZE bsize, BLOCK_SIZE above_bsize,
+                                      BLOCK_SIZE left_bsize,
+                                      unsigned int source_variance,
+                                      const RD_STATS *none_rdc,
+                                      int none_skippable, int bit_depth,
+                                      int base_qindex, float *features);
+
+// Returns 1 if the model predicts that PARTITION_SPLIT will not win over
+// PARTITION_NONE for the block, so its search can be skipped. level is the
+// ml_prune_partition_search speed feature.
+int av1_ml_prune_split(const float *features, int level);
+
+// Returns 1 if the model predicts that neither PARTITION_NONE nor
+// PARTITION_SPLIT will be beaten by a rectangular partition. Fills in the
+// last two features from the split search: its rd cost, INT64_MAX if it was
+// not searched to the end, and whether it is the best partition so far.
+int av1_ml_prune_rect(float *features, int64_t none_rdcost,
+                      int64_t split_rdcost, int split_is_best, int level);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // AV1_ENCODER_PARTITION_STRATEGY_H_
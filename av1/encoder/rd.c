@@ -79,18 +79,32 @@ static const int use_inter_ext_tx_for_txsize[EXT_TX_SETS_INTER][EXT_TX_SIZES] =
       { 0, 0, 0, 1 },
     };
 
+// Returns 1 if the CDFs at cdf differ from their copy at snapshot, and
+// refreshes the copy. Without a snapshot every CDF counts as changed.
+static int cdfs_changed(const void *cdf, void *snapshot, size_t size) {
+  if (snapshot == NULL) return 1;
+  if (!memcmp(cdf, snapshot, size)) return 0;
+  memcpy(snapshot, cdf, size);
+  return 1;
+}
+
+#define CDFS_CHANGED(snap, fc, field)                                  \
+  cdfs_changed(&(fc)->field, (snap) ? (void *)&(snap)->field : NULL, \
+               sizeof((fc)->field))
+
 void av1_fill_mode_rates(AV1_COMMON *const cm, MACROBLOCK *x,
                          FRAME_CONTEXT *fc) {
+  FRAME_CONTEXT *const snap = x->cost_cdfs_valid ? x->cost_cdfs : NULL;
   int i, j;
 
-  if (cm->frame_type == KEY_FRAME) {
+  if (cm->frame_type == KEY_FRAME && CDFS_CHANGED(snap, fc, partition_cdf)) {
     for (i = 0; i < PARTITION_CONTEXTS_PRIMARY; ++i)
       av1_cost_tokens_from_cdf(x->partition_cost[i], fc->partition_cdf[i],
                                NULL);
   }
 
 #if CONFIG_EXT_SKIP
-  if (cm->skip_mode_flag) {
+  if (cm->skip_mode_flag && CDFS_CHANGED(snap, fc, skip_mode_cdfs)) {
     for (i = 0; i < SKIP_CONTEXTS; ++i) {
       av1_cost_tokens_from_cdf(x->skip_mode_cost[i], fc->skip_mode_cdfs[i],
                                NULL);
@@ -98,195 +112,285 @@ void av1_fill_mode_rates(AV1_COMMON *const cm, MACROBLOCK *x,
   }
 #endif  // CONFIG_EXT_SKIP
 
-  for (i = 0; i < SKIP_CONTEXTS; ++i) {
-    av1_cost_tokens_from_cdf(x->skip_cost[i], fc->skip_cdfs[i], NULL);
+  if (CDFS_CHANGED(snap, fc, skip_cdfs)) {
+    for (i = 0; i < SKIP_CONTEXTS; ++i) {
+      av1_cost_tokens_from_cdf(x->skip_cost[i], fc->skip_cdfs[i], NULL);
+    }
   }
 
+  if (CDFS_CHANGED(snap, fc, kf_y_cdf)) {
 #if CONFIG_KF_CTX
-  for (i = 0; i < KF_MODE_CONTEXTS; ++i)
-    for (j = 0; j < KF_MODE_CONTEXTS; ++j)
-      av1_cost_tokens_from_cdf(x->y_mode_costs[i][j], fc->kf_y_cdf[i][j], NULL);
+    for (i = 0; i < KF_MODE_CONTEXTS; ++i)
+      for (j = 0; j < KF_MODE_CONTEXTS; ++j)
+        av1_cost_tokens_from_cdf(x->y_mode_costs[i][j], fc->kf_y_cdf[i][j],
+                                 NULL);
 #else
-  for (i = 0; i < INTRA_MODES; ++i)
-    for (j = 0; j < INTRA_MODES; ++j)
-      av1_cost_tokens_from_cdf(x->y_mode_costs[i][j], fc->kf_y_cdf[i][j], NULL);
+    for (i = 0; i < INTRA_MODES; ++i)
+      for (j = 0; j < INTRA_MODES; ++j)
+        av1_cost_tokens_from_cdf(x->y_mode_costs[i][j], fc->kf_y_cdf[i][j],
+                                 NULL);
 #endif
+  }
 
-  for (i = 0; i < BLOCK_SIZE_GROUPS; ++i)
-    av1_cost_tokens_from_cdf(x->mbmode_cost[i], fc->y_mode_cdf[i], NULL);
-  for (i = 0; i < INTRA_MODES; ++i)
-    av1_cost_tokens_from_cdf(x->intra_uv_mode_cost[i], fc->uv_mode_cdf[i],
-                             NULL);
+  if (CDFS_CHANGED(snap, fc, y_mode_cdf)) {
+    for (i = 0; i < BLOCK_SIZE_GROUPS; ++i)
+      av1_cost_tokens_from_cdf(x->mbmode_cost[i], fc->y_mode_cdf[i], NULL);
+  }
+  if (CDFS_CHANGED(snap, fc, uv_mode_cdf)) {
+    for (i = 0; i < INTRA_MODES; ++i)
+      av1_cost_tokens_from_cdf(x->intra_uv_mode_cost[i], fc->uv_mode_cdf[i],
+                               NULL);
+  }
 
 #if CONFIG_FILTER_INTRA
-  av1_cost_tokens_from_cdf(x->filter_intra_mode_cost[0],
-                           fc->filter_intra_mode_cdf[0], NULL);
-  for (i = 0; i < TX_SIZES_ALL; ++i)
-    av1_cost_tokens_from_cdf(x->filter_intra_cost[i], fc->filter_intra_cdfs[i],
-                             NULL);
+  if (CDFS_CHANGED(snap, fc, filter_intra_mode_cdf))
+    av1_cost_tokens_from_cdf(x->filter_intra_mode_cost[0],
+                             fc->filter_intra_mode_cdf[0], NULL);
+  if (CDFS_CHANGED(snap, fc, filter_intra_cdfs)) {
+    for (i = 0; i < TX_SIZES_ALL; ++i)
+      av1_cost_tokens_from_cdf(x->filter_intra_cost[i],
+                               fc->filter_intra_cdfs[i], NULL);
+  }
 #endif
 
-  for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-    av1_cost_tokens_from_cdf(x->switchable_interp_costs[i],
-                             fc->switchable_interp_cdf[i], NULL);
-
-  for (i = 0; i < PALETTE_BLOCK_SIZES; ++i) {
-    av1_cost_tokens_from_cdf(x->palette_y_size_cost[i],
-                             fc->palette_y_size_cdf[i], NULL);
-    av1_cost_tokens_from_cdf(x->palette_uv_size_cost[i],
-                             fc->palette_uv_size_cdf[i], NULL);
-    for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j) {
-      av1_cost_tokens_from_cdf(x->palette_y_mode_cost[i][j],
-                               fc->palette_y_mode_cdf[i][j], NULL);
+  if (CDFS_CHANGED(snap, fc, switchable_interp_cdf)) {
+    for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
+      av1_cost_tokens_from_cdf(x->switchable_interp_costs[i],
+                               fc->switchable_interp_cdf[i], NULL);
+  }
+
+  if (CDFS_CHANGED(snap, fc, palette_y_size_cdf)) {
+    for (i = 0; i < PALETTE_BLOCK_SIZES; ++i)
+      av1_cost_tokens_from_cdf(x->palette_y_size_cost[i],
+                               fc->palette_y_size_cdf[i], NULL);
+  }
+  if (CDFS_CHANGED(snap, fc, palette_uv_size_cdf)) {
+    for (i = 0; i < PALETTE_BLOCK_SIZES; ++i)
+      av1_cost_tokens_from_cdf(x->palette_uv_size_cost[i],
+                               fc->palette_uv_size_cdf[i], NULL);
+  }
+  if (CDFS_CHANGED(snap, fc, palette_y_mode_cdf)) {
+    for (i = 0; i < PALETTE_BLOCK_SIZES; ++i) {
+      for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j) {
+        av1_cost_tokens_from_cdf(x->palette_y_mode_cost[i][j],
+                                 fc->palette_y_mode_cdf[i][j], NULL);
+      }
     }
   }
 
-  for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i) {
-    av1_cost_tokens_from_cdf(x->palette_uv_mode_cost[i],
-                             fc->palette_uv_mode_cdf[i], NULL);
+  if (CDFS_CHANGED(snap, fc, palette_uv_mode_cdf)) {
+    for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i) {
+      av1_cost_tokens_from_cdf(x->palette_uv_mode_cost[i],
+                               fc->palette_uv_mode_cdf[i], NULL);
+    }
   }
 
-  for (i = 0; i < PALETTE_SIZES; ++i) {
-    for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
-      av1_cost_tokens_from_cdf(x->palette_y_color_cost[i][j],
-                               fc->palette_y_color_index_cdf[i][j], NULL);
-      av1_cost_tokens_from_cdf(x->palette_uv_color_cost[i][j],
-                               fc->palette_uv_color_index_cdf[i][j], NULL);
+  if (CDFS_CHANGED(snap, fc, palette_y_color_index_cdf)) {
+    for (i = 0; i < PALETTE_SIZES; ++i) {
+      for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
+        av1_cost_tokens_from_cdf(x->palette_y_color_cost[i][j],
+                                 fc->palette_y_color_index_cdf[i][j], NULL);
+      }
+    }
+  }
+  if (CDFS_CHANGED(snap, fc, palette_uv_color_index_cdf)) {
+    for (i = 0; i < PALETTE_SIZES; ++i) {
+      for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
+        av1_cost_tokens_from_cdf(x->palette_uv_color_cost[i][j],
+                                 fc->palette_uv_color_index_cdf[i][j], NULL);
+      }
     }
   }
 
 #if CONFIG_CFL
-  int sign_cost[CFL_JOINT_SIGNS];
-  av1_cost_tokens_from_cdf(sign_cost, fc->cfl_sign_cdf, NULL);
-  for (int joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
-    int *cost_u = x->cfl_cost[joint_sign][CFL_PRED_U];
-    int *cost_v = x->cfl_cost[joint_sign][CFL_PRED_V];
-    if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO) {
-      memset(cost_u, 0, CFL_ALPHABET_SIZE * sizeof(*cost_u));
-    } else {
-      const aom_cdf_prob *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
-      av1_cost_tokens_from_cdf(cost_u, cdf_u, NULL);
-    }
-    if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO) {
-      memset(cost_v, 0, CFL_ALPHABET_SIZE * sizeof(*cost_v));
-    } else {
-      const aom_cdf_prob *cdf_v = fc->cfl_alpha_cdf[CFL_CONTEXT_V(joint_sign)];
-      av1_cost_tokens_from_cdf(cost_v, cdf_v, NULL);
+  // The alpha costs include the sign cost, so both CDFs must be checked
+  // (and their snapshots refreshed) before deciding to skip the rebuild.
+  const int cfl_sign_changed = CDFS_CHANGED(snap, fc, cfl_sign_cdf);
+  const int cfl_alpha_changed = CDFS_CHANGED(snap, fc, cfl_alpha_cdf);
+  if (cfl_sign_changed || cfl_alpha_changed) {
+    int sign_cost[CFL_JOINT_SIGNS];
+    av1_cost_tokens_from_cdf(sign_cost, fc->cfl_sign_cdf, NULL);
+    for (int joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
+      int *cost_u = x->cfl_cost[joint_sign][CFL_PRED_U];
+      int *cost_v = x->cfl_cost[joint_sign][CFL_PRED_V];
+      if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO) {
+        memset(cost_u, 0, CFL_ALPHABET_SIZE * sizeof(*cost_u));
+      } else {
+        const aom_cdf_prob *cdf_u =
+            fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
+        av1_cost_tokens_from_cdf(cost_u, cdf_u, NULL);
+      }
+      if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO) {
+        memset(cost_v, 0, CFL_ALPHABET_SIZE * sizeof(*cost_v));
+      } else {
+        const aom_cdf_prob *cdf_v =
+            fc->cfl_alpha_cdf[CFL_CONTEXT_V(joint_sign)];
+        av1_cost_tokens_from_cdf(cost_v, cdf_v, NULL);
+      }
+      for (int u = 0; u < CFL_ALPHABET_SIZE; u++)
+        cost_u[u] += sign_cost[joint_sign];
     }
-    for (int u = 0; u < CFL_ALPHABET_SIZE; u++)
-      cost_u[u] += sign_cost[joint_sign];
   }
 #endif  // CONFIG_CFL
 
-  for (i = 0; i < MAX_TX_CATS; ++i)
-    for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
-      av1_cost_tokens_from_cdf(x->tx_size_cost[i][j], fc->tx_size_cdf[i][j],
-                               NULL);
+  if (CDFS_CHANGED(snap, fc, tx_size_cdf)) {
+    for (i = 0; i < MAX_TX_CATS; ++i)
+      for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
+        av1_cost_tokens_from_cdf(x->tx_size_cost[i][j], fc->tx_size_cdf[i][j],
+                                 NULL);
+  }
 
-  for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
-    av1_cost_tokens_from_cdf(x->txfm_partition_cost[i],
-                             fc->txfm_partition_cdf[i], NULL);
+  if (CDFS_CHANGED(snap, fc, txfm_partition_cdf)) {
+    for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
+      av1_cost_tokens_from_cdf(x->txfm_partition_cost[i],
+                               fc->txfm_partition_cdf[i], NULL);
+    }
   }
 
-  for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
-    int s;
-    for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
-      if (use_inter_ext_tx_for_txsize[s][i]) {
-        av1_cost_tokens_from_cdf(
-            x->inter_tx_type_costs[s][i], fc->inter_ext_tx_cdf[s][i],
-            av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
+  if (CDFS_CHANGED(snap, fc, inter_ext_tx_cdf)) {
+    for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
+      int s;
+      for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
+        if (use_inter_ext_tx_for_txsize[s][i]) {
+          av1_cost_tokens_from_cdf(
+              x->inter_tx_type_costs[s][i], fc->inter_ext_tx_cdf[s][i],
+              av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
+        }
       }
     }
-    for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
-      if (use_intra_ext_tx_for_txsize[s][i]) {
-        for (j = 0; j < INTRA_MODES; ++j) {
-          av1_cost_tokens_from_cdf(
-              x->intra_tx_type_costs[s][i][j], fc->intra_ext_tx_cdf[s][i][j],
-              av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+  }
+  if (CDFS_CHANGED(snap, fc, intra_ext_tx_cdf)) {
+    for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
+      int s;
+      for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
+        if (use_intra_ext_tx_for_txsize[s][i]) {
+          for (j = 0; j < INTRA_MODES; ++j) {
+            av1_cost_tokens_from_cdf(
+                x->intra_tx_type_costs[s][i][j], fc->intra_ext_tx_cdf[s][i][j],
+                av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+          }
         }
       }
     }
   }
 #if CONFIG_EXT_INTRA && CONFIG_EXT_INTRA_MOD
-  for (i = 0; i < DIRECTIONAL_MODES; ++i) {
-    av1_cost_tokens_from_cdf(x->angle_delta_cost[i], fc->angle_delta_cdf[i],
-                             NULL);
+  if (CDFS_CHANGED(snap, fc, angle_delta_cdf)) {
+    for (i = 0; i < DIRECTIONAL_MODES; ++i) {
+      av1_cost_tokens_from_cdf(x->angle_delta_cost[i], fc->angle_delta_cdf[i],
+                               NULL);
+    }
   }
 #endif  // CONFIG_EXT_INTRA && CONFIG_EXT_INTRA_MOD
 #if CONFIG_LOOP_RESTORATION
-  av1_cost_tokens_from_cdf(x->switchable_restore_cost,
-                           fc->switchable_restore_cdf, NULL);
-  av1_cost_tokens_from_cdf(x->wiener_restore_cost, fc->wiener_restore_cdf,
-                           NULL);
-  av1_cost_tokens_from_cdf(x->sgrproj_restore_cost, fc->sgrproj_restore_cdf,
-                           NULL);
+  if (CDFS_CHANGED(snap, fc, switchable_restore_cdf))
+    av1_cost_tokens_from_cdf(x->switchable_restore_cost,
+                             fc->switchable_restore_cdf, NULL);
+  if (CDFS_CHANGED(snap, fc, wiener_restore_cdf))
+    av1_cost_tokens_from_cdf(x->wiener_restore_cost, fc->wiener_restore_cdf,
+                             NULL);
+  if (CDFS_CHANGED(snap, fc, sgrproj_restore_cdf))
+    av1_cost_tokens_from_cdf(x->sgrproj_restore_cost, fc->sgrproj_restore_cdf,
+                             NULL);
 #endif  // CONFIG_LOOP_RESTORATION
 #if CONFIG_INTRABC
-  av1_cost_tokens_from_cdf(x->intrabc_cost, fc->intrabc_cdf, NULL);
+  if (CDFS_CHANGED(snap, fc, intrabc_cdf))
+    av1_cost_tokens_from_cdf(x->intrabc_cost, fc->intrabc_cdf, NULL);
 #endif  // CONFIG_INTRABC
 
   if (!frame_is_intra_only(cm)) {
-    for (i = 0; i < INTRA_INTER_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->intra_inter_cost[i], fc->intra_inter_cdf[i],
-                               NULL);
+    if (CDFS_CHANGED(snap, fc, intra_inter_cdf)) {
+      for (i = 0; i < INTRA_INTER_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->intra_inter_cost[i],
+                                 fc->intra_inter_cdf[i], NULL);
+      }
     }
 
-    for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->newmv_mode_cost[i], fc->newmv_cdf[i], NULL);
+    if (CDFS_CHANGED(snap, fc, newmv_cdf)) {
+      for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->newmv_mode_cost[i], fc->newmv_cdf[i],
+                                 NULL);
+      }
     }
 
-    for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->zeromv_mode_cost[i], fc->zeromv_cdf[i], NULL);
+    if (CDFS_CHANGED(snap, fc, zeromv_cdf)) {
+      for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->zeromv_mode_cost[i], fc->zeromv_cdf[i],
+                                 NULL);
+      }
     }
 
-    for (i = 0; i < REFMV_MODE_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->refmv_mode_cost[i], fc->refmv_cdf[i], NULL);
+    if (CDFS_CHANGED(snap, fc, refmv_cdf)) {
+      for (i = 0; i < REFMV_MODE_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->refmv_mode_cost[i], fc->refmv_cdf[i],
+                                 NULL);
+      }
     }
 
-    for (i = 0; i < DRL_MODE_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->drl_mode_cost0[i], fc->drl_cdf[i], NULL);
+    if (CDFS_CHANGED(snap, fc, drl_cdf)) {
+      for (i = 0; i < DRL_MODE_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->drl_mode_cost0[i], fc->drl_cdf[i], NULL);
+      }
     }
-    for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
-      av1_cost_tokens_from_cdf(x->inter_compound_mode_cost[i],
-                               fc->inter_compound_mode_cdf[i], NULL);
-    for (i = 0; i < BLOCK_SIZES_ALL; ++i)
-      av1_cost_tokens_from_cdf(x->compound_type_cost[i],
-                               fc->compound_type_cdf[i], NULL);
-    for (i = 0; i < BLOCK_SIZE_GROUPS; ++i) {
-      av1_cost_tokens_from_cdf(x->interintra_cost[i], fc->interintra_cdf[i],
-                               NULL);
-      av1_cost_tokens_from_cdf(x->interintra_mode_cost[i],
-                               fc->interintra_mode_cdf[i], NULL);
+    if (CDFS_CHANGED(snap, fc, inter_compound_mode_cdf)) {
+      for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
+        av1_cost_tokens_from_cdf(x->inter_compound_mode_cost[i],
+                                 fc->inter_compound_mode_cdf[i], NULL);
     }
-    for (i = 0; i < BLOCK_SIZES_ALL; ++i) {
-      av1_cost_tokens_from_cdf(x->wedge_interintra_cost[i],
-                               fc->wedge_interintra_cdf[i], NULL);
+    if (CDFS_CHANGED(snap, fc, compound_type_cdf)) {
+      for (i = 0; i < BLOCK_SIZES_ALL; ++i)
+        av1_cost_tokens_from_cdf(x->compound_type_cost[i],
+                                 fc->compound_type_cdf[i], NULL);
     }
-#if CONFIG_EXT_WARPED_MOTION
-    for (i = 0; i < MOTION_MODE_CTX; i++) {
-      for (j = BLOCK_8X8; j < BLOCK_SIZES_ALL; j++) {
-        av1_cost_tokens_from_cdf(x->motion_mode_cost[i][j],
-                                 fc->motion_mode_cdf[i][j], NULL);
+    if (CDFS_CHANGED(snap, fc, interintra_cdf)) {
+      for (i = 0; i < BLOCK_SIZE_GROUPS; ++i)
+        av1_cost_tokens_from_cdf(x->interintra_cost[i], fc->interintra_cdf[i],
+                                 NULL);
+    }
+    if (CDFS_CHANGED(snap, fc, interintra_mode_cdf)) {
+      for (i = 0; i < BLOCK_SIZE_GROUPS; ++i)
+        av1_cost_tokens_from_cdf(x->interintra_mode_cost[i],
+                                 fc->interintra_mode_cdf[i], NULL);
+    }
+    if (CDFS_CHANGED(snap, fc, wedge_interintra_cdf)) {
+      for (i = 0; i < BLOCK_SIZES_ALL; ++i) {
+        av1_cost_tokens_from_cdf(x->wedge_interintra_cost[i],
+                                 fc->wedge_interintra_cdf[i], NULL);
       }
     }
+    if (CDFS_CHANGED(snap, fc, motion_mode_cdf)) {
+#if CONFIG_EXT_WARPED_MOTION
+      for (i = 0; i < MOTION_MODE_CTX; i++) {
+        for (j = BLOCK_8X8; j < BLOCK_SIZES_ALL; j++) {
+          av1_cost_tokens_from_cdf(x->motion_mode_cost[i][j],
+                                   fc->motion_mode_cdf[i][j], NULL);
+        }
+      }
 #else
-    for (i = BLOCK_8X8; i < BLOCK_SIZES_ALL; i++) {
-      av1_cost_tokens_from_cdf(x->motion_mode_cost[i], fc->motion_mode_cdf[i],
-                               NULL);
-    }
+      for (i = BLOCK_8X8; i < BLOCK_SIZES_ALL; i++) {
+        av1_cost_tokens_from_cdf(x->motion_mode_cost[i],
+                                 fc->motion_mode_cdf[i], NULL);
+      }
 #endif  // CONFIG_EXT_WARPED_MOTION
+    }
 
-    for (i = BLOCK_8X8; i < BLOCK_SIZES_ALL; i++) {
-      av1_cost_tokens_from_cdf(x->motion_mode_cost1[i], fc->obmc_cdf[i], NULL);
+    if (CDFS_CHANGED(snap, fc, obmc_cdf)) {
+      for (i = BLOCK_8X8; i < BLOCK_SIZES_ALL; i++) {
+        av1_cost_tokens_from_cdf(x->motion_mode_cost1[i], fc->obmc_cdf[i],
+                                 NULL);
+      }
     }
 #if CONFIG_JNT_COMP
-    for (i = 0; i < COMP_INDEX_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->comp_idx_cost[i], fc->compound_index_cdf[i],
-                               NULL);
+    if (CDFS_CHANGED(snap, fc, compound_index_cdf)) {
+      for (i = 0; i < COMP_INDEX_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->comp_idx_cost[i],
+                                 fc->compound_index_cdf[i], NULL);
+      }
     }
-    for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i) {
-      av1_cost_tokens_from_cdf(x->comp_group_idx_cost[i],
-                               fc->comp_group_idx_cdf[i], NULL);
+    if (CDFS_CHANGED(snap, fc, comp_group_idx_cdf)) {
+      for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i) {
+        av1_cost_tokens_from_cdf(x->comp_group_idx_cost[i],
+                                 fc->comp_group_idx_cdf[i], NULL);
+      }
     }
 #endif  // CONFIG_JNT_COMP
   }
@@ -447,47 +551,83 @@ void av1_set_mvcost(MACROBLOCK *x, MV_REFERENCE_FRAME ref_frame, int ref,
 
 #if CONFIG_LV_MAP
 void av1_fill_coeff_costs(MACROBLOCK *x, FRAME_CONTEXT *fc) {
+  FRAME_CONTEXT *const snap = x->cost_cdfs_valid ? x->cost_cdfs : NULL;
+  // dc_sign_cdf is shared by all transform sizes, and txb_skip_cdf by both
+  // plane types, so check them once up front.
+  int dc_sign_changed[PLANE_TYPES];
+  for (int plane = 0; plane < PLANE_TYPES; ++plane)
+    dc_sign_changed[plane] = CDFS_CHANGED(snap, fc, dc_sign_cdf[plane]);
+
   for (int tx_size = 0; tx_size < TX_SIZES; ++tx_size) {
+    const int txb_skip_changed =
+        CDFS_CHANGED(snap, fc, txb_skip_cdf[tx_size]);
     for (int plane = 0; plane < PLANE_TYPES; ++plane) {
       LV_MAP_COEFF_COST *pcost = &x->coeff_costs[tx_size][plane];
 
-      for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->txb_skip_cost[ctx],
-                                 fc->txb_skip_cdf[tx_size][ctx], NULL);
+      if (txb_skip_changed) {
+        for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->txb_skip_cost[ctx],
+                                   fc->txb_skip_cdf[tx_size][ctx], NULL);
+      }
 
 #if CONFIG_LV_MAP_MULTI
 #if USE_BASE_EOB_ALPHABET
-      for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->base_eob_cost[ctx],
-                                 fc->coeff_base_eob_cdf[tx_size][plane][ctx],
-                                 NULL);
+      if (CDFS_CHANGED(snap, fc, coeff_base_eob_cdf[tx_size][plane])) {
+        for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->base_eob_cost[ctx],
+                                   fc->coeff_base_eob_cdf[tx_size][plane][ctx],
+                                   NULL);
+      }
 #endif
-      for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->base_cost[ctx],
-                                 fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
+      if (CDFS_CHANGED(snap, fc, coeff_base_cdf[tx_size][plane])) {
+        for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->base_cost[ctx],
+                                   fc->coeff_base_cdf[tx_size][plane][ctx],
+                                   NULL);
+      }
 #else
-      for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->nz_map_cost[ctx],
-                                 fc->nz_map_cdf[tx_size][plane][ctx], NULL);
+      if (CDFS_CHANGED(snap, fc, nz_map_cdf[tx_size][plane])) {
+        for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->nz_map_cost[ctx],
+                                   fc->nz_map_cdf[tx_size][plane][ctx], NULL);
+      }
 #endif
-      for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->eob_cost[ctx],
-                                 fc->eob_flag_cdf[tx_size][plane][ctx], NULL);
+      if (CDFS_CHANGED(snap, fc, eob_flag_cdf[tx_size][plane])) {
+        for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->eob_cost[ctx],
+                                   fc->eob_flag_cdf[tx_size][plane][ctx], NULL);
+      }
 
-      for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->eob_extra_cost[ctx],
-                                 fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
+      if (CDFS_CHANGED(snap, fc, eob_extra_cdf[tx_size][plane])) {
+        for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->eob_extra_cost[ctx],
+                                   fc->eob_extra_cdf[tx_size][plane][ctx],
+                                   NULL);
+      }
 
-      for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
-        av1_cost_tokens_from_cdf(pcost->dc_sign_cost[ctx],
-                                 fc->dc_sign_cdf[plane][ctx], NULL);
+      if (dc_sign_changed[plane]) {
+        for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
+          av1_cost_tokens_from_cdf(pcost->dc_sign_cost[ctx],
+                                   fc->dc_sign_cdf[plane][ctx], NULL);
+      }
 
-#if !CONFIG_LV_MAP_MULTI
-      for (int layer = 0; layer < NUM_BASE_LEVELS; ++layer)
-        for (int ctx = 0; ctx < COEFF_BASE_CONTEXTS; ++ctx)
-          av1_cost_tokens_from_cdf(
-              pcost->base_cost[layer][ctx],
-              fc->coeff_base_cdf[tx_size][plane][layer][ctx], NULL);
+      // The level costs below are derived from the base range CDFs, so they
+      // only need rebuilding when those change.
+#if CONFIG_LV_MAP_MULTI
+      if (!CDFS_CHANGED(snap, fc, coeff_br_cdf[tx_size][plane])) continue;
+#else
+      if (CDFS_CHANGED(snap, fc, coeff_base_cdf[tx_size][plane])) {
+        for (int layer = 0; layer < NUM_BASE_LEVELS; ++layer)
+          for (int ctx = 0; ctx < COEFF_BASE_CONTEXTS; ++ctx)
+            av1_cost_tokens_from_cdf(
+                pcost->base_cost[layer][ctx],
+                fc->coeff_base_cdf[tx_size][plane][layer][ctx], NULL);
+      }
+      const int br_changed =
+          CDFS_CHANGED(snap, fc, coeff_br_cdf[tx_size][plane]);
+      const int lps_changed =
+          CDFS_CHANGED(snap, fc, coeff_lps_cdf[tx_size][plane]);
+      if (!br_changed && !lps_changed) continue;
       for (int br = 0; br < BASE_RANGE_SETS; ++br)
         for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx)
           av1_cost_tokens_from_cdf(pcost->br_cost[br][ctx],
@@ -560,9 +700,13 @@ void av1_fill_coeff_costs(MACROBLOCK *x, FRAME_CONTEXT *fc) {
 #endif  // CONFIG_LV_MAP
 
 void av1_fill_token_costs_from_cdf(av1_coeff_cost *cost,
-                                   coeff_cdf_model (*cdf)[PLANE_TYPES]) {
+                                   coeff_cdf_model (*cdf)[PLANE_TYPES],
+                                   coeff_cdf_model (*snapshot)[PLANE_TYPES]) {
   for (int tx = 0; tx < TX_SIZES; ++tx) {
     for (int pt = 0; pt < PLANE_TYPES; ++pt) {
+      if (!cdfs_changed(cdf[tx][pt], snapshot ? snapshot[tx][pt] : NULL,
+                        sizeof(cdf[tx][pt])))
+        continue;
       for (int rt = 0; rt < REF_TYPES; ++rt) {
         for (int band = 0; band < COEF_BANDS; ++band) {
           for (int ctx = 0; ctx < BAND_COEFF_CONTEXTS(band); ++ctx) {
@@ -575,6 +719,25 @@ void av1_fill_token_costs_from_cdf(av1_coeff_cost *cost,
   }
 }
 
+void av1_fill_rate_tables(AV1_COMMON *const cm, MACROBLOCK *x,
+                          FRAME_CONTEXT *fc) {
+#if CONFIG_LV_MAP
+  av1_fill_coeff_costs(x, fc);
+#else
+  FRAME_CONTEXT *const snap = x->cost_cdfs_valid ? x->cost_cdfs : NULL;
+  av1_fill_token_costs_from_cdf(x->token_head_costs, fc->coef_head_cdfs,
+                                snap ? snap->coef_head_cdfs : NULL);
+  av1_fill_token_costs_from_cdf(x->token_tail_costs, fc->coef_tail_cdfs,
+                                snap ? snap->coef_tail_cdfs : NULL);
+#endif
+  av1_fill_mode_rates(cm, x, fc);
+
+  if (x->cost_cdfs != NULL && !x->cost_cdfs_valid) {
+    memcpy(x->cost_cdfs, fc, sizeof(*fc));
+    x->cost_cdfs_valid = 1;
+  }
+}
+
 void av1_initialize_rd_consts(AV1_COMP *cpi) {
   AV1_COMMON *const cm = &cpi->common;
   MACROBLOCK *const x = &cpi->td.mb;
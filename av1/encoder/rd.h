@@ -493,8 +493,18 @@ void av1_fill_mode_rates(AV1_COMMON *const cm, MACROBLOCK *x,
 void av1_fill_coeff_costs(MACROBLOCK *x, FRAME_CONTEXT *fc);
 #endif
 
+// Rebuilds the cost tables of the [tx size][plane type] CDF groups that
+// differ from snapshot, and updates snapshot to match. A NULL snapshot
+// rebuilds every table.
 void av1_fill_token_costs_from_cdf(av1_coeff_cost *cost,
-                                   coeff_cdf_model (*cdf)[PLANE_TYPES]);
+                                   coeff_cdf_model (*cdf)[PLANE_TYPES],
+                                   coeff_cdf_model (*snapshot)[PLANE_TYPES]);
+
+// Brings all the coefficient and mode cost tables in x up to date with fc.
+// Only tables whose CDFs changed since the last call are rebuilt; clear
+// x->cost_cdfs_valid to force a full rebuild.
+void av1_fill_rate_tables(AV1_COMMON *const cm, MACROBLOCK *x,
+                          FRAME_CONTEXT *fc);
 
 #ifdef __cplusplus
 }  // extern "C"
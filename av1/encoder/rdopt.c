@@ -53,6 +53,7 @@
 #endif
 #include "av1/encoder/hybrid_fwd_txfm.h"
 #include "av1/encoder/mcomp.h"
+#include "av1/encoder/ml.h"
 #include "av1/encoder/palette.h"
 #include "av1/encoder/ratectrl.h"
 #include "av1/encoder/rd.h"
@@ -1227,33 +1228,6 @@ static void get_horver_correlation_full(const int16_t *diff, int stride, int w,
   }
 }
 
-// Performs a forward pass through a neural network with 2 fully-connected
-// layers, assuming ReLU as activation function. Number of output neurons
-// is always equal to 4.
-// fc1, fc2 - weight matrices of the respective layers.
-// b1, b2 - bias vectors of the respective layers.
-static void compute_1D_scores(float *features, int num_features,
-                              const float *fc1, const float *b1,
-                              const float *fc2, const float *b2,
-                              int num_hidden_units, float *dst_scores) {
-  assert(num_hidden_units <= 32);
-  float hidden_layer[32];
-  for (int i = 0; i < num_hidden_units; i++) {
-    const float *cur_coef = fc1 + i * num_features;
-    hidden_layer[i] = 0.0f;
-    for (int j = 0; j < num_features; j++)
-      hidden_layer[i] += cur_coef[j] * features[j];
-    hidden_layer[i] = AOMMAX(hidden_layer[i] + b1[i], 0.0f);
-  }
-  for (int i = 0; i < 4; i++) {
-    const float *cur_coef = fc2 + i * num_hidden_units;
-    dst_scores[i] = 0.0f;
-    for (int j = 0; j < num_hidden_units; j++)
-      dst_scores[i] += cur_coef[j] * hidden_layer[j];
-    dst_scores[i] += b2[i];
-  }
-}
-
 // Transforms raw scores into a probability distribution across 16 TX types
 static void score_2D_transform_pow8(float *scores_2D, float shift) {
   float sum = 0.0f;
@@ -1270,30 +1244,6 @@ static void score_2D_transform_pow8(float *scores_2D, float shift) {
   for (i = 0; i < 16; i++) scores_2D[i] /= sum;
 }
 
-// Similarly to compute_1D_scores() performs a forward pass through a
-// neural network with two fully-connected layers. The only difference
-// is that it assumes 1 output neuron, as required by the classifier used
-// for TX size pruning.
-static float compute_tx_split_prune_score(float *features, int num_features,
-                                          const float *fc1, const float *b1,
-                                          const float *fc2, float b2,
-                                          int num_hidden_units) {
-  assert(num_hidden_units <= 64);
-  float hidden_layer[64];
-  for (int i = 0; i < num_hidden_units; i++) {
-    const float *cur_coef = fc1 + i * num_features;
-    hidden_layer[i] = 0.0f;
-    for (int j = 0; j < num_features; j++)
-      hidden_layer[i] += cur_coef[j] * features[j];
-    hidden_layer[i] = AOMMAX(hidden_layer[i] + b1[i], 0.0f);
-  }
-  float dst_score = 0.0f;
-  for (int j = 0; j < num_hidden_units; j++)
-    dst_score += fc2[j] * hidden_layer[j];
-  dst_score += b2;
-  return dst_score;
-}
-
 static int prune_tx_split(BLOCK_SIZE bsize, const int16_t *diff, float hcorr,
                           float vcorr) {
   if (bsize <= BLOCK_4X4 || bsize > BLOCK_16X16) return 0;
@@ -1308,14 +1258,12 @@ static int prune_tx_split(BLOCK_SIZE bsize, const int16_t *diff, float hcorr,
   features[feature_num - 1] = vcorr;
 
   const int bidx = bsize - BLOCK_4X4 - 1;
-  const float *fc1 = av1_prune_tx_split_learned_weights[bidx];
-  const float *b1 =
-      fc1 + av1_prune_tx_split_num_hidden_units[bidx] * feature_num;
-  const float *fc2 = b1 + av1_prune_tx_split_num_hidden_units[bidx];
-  float b2 = *(fc2 + av1_prune_tx_split_num_hidden_units[bidx]);
-  float score =
-      compute_tx_split_prune_score(features, feature_num, fc1, b1, fc2, b2,
-                                   av1_prune_tx_split_num_hidden_units[bidx]);
+  NN_CONFIG nn_config;
+  float score;
+  av1_nn_init_packed(&nn_config, av1_prune_tx_split_learned_weights[bidx],
+                     feature_num, 1, &av1_prune_tx_split_num_hidden_units[bidx],
+                     1);
+  av1_nn_predict(features, &nn_config, &score);
 
   return (score > av1_prune_tx_split_thresholds[bidx]);
 }
@@ -1350,21 +1298,15 @@ static int prune_tx_2D(BLOCK_SIZE bsize, const MACROBLOCK *x, int tx_set_type,
                               &hfeatures[hfeatures_num - 1],
                               &vfeatures[vfeatures_num - 1]);
 
-  const float *fc1_hor = av1_prune_2D_learned_weights_hor[bidx];
-  const float *b1_hor =
-      fc1_hor + av1_prune_2D_num_hidden_units_hor[bidx] * hfeatures_num;
-  const float *fc2_hor = b1_hor + av1_prune_2D_num_hidden_units_hor[bidx];
-  const float *b2_hor = fc2_hor + av1_prune_2D_num_hidden_units_hor[bidx] * 4;
-  compute_1D_scores(hfeatures, hfeatures_num, fc1_hor, b1_hor, fc2_hor, b2_hor,
-                    av1_prune_2D_num_hidden_units_hor[bidx], hscores);
-
-  const float *fc1_ver = av1_prune_2D_learned_weights_ver[bidx];
-  const float *b1_ver =
-      fc1_ver + av1_prune_2D_num_hidden_units_ver[bidx] * vfeatures_num;
-  const float *fc2_ver = b1_ver + av1_prune_2D_num_hidden_units_ver[bidx];
-  const float *b2_ver = fc2_ver + av1_prune_2D_num_hidden_units_ver[bidx] * 4;
-  compute_1D_scores(vfeatures, vfeatures_num, fc1_ver, b1_ver, fc2_ver, b2_ver,
-                    av1_prune_2D_num_hidden_units_ver[bidx], vscores);
+  NN_CONFIG nn_config;
+  av1_nn_init_packed(&nn_config, av1_prune_2D_learned_weights_hor[bidx],
+                     hfeatures_num, 1, &av1_prune_2D_num_hidden_units_hor[bidx],
+                     4);
+  av1_nn_predict(hfeatures, &nn_config, hscores);
+  av1_nn_init_packed(&nn_config, av1_prune_2D_learned_weights_ver[bidx],
+                     vfeatures_num, 1, &av1_prune_2D_num_hidden_units_ver[bidx],
+                     4);
+  av1_nn_predict(vfeatures, &nn_config, vscores);
 
   float score_2D_average = 0.0f;
   for (int i = 0; i < 4; i++) {
@@ -2674,6 +2616,7 @@ static void super_block_yrd(const AV1_COMP *const cpi, MACROBLOCK *x,
                             int64_t ref_best_rd) {
   MACROBLOCKD *xd = &x->e_mbd;
   av1_init_rd_stats(rd_stats);
+  ++x->search_counts.tx_search_evals;
 
   assert(bs == xd->mi[0]->mbmi.sb_type);
 
@@ -3847,8 +3790,8 @@ static void select_tx_block(const AV1_COMP *cpi, MACROBLOCK *x, int blk_row,
   const int tx_row = blk_row >> (1 - pd->subsampling_y);
   const int tx_col = blk_col >> (1 - pd->subsampling_x);
   TX_SIZE(*const inter_tx_size)
-  [MAX_MIB_SIZE] =
-      (TX_SIZE(*)[MAX_MIB_SIZE]) & mbmi->inter_tx_size[tx_row][tx_col];
+  [INTER_TX_SIZE_BUF_LEN] =
+      (TX_SIZE(*)[INTER_TX_SIZE_BUF_LEN]) & mbmi->inter_tx_size[tx_row][tx_col];
   const int max_blocks_high = max_block_high(xd, plane_bsize, plane);
   const int max_blocks_wide = max_block_wide(xd, plane_bsize, plane);
   const int bw = block_size_wide[plane_bsize] >> tx_size_wide_log2[0];
@@ -4498,8 +4441,8 @@ static void save_tx_rd_info(int n4, uint32_t hash, const MACROBLOCK *const x,
   tx_rd_info->min_tx_size = mbmi->min_tx_size;
   memcpy(tx_rd_info->blk_skip, x->blk_skip[0],
          sizeof(tx_rd_info->blk_skip[0]) * n4);
-  for (int idy = 0; idy < xd->n8_h; ++idy)
-    for (int idx = 0; idx < xd->n8_w; ++idx)
+  for (int idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+    for (int idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
       tx_rd_info->inter_tx_size[idy][idx] = mbmi->inter_tx_size[idy][idx];
 #if CONFIG_TXK_SEL
   av1_copy(tx_rd_info->txk_type, mbmi->txk_type);
@@ -4516,8 +4459,8 @@ static void fetch_tx_rd_info(int n4, const TX_RD_INFO *const tx_rd_info,
   mbmi->min_tx_size = tx_rd_info->min_tx_size;
   memcpy(x->blk_skip[0], tx_rd_info->blk_skip,
          sizeof(tx_rd_info->blk_skip[0]) * n4);
-  for (int idy = 0; idy < xd->n8_h; ++idy)
-    for (int idx = 0; idx < xd->n8_w; ++idx)
+  for (int idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+    for (int idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
       mbmi->inter_tx_size[idy][idx] = tx_rd_info->inter_tx_size[idy][idx];
 #if CONFIG_TXK_SEL
   av1_copy(mbmi->txk_type, tx_rd_info->txk_type);
@@ -4761,8 +4704,8 @@ static void set_skip_flag(const AV1_COMP *cpi, MACROBLOCK *x,
          sizeof(mbmi->txk_type[0]) *
              (MAX_SB_SQUARE / (TX_SIZE_W_MIN * TX_SIZE_H_MIN)));
 #endif
-  for (int idy = 0; idy < xd->n8_h; ++idy)
-    for (int idx = 0; idx < xd->n8_w; ++idx)
+  for (int idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+    for (int idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
       mbmi->inter_tx_size[idy][idx] = tx_size;
   mbmi->tx_size = tx_size;
   mbmi->min_tx_size = get_min_tx_size(tx_size);
@@ -4823,7 +4766,7 @@ static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
   int64_t best_rd = INT64_MAX;
   TX_TYPE tx_type, best_tx_type = DCT_DCT;
   const int is_inter = is_inter_block(mbmi);
-  TX_SIZE best_tx_size[MAX_MIB_SIZE][MAX_MIB_SIZE];
+  TX_SIZE best_tx_size[INTER_TX_SIZE_BUF_LEN][INTER_TX_SIZE_BUF_LEN];
   TX_SIZE best_tx = max_txsize_rect_lookup[1][bsize];
   TX_SIZE best_min_tx_size = TX_SIZES_ALL;
   uint8_t best_blk_skip[MAX_MIB_SIZE * MAX_MIB_SIZE * 8];
@@ -4850,7 +4793,9 @@ static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
   const uint32_t hash = get_block_residue_hash(x, bsize);
   TX_RD_RECORD *tx_rd_record = &x->tx_rd_record;
 
+  ++x->search_counts.tx_search_evals;
   if (ref_best_rd != INT64_MAX && within_border) {
+    ++x->search_counts.tx_cache_lookups;
     for (int i = 0; i < tx_rd_record->num; ++i) {
       const int index = (tx_rd_record->index_start + i) % RD_RECORD_BUFFER_LEN;
       // If there is a match in the tx_rd_record, fetch the RD decision and
@@ -4858,6 +4803,7 @@ static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
       if (tx_rd_record->tx_rd_info[index].hash_value == hash) {
         TX_RD_INFO *tx_rd_info = &tx_rd_record->tx_rd_info[index];
         fetch_tx_rd_info(n4, tx_rd_info, rd_stats, x);
+        ++x->search_counts.tx_cache_hits;
         return;
       }
     }
@@ -4942,8 +4888,8 @@ static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
       best_min_tx_size = mbmi->min_tx_size;
       memcpy(best_blk_skip, x->blk_skip[0], sizeof(best_blk_skip[0]) * n4);
       found = 1;
-      for (idy = 0; idy < xd->n8_h; ++idy)
-        for (idx = 0; idx < xd->n8_w; ++idx)
+      for (idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+        for (idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
           best_tx_size[idy][idx] = mbmi->inter_tx_size[idy][idx];
     }
   }
@@ -4957,8 +4903,8 @@ static void select_tx_type_yrd(const AV1_COMP *cpi, MACROBLOCK *x,
   // We found a candidate transform to use. Copy our results from the "best"
   // array into mbmi.
   mbmi->tx_type = best_tx_type;
-  for (idy = 0; idy < xd->n8_h; ++idy)
-    for (idx = 0; idx < xd->n8_w; ++idx)
+  for (idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+    for (idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
       mbmi->inter_tx_size[idy][idx] = best_tx_size[idy][idx];
   mbmi->tx_size = best_tx;
   mbmi->min_tx_size = best_min_tx_size;
@@ -6286,6 +6232,53 @@ static void setup_buffer_inter(
               block_size);
 }
 
+// Returns the cache entry of a single reference motion search. The entry is
+// reset to the given key unless it already holds a result for it, which is
+// signalled through hit. Only searches that completed the sub-pel step are
+// stored, so that a hit also reproduces pred_sse.
+static MV_SEARCH_RESULT *get_mv_search_result(MACROBLOCK *x, int mi_row,
+                                              int mi_col, BLOCK_SIZE bsize,
+                                              int ref, const MV *ref_mv,
+                                              const MV *start_mv,
+                                              int step_param, int *hit) {
+  MV_SEARCH_CACHE *const cache = &x->mv_search_cache;
+  const unsigned int hash =
+      (unsigned int)(mi_row * 61 + mi_col * 37 + bsize * 11 + ref * 5);
+  MV_SEARCH_RESULT *const entry =
+      &cache->entries[hash & (MV_SEARCH_CACHE_SIZE - 1)];
+  int_mv ref_mv_key, start_mv_key;
+
+  ref_mv_key.as_mv = *ref_mv;
+  start_mv_key.as_mv = *start_mv;
+  ++x->search_counts.mv_cache_lookups;
+  *hit = entry->generation == cache->generation && entry->mi_row == mi_row &&
+         entry->mi_col == mi_col && entry->bsize == bsize &&
+         entry->ref == ref && entry->step_param == step_param &&
+         entry->errorperbit == x->errorperbit &&
+         entry->sadperbit == x->sadperbit16 &&
+         entry->ref_mv.as_int == ref_mv_key.as_int &&
+         entry->start_mv.as_int == start_mv_key.as_int &&
+         entry->mvcost == x->mvcost && entry->best_mv.as_int != INVALID_MV;
+  if (*hit) {
+    ++x->search_counts.mv_cache_hits;
+    return entry;
+  }
+
+  entry->generation = cache->generation;
+  entry->mi_row = mi_row;
+  entry->mi_col = mi_col;
+  entry->bsize = bsize;
+  entry->ref = ref;
+  entry->step_param = step_param;
+  entry->errorperbit = x->errorperbit;
+  entry->sadperbit = x->sadperbit16;
+  entry->ref_mv = ref_mv_key;
+  entry->start_mv = start_mv_key;
+  entry->mvcost = x->mvcost;
+  entry->best_mv.as_int = INVALID_MV;
+  return entry;
+}
+
 static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
                                  BLOCK_SIZE bsize, int mi_row, int mi_col,
                                  int ref_idx, int *rate_mv) {
@@ -6302,6 +6295,10 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
 
   MvLimits tmp_mv_limits = x->mv_limits;
   int cost_list[5];
+  MV_SEARCH_RESULT *cached = NULL;
+  int cache_hit = 0;
+  const int m_search_count = *x->m_search_count_ptr;
+  const int ex_search_count = *x->ex_search_count_ptr;
 
   const YV12_BUFFER_CONFIG *scaled_ref_frame =
       av1_get_scaled_ref_frame(cpi, ref);
@@ -6388,26 +6385,43 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
 
   x->best_mv.as_int = x->second_best_mv.as_int = INVALID_MV;
 
-  switch (mbmi->motion_mode) {
-    case SIMPLE_TRANSLATION:
+  if (cpi->sf.mv.reuse_search_results &&
+      mbmi->motion_mode == SIMPLE_TRANSLATION) {
+    cached = get_mv_search_result(x, mi_row, mi_col, bsize, ref, &ref_mv,
+                                  &mvp_full, step_param, &cache_hit);
+  }
+
+  if (cache_hit) {
+    // Everything the search depends on matches, so bestsme is left at
+    // INT_MAX to skip the sub-pel step as well.
+    x->best_mv = cached->best_mv;
+    x->pred_sse[ref] = cached->pred_sse;
+    // Count the searches as if they were run, so that the exhaustive search
+    // budget of the frame is spent the same way with and without the cache.
+    *x->m_search_count_ptr += cached->m_search_count;
+    *x->ex_search_count_ptr += cached->ex_search_count;
+  } else {
+    switch (mbmi->motion_mode) {
+      case SIMPLE_TRANSLATION:
 #if CONFIG_HASH_ME
-      bestsme = av1_full_pixel_search(cpi, x, bsize, &mvp_full, step_param,
-                                      sadpb, cond_cost_list(cpi, cost_list),
-                                      &ref_mv, INT_MAX, 1, (MI_SIZE * mi_col),
-                                      (MI_SIZE * mi_row), 0);
+        bestsme = av1_full_pixel_search(cpi, x, bsize, &mvp_full, step_param,
+                                        sadpb, cond_cost_list(cpi, cost_list),
+                                        &ref_mv, INT_MAX, 1, (MI_SIZE * mi_col),
+                                        (MI_SIZE * mi_row), 0);
 #else
-      bestsme = av1_full_pixel_search(cpi, x, bsize, &mvp_full, step_param,
-                                      sadpb, cond_cost_list(cpi, cost_list),
-                                      &ref_mv, INT_MAX, 1);
+        bestsme = av1_full_pixel_search(cpi, x, bsize, &mvp_full, step_param,
+                                        sadpb, cond_cost_list(cpi, cost_list),
+                                        &ref_mv, INT_MAX, 1);
 #endif
-      break;
-    case OBMC_CAUSAL:
-      bestsme = av1_obmc_full_pixel_diamond(
-          cpi, x, &mvp_full, step_param, sadpb,
-          MAX_MVSEARCH_STEPS - 1 - step_param, 1, &cpi->fn_ptr[bsize], &ref_mv,
-          &(x->best_mv.as_mv), 0);
-      break;
-    default: assert(0 && "Invalid motion mode!\n");
+        break;
+      case OBMC_CAUSAL:
+        bestsme = av1_obmc_full_pixel_diamond(
+            cpi, x, &mvp_full, step_param, sadpb,
+            MAX_MVSEARCH_STEPS - 1 - step_param, 1, &cpi->fn_ptr[bsize],
+            &ref_mv, &(x->best_mv.as_mv), 0);
+        break;
+      default: assert(0 && "Invalid motion mode!\n");
+    }
   }
 
   x->mv_limits = tmp_mv_limits;
@@ -6473,6 +6487,12 @@ static void single_motion_search(const AV1_COMP *const cpi, MACROBLOCK *x,
               x->nmvjointcost, x->mvcost, &dis, &x->pred_sse[ref], NULL, NULL,
               0, 0, 0, 0, 0);
         }
+        if (cached != NULL) {
+          cached->best_mv = x->best_mv;
+          cached->pred_sse = x->pred_sse[ref];
+          cached->m_search_count = *x->m_search_count_ptr - m_search_count;
+          cached->ex_search_count = *x->ex_search_count_ptr - ex_search_count;
+        }
         break;
       case OBMC_CAUSAL:
         av1_find_best_obmc_sub_pixel_tree_up(
@@ -7401,7 +7421,6 @@ static int64_t handle_newmv(const AV1_COMP *const cpi, MACROBLOCK *const x,
     if (x->best_mv.as_int == INVALID_MV) return INT64_MAX;
 
     frame_mv[refs[0]] = x->best_mv;
-    xd->mi[0]->bmi[0].as_mv[0] = x->best_mv;
 
     // Estimate the rate implications of a new mv but discount this
     // under certain circumstances where we want to help initiate a weak
@@ -7890,8 +7909,8 @@ static int64_t motion_mode_rd(
       } else {
         int idx, idy;
         super_block_yrd(cpi, x, rd_stats_y, bsize, ref_best_rd);
-        for (idy = 0; idy < xd->n8_h; ++idy)
-          for (idx = 0; idx < xd->n8_w; ++idx)
+        for (idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+          for (idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
             mbmi->inter_tx_size[idy][idx] = mbmi->tx_size;
         memset(x->blk_skip[0], rd_stats_y->skip,
                sizeof(uint8_t) * xd->n8_h * xd->n8_w * 4);
@@ -8433,8 +8452,6 @@ static int64_t handle_inter_mode(
     if (have_newmv_in_inter_mode(this_mode)) {
       mbmi->mv[0].as_int = best_mv[0].as_int;
       mbmi->mv[1].as_int = best_mv[1].as_int;
-      xd->mi[0]->bmi[0].as_mv[0].as_int = mbmi->mv[0].as_int;
-      xd->mi[0]->bmi[0].as_mv[1].as_int = mbmi->mv[1].as_int;
       if (use_masked_motion_search(mbmi->interinter_compound_type)) {
         rd_stats->rate += best_tmp_rate_mv - rate_mv;
         rate_mv = best_tmp_rate_mv;
@@ -8788,8 +8805,8 @@ static int64_t rd_pick_intrabc_mode_sb(const AV1_COMP *cpi, MACROBLOCK *x,
     } else {
       int idx, idy;
       super_block_yrd(cpi, x, &rd_stats, bsize, INT64_MAX);
-      for (idy = 0; idy < xd->n8_h; ++idy)
-        for (idx = 0; idx < xd->n8_w; ++idx)
+      for (idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+        for (idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
           mbmi->inter_tx_size[idy][idx] = mbmi->tx_size;
       memset(x->blk_skip[0], rd_stats.skip,
              sizeof(uint8_t) * xd->n8_h * xd->n8_w * 4);
@@ -8858,6 +8875,11 @@ void av1_rd_pick_intra_mode_sb(const AV1_COMP *cpi, MACROBLOCK *x,
   mbmi->mv[0].as_int = 0;
 #endif  // CONFIG_INTRABC
 
+  // The pixels around the block stay fixed until the chroma search is done,
+  // so the edges gathered for the first mode serve all the others.
+  xd->intra_pred_cache = &x->intra_pred_cache;
+  av1_reset_intra_pred_cache(xd->intra_pred_cache);
+
   const int64_t intra_yrd = rd_pick_intra_sby_mode(
       cpi, x, &rate_y, &rate_y_tokenonly, &dist_y, &y_skip, bsize, best_rd);
 
@@ -8896,6 +8918,7 @@ void av1_rd_pick_intra_mode_sb(const AV1_COMP *cpi, MACROBLOCK *x,
   } else {
     rd_cost->rate = INT_MAX;
   }
+  xd->intra_pred_cache = NULL;
 
 #if CONFIG_INTRABC
   if (rd_cost->rate != INT_MAX && rd_cost->rdcost < best_rd)
@@ -10458,8 +10481,8 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
       } else {
         int idx, idy;
         super_block_yrd(cpi, x, &rd_stats_y, bsize, INT64_MAX);
-        for (idy = 0; idy < xd->n8_h; ++idy)
-          for (idx = 0; idx < xd->n8_w; ++idx)
+        for (idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+          for (idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
             mbmi->inter_tx_size[idy][idx] = mbmi->tx_size;
         memset(x->blk_skip[0], rd_stats_y.skip,
                sizeof(uint8_t) * xd->n8_h * xd->n8_w * 4);
@@ -10490,8 +10513,8 @@ void av1_rd_pick_inter_mode_sb(const AV1_COMP *cpi, TileDataEnc *tile_data,
       int idx, idy;
       best_mbmode.tx_type = mbmi->tx_type;
       best_mbmode.tx_size = mbmi->tx_size;
-      for (idy = 0; idy < xd->n8_h; ++idy)
-        for (idx = 0; idx < xd->n8_w; ++idx)
+      for (idy = 0; idy < (xd->n8_h + 1) >> 1; ++idy)
+        for (idx = 0; idx < (xd->n8_w + 1) >> 1; ++idx)
           best_mbmode.inter_tx_size[idy][idx] = mbmi->inter_tx_size[idy][idx];
 
       for (i = 0; i < MAX_MB_PLANE; ++i)
@@ -144,6 +144,7 @@ static void set_good_speed_features_framesize_independent(AV1_COMP *cpi,
 #if CONFIG_DUAL_FILTER
     sf->use_fast_interpolation_filter_search = 1;
 #endif  // CONFIG_DUAL_FILTER
+    sf->mv.reuse_search_results = 1;
   }
 
   if (speed >= 2) {
@@ -395,6 +396,7 @@ static void set_dev_sf(AV1_COMP *cpi, SPEED_FEATURES *sf, int speed) {
       sf->use_square_partition_only = !frame_is_intra_only(cm);
     }
     sf->less_rectangular_check = 1;
+    sf->ml_prune_partition_search = 1;
 #if CONFIG_EXT_PARTITION_TYPES
     sf->prune_ext_partition_types_search = 1;
 #endif  // CONFIG_EXT_PARTITION_TYPES
@@ -407,6 +409,14 @@ static void set_dev_sf(AV1_COMP *cpi, SPEED_FEATURES *sf, int speed) {
   if (speed & RD_SKIP_SF) {
     sf->use_rd_breakout = 1;
   }
+
+  if (speed & RECODE_SF) {
+    sf->recode_reuse_partition = 1;
+  }
+
+  if (speed & MV_SEARCH_SF) {
+    sf->mv.reuse_search_results = 1;
+  }
 }
 
 void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
@@ -426,6 +436,7 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   sf->mv.subpel_force_stop = 0;
   sf->optimize_coefficients = !is_lossless_requested(&cpi->oxcf);
   sf->mv.reduce_first_step_size = 0;
+  sf->mv.reuse_search_results = 0;
   sf->coeff_prob_appx_step = 1;
   sf->mv.auto_mv_step_size = 0;
   sf->mv.fullpel_search_step_param = 6;
@@ -448,6 +459,8 @@ void av1_set_speed_features_framesize_independent(AV1_COMP *cpi) {
   sf->tx_type_search.fast_inter_tx_type_search = 0;
   sf->selective_ref_frame = 0;
   sf->less_rectangular_check = 0;
+  sf->ml_prune_partition_search = 0;
+  sf->recode_reuse_partition = 0;
   sf->use_square_partition_only = 0;
   sf->auto_min_max_partition_size = NOT_IN_USE;
   sf->rd_auto_partition_min_limit = BLOCK_4X4;
@@ -101,8 +101,8 @@ typedef enum {
   PARTITION_SF = 8,
   LOOP_FILTER_SF = 16,
   RD_SKIP_SF = 32,
-  RESERVE_2_SF = 64,
-  RESERVE_3_SF = 128,
+  RECODE_SF = 64,
+  MV_SEARCH_SF = 128,
 } DEV_SPEED_FEATURES;
 
 typedef enum {
@@ -261,6 +261,11 @@ typedef struct MV_SPEED_FEATURES {
 
   // This variable sets the step_param used in full pel motion search.
   int fullpel_search_step_param;
+
+  // Reuse the result of an earlier single reference motion search of the
+  // same block, made while trying another partition shape of the
+  // superblock, when all of its inputs match.
+  int reuse_search_results;
 } MV_SPEED_FEATURES;
 
 #define MAX_MESH_STEP 4
@@ -350,6 +355,18 @@ typedef struct SPEED_FEATURES {
   // rd than partition type split.
   int less_rectangular_check;
 
+  // Use learned models on the PARTITION_NONE result to skip the split and
+  // rectangular partition searches. 0: off; 1 and 2 prune more and more.
+  // Only turned on by the PARTITION_SF developer speed feature until the
+  // models are trained on a larger set of real content.
+  int ml_prune_partition_search;
+
+  // In the recode loop, search only the partition picked for each block by
+  // the first iteration instead of running the full partition search again.
+  // Only turned on by the RECODE_SF developer speed feature, as it trades
+  // some coding efficiency for the speedup.
+  int recode_reuse_partition;
+
   // Disable testing non square partitions. (eg 16x32)
   int use_square_partition_only;
 
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <immintrin.h>
+
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+
+void av1_nn_fc_layer_avx2(const float *input, int num_inputs,
+                          const float *weights, const float *bias,
+                          int num_outputs, int apply_relu, float *output) {
+  // The 8-wide path only pays off once a weight row spans at least one full
+  // register.
+  if (num_inputs < 8) {
+    av1_nn_fc_layer_sse2(input, num_inputs, weights, bias, num_outputs,
+                         apply_relu, output);
+    return;
+  }
+
+  const __m128 zero = _mm_setzero_ps();
+  const int tail8 = num_inputs & ~7;
+  const int tail4 = num_inputs & ~3;
+  int i = 0;
+
+  for (; i + 4 <= num_outputs; i += 4) {
+    const float *w0 = weights + i * num_inputs;
+    const float *w1 = w0 + num_inputs;
+    const float *w2 = w1 + num_inputs;
+    const float *w3 = w2 + num_inputs;
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    for (int j = 0; j < tail8; j += 8) {
+      const __m256 in = _mm256_loadu_ps(input + j);
+      acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(w0 + j), in));
+      acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(w1 + j), in));
+      acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(_mm256_loadu_ps(w2 + j), in));
+      acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(_mm256_loadu_ps(w3 + j), in));
+    }
+    // Fold each accumulator down to four lanes.
+    __m128 s0 = _mm_add_ps(_mm256_castps256_ps128(acc0),
+                           _mm256_extractf128_ps(acc0, 1));
+    __m128 s1 = _mm_add_ps(_mm256_castps256_ps128(acc1),
+                           _mm256_extractf128_ps(acc1, 1));
+    __m128 s2 = _mm_add_ps(_mm256_castps256_ps128(acc2),
+                           _mm256_extractf128_ps(acc2, 1));
+    __m128 s3 = _mm_add_ps(_mm256_castps256_ps128(acc3),
+                           _mm256_extractf128_ps(acc3, 1));
+    if (tail8 < tail4) {
+      const __m128 in = _mm_loadu_ps(input + tail8);
+      s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(w0 + tail8), in));
+      s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(w1 + tail8), in));
+      s2 = _mm_add_ps(s2, _mm_mul_ps(_mm_loadu_ps(w2 + tail8), in));
+      s3 = _mm_add_ps(s3, _mm_mul_ps(_mm_loadu_ps(w3 + tail8), in));
+    }
+    _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+    __m128 sum = _mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3));
+    if (tail4 < num_inputs) {
+      DECLARE_ALIGNED(16, float, rem[4]) = { 0.0f, 0.0f, 0.0f, 0.0f };
+      for (int j = tail4; j < num_inputs; ++j) {
+        rem[0] += w0[j] * input[j];
+        rem[1] += w1[j] * input[j];
+        rem[2] += w2[j] * input[j];
+        rem[3] += w3[j] * input[j];
+      }
+      sum = _mm_add_ps(sum, _mm_load_ps(rem));
+    }
+    sum = _mm_add_ps(sum, _mm_loadu_ps(bias + i));
+    if (apply_relu) sum = _mm_max_ps(sum, zero);
+    _mm_storeu_ps(output + i, sum);
+  }
+
+  // Leftover output nodes are handled by the SSE2 version.
+  if (i < num_outputs) {
+    av1_nn_fc_layer_sse2(input, num_inputs, weights + i * num_inputs,
+                         bias + i, num_outputs - i, apply_relu, output + i);
+  }
+}
+
+// Folds an 8-lane accumulator down to four lanes.
+static INLINE __m128 fold(__m256 acc) {
+  return _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+}
+
+// Finishes the sums of four output nodes for one sample, whose accumulators
+// cover the inputs up to tail8, and writes them out.
+static INLINE void store_4_nodes(__m256 acc0, __m256 acc1, __m256 acc2,
+                                 __m256 acc3, const float *w, const float *in,
+                                 int num_inputs, int tail8, const float *bias,
+                                 int apply_relu, float *output) {
+  const int tail4 = num_inputs & ~3;
+  __m128 s0 = fold(acc0), s1 = fold(acc1), s2 = fold(acc2), s3 = fold(acc3);
+  if (tail8 < tail4) {
+    const __m128 x = _mm_loadu_ps(in + tail8);
+    s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(w + tail8), x));
+    s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(w + num_inputs + tail8), x));
+    s2 = _mm_add_ps(s2,
+                    _mm_mul_ps(_mm_loadu_ps(w + 2 * num_inputs + tail8), x));
+    s3 = _mm_add_ps(s3,
+                    _mm_mul_ps(_mm_loadu_ps(w + 3 * num_inputs + tail8), x));
+  }
+  _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+  __m128 sum = _mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3));
+  if (tail4 < num_inputs) {
+    DECLARE_ALIGNED(16, float, rem[4]) = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < 4; ++k)
+      for (int j = tail4; j < num_inputs; ++j)
+        rem[k] += w[k * num_inputs + j] * in[j];
+    sum = _mm_add_ps(sum, _mm_load_ps(rem));
+  }
+  sum = _mm_add_ps(sum, _mm_loadu_ps(bias));
+  if (apply_relu) sum = _mm_max_ps(sum, _mm_setzero_ps());
+  _mm_storeu_ps(output, sum);
+}
+
+void av1_nn_fc_layer_batch_avx2(const float *input, int num_samples,
+                                int num_inputs, const float *weights,
+                                const float *bias, int num_outputs,
+                                int apply_relu, float *output) {
+  if (num_inputs < 8) {
+    av1_nn_fc_layer_batch_sse2(input, num_samples, num_inputs, weights, bias,
+                               num_outputs, apply_relu, output);
+    return;
+  }
+
+  const int tail8 = num_inputs & ~7;
+  const int num_paired = num_samples & ~1;
+  int i = 0;
+
+  // Four output nodes by two samples at a time, as in the SSE2 version.
+  for (; i + 4 <= num_outputs; i += 4) {
+    const float *w0 = weights + i * num_inputs;
+    const float *w1 = w0 + num_inputs;
+    const float *w2 = w1 + num_inputs;
+    const float *w3 = w2 + num_inputs;
+    for (int s = 0; s < num_samples; s += 2) {
+      const float *in0 = input + s * num_inputs;
+      if (s == num_paired) {
+        av1_nn_fc_layer_avx2(in0, num_inputs, w0, bias + i, 4, apply_relu,
+                             output + s * num_outputs + i);
+        break;
+      }
+      const float *in1 = in0 + num_inputs;
+      __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+      __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+      __m256 b0 = _mm256_setzero_ps(), b1 = _mm256_setzero_ps();
+      __m256 b2 = _mm256_setzero_ps(), b3 = _mm256_setzero_ps();
+      for (int j = 0; j < tail8; j += 8) {
+        const __m256 x = _mm256_loadu_ps(in0 + j);
+        const __m256 y = _mm256_loadu_ps(in1 + j);
+        const __m256 wj0 = _mm256_loadu_ps(w0 + j);
+        const __m256 wj1 = _mm256_loadu_ps(w1 + j);
+        const __m256 wj2 = _mm256_loadu_ps(w2 + j);
+        const __m256 wj3 = _mm256_loadu_ps(w3 + j);
+        a0 = _mm256_add_ps(a0, _mm256_mul_ps(wj0, x));
+        a1 = _mm256_add_ps(a1, _mm256_mul_ps(wj1, x));
+        a2 = _mm256_add_ps(a2, _mm256_mul_ps(wj2, x));
+        a3 = _mm256_add_ps(a3, _mm256_mul_ps(wj3, x));
+        b0 = _mm256_add_ps(b0, _mm256_mul_ps(wj0, y));
+        b1 = _mm256_add_ps(b1, _mm256_mul_ps(wj1, y));
+        b2 = _mm256_add_ps(b2, _mm256_mul_ps(wj2, y));
+        b3 = _mm256_add_ps(b3, _mm256_mul_ps(wj3, y));
+      }
+      float *dst = output + s * num_outputs + i;
+      store_4_nodes(a0, a1, a2, a3, w0, in0, num_inputs, tail8, bias + i,
+                    apply_relu, dst);
+      store_4_nodes(b0, b1, b2, b3, w0, in1, num_inputs, tail8, bias + i,
+                    apply_relu, dst + num_outputs);
+    }
+  }
+
+  // Leftover output nodes go through the single sample version.
+  if (i < num_outputs) {
+    for (int s = 0; s < num_samples; ++s) {
+      av1_nn_fc_layer_avx2(input + s * num_inputs, num_inputs,
+                           weights + i * num_inputs, bias + i, num_outputs - i,
+                           apply_relu, output + s * num_outputs + i);
+    }
+  }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <emmintrin.h>
+
+#include "./av1_rtcd.h"
+#include "aom_ports/mem.h"
+
+// Dot product of one weight row with the input, for a single output node.
+static float dot_product(const float *weights, const float *input,
+                         int num_inputs) {
+  __m128 acc = _mm_setzero_ps();
+  int j = 0;
+  for (; j + 4 <= num_inputs; j += 4)
+    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(weights + j),
+                                     _mm_loadu_ps(input + j)));
+  acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+  acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+  float val = _mm_cvtss_f32(acc);
+  for (; j < num_inputs; ++j) val += weights[j] * input[j];
+  return val;
+}
+
+void av1_nn_fc_layer_sse2(const float *input, int num_inputs,
+                          const float *weights, const float *bias,
+                          int num_outputs, int apply_relu, float *output) {
+  const __m128 zero = _mm_setzero_ps();
+  const int tail = num_inputs & ~3;
+  int i = 0;
+
+  // Four output nodes at a time, so that each chunk of the input is loaded
+  // once for all of them.
+  for (; i + 4 <= num_outputs; i += 4) {
+    const float *w0 = weights + i * num_inputs;
+    const float *w1 = w0 + num_inputs;
+    const float *w2 = w1 + num_inputs;
+    const float *w3 = w2 + num_inputs;
+    __m128 acc0 = zero, acc1 = zero, acc2 = zero, acc3 = zero;
+    for (int j = 0; j < tail; j += 4) {
+      const __m128 in = _mm_loadu_ps(input + j);
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(w0 + j), in));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(w1 + j), in));
+      acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(w2 + j), in));
+      acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(w3 + j), in));
+    }
+    // Horizontal sums of the four accumulators, one per lane.
+    _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+    __m128 sum = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+    if (tail < num_inputs) {
+      DECLARE_ALIGNED(16, float, rem[4]) = { 0.0f, 0.0f, 0.0f, 0.0f };
+      for (int j = tail; j < num_inputs; ++j) {
+        rem[0] += w0[j] * input[j];
+        rem[1] += w1[j] * input[j];
+        rem[2] += w2[j] * input[j];
+        rem[3] += w3[j] * input[j];
+      }
+      sum = _mm_add_ps(sum, _mm_load_ps(rem));
+    }
+    sum = _mm_add_ps(sum, _mm_loadu_ps(bias + i));
+    if (apply_relu) sum = _mm_max_ps(sum, zero);
+    _mm_storeu_ps(output + i, sum);
+  }
+
+  for (; i < num_outputs; ++i) {
+    float val = dot_product(weights + i * num_inputs, input, num_inputs);
+    val += bias[i];
+    output[i] = (apply_relu && val < 0.0f) ? 0.0f : val;
+  }
+}
+
+// Finishes the sums of four output nodes for one sample, whose accumulators
+// cover the inputs up to tail, and writes them out.
+static INLINE void store_4_nodes(__m128 acc0, __m128 acc1, __m128 acc2,
+                                 __m128 acc3, const float *w, const float *in,
+                                 int num_inputs, int tail, const float *bias,
+                                 int apply_relu, float *output) {
+  _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+  __m128 sum = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+  if (tail < num_inputs) {
+    DECLARE_ALIGNED(16, float, rem[4]) = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < 4; ++k)
+      for (int j = tail; j < num_inputs; ++j)
+        rem[k] += w[k * num_inputs + j] * in[j];
+    sum = _mm_add_ps(sum, _mm_load_ps(rem));
+  }
+  sum = _mm_add_ps(sum, _mm_loadu_ps(bias));
+  if (apply_relu) sum = _mm_max_ps(sum, _mm_setzero_ps());
+  _mm_storeu_ps(output, sum);
+}
+
+void av1_nn_fc_layer_batch_sse2(const float *input, int num_samples,
+                                int num_inputs, const float *weights,
+                                const float *bias, int num_outputs,
+                                int apply_relu, float *output) {
+  const __m128 zero = _mm_setzero_ps();
+  const int tail = num_inputs & ~3;
+  const int num_paired = num_samples & ~1;
+  int i = 0;
+
+  // Four output nodes by two samples at a time: each chunk of a weight row is
+  // loaded once for both samples, and each chunk of a sample once for all
+  // four rows. The rows stay in the cache while all the samples go past.
+  for (; i + 4 <= num_outputs; i += 4) {
+    const float *w0 = weights + i * num_inputs;
+    const float *w1 = w0 + num_inputs;
+    const float *w2 = w1 + num_inputs;
+    const float *w3 = w2 + num_inputs;
+    for (int s = 0; s < num_samples; s += 2) {
+      const float *in0 = input + s * num_inputs;
+      if (s == num_paired) {
+        av1_nn_fc_layer_sse2(in0, num_inputs, w0, bias + i, 4, apply_relu,
+                             output + s * num_outputs + i);
+        break;
+      }
+      const float *in1 = in0 + num_inputs;
+      __m128 a0 = zero, a1 = zero, a2 = zero, a3 = zero;
+      __m128 b0 = zero, b1 = zero, b2 = zero, b3 = zero;
+      for (int j = 0; j < tail; j += 4) {
+        const __m128 x = _mm_loadu_ps(in0 + j);
+        const __m128 y = _mm_loadu_ps(in1 + j);
+        const __m128 wj0 = _mm_loadu_ps(w0 + j);
+        const __m128 wj1 = _mm_loadu_ps(w1 + j);
+        const __m128 wj2 = _mm_loadu_ps(w2 + j);
+        const __m128 wj3 = _mm_loadu_ps(w3 + j);
+        a0 = _mm_add_ps(a0, _mm_mul_ps(wj0, x));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(wj1, x));
+        a2 = _mm_add_ps(a2, _mm_mul_ps(wj2, x));
+        a3 = _mm_add_ps(a3, _mm_mul_ps(wj3, x));
+        b0 = _mm_add_ps(b0, _mm_mul_ps(wj0, y));
+        b1 = _mm_add_ps(b1, _mm_mul_ps(wj1, y));
+        b2 = _mm_add_ps(b2, _mm_mul_ps(wj2, y));
+        b3 = _mm_add_ps(b3, _mm_mul_ps(wj3, y));
+      }
+      float *dst = output + s * num_outputs + i;
+      store_4_nodes(a0, a1, a2, a3, w0, in0, num_inputs, tail, bias + i,
+                    apply_relu, dst);
+      store_4_nodes(b0, b1, b2, b3, w0, in1, num_inputs, tail, bias + i,
+                    apply_relu, dst + num_outputs);
+    }
+  }
+
+  // Leftover output nodes go through the single sample version.
+  if (i < num_outputs) {
+    for (int s = 0; s < num_samples; ++s) {
+      av1_nn_fc_layer_sse2(input + s * num_inputs, num_inputs,
+                           weights + i * num_inputs, bias + i, num_outputs - i,
+                           apply_relu, output + s * num_outputs + i);
+    }
+  }
+}
@@ -73,3 +73,65 @@ TEST(AV1, TestAccounting) {
   GTEST_ASSERT_NE(aom_accounting_dictionary_lookup(&accounting, "AB"),
                   aom_accounting_dictionary_lookup(&accounting, "BA"));
 }
+
+TEST(AV1, TestAccountingHistogram) {
+  const int kBufferSize = 10000;
+  const int kSymbols = 256;
+  aom_writer bw;
+  uint8_t bw_buffer[kBufferSize];
+  aom_start_encode(&bw, bw_buffer);
+  for (int i = 0; i < kSymbols; i++) {
+    aom_write(&bw, 0, 32);
+    aom_write(&bw, 0, 32);
+  }
+  aom_stop_encode(&bw);
+  aom_reader br;
+  aom_reader_init(&br, bw_buffer, bw.pos, NULL, NULL);
+
+  Accounting accounting;
+  aom_accounting_init(&accounting);
+  aom_accounting_set_mode(&accounting, AOM_ACCOUNTING_HISTOGRAM);
+  // 4x3 superblocks of 16x16 mi units.
+  aom_accounting_set_frame_size(&accounting, 40, 50, 4);
+  aom_accounting_reset(&accounting);
+  GTEST_ASSERT_EQ(accounting.hist.sb_rows, 3);
+  GTEST_ASSERT_EQ(accounting.hist.sb_cols, 4);
+  br.accounting = &accounting;
+
+  // Symbols read outside of a block only go to the symbol histogram.
+  aom_read(&br, 32, "header");
+  for (int i = 1; i < kSymbols; i++) {
+    aom_accounting_set_context(&accounting, (i % 4) * 16, (i % 3) * 16);
+    aom_read(&br, 32, "A");
+    aom_read(&br, 32, "B");
+  }
+  aom_read(&br, 32, "A");
+  // No per symbol records are kept in histogram mode.
+  GTEST_ASSERT_EQ(accounting.syms.num_syms, 0);
+
+  const int header = aom_accounting_dictionary_lookup(&accounting, "header");
+  const int a = aom_accounting_dictionary_lookup(&accounting, "A");
+  const int b = aom_accounting_dictionary_lookup(&accounting, "B");
+  GTEST_ASSERT_EQ(accounting.hist.samples[header], 1U);
+  GTEST_ASSERT_EQ(accounting.hist.samples[a], (unsigned int)kSymbols);
+  GTEST_ASSERT_EQ(accounting.hist.samples[b], (unsigned int)kSymbols - 1);
+
+  const uint32_t tell_frac = aom_reader_tell_frac(&br);
+  const uint64_t total = accounting.hist.bits[header] +
+                         accounting.hist.bits[a] + accounting.hist.bits[b];
+  GTEST_ASSERT_EQ(total, (uint64_t)tell_frac);
+
+  uint64_t sb_total = 0;
+  uint32_t sb_samples = 0;
+  for (int i = 0; i < 12; i++) {
+    sb_total += accounting.hist.sb_bits[i];
+    sb_samples += accounting.hist.sb_samples[i];
+  }
+  GTEST_ASSERT_EQ(sb_total, total - accounting.hist.bits[header]);
+  GTEST_ASSERT_EQ(sb_samples, 2U * kSymbols - 1);
+
+  aom_accounting_reset(&accounting);
+  GTEST_ASSERT_EQ(accounting.hist.bits[a], 0U);
+  GTEST_ASSERT_EQ(accounting.hist.sb_bits[0], 0U);
+  aom_accounting_clear(&accounting);
+}
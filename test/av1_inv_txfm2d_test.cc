@@ -14,6 +14,7 @@
 #include <stdlib.h>
 
 #include "./av1_rtcd.h"
+#include "aom_dsp/inv_txfm.h"
 #include "test/acm_random.h"
 #include "test/util.h"
 #include "test/av1_txfm_test.h"
@@ -212,6 +213,79 @@ TEST(AV1InvTxfm2d, CfgTest) {
     }
   }
 }
+
+TEST(AV1InvTxfm2d, PartialMatchesFullTransform) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int bd_idx = 0; bd_idx < BD_NUM; ++bd_idx) {
+    const int bd = libaom_test::bd_arr[bd_idx];
+    for (int tx_size = 0; tx_size < TX_SIZES_ALL; ++tx_size) {
+      const Inv_Txfm2d_Func inv_txfm_func =
+          libaom_test::inv_txfm_func_ls[tx_size];
+      const int tx_w = tx_size_wide[tx_size];
+      const int tx_h = tx_size_high[tx_size];
+      if (inv_txfm_func == NULL || tx_w > 32 || tx_h > 32) continue;
+      for (int tx_type = 0; tx_type < TX_TYPES; ++tx_type) {
+        for (int ci = 0; ci < 20; ci++) {
+          const int nz_rows = 1 + rnd.PseudoUniform(tx_h);
+          const int nz_cols = 1 + rnd.PseudoUniform(tx_w);
+          int32_t input[32 * 32] = { 0 };
+          uint16_t expected[32 * 32];
+          uint16_t actual[32 * 32];
+          for (int r = 0; r < nz_rows; ++r)
+            for (int c = 0; c < nz_cols; ++c)
+              input[r * tx_w + c] = rnd.PseudoUniform(1 << 10) - (1 << 9);
+          for (int i = 0; i < tx_w * tx_h; ++i)
+            expected[i] = actual[i] = rnd.Rand16() & ((1 << bd) - 1);
+
+          inv_txfm_func(input, expected, tx_w, static_cast<TX_TYPE>(tx_type),
+                        bd);
+          av1_inv_txfm2d_add_partial(input, actual, tx_w,
+                                     static_cast<TX_TYPE>(tx_type),
+                                     static_cast<TX_SIZE>(tx_size), nz_rows,
+                                     nz_cols, bd);
+
+          for (int i = 0; i < tx_w * tx_h; ++i)
+            ASSERT_EQ(expected[i], actual[i])
+                << "tx_size: " << tx_size << " tx_type: " << tx_type
+                << " bd: " << bd << " i: " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(AV1InvTxfm2d, DcResidualMatchesFullTransform) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int bd_idx = 0; bd_idx < BD_NUM; ++bd_idx) {
+    const int bd = libaom_test::bd_arr[bd_idx];
+    for (int tx_size = 0; tx_size < TX_SIZES_ALL; ++tx_size) {
+      const Inv_Txfm2d_Func inv_txfm_func =
+          libaom_test::inv_txfm_func_ls[tx_size];
+      const int tx_w = tx_size_wide[tx_size];
+      const int tx_h = tx_size_high[tx_size];
+      if (inv_txfm_func == NULL || tx_w > 32 || tx_h > 32) continue;
+      for (int ci = 0; ci < 500; ci++) {
+        int32_t input[32 * 32] = { 0 };
+        uint16_t expected[32 * 32];
+        uint16_t actual[32 * 32];
+        const int range = 1 << (bd + 6);
+        input[0] = rnd.PseudoUniform(2 * range) - range;
+        for (int i = 0; i < tx_w * tx_h; ++i)
+          expected[i] = actual[i] = rnd.Rand16() & ((1 << bd) - 1);
+
+        inv_txfm_func(input, expected, tx_w, DCT_DCT, bd);
+        const int32_t residual = av1_inv_txfm2d_dc_residual(
+            input[0], static_cast<TX_SIZE>(tx_size), bd);
+        for (int i = 0; i < tx_w * tx_h; ++i)
+          actual[i] = highbd_clip_pixel_add(actual[i], residual, bd);
+
+        for (int i = 0; i < tx_w * tx_h; ++i)
+          ASSERT_EQ(expected[i], actual[i])
+              << "tx_size: " << tx_size << " bd: " << bd << " i: " << i;
+      }
+    }
+  }
+}
 #endif  // CONFIG_HIGHBITDEPTH
 
 }  // namespace
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <math.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+
+#include "./av1_rtcd.h"
+#include "av1/encoder/ml.h"
+
+namespace {
+
+using libaom_test::ACMRandom;
+
+typedef void (*FcLayerFunc)(const float *input, int num_inputs,
+                            const float *weights, const float *bias,
+                            int num_outputs, int apply_relu, float *output);
+typedef void (*FcLayerBatchFunc)(const float *input, int num_samples,
+                                 int num_inputs, const float *weights,
+                                 const float *bias, int num_outputs,
+                                 int apply_relu, float *output);
+
+const int kMaxInputs = 40;
+const int kMaxOutputs = 40;
+const int kMaxSamples = 11;
+
+float RandFloat(ACMRandom *rnd) {
+  return (static_cast<int>(rnd->Rand16()) - 32768) / 8192.0f;
+}
+
+// Reference two-layer network with ReLU on the hidden layer, written out the
+// same way the TX pruning models used to be evaluated.
+void ReferencePredict(const float *features, int num_features,
+                      const float *params, int num_hidden, int num_outputs,
+                      float *output) {
+  const float *fc1 = params;
+  const float *b1 = fc1 + num_hidden * num_features;
+  const float *fc2 = b1 + num_hidden;
+  const float *b2 = fc2 + num_outputs * num_hidden;
+  float hidden[NN_MAX_NODES_PER_LAYER];
+  for (int i = 0; i < num_hidden; ++i) {
+    hidden[i] = 0.0f;
+    for (int j = 0; j < num_features; ++j)
+      hidden[i] += fc1[i * num_features + j] * features[j];
+    hidden[i] = hidden[i] + b1[i] > 0.0f ? hidden[i] + b1[i] : 0.0f;
+  }
+  for (int i = 0; i < num_outputs; ++i) {
+    output[i] = 0.0f;
+    for (int j = 0; j < num_hidden; ++j)
+      output[i] += fc2[i * num_hidden + j] * hidden[j];
+    output[i] += b2[i];
+  }
+}
+
+TEST(AV1NNPredictTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kNumSamples = 20;
+  float params[kMaxInputs * 64 + 64 + 64 * 4 + 4];
+  float features[kNumSamples * kMaxInputs];
+  float ref[kNumSamples * 4], single[4], batch[kNumSamples * 4];
+
+  for (int iter = 0; iter < 200; ++iter) {
+    const int num_inputs = 1 + rnd.PseudoUniform(kMaxInputs);
+    const int num_hidden = 1 + rnd.PseudoUniform(64);
+    const int num_outputs = 1 + rnd.PseudoUniform(4);
+    for (size_t i = 0; i < sizeof(params) / sizeof(params[0]); ++i)
+      params[i] = RandFloat(&rnd);
+    for (int i = 0; i < kNumSamples * num_inputs; ++i)
+      features[i] = RandFloat(&rnd);
+
+    NN_CONFIG nn_config;
+    av1_nn_init_packed(&nn_config, params, num_inputs, 1, &num_hidden,
+                       num_outputs);
+    av1_nn_predict_batch(features, kNumSamples, &nn_config, batch);
+    for (int s = 0; s < kNumSamples; ++s) {
+      const float *cur = features + s * num_inputs;
+      ReferencePredict(cur, num_inputs, params, num_hidden, num_outputs,
+                       ref + s * num_outputs);
+      av1_nn_predict(cur, &nn_config, single);
+      for (int i = 0; i < num_outputs; ++i) {
+        const float r = ref[s * num_outputs + i];
+        const float tol = 1e-4f * (1.0f + fabsf(r));
+        ASSERT_NEAR(r, single[i], tol) << "iter " << iter << " sample " << s;
+        ASSERT_NEAR(r, batch[s * num_outputs + i], tol)
+            << "iter " << iter << " sample " << s;
+      }
+    }
+    libaom_test::ClearSystemState();
+  }
+}
+
+class AV1NNFcLayerTest : public ::testing::TestWithParam<FcLayerFunc> {
+ public:
+  virtual void SetUp() { rnd_.Reset(ACMRandom::DeterministicSeed()); }
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  ACMRandom rnd_;
+};
+
+TEST_P(AV1NNFcLayerTest, MatchesC) {
+  const FcLayerFunc func = GetParam();
+  float input[kMaxInputs];
+  float weights[kMaxInputs * kMaxOutputs];
+  float bias[kMaxOutputs];
+  float ref[kMaxOutputs], out[kMaxOutputs];
+
+  for (int num_inputs = 1; num_inputs <= kMaxInputs; ++num_inputs) {
+    for (int num_outputs = 1; num_outputs <= kMaxOutputs; ++num_outputs) {
+      for (int i = 0; i < num_inputs; ++i) input[i] = RandFloat(&rnd_);
+      for (int i = 0; i < num_inputs * num_outputs; ++i)
+        weights[i] = RandFloat(&rnd_);
+      for (int i = 0; i < num_outputs; ++i) bias[i] = RandFloat(&rnd_);
+      const int apply_relu = (num_inputs + num_outputs) & 1;
+
+      av1_nn_fc_layer_c(input, num_inputs, weights, bias, num_outputs,
+                        apply_relu, ref);
+      ASM_REGISTER_STATE_CHECK(func(input, num_inputs, weights, bias,
+                                    num_outputs, apply_relu, out));
+      for (int i = 0; i < num_outputs; ++i) {
+        // The SIMD versions sum in a different order, so only expect the
+        // results to agree to within rounding.
+        const float tol = 1e-4f * (1.0f + fabsf(ref[i]));
+        ASSERT_NEAR(ref[i], out[i], tol) << num_inputs << "x" << num_outputs;
+        if (apply_relu) {
+          ASSERT_GE(out[i], 0.0f);
+        }
+      }
+    }
+  }
+}
+
+class AV1NNFcLayerBatchTest
+    : public ::testing::TestWithParam<FcLayerBatchFunc> {
+ public:
+  virtual void SetUp() { rnd_.Reset(ACMRandom::DeterministicSeed()); }
+  virtual void TearDown() { libaom_test::ClearSystemState(); }
+
+ protected:
+  ACMRandom rnd_;
+};
+
+TEST_P(AV1NNFcLayerBatchTest, MatchesSingle) {
+  const FcLayerBatchFunc func = GetParam();
+  float input[kMaxSamples * kMaxInputs];
+  float weights[kMaxInputs * kMaxOutputs];
+  float bias[kMaxOutputs];
+  float ref[kMaxOutputs], out[kMaxSamples * kMaxOutputs];
+
+  for (int num_samples = 1; num_samples <= kMaxSamples; ++num_samples) {
+    for (int num_inputs = 1; num_inputs <= kMaxInputs; num_inputs += 3) {
+      for (int num_outputs = 1; num_outputs <= kMaxOutputs; num_outputs += 5) {
+        for (int i = 0; i < num_samples * num_inputs; ++i)
+          input[i] = RandFloat(&rnd_);
+        for (int i = 0; i < num_inputs * num_outputs; ++i)
+          weights[i] = RandFloat(&rnd_);
+        for (int i = 0; i < num_outputs; ++i) bias[i] = RandFloat(&rnd_);
+        const int apply_relu = (num_samples + num_outputs) & 1;
+
+        ASM_REGISTER_STATE_CHECK(func(input, num_samples, num_inputs, weights,
+                                      bias, num_outputs, apply_relu, out));
+        for (int s = 0; s < num_samples; ++s) {
+          av1_nn_fc_layer_c(input + s * num_inputs, num_inputs, weights, bias,
+                            num_outputs, apply_relu, ref);
+          for (int i = 0; i < num_outputs; ++i) {
+            const float tol = 1e-4f * (1.0f + fabsf(ref[i]));
+            ASSERT_NEAR(ref[i], out[s * num_outputs + i], tol)
+                << num_samples << " samples " << num_inputs << "x"
+                << num_outputs;
+          }
+        }
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(C, AV1NNFcLayerTest,
+                        ::testing::Values(av1_nn_fc_layer_c));
+
+INSTANTIATE_TEST_CASE_P(C, AV1NNFcLayerBatchTest,
+                        ::testing::Values(av1_nn_fc_layer_batch_c));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, AV1NNFcLayerTest,
+                        ::testing::Values(av1_nn_fc_layer_sse2));
+INSTANTIATE_TEST_CASE_P(SSE2, AV1NNFcLayerBatchTest,
+                        ::testing::Values(av1_nn_fc_layer_batch_sse2));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, AV1NNFcLayerTest,
+                        ::testing::Values(av1_nn_fc_layer_avx2));
+INSTANTIATE_TEST_CASE_P(AVX2, AV1NNFcLayerBatchTest,
+                        ::testing::Values(av1_nn_fc_layer_batch_avx2));
+#endif
+
+}  // namespace
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+
+#include "av1/encoder/partition_model_weights.h"
+#include "av1/encoder/partition_strategy.h"
+
+namespace {
+
+using libaom_test::ACMRandom;
+
+RD_STATS MakeRdStats(int rate, int64_t dist) {
+  RD_STATS rd_stats;
+  memset(&rd_stats, 0, sizeof(rd_stats));
+  rd_stats.rate = rate;
+  rd_stats.dist = dist;
+  return rd_stats;
+}
+
+// Logistic regression score of a model stored as in partition_model_weights.h.
+float Score(const float *weights, const float *features, int num_features) {
+  float score = weights[num_features];
+  for (int i = 0; i < num_features; ++i) score += weights[i] * features[i];
+  return score;
+}
+
+TEST(AV1PartitionPruneTest, Features) {
+  float features[PARTITION_RECT_PRUNE_FEATURES];
+  const RD_STATS none_rdc = MakeRdStats(512 * 3, 512 * 7);
+
+  av1_get_partition_prune_features(BLOCK_32X16, BLOCK_8X8, BLOCK_32X32, 15,
+                                   &none_rdc, 1, 8, 128, features);
+  EXPECT_EQ(9.0f, features[0]);
+  EXPECT_FLOAT_EQ(logf(16.0f), features[1]);
+  EXPECT_FLOAT_EQ(logf(4.0f), features[2]);
+  EXPECT_FLOAT_EQ(logf(8.0f), features[3]);
+  EXPECT_EQ(1.0f, features[4]);
+  EXPECT_FLOAT_EQ(128.0f / 255.0f, features[5]);
+  // The block above is two width steps narrower, the one to the left one
+  // height step taller.
+  EXPECT_EQ(2.0f, features[6]);
+  EXPECT_EQ(-1.0f, features[7]);
+}
+
+TEST(AV1PartitionPruneTest, HighBitDepthDistortion) {
+  float features_8[PARTITION_RECT_PRUNE_FEATURES];
+  float features_10[PARTITION_RECT_PRUNE_FEATURES];
+  const RD_STATS rdc_8 = MakeRdStats(1000, 12345);
+  const RD_STATS rdc_10 = MakeRdStats(1000, 12345 << 4);
+
+  av1_get_partition_prune_features(BLOCK_16X16, BLOCK_16X16, BLOCK_16X16, 40,
+                                   &rdc_8, 0, 8, 60, features_8);
+  av1_get_partition_prune_features(BLOCK_16X16, BLOCK_16X16, BLOCK_16X16, 40,
+                                   &rdc_10, 0, 10, 60, features_10);
+  for (int i = 0; i < PARTITION_SPLIT_PRUNE_FEATURES; ++i)
+    EXPECT_EQ(features_8[i], features_10[i]) << "feature " << i;
+}
+
+TEST(AV1PartitionPruneTest, SplitDecision) {
+  float features[PARTITION_RECT_PRUNE_FEATURES];
+
+  // A flat, skippable superblock: splitting it is not worth searching.
+  const RD_STATS flat = MakeRdStats(300, 4096);
+  av1_get_partition_prune_features(BLOCK_64X64, BLOCK_64X64, BLOCK_64X64, 0,
+                                   &flat, 1, 8, 128, features);
+  EXPECT_EQ(1, av1_ml_prune_split(features, 1));
+  EXPECT_EQ(1, av1_ml_prune_split(features, 2));
+
+  // A detailed block with expensive PARTITION_NONE result must be searched.
+  const RD_STATS busy = MakeRdStats(1024 * 60, 1024 * 150);
+  av1_get_partition_prune_features(BLOCK_32X32, BLOCK_8X8, BLOCK_8X8, 2000,
+                                   &busy, 0, 8, 128, features);
+  EXPECT_EQ(0, av1_ml_prune_split(features, 1));
+  EXPECT_EQ(0, av1_ml_prune_split(features, 2));
+}
+
+// The decisions follow the model scores, and the higher level prunes at
+// least as much as the lower one.
+TEST(AV1PartitionPruneTest, MatchesModel) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const BLOCK_SIZE kSizes[] = { BLOCK_8X8, BLOCK_16X16, BLOCK_32X32,
+                                BLOCK_64X64 };
+  float features[PARTITION_RECT_PRUNE_FEATURES];
+
+  for (int iter = 0; iter < 1000; ++iter) {
+    const BLOCK_SIZE bsize = kSizes[rnd.PseudoUniform(4)];
+    const BLOCK_SIZE above = kSizes[rnd.PseudoUniform(4)];
+    const BLOCK_SIZE left = kSizes[rnd.PseudoUniform(4)];
+    const RD_STATS none_rdc =
+        MakeRdStats(rnd.Rand16() * 4, static_cast<int64_t>(rnd.Rand16()) * 64);
+    av1_get_partition_prune_features(bsize, above, left, rnd.Rand16() >> 4,
+                                     &none_rdc, rnd.PseudoUniform(2), 8,
+                                     rnd.Rand8(), features);
+
+    const float split_score = Score(av1_partition_split_prune_weights,
+                                    features, PARTITION_SPLIT_PRUNE_FEATURES);
+    for (int level = 1; level <= 2; ++level) {
+      const float thresh = av1_partition_split_prune_thresh[level - 1];
+      // Leave out scores so close to the threshold that the summation order
+      // may decide.
+      if (fabsf(split_score - thresh) < 1e-4f) continue;
+      EXPECT_EQ(split_score > thresh, av1_ml_prune_split(features, level))
+          << "iter " << iter << " level " << level;
+    }
+    if (av1_ml_prune_split(features, 1)) {
+      EXPECT_EQ(1, av1_ml_prune_split(features, 2)) << "iter " << iter;
+    }
+
+    const int64_t none_rdcost = 1 + rnd.Rand16();
+    const int64_t split_rdcost =
+        rnd.PseudoUniform(4) ? 1 + rnd.Rand16() : INT64_MAX;
+    const int split_is_best =
+        split_rdcost != INT64_MAX && split_rdcost < none_rdcost;
+    const int prune_1 = av1_ml_prune_rect(features, none_rdcost, split_rdcost,
+                                          split_is_best, 1);
+    const int prune_2 = av1_ml_prune_rect(features, none_rdcost, split_rdcost,
+                                          split_is_best, 2);
+    const float rect_score = Score(av1_partition_rect_prune_weights, features,
+                                   PARTITION_RECT_PRUNE_FEATURES);
+    if (fabsf(rect_score - av1_partition_rect_prune_thresh[0]) >= 1e-4f) {
+      EXPECT_EQ(rect_score > av1_partition_rect_prune_thresh[0], prune_1)
+          << "iter " << iter;
+    }
+    if (fabsf(rect_score - av1_partition_rect_prune_thresh[1]) >= 1e-4f) {
+      EXPECT_EQ(rect_score > av1_partition_rect_prune_thresh[1], prune_2)
+          << "iter " << iter;
+    }
+    if (prune_1) {
+      EXPECT_EQ(1, prune_2) << "iter " << iter;
+    }
+  }
+  libaom_test::ClearSystemState();
+}
+
+TEST(AV1PartitionPruneTest, RectFeatures) {
+  float features[PARTITION_RECT_PRUNE_FEATURES];
+  const RD_STATS none_rdc = MakeRdStats(2000, 50000);
+  av1_get_partition_prune_features(BLOCK_32X32, BLOCK_32X32, BLOCK_32X32, 100,
+                                   &none_rdc, 0, 8, 100, features);
+
+  // A split search that did not finish counts as far worse than NONE.
+  av1_ml_prune_rect(features, 1000, INT64_MAX, 0, 1);
+  EXPECT_EQ(3.0f, features[PARTITION_SPLIT_PRUNE_FEATURES]);
+  EXPECT_EQ(0.0f, features[PARTITION_SPLIT_PRUNE_FEATURES + 1]);
+
+  av1_ml_prune_rect(features, 1000, 500, 1, 1);
+  EXPECT_FLOAT_EQ(logf(0.5f), features[PARTITION_SPLIT_PRUNE_FEATURES]);
+  EXPECT_EQ(1.0f, features[PARTITION_SPLIT_PRUNE_FEATURES + 1]);
+
+  // The cost ratio is clamped.
+  av1_ml_prune_rect(features, 1000000, 1, 1, 1);
+  EXPECT_EQ(-3.0f, features[PARTITION_SPLIT_PRUNE_FEATURES]);
+}
+
+}  // namespace
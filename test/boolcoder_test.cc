@@ -86,6 +86,108 @@ TEST(AV1, TestBitIO) {
   }
 }
 
+TEST(AV1, TestSymbolIO) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kBufferSize = 20000;
+  const int kMaxSymbols = 4000;
+  uint8_t bw_buffer[kBufferSize];
+  int nsymbs[kMaxSymbols];
+  int symbs[kMaxSymbols];
+  // Short streams end inside the first refill of the decoder window.
+  for (int num_symbols = 1; num_symbols <= kMaxSymbols; num_symbols *= 4) {
+    for (int n = 0; n < num_tests; ++n) {
+      aom_cdf_prob cdfs[16][17];
+      for (int k = 0; k < 16; ++k) {
+        // Context k has k + 1 equally likely symbols.
+        for (int i = 0; i < k; ++i)
+          cdfs[k][i] = AOM_ICDF(CDF_PROB_TOP * (i + 1) / (k + 1));
+        cdfs[k][k] = AOM_ICDF(CDF_PROB_TOP);
+        cdfs[k][k + 1] = 0;
+      }
+      aom_cdf_prob enc_cdfs[16][17];
+      memcpy(enc_cdfs, cdfs, sizeof(cdfs));
+      aom_writer bw;
+      bw.allow_update_cdf = 1;
+      aom_start_encode(&bw, bw_buffer);
+      for (int i = 0; i < num_symbols; ++i) {
+        nsymbs[i] = 2 + rnd(15);
+        // Skew towards the low symbols like real mode and coefficient data.
+        symbs[i] = rnd(nsymbs[i]) >> rnd(3);
+        aom_write_symbol(&bw, symbs[i], enc_cdfs[nsymbs[i] - 1], nsymbs[i]);
+      }
+      aom_stop_encode(&bw);
+
+      aom_reader br;
+      aom_reader_init(&br, bw_buffer, bw.pos, NULL, NULL);
+      br.allow_update_cdf = 1;
+      for (int i = 0; i < num_symbols; ++i) {
+        GTEST_ASSERT_EQ(
+            aom_read_symbol(&br, cdfs[nsymbs[i] - 1], nsymbs[i], NULL),
+            symbs[i])
+            << "pos: " << i << " / " << num_symbols;
+      }
+      // Reading past the end of the data must stay well behaved.
+      uint32_t last_tell = aom_reader_tell(&br);
+      for (int i = 0; i < 1000; ++i) {
+        aom_read_symbol(&br, cdfs[15], 16, NULL);
+        const uint32_t tell = aom_reader_tell(&br);
+        GTEST_ASSERT_GE(tell, last_tell);
+        last_tell = tell;
+      }
+    }
+  }
+}
+
+#if !CONFIG_LV_MAP_MULTI
+// Element by element CDF adaptation, as update_cdf() did before it was
+// vectorized.
+static void reference_update_cdf(aom_cdf_prob *cdf, int val, int nsymbs) {
+  int rate = 4 + (cdf[nsymbs] > 31) + get_msb(nsymbs);
+#if CONFIG_LV_MAP
+  if (nsymbs == 2)
+    rate = 4 + (cdf[nsymbs] > 7) + (cdf[nsymbs] > 15) + get_msb(nsymbs);
+#endif
+  const int tmp0 = 1 << 5;
+  int tmp = AOM_ICDF(tmp0);
+  const int diff = ((CDF_PROB_TOP - (nsymbs << 5)) >> rate) << rate;
+  for (int i = 0; i < nsymbs - 1; ++i, tmp -= tmp0) {
+    tmp -= (i == val ? diff : 0);
+    cdf[i] += ((tmp - cdf[i]) >> rate);
+  }
+  cdf[nsymbs] += (cdf[nsymbs] < 32);
+}
+
+TEST(AV1, TestCdfUpdate) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kGuard = 8;
+  for (int nsymbs = 2; nsymbs <= 16; ++nsymbs) {
+    for (int n = 0; n < 100; ++n) {
+      // Surround the CDF with random values that must not be touched.
+      aom_cdf_prob cdf[kGuard + CDF_SIZE(16) + kGuard];
+      for (size_t i = 0; i < sizeof(cdf) / sizeof(cdf[0]); ++i)
+        cdf[i] = rnd.Rand16();
+      aom_cdf_prob *const c = cdf + kGuard;
+      int sum = 0;
+      for (int i = 0; i < nsymbs - 1; ++i) {
+        sum += 1 + rnd((CDF_PROB_TOP - sum) / (nsymbs - i) - 1);
+        c[i] = AOM_ICDF(sum);
+      }
+      c[nsymbs - 1] = AOM_ICDF(CDF_PROB_TOP);
+      c[nsymbs] = rnd(33);
+      aom_cdf_prob ref[sizeof(cdf) / sizeof(cdf[0])];
+      memcpy(ref, cdf, sizeof(cdf));
+      for (int i = 0; i < 64; ++i) {
+        const int val = rnd(nsymbs);
+        update_cdf(c, val, nsymbs);
+        reference_update_cdf(ref + kGuard, val, nsymbs);
+        ASSERT_EQ(0, memcmp(ref, cdf, sizeof(cdf)))
+            << "nsymbs: " << nsymbs << " update: " << i;
+      }
+    }
+  }
+}
+#endif  // !CONFIG_LV_MAP_MULTI
+
 #define FRAC_DIFF_TOTAL_ERROR 0.16
 
 TEST(AV1, TestTell) {
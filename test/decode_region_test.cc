@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "aom/aomdx.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+
+namespace {
+
+const int kWidth = 352;
+const int kHeight = 288;
+const int kNumFrames = 5;
+
+// Decodes each frame whole and with only the tiles around the top left corner,
+// and checks that the valid region of the second decode matches the first. The
+// region can be moved before a given frame.
+class DecodeRegionTest
+    : public ::libaom_test::CodecTestWithParam<libaom_test::TestMode>,
+      public ::libaom_test::EncoderTest {
+ protected:
+  DecodeRegionTest()
+      : EncoderTest(GET_PARAM(0)), encoding_mode_(GET_PARAM(1)),
+        frame_parallel_(1), intra_only_(false), move_frame_(-1),
+        superblock_size_(AOM_SUPERBLOCK_SIZE_DYNAMIC) {
+    aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
+    cfg.w = kWidth;
+    cfg.h = kHeight;
+    cfg.threads = 1;
+    cfg.allow_lowbitdepth = 1;
+    full_dec_ = codec_->CreateDecoder(cfg, 0);
+    region_dec_ = codec_->CreateDecoder(cfg, 0);
+    aom_region_t region = { 0, 0, 64, 64 };
+    region_dec_->Control(AV1D_SET_DECODE_REGION, &region);
+    moved_region_ = region;
+  }
+
+  virtual ~DecodeRegionTest() {
+    delete full_dec_;
+    delete region_dec_;
+  }
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(encoding_mode_);
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 4);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, 1);
+      encoder->Control(AV1E_SET_TILE_ROWS, 1);
+      encoder->Control(AV1E_SET_FRAME_PARALLEL_DECODING, frame_parallel_);
+      encoder->Control(AV1E_SET_SUPERBLOCK_SIZE, superblock_size_);
+    }
+    frame_flags_ = intra_only_ ? AOM_EFLAG_FORCE_KF : 0;
+  }
+
+  const aom_image_t *Decode(::libaom_test::Decoder *dec,
+                            const aom_codec_cx_pkt_t *pkt,
+                            aom_region_t *valid) {
+    const aom_codec_err_t res = dec->DecodeFrame(
+        reinterpret_cast<uint8_t *>(pkt->data.frame.buf), pkt->data.frame.sz);
+    EXPECT_EQ(AOM_CODEC_OK, res) << dec->DecodeError();
+    if (res != AOM_CODEC_OK) return NULL;
+    EXPECT_EQ(AOM_CODEC_OK, aom_codec_control(dec->GetDecoder(),
+                                              AV1D_GET_VALID_REGION, valid));
+    return dec->GetDxData().Next();
+  }
+
+  // Compares the pixels of the two images inside the region.
+  void CompareRegion(const aom_image_t *a, const aom_image_t *b,
+                     const aom_region_t &region) {
+    const int bytes = (a->fmt & AOM_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int ss_x = plane ? a->x_chroma_shift : 0;
+      const int ss_y = plane ? a->y_chroma_shift : 0;
+      const int x0 = region.x >> ss_x;
+      const int y0 = region.y >> ss_y;
+      const int x1 = (region.x + region.width) >> ss_x;
+      const int y1 = (region.y + region.height) >> ss_y;
+      for (int y = y0; y < y1; ++y) {
+        const uint8_t *row_a =
+            a->planes[plane] + y * a->stride[plane] + x0 * bytes;
+        const uint8_t *row_b =
+            b->planes[plane] + y * b->stride[plane] + x0 * bytes;
+        ASSERT_EQ(0, memcmp(row_a, row_b, (x1 - x0) * bytes))
+            << "plane: " << plane << " row: " << y;
+      }
+    }
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    aom_region_t full_valid, valid;
+    if (static_cast<int>(valid_.size()) == move_frame_)
+      region_dec_->Control(AV1D_SET_DECODE_REGION, &moved_region_);
+    const aom_image_t *full_img = Decode(full_dec_, pkt, &full_valid);
+    const aom_image_t *img = Decode(region_dec_, pkt, &valid);
+    if (full_img == NULL || img == NULL) {
+      abort_ = true;
+      return;
+    }
+    EXPECT_EQ(0, full_valid.x);
+    EXPECT_EQ(0, full_valid.y);
+    EXPECT_EQ(kWidth, full_valid.width);
+    EXPECT_EQ(kHeight, full_valid.height);
+    full_md5_.Add(full_img);
+    region_md5_.Add(img);
+
+    valid_.push_back(valid);
+    ASSERT_NO_FATAL_FAILURE(CompareRegion(full_img, img, valid));
+  }
+
+  ::libaom_test::TestMode encoding_mode_;
+  int frame_parallel_;
+  bool intra_only_;
+  int move_frame_;
+  aom_region_t moved_region_;
+  unsigned int superblock_size_;
+  ::libaom_test::Decoder *full_dec_;
+  ::libaom_test::Decoder *region_dec_;
+  ::libaom_test::MD5 full_md5_;
+  ::libaom_test::MD5 region_md5_;
+  std::vector<aom_region_t> valid_;
+};
+
+// Every frame is a key frame, so the tiles decoded are exact.
+TEST_P(DecodeRegionTest, IntraFramesMatchInRegion) {
+  intra_only_ = true;
+  ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", kWidth,
+                                       kHeight, 30, 1, 0, kNumFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+  ASSERT_EQ(static_cast<size_t>(kNumFrames), valid_.size());
+  for (size_t i = 0; i < valid_.size(); ++i) {
+    EXPECT_EQ(0, valid_[i].x) << "frame: " << i;
+    EXPECT_EQ(0, valid_[i].y) << "frame: " << i;
+    EXPECT_GT(valid_[i].width, 0) << "frame: " << i;
+    EXPECT_GT(valid_[i].height, 0) << "frame: " << i;
+    EXPECT_LT(valid_[i].width * valid_[i].height, kWidth * kHeight)
+        << "frame: " << i;
+  }
+  // The other tiles were left out.
+  EXPECT_STRNE(full_md5_.Get(), region_md5_.Get());
+}
+
+// Frames that adapt the frame context from their tiles are decoded whole.
+TEST_P(DecodeRegionTest, BackwardAdaptedFramesDecodeWhole) {
+  frame_parallel_ = 0;
+  ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", kWidth,
+                                       kHeight, 30, 1, 0, kNumFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+  for (size_t i = 0; i < valid_.size(); ++i) {
+    EXPECT_EQ(kWidth, valid_[i].width) << "frame: " << i;
+    EXPECT_EQ(kHeight, valid_[i].height) << "frame: " << i;
+  }
+  EXPECT_STREQ(full_md5_.Get(), region_md5_.Get());
+}
+
+// Error resilient inter frames do not read the motion vectors of earlier
+// frames, so they are decoded around the region too. The region moves on an
+// inter frame, which is then decoded whole. The valid region shrinks as the
+// motion reaches into the pixels the references left out, and what is left
+// of it keeps matching the full decode.
+TEST_P(DecodeRegionTest, MovingRegionMatchesOnInterFrames) {
+  cfg_.g_error_resilient = 1;
+  superblock_size_ = AOM_SUPERBLOCK_SIZE_64X64;
+  move_frame_ = 2;
+  moved_region_.x = 32;
+  moved_region_.y = 32;
+  ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", kWidth,
+                                       kHeight, 30, 1, 0, kNumFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+  ASSERT_EQ(static_cast<size_t>(kNumFrames), valid_.size());
+  for (size_t i = 0; i < valid_.size(); ++i) {
+    EXPECT_LT(valid_[i].width * valid_[i].height, kWidth * kHeight)
+        << "frame: " << i;
+    if (i > static_cast<size_t>(move_frame_) + 1) continue;
+    // Some inter frames are compared before and after the move.
+    EXPECT_GT(valid_[i].width, 0) << "frame: " << i;
+    EXPECT_GT(valid_[i].height, 0) << "frame: " << i;
+  }
+  EXPECT_STRNE(full_md5_.Get(), region_md5_.Get());
+
+  // Regions with negative values or out of the frame are rejected.
+  aom_codec_ctx_t *const dec = region_dec_->GetDecoder();
+  aom_region_t region = { -1, 0, 64, 64 };
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(dec, AV1D_SET_DECODE_REGION, &region));
+  region.x = 0;
+  region.height = -64;
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(dec, AV1D_SET_DECODE_REGION, &region));
+  region.height = 64;
+  region.x = kWidth - 32;
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(dec, AV1D_SET_DECODE_REGION, &region));
+  region.x = kWidth - 64;
+  EXPECT_EQ(AOM_CODEC_OK,
+            aom_codec_control(dec, AV1D_SET_DECODE_REGION, &region));
+}
+
+AV1_INSTANTIATE_TEST_CASE(DecodeRegionTest,
+                          ::testing::Values(::libaom_test::kOnePassGood));
+
+}  // namespace
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+#include "aom/aomdx.h"
+
+namespace {
+
+class DecodeTimingTest : public ::libaom_test::CodecTestWithParam<int>,
+                         public ::libaom_test::EncoderTest {
+ protected:
+  DecodeTimingTest()
+      : EncoderTest(GET_PARAM(0)), n_tile_cols_(GET_PARAM(1)),
+        decoded_frames_(0) {}
+
+  virtual ~DecodeTimingTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libaom_test::kOnePassGood);
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 4);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, n_tile_cols_);
+    }
+  }
+
+  virtual bool HandleDecodeResult(const aom_codec_err_t res_dec,
+                                  ::libaom_test::Decoder *decoder) {
+    EXPECT_EQ(AOM_CODEC_OK, res_dec) << decoder->DecodeError();
+    if (res_dec != AOM_CODEC_OK) return false;
+
+    aom_codec_ctx_t *const ctx = decoder->GetDecoder();
+    EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+              aom_codec_control(ctx, AV1D_GET_FRAME_TIMING,
+                                static_cast<aom_frame_timing_t *>(NULL)));
+
+    aom_frame_timing_t timing;
+    EXPECT_EQ(AOM_CODEC_OK,
+              aom_codec_control(ctx, AV1D_GET_FRAME_TIMING, &timing));
+    EXPECT_GE(timing.frames, 1);
+    EXPECT_GE(timing.total_us, timing.tile_decode_us);
+    EXPECT_GE(timing.tile_decode_us, 0);
+    EXPECT_GE(timing.deblock_us, 0);
+    EXPECT_GE(timing.cdef_us, 0);
+    EXPECT_GE(timing.restoration_us, 0);
+
+    // Per-tile times must add up to the whole-frame tile decode time.
+    EXPECT_GE(timing.tile_cols, 1);
+    EXPECT_GE(timing.tile_rows, 1);
+    EXPECT_TRUE(timing.tile_us != NULL);
+    if (timing.tile_us != NULL) {
+      int64_t tile_sum = 0;
+      for (int i = 0; i < timing.tile_rows * timing.tile_cols; ++i) {
+        EXPECT_GE(timing.tile_us[i], 0);
+        tile_sum += timing.tile_us[i];
+      }
+      EXPECT_EQ(timing.tile_decode_us, tile_sum);
+    }
+    ++decoded_frames_;
+    return true;
+  }
+
+  int n_tile_cols_;
+  int decoded_frames_;
+};
+
+TEST_P(DecodeTimingTest, ReportsStages) {
+  cfg_.rc_target_bitrate = 500;
+  cfg_.g_lag_in_frames = 0;
+#if CONFIG_EXT_TILE
+  cfg_.large_scale_tile = 0;
+#endif  // CONFIG_EXT_TILE
+
+  ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", 704, 144,
+                                       30, 1, 0, 3);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_GT(decoded_frames_, 0);
+}
+
+AV1_INSTANTIATE_TEST_CASE(DecodeTimingTest, ::testing::Values(0, 1));
+
+}  // namespace
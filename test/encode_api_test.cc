@@ -12,9 +12,14 @@
 #include "third_party/googletest/src/googletest/include/gtest/gtest.h"
 
 #include "./aom_config.h"
+#include "test/acm_random.h"
+#include "test/md5_helper.h"
 #include "test/util.h"
 #include "aom/aomcx.h"
 #include "aom/aom_encoder.h"
+#if CONFIG_AV1_ENCODER
+#include "av1/encoder/encoder.h"
+#endif
 
 namespace {
 
@@ -59,4 +64,121 @@ TEST(EncodeAPI, InvalidParams) {
   }
 }
 
+#if CONFIG_AV1_ENCODER
+TEST(EncodeAPI, FrameStats) {
+  aom_codec_ctx_t enc;
+  aom_codec_enc_cfg_t cfg;
+  aom_image_t img;
+  aom_frame_stats_t stats;
+
+  EXPECT_EQ(AOM_CODEC_OK,
+            aom_codec_enc_config_default(&aom_codec_av1_cx_algo, &cfg, 0));
+  cfg.g_w = 64;
+  cfg.g_h = 64;
+  cfg.g_lag_in_frames = 0;
+  ASSERT_TRUE(aom_img_alloc(&img, AOM_IMG_FMT_I420, 64, 64, 32) != NULL);
+  memset(img.img_data, 128, 64 * 64 * 3 / 2);
+  EXPECT_EQ(AOM_CODEC_OK,
+            aom_codec_enc_init(&enc, &aom_codec_av1_cx_algo, &cfg, 0));
+  EXPECT_EQ(AOM_CODEC_INVALID_PARAM,
+            aom_codec_control(&enc, AV1E_GET_FRAME_STATS, NULL));
+
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_encode(&enc, &img, 0, 1, 0, 0));
+  EXPECT_EQ(AOM_CODEC_OK,
+            aom_codec_control(&enc, AV1E_GET_FRAME_STATS, &stats));
+  EXPECT_EQ(1u, stats.frames);
+  EXPECT_GE(stats.encode_passes, 1u);
+  EXPECT_GT(stats.partition_evals, 0u);
+  EXPECT_GT(stats.mode_evals, 0u);
+  EXPECT_LE(stats.tx_cache_hits, stats.tx_cache_lookups);
+  EXPECT_LE(stats.mv_cache_hits, stats.mv_cache_lookups);
+  EXPECT_GE(stats.total_us, stats.partition_search_us);
+
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&enc));
+  aom_img_free(&img);
+}
+
+// Encodes a few frames of a textured picture moving down and right, and
+// returns the MD5 of the stream and the motion search cache counts.
+void EncodeMovingTexture(int speed, int dev_sf, ::libaom_test::MD5 *md5,
+                         uint64_t *mv_cache_lookups, uint64_t *mv_cache_hits) {
+  const int kSize = 128;
+  const int kNumFrames = 3;
+  aom_codec_ctx_t enc;
+  aom_codec_enc_cfg_t cfg;
+  aom_image_t img;
+  aom_frame_stats_t stats;
+  uint8_t texture[2 * kSize][2 * kSize];
+  ::libaom_test::ACMRandom rnd(::libaom_test::ACMRandom::DeterministicSeed());
+
+  // Blocks of noise, so that the motion search has something to lock on to.
+  for (int r = 0; r < 2 * kSize; ++r) {
+    for (int c = 0; c < 2 * kSize; ++c) {
+      texture[r][c] = (r & 7) || (c & 7) ? texture[r & ~7][c & ~7]
+                                         : rnd.Rand8();
+    }
+  }
+  EXPECT_EQ(AOM_CODEC_OK,
+            aom_codec_enc_config_default(&aom_codec_av1_cx_algo, &cfg, 0));
+  cfg.g_w = kSize;
+  cfg.g_h = kSize;
+  cfg.g_lag_in_frames = 0;
+  ASSERT_TRUE(aom_img_alloc(&img, AOM_IMG_FMT_I420, kSize, kSize, 32) != NULL);
+  memset(img.planes[AOM_PLANE_U], 128, img.stride[AOM_PLANE_U] * kSize / 2);
+  memset(img.planes[AOM_PLANE_V], 128, img.stride[AOM_PLANE_V] * kSize / 2);
+  ASSERT_EQ(AOM_CODEC_OK,
+            aom_codec_enc_init(&enc, &aom_codec_av1_cx_algo, &cfg, 0));
+  ASSERT_EQ(AOM_CODEC_OK, aom_codec_control(&enc, AOME_SET_CPUUSED, speed));
+  ASSERT_EQ(AOM_CODEC_OK, aom_codec_control(&enc, AOME_SET_DEVSF, dev_sf));
+  *mv_cache_lookups = 0;
+  *mv_cache_hits = 0;
+
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    for (int r = 0; r < kSize; ++r) {
+      memcpy(img.planes[AOM_PLANE_Y] + r * img.stride[AOM_PLANE_Y],
+             &texture[kSize - 3 * frame + r][kSize - 5 * frame], kSize);
+    }
+    ASSERT_EQ(AOM_CODEC_OK, aom_codec_encode(&enc, &img, frame, 1, 0, 0));
+    aom_codec_iter_t iter = NULL;
+    const aom_codec_cx_pkt_t *pkt;
+    while ((pkt = aom_codec_get_cx_data(&enc, &iter)) != NULL) {
+      if (pkt->kind == AOM_CODEC_CX_FRAME_PKT) {
+        md5->Add(static_cast<const uint8_t *>(pkt->data.frame.buf),
+                 pkt->data.frame.sz);
+      }
+    }
+    ASSERT_EQ(AOM_CODEC_OK,
+              aom_codec_control(&enc, AV1E_GET_FRAME_STATS, &stats));
+    *mv_cache_lookups += stats.mv_cache_lookups;
+    *mv_cache_hits += stats.mv_cache_hits;
+  }
+  EXPECT_EQ(AOM_CODEC_OK, aom_codec_destroy(&enc));
+  aom_img_free(&img);
+}
+
+TEST(EncodeAPI, MotionSearchCacheHits) {
+  ::libaom_test::MD5 md5;
+  uint64_t lookups, hits;
+
+  // Speed 1 turns the cache on.
+  ASSERT_NO_FATAL_FAILURE(EncodeMovingTexture(1, 0, &md5, &lookups, &hits));
+  EXPECT_GT(lookups, 0u);
+  EXPECT_GT(hits, 0u);
+}
+
+TEST(EncodeAPI, MotionSearchCacheIsBitExact) {
+  ::libaom_test::MD5 md5_off, md5_on;
+  uint64_t lookups, hits;
+
+  // The MV_SEARCH_SF developer speed feature turns the cache on at speed 0.
+  ASSERT_NO_FATAL_FAILURE(
+      EncodeMovingTexture(0, 0, &md5_off, &lookups, &hits));
+  EXPECT_EQ(0u, lookups);
+  ASSERT_NO_FATAL_FAILURE(
+      EncodeMovingTexture(0, MV_SEARCH_SF, &md5_on, &lookups, &hits));
+  EXPECT_GT(hits, 0u);
+  EXPECT_STREQ(md5_off.Get(), md5_on.Get());
+}
+#endif  // CONFIG_AV1_ENCODER
+
 }  // namespace
@@ -120,6 +120,11 @@ class Encoder {
     const aom_codec_err_t res = aom_codec_control_(&encoder_, ctrl_id, arg);
     ASSERT_EQ(AOM_CODEC_OK, res) << EncoderError();
   }
+
+  void Control(int ctrl_id, aom_frame_stats_t *arg) {
+    const aom_codec_err_t res = aom_codec_control_(&encoder_, ctrl_id, arg);
+    ASSERT_EQ(AOM_CODEC_OK, res) << EncoderError();
+  }
 #endif
 
   void Config(const aom_codec_enc_cfg_t *cfg) {
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+
+#include "./aom_config.h"
+#include "aom_mem/aom_mem.h"
+#include "av1/common/alloccommon.h"
+#include "av1/common/entropymode.h"
+#include "av1/common/onyxc_int.h"
+
+namespace {
+
+// Checks the reference counts of the shared saved frame contexts as frames
+// store, reset and copy them. The initialized field of each context is used
+// as a tag to tell the contexts apart.
+class FrameContextPoolTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    cm_ = CreateCommon();
+    ASSERT_TRUE(cm_ != NULL);
+  }
+
+  virtual void TearDown() { DestroyCommon(cm_); }
+
+  static AV1_COMMON *CreateCommon() {
+    AV1_COMMON *const cm = new AV1_COMMON();
+    cm->fc = reinterpret_cast<FRAME_CONTEXT *>(
+        aom_memalign(32, sizeof(*cm->fc)));
+    if (cm->fc == NULL || av1_alloc_frame_contexts(cm)) {
+      DestroyCommon(cm);
+      return NULL;
+    }
+    memset(cm->fc, 0, sizeof(*cm->fc));
+    return cm;
+  }
+
+  static void DestroyCommon(AV1_COMMON *cm) {
+    av1_free_frame_contexts(cm);
+    aom_free(cm->fc);
+    delete cm;
+  }
+
+  // Returns the number of allocated pool buffers, after checking that each
+  // is referenced exactly by the slots that refer to it.
+  static int CheckPool(const AV1_COMMON *cm) {
+    int num_buffers = 0;
+    for (int i = 0; i < FRAME_CONTEXTS; ++i) {
+      int refs = 0;
+      for (int slot = 0; slot < FRAME_CONTEXTS; ++slot)
+        refs += cm->frame_context_buf[slot] == i;
+      EXPECT_EQ(refs, cm->fc_pool_refs[i]) << "buffer " << i;
+      EXPECT_EQ(refs > 0, cm->fc_pool[i] != NULL) << "buffer " << i;
+      num_buffers += cm->fc_pool[i] != NULL;
+    }
+    return num_buffers;
+  }
+
+  void StoreContext(int slot, int tag) {
+    cm_->fc->initialized = tag;
+    av1_store_frame_context(cm_, slot, cm_->fc);
+  }
+
+  void SetupFrame(FRAME_TYPE frame_type, int intra_only, int error_resilient,
+                  int tag) {
+    cm_->frame_type = frame_type;
+    cm_->intra_only = intra_only;
+    cm_->error_resilient_mode = error_resilient;
+    cm_->fc->initialized = tag;
+    av1_setup_frame_contexts(cm_);
+  }
+
+  int Tag(int slot) const { return get_frame_context(cm_, slot)->initialized; }
+
+  AV1_COMMON *cm_;
+};
+
+TEST_F(FrameContextPoolTest, SharesOneBufferAfterAlloc) {
+  EXPECT_EQ(1, CheckPool(cm_));
+  EXPECT_EQ(FRAME_CONTEXTS, cm_->fc_pool_refs[cm_->frame_context_buf[0]]);
+}
+
+TEST_F(FrameContextPoolTest, StoreUnsharesOnlyTheWrittenSlot) {
+  StoreContext(1, 1);
+  EXPECT_EQ(2, CheckPool(cm_));
+  load_frame_context(cm_, 1);
+  StoreContext(1, 2);
+  EXPECT_EQ(2, CheckPool(cm_));
+  StoreContext(2, 3);
+  EXPECT_EQ(3, CheckPool(cm_));
+
+  EXPECT_EQ(0, Tag(0));
+  EXPECT_EQ(2, Tag(1));
+  EXPECT_EQ(3, Tag(2));
+  // pre_fc follows the slot it was loaded from, not the other slots that
+  // shared its buffer.
+  EXPECT_EQ(get_frame_context(cm_, 1), cm_->pre_fc);
+  EXPECT_EQ(2, cm_->pre_fc->initialized);
+}
+
+TEST_F(FrameContextPoolTest, KeyIntraOnlyAndErrorResilientFrames) {
+  StoreContext(1, 1);
+  StoreContext(2, 2);
+  load_frame_context(cm_, 2);
+  EXPECT_EQ(3, CheckPool(cm_));
+
+  // A key frame resets every slot, and frees the buffers left unreferenced.
+  SetupFrame(KEY_FRAME, 0, 0, 4);
+  EXPECT_EQ(1, CheckPool(cm_));
+  for (int slot = 0; slot < FRAME_CONTEXTS; ++slot) EXPECT_EQ(4, Tag(slot));
+  EXPECT_EQ(get_frame_context(cm_, 2), cm_->pre_fc);
+
+  // An intra-only frame resets a single slot.
+#if CONFIG_NO_FRAME_CONTEXT_SIGNALING
+  const int intra_only_slot = FRAME_CONTEXT_DEFAULTS;
+#else
+  const int intra_only_slot = 3;
+  cm_->reset_frame_context = RESET_FRAME_CONTEXT_CURRENT;
+  cm_->frame_context_idx = intra_only_slot;
+#endif  // CONFIG_NO_FRAME_CONTEXT_SIGNALING
+  SetupFrame(INTER_FRAME, 1, 0, 5);
+  EXPECT_EQ(2, CheckPool(cm_));
+  for (int slot = 0; slot < FRAME_CONTEXTS; ++slot)
+    EXPECT_EQ(slot == intra_only_slot ? 5 : 4, Tag(slot));
+
+  SetupFrame(INTER_FRAME, 0, 1, 6);
+#if CONFIG_NO_FRAME_CONTEXT_SIGNALING
+  // Error resilient frames use the default slot, like intra-only frames.
+  EXPECT_EQ(2, CheckPool(cm_));
+  EXPECT_EQ(6, Tag(FRAME_CONTEXT_DEFAULTS));
+#else
+  // Error resilient frames reset every slot.
+  EXPECT_EQ(1, CheckPool(cm_));
+  for (int slot = 0; slot < FRAME_CONTEXTS; ++slot) EXPECT_EQ(6, Tag(slot));
+#endif  // CONFIG_NO_FRAME_CONTEXT_SIGNALING
+}
+
+TEST_F(FrameContextPoolTest, CopyMirrorsTheSharing) {
+  AV1_COMMON *const dst = CreateCommon();
+  ASSERT_TRUE(dst != NULL);
+  // Give dst buffers that src does not use, to check they are freed.
+  for (int slot = 0; slot < 4; ++slot) {
+    dst->fc->initialized = 10 + slot;
+    av1_store_frame_context(dst, slot, dst->fc);
+  }
+  load_frame_context(dst, 1);
+  EXPECT_EQ(5, CheckPool(dst));
+
+  StoreContext(1, 1);
+  av1_copy_frame_contexts(dst, cm_);
+  EXPECT_EQ(2, CheckPool(dst));
+  for (int slot = 0; slot < FRAME_CONTEXTS; ++slot)
+    EXPECT_EQ(Tag(slot), get_frame_context(dst, slot)->initialized);
+  EXPECT_EQ(get_frame_context(dst, 1), dst->pre_fc);
+  DestroyCommon(dst);
+}
+
+}  // namespace
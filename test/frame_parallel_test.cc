@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+
+namespace {
+
+const int kNumFrames = 10;
+
+// Decodes a stream with frame parallel threading and checks that every
+// output frame matches the serially decoded one.
+class FrameParallelTest
+    : public ::libaom_test::CodecTestWith2Params<int, int>,
+      public ::libaom_test::EncoderTest {
+ protected:
+  FrameParallelTest()
+      : EncoderTest(GET_PARAM(0)), lossless_(GET_PARAM(1)),
+        n_tile_cols_(GET_PARAM(2)), row_publishes_(0) {}
+
+  virtual ~FrameParallelTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libaom_test::kOnePassGood);
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 4);
+      encoder->Control(AV1E_SET_LOSSLESS, lossless_);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, n_tile_cols_);
+    }
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) return;
+    frames_.push_back(
+        std::string(reinterpret_cast<const char *>(pkt->data.frame.buf),
+                    pkt->data.frame.sz));
+  }
+
+  virtual void DecompressedFrameHook(const aom_image_t &img,
+                                     aom_codec_pts_t /*pts*/) {
+    ::libaom_test::MD5 md5;
+    md5.Add(&img);
+    serial_md5_.push_back(md5.Get());
+  }
+
+  // Each iterator yields at most one frame in frame parallel mode, so keep
+  // asking until the decoder has nothing more to output.
+  void AddOutputFrames(::libaom_test::Decoder *decoder) {
+    for (;;) {
+      ::libaom_test::DxDataIterator dec_iter = decoder->GetDxData();
+      const aom_image_t *const img = dec_iter.Next();
+      if (img == NULL) break;
+      ::libaom_test::MD5 md5;
+      md5.Add(img);
+      parallel_md5_.push_back(md5.Get());
+    }
+  }
+
+  void DecodeFrameParallel(int threads) {
+    aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
+    cfg.threads = threads;
+    cfg.allow_lowbitdepth = CONFIG_LOWBITDEPTH;
+    ::libaom_test::Decoder *const decoder =
+        codec_->CreateDecoder(cfg, AOM_CODEC_USE_FRAME_THREADING);
+    for (size_t i = 0; i < frames_.size(); ++i) {
+      const aom_codec_err_t res = decoder->DecodeFrame(
+          reinterpret_cast<const uint8_t *>(frames_[i].data()),
+          frames_[i].size());
+      ASSERT_EQ(AOM_CODEC_OK, res) << decoder->DecodeError();
+      AddOutputFrames(decoder);
+    }
+    // Flush the frames still held by the workers.
+    ASSERT_EQ(AOM_CODEC_OK, decoder->DecodeFrame(NULL, 0));
+    AddOutputFrames(decoder);
+    decoder->Control(AV1D_GET_ROW_PUBLISHES, &row_publishes_);
+    delete decoder;
+  }
+
+  int lossless_;
+  int n_tile_cols_;
+  int row_publishes_;
+  std::vector<std::string> frames_;
+  std::vector<std::string> serial_md5_;
+  std::vector<std::string> parallel_md5_;
+};
+
+TEST_P(FrameParallelTest, MatchesSerialDecode) {
+  cfg_.rc_target_bitrate = 500;
+#if CONFIG_EXT_TILE
+  cfg_.large_scale_tile = 0;
+#endif  // CONFIG_EXT_TILE
+
+  ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, kNumFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_GT(serial_md5_.size(), 0u);
+
+  for (int threads = 2; threads <= 4; threads += 2) {
+    parallel_md5_.clear();
+    ASSERT_NO_FATAL_FAILURE(DecodeFrameParallel(threads));
+    ASSERT_EQ(serial_md5_.size(), parallel_md5_.size())
+        << "threads: " << threads;
+    for (size_t i = 0; i < serial_md5_.size(); ++i)
+      EXPECT_EQ(serial_md5_[i], parallel_md5_[i])
+          << "threads: " << threads << " frame: " << i;
+    // Rows are released as they come out of the post filters, which the
+    // lossy streams turn on, so the workers must have let each other start
+    // on rows of frames that were not done yet.
+    EXPECT_GT(row_publishes_, 0) << "threads: " << threads;
+  }
+}
+
+AV1_INSTANTIATE_TEST_CASE(FrameParallelTest, ::testing::Values(0, 1),
+                          ::testing::Values(0, 1));
+
+}  // namespace
@@ -30,6 +30,12 @@ INSTANTIATE_TEST_CASE_P(SSE2, AV1HiprecConvolveTest,
                             aom_convolve8_add_src_hip_sse2));
 #endif
 
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, AV1HiprecConvolveTest,
+                        libaom_test::AV1HiprecConvolve::BuildParams(
+                            aom_convolve8_add_src_hip_avx2));
+#endif
+
 #if CONFIG_HIGHBITDEPTH && HAVE_SSSE3
 TEST_P(AV1HighbdHiprecConvolveTest, CheckOutput) {
   RunCheckOutput(GET_PARAM(4));
@@ -41,4 +47,10 @@ INSTANTIATE_TEST_CASE_P(SSSE3, AV1HighbdHiprecConvolveTest,
 
 #endif
 
+#if CONFIG_HIGHBITDEPTH && HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, AV1HighbdHiprecConvolveTest,
+                        libaom_test::AV1HighbdHiprecConvolve::BuildParams(
+                            aom_highbd_convolve8_add_src_hip_avx2));
+#endif
+
 }  // namespace
@@ -140,11 +140,11 @@ class LowbdIntraPredTest : public AV1IntraPredTest<IntraPred, uint8_t> {
 };
 
 TEST_P(HighbdIntraPredTest, Bitexact) {
-  // max block size is 32
-  DECLARE_ALIGNED(16, uint16_t, left_col[2 * 32]);
-  DECLARE_ALIGNED(16, uint16_t, above_data[2 * 32 + 32]);
-  DECLARE_ALIGNED(16, uint16_t, dst[3 * 32 * 32]);
-  DECLARE_ALIGNED(16, uint16_t, ref_dst[3 * 32 * 32]);
+  // max block size is 64
+  DECLARE_ALIGNED(16, uint16_t, left_col[2 * 64]);
+  DECLARE_ALIGNED(16, uint16_t, above_data[2 * 64 + 64]);
+  DECLARE_ALIGNED(16, uint16_t, dst[3 * 64 * 64]);
+  DECLARE_ALIGNED(16, uint16_t, ref_dst[3 * 64 * 64]);
   memset(left_col, 0, sizeof(left_col));
   memset(above_data, 0, sizeof(above_data));
   RunTest(left_col, above_data, dst, ref_dst);
@@ -178,6 +178,40 @@ TEST_P(LowbdIntraPredTest, Bitexact) {
       highbd_entry(type, 16, 32, opt, bd),                                    \
       highbd_entry(type, 32, 16, opt, bd), highbd_entry(type, 32, 32, opt, bd)
 
+// The 1:4 sizes and, with CONFIG_TX64X64, the 64 wide and high sizes.
+#if CONFIG_TX64X64
+#define highbd_intrapred_ext(type, opt, bd)                                   \
+  highbd_entry(type, 4, 16, opt, bd), highbd_entry(type, 16, 4, opt, bd),     \
+      highbd_entry(type, 8, 32, opt, bd), highbd_entry(type, 32, 8, opt, bd), \
+      highbd_entry(type, 16, 64, opt, bd),                                    \
+      highbd_entry(type, 64, 16, opt, bd),                                    \
+      highbd_entry(type, 32, 64, opt, bd),                                    \
+      highbd_entry(type, 64, 32, opt, bd), highbd_entry(type, 64, 64, opt, bd)
+#define highbd_intrapred_wide(type, opt, bd)                                 \
+  highbd_entry(type, 16, 4, opt, bd), highbd_entry(type, 16, 8, opt, bd),    \
+      highbd_entry(type, 16, 16, opt, bd),                                   \
+      highbd_entry(type, 16, 32, opt, bd),                                   \
+      highbd_entry(type, 16, 64, opt, bd),                                   \
+      highbd_entry(type, 32, 8, opt, bd), highbd_entry(type, 32, 16, opt, bd), \
+      highbd_entry(type, 32, 32, opt, bd),                                   \
+      highbd_entry(type, 32, 64, opt, bd),                                   \
+      highbd_entry(type, 64, 16, opt, bd),                                   \
+      highbd_entry(type, 64, 32, opt, bd), highbd_entry(type, 64, 64, opt, bd)
+#else
+#define highbd_intrapred_ext(type, opt, bd)                               \
+  highbd_entry(type, 4, 16, opt, bd), highbd_entry(type, 16, 4, opt, bd), \
+      highbd_entry(type, 8, 32, opt, bd), highbd_entry(type, 32, 8, opt, bd)
+#define highbd_intrapred_wide(type, opt, bd)                                 \
+  highbd_entry(type, 16, 4, opt, bd), highbd_entry(type, 16, 8, opt, bd),    \
+      highbd_entry(type, 16, 16, opt, bd),                                   \
+      highbd_entry(type, 16, 32, opt, bd),                                   \
+      highbd_entry(type, 32, 8, opt, bd), highbd_entry(type, 32, 16, opt, bd), \
+      highbd_entry(type, 32, 32, opt, bd)
+#endif  // CONFIG_TX64X64
+
+#define highbd_intrapred_all(type, opt, bd) \
+  highbd_intrapred(type, opt, bd), highbd_intrapred_ext(type, opt, bd)
+
 #if CONFIG_HIGHBITDEPTH
 #if HAVE_SSE2
 const IntraPredFunc<HighbdIntraPred> IntraPredTestVector8[] = {
@@ -195,6 +229,15 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVector8[] = {
   highbd_entry(d63e, 4, 4, sse2, 8),  highbd_entry(d63e, 4, 8, sse2, 8),
   highbd_entry(d63e, 8, 4, sse2, 8),  highbd_entry(d63e, 8, 8, sse2, 8),
   highbd_entry(d63e, 8, 16, sse2, 8),
+  highbd_intrapred_ext(dc, sse2, 8),
+  highbd_intrapred_ext(dc_left, sse2, 8),
+  highbd_intrapred_ext(dc_top, sse2, 8),
+  highbd_intrapred_ext(dc_128, sse2, 8),
+  highbd_intrapred_ext(v, sse2, 8),
+  highbd_intrapred_ext(h, sse2, 8),
+  highbd_intrapred_all(smooth, sse2, 8),
+  highbd_intrapred_all(smooth_v, sse2, 8),
+  highbd_intrapred_all(smooth_h, sse2, 8),
 };
 
 INSTANTIATE_TEST_CASE_P(SSE2_TO_C_8, HighbdIntraPredTest,
@@ -220,6 +263,15 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVector10[] = {
   highbd_entry(d63e, 4, 4, sse2, 10),  highbd_entry(d63e, 4, 8, sse2, 10),
   highbd_entry(d63e, 8, 4, sse2, 10),  highbd_entry(d63e, 8, 8, sse2, 10),
   highbd_entry(d63e, 8, 16, sse2, 10),
+  highbd_intrapred_ext(dc, sse2, 10),
+  highbd_intrapred_ext(dc_left, sse2, 10),
+  highbd_intrapred_ext(dc_top, sse2, 10),
+  highbd_intrapred_ext(dc_128, sse2, 10),
+  highbd_intrapred_ext(v, sse2, 10),
+  highbd_intrapred_ext(h, sse2, 10),
+  highbd_intrapred_all(smooth, sse2, 10),
+  highbd_intrapred_all(smooth_v, sse2, 10),
+  highbd_intrapred_all(smooth_h, sse2, 10),
 };
 
 INSTANTIATE_TEST_CASE_P(SSE2_TO_C_10, HighbdIntraPredTest,
@@ -243,6 +295,15 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVector12[] = {
   highbd_entry(d63e, 4, 4, sse2, 12),  highbd_entry(d63e, 4, 8, sse2, 12),
   highbd_entry(d63e, 8, 4, sse2, 12),  highbd_entry(d63e, 8, 8, sse2, 12),
   highbd_entry(d63e, 8, 16, sse2, 12),
+  highbd_intrapred_ext(dc, sse2, 12),
+  highbd_intrapred_ext(dc_left, sse2, 12),
+  highbd_intrapred_ext(dc_top, sse2, 12),
+  highbd_intrapred_ext(dc_128, sse2, 12),
+  highbd_intrapred_ext(v, sse2, 12),
+  highbd_intrapred_ext(h, sse2, 12),
+  highbd_intrapred_all(smooth, sse2, 12),
+  highbd_intrapred_all(smooth_v, sse2, 12),
+  highbd_intrapred_all(smooth_h, sse2, 12),
 };
 
 INSTANTIATE_TEST_CASE_P(SSE2_TO_C_12, HighbdIntraPredTest,
@@ -257,6 +318,7 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVectorSsse3_8[] = {
   highbd_entry(d135, 16, 16, ssse3, 8), highbd_entry(d135, 32, 32, ssse3, 8),
   highbd_entry(d153, 8, 8, ssse3, 8),   highbd_entry(d153, 16, 16, ssse3, 8),
   highbd_entry(d153, 32, 32, ssse3, 8),
+  highbd_intrapred_all(paeth, ssse3, 8),
 };
 INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_8, HighbdIntraPredTest,
                         ::testing::ValuesIn(IntraPredTestVectorSsse3_8));
@@ -267,6 +329,7 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVectorSsse3_10[] = {
   highbd_entry(d135, 16, 16, ssse3, 10), highbd_entry(d135, 32, 32, ssse3, 10),
   highbd_entry(d153, 8, 8, ssse3, 10),   highbd_entry(d153, 16, 16, ssse3, 10),
   highbd_entry(d153, 32, 32, ssse3, 10),
+  highbd_intrapred_all(paeth, ssse3, 10),
 };
 INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_10, HighbdIntraPredTest,
                         ::testing::ValuesIn(IntraPredTestVectorSsse3_10));
@@ -277,6 +340,7 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVectorSsse3_12[] = {
   highbd_entry(d135, 16, 16, ssse3, 12), highbd_entry(d135, 32, 32, ssse3, 12),
   highbd_entry(d153, 8, 8, ssse3, 12),   highbd_entry(d153, 16, 16, ssse3, 12),
   highbd_entry(d153, 32, 32, ssse3, 12),
+  highbd_intrapred_all(paeth, ssse3, 12),
 };
 INSTANTIATE_TEST_CASE_P(SSSE3_TO_C_12, HighbdIntraPredTest,
                         ::testing::ValuesIn(IntraPredTestVectorSsse3_12));
@@ -290,6 +354,7 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVectorAvx2_8[] = {
   highbd_entry(d207e, 32, 32, avx2, 8), highbd_entry(d63e, 16, 8, avx2, 8),
   highbd_entry(d63e, 16, 16, avx2, 8),  highbd_entry(d63e, 16, 32, avx2, 8),
   highbd_entry(d63e, 32, 16, avx2, 8),  highbd_entry(d63e, 32, 32, avx2, 8),
+  highbd_intrapred_wide(paeth, avx2, 8),
 };
 INSTANTIATE_TEST_CASE_P(AVX2_TO_C_8, HighbdIntraPredTest,
                         ::testing::ValuesIn(IntraPredTestVectorAvx2_8));
@@ -301,6 +366,7 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVectorAvx2_10[] = {
   highbd_entry(d207e, 32, 32, avx2, 10), highbd_entry(d63e, 16, 8, avx2, 10),
   highbd_entry(d63e, 16, 16, avx2, 10),  highbd_entry(d63e, 16, 32, avx2, 10),
   highbd_entry(d63e, 32, 16, avx2, 10),  highbd_entry(d63e, 32, 32, avx2, 10),
+  highbd_intrapred_wide(paeth, avx2, 10),
 };
 INSTANTIATE_TEST_CASE_P(AVX2_TO_C_10, HighbdIntraPredTest,
                         ::testing::ValuesIn(IntraPredTestVectorAvx2_10));
@@ -312,6 +378,7 @@ const IntraPredFunc<HighbdIntraPred> IntraPredTestVectorAvx2_12[] = {
   highbd_entry(d207e, 32, 32, avx2, 12), highbd_entry(d63e, 16, 8, avx2, 12),
   highbd_entry(d63e, 16, 16, avx2, 12),  highbd_entry(d63e, 16, 32, avx2, 12),
   highbd_entry(d63e, 32, 16, avx2, 12),  highbd_entry(d63e, 32, 32, avx2, 12),
+  highbd_intrapred_wide(paeth, avx2, 12),
 };
 INSTANTIATE_TEST_CASE_P(AVX2_TO_C_12, HighbdIntraPredTest,
                         ::testing::ValuesIn(IntraPredTestVectorAvx2_12));
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+
+namespace {
+
+const int kNumFrames = 6;
+
+// Decodes a stream with the loop filter spread over several threads and checks
+// that every output frame matches the single threaded decode.
+class LoopFilterThreadTest
+    : public ::libaom_test::CodecTestWithParam<int>,
+      public ::libaom_test::EncoderTest {
+ protected:
+  LoopFilterThreadTest()
+      : EncoderTest(GET_PARAM(0)), n_tile_cols_(GET_PARAM(1)) {}
+
+  virtual ~LoopFilterThreadTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libaom_test::kOnePassGood);
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 4);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, n_tile_cols_);
+    }
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    if (pkt->kind != AOM_CODEC_CX_FRAME_PKT) return;
+    frames_.push_back(
+        std::string(reinterpret_cast<const char *>(pkt->data.frame.buf),
+                    pkt->data.frame.sz));
+  }
+
+  virtual void DecompressedFrameHook(const aom_image_t &img,
+                                     aom_codec_pts_t /*pts*/) {
+    ::libaom_test::MD5 md5;
+    md5.Add(&img);
+    serial_md5_.push_back(md5.Get());
+  }
+
+  void DecodeThreaded(int threads) {
+    aom_codec_dec_cfg_t cfg = aom_codec_dec_cfg_t();
+    cfg.threads = threads;
+    cfg.allow_lowbitdepth = CONFIG_LOWBITDEPTH;
+    ::libaom_test::Decoder *const decoder = codec_->CreateDecoder(cfg, 0);
+    for (size_t i = 0; i < frames_.size(); ++i) {
+      const aom_codec_err_t res = decoder->DecodeFrame(
+          reinterpret_cast<const uint8_t *>(frames_[i].data()),
+          frames_[i].size());
+      ASSERT_EQ(AOM_CODEC_OK, res) << decoder->DecodeError();
+      ::libaom_test::DxDataIterator dec_iter = decoder->GetDxData();
+      const aom_image_t *img;
+      while ((img = dec_iter.Next()) != NULL) {
+        ::libaom_test::MD5 md5;
+        md5.Add(img);
+        threaded_md5_.push_back(md5.Get());
+      }
+    }
+    delete decoder;
+  }
+
+  int n_tile_cols_;
+  std::vector<std::string> frames_;
+  std::vector<std::string> serial_md5_;
+  std::vector<std::string> threaded_md5_;
+};
+
+TEST_P(LoopFilterThreadTest, MatchesSingleThreadDecode) {
+  cfg_.rc_target_bitrate = 300;
+  cfg_.g_threads = 4;
+#if CONFIG_EXT_TILE
+  cfg_.large_scale_tile = 0;
+#endif  // CONFIG_EXT_TILE
+
+  ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, kNumFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_GT(serial_md5_.size(), 0u);
+
+  for (int threads = 2; threads <= 8; threads *= 2) {
+    threaded_md5_.clear();
+    ASSERT_NO_FATAL_FAILURE(DecodeThreaded(threads));
+    ASSERT_EQ(serial_md5_.size(), threaded_md5_.size())
+        << "threads: " << threads;
+    for (size_t i = 0; i < serial_md5_.size(); ++i)
+      EXPECT_EQ(serial_md5_[i], threaded_md5_[i])
+          << "threads: " << threads << " frame: " << i;
+  }
+}
+
+AV1_INSTANTIATE_TEST_CASE(LoopFilterThreadTest, ::testing::Values(0, 1));
+
+}  // namespace
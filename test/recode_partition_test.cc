@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+#include "av1/encoder/encoder.h"
+
+namespace {
+
+const int kNumFrames = 5;
+
+// Encodes with and without the reuse of first iteration partitions in the
+// recode loop, see sf.recode_reuse_partition.
+class RecodePartitionTestLarge
+    : public ::libaom_test::CodecTestWithParam<libaom_test::TestMode>,
+      public ::libaom_test::EncoderTest {
+ protected:
+  RecodePartitionTestLarge()
+      : EncoderTest(GET_PARAM(0)), encoding_mode_(GET_PARAM(1)),
+        dev_sf_(0), bytes_(0), psnr_sum_(0.0), frames_(0), encode_passes_(0),
+        coded_frames_(0) {}
+
+  virtual ~RecodePartitionTestLarge() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(encoding_mode_);
+    cfg_.rc_end_usage = AOM_VBR;
+    cfg_.rc_target_bitrate = 300;
+    init_flags_ = AOM_CODEC_USE_PSNR;
+  }
+
+  virtual void BeginPassHook(unsigned int /*pass*/) {
+    encode_passes_ = 0;
+    coded_frames_ = 0;
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 2);
+      encoder->Control(AOME_SET_DEVSF, dev_sf_);
+    } else {
+      // The stats cover the frames of the previous aom_codec_encode() call.
+      aom_frame_stats_t stats;
+      encoder->Control(AV1E_GET_FRAME_STATS, &stats);
+      encode_passes_ += stats.encode_passes;
+      coded_frames_ += stats.frames;
+    }
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    bytes_ += pkt->data.frame.sz;
+  }
+
+  virtual void PSNRPktHook(const aom_codec_cx_pkt_t *pkt) {
+    psnr_sum_ += pkt->data.psnr.psnr[0];
+    ++frames_;
+  }
+
+  void Encode(int dev_sf) {
+    dev_sf_ = dev_sf;
+    bytes_ = 0;
+    psnr_sum_ = 0.0;
+    frames_ = 0;
+    ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352,
+                                         288, 30, 1, 0, kNumFrames);
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+    ASSERT_GT(frames_, 0);
+  }
+
+  double AveragePsnr() const { return psnr_sum_ / frames_; }
+
+  ::libaom_test::TestMode encoding_mode_;
+  int dev_sf_;
+  size_t bytes_;
+  double psnr_sum_;
+  int frames_;
+  unsigned int encode_passes_;
+  unsigned int coded_frames_;
+};
+
+TEST_P(RecodePartitionTestLarge, StaysCloseToFullSearch) {
+  ASSERT_NO_FATAL_FAILURE(Encode(0));
+  const size_t full_bytes = bytes_;
+  const double full_psnr = AveragePsnr();
+
+  ASSERT_NO_FATAL_FAILURE(Encode(RECODE_SF));
+  // Some frames went through the recode loop.
+  EXPECT_GT(encode_passes_, coded_frames_);
+
+  // The rate control targets the same rate, so a loss shows up as a larger
+  // stream, a lower quality, or both. The reuse costs about 8% of the size
+  // and 0.1 dB on this clip.
+  EXPECT_LE(bytes_, full_bytes + full_bytes / 10);
+  EXPECT_GE(AveragePsnr(), full_psnr - 0.25);
+}
+
+// One pass encodes of this clip do not recode any frame.
+AV1_INSTANTIATE_TEST_CASE(RecodePartitionTestLarge,
+                          ::testing::Values(::libaom_test::kTwoPassGood));
+}  // namespace
@@ -26,16 +26,20 @@
 namespace {
 
 using std::tr1::tuple;
-using std::tr1::make_tuple;
 using libaom_test::ACMRandom;
 
-typedef tuple<> FilterTestParam;
+typedef void (*SgrFunc)(const uint8_t *dat8, int width, int height,
+                        int stride, int eps, const int *xqd, uint8_t *dst8,
+                        int dst_stride, int32_t *tmpbuf, int bit_depth,
+                        int highbd);
+
+typedef tuple<SgrFunc> FilterTestParam;
 
 class AV1SelfguidedFilterTest
     : public ::testing::TestWithParam<FilterTestParam> {
  public:
   virtual ~AV1SelfguidedFilterTest() {}
-  virtual void SetUp() {}
+  virtual void SetUp() { tst_fun_ = GET_PARAM(0); }
 
   virtual void TearDown() { libaom_test::ClearSystemState(); }
 
@@ -81,8 +85,8 @@ class AV1SelfguidedFilterTest
           int h = AOMMIN(pu_height, height - k);
           uint8_t *input_p = input + k * stride + j;
           uint8_t *output_p = output + k * out_stride + j;
-          apply_selfguided_restoration(input_p, w, h, stride, eps, xqd,
-                                       output_p, out_stride, tmpbuf, 8, 0);
+          tst_fun_(input_p, w, h, stride, eps, xqd, output_p, out_stride,
+                   tmpbuf, 8, 0);
         }
     }
     std::clock_t end = std::clock();
@@ -146,8 +150,8 @@ class AV1SelfguidedFilterTest
           uint8_t *input_p = input + k * stride + j;
           uint8_t *output_p = output + k * out_stride + j;
           uint8_t *output2_p = output2 + k * out_stride + j;
-          apply_selfguided_restoration(input_p, w, h, stride, eps, xqd,
-                                       output_p, out_stride, tmpbuf, 8, 0);
+          tst_fun_(input_p, w, h, stride, eps, xqd, output_p, out_stride,
+                   tmpbuf, 8, 0);
           apply_selfguided_restoration_c(input_p, w, h, stride, eps, xqd,
                                          output2_p, out_stride, tmpbuf, 8, 0);
         }
@@ -168,26 +172,32 @@ class AV1SelfguidedFilterTest
     aom_free(output2_);
     aom_free(tmpbuf);
   }
+
+  SgrFunc tst_fun_;
 };
 
 TEST_P(AV1SelfguidedFilterTest, SpeedTest) { RunSpeedTest(); }
 TEST_P(AV1SelfguidedFilterTest, CorrectnessTest) { RunCorrectnessTest(); }
 
 #if HAVE_SSE4_1
-const FilterTestParam params[] = { make_tuple() };
 INSTANTIATE_TEST_CASE_P(SSE4_1, AV1SelfguidedFilterTest,
-                        ::testing::ValuesIn(params));
+                        ::testing::Values(apply_selfguided_restoration_sse4_1));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, AV1SelfguidedFilterTest,
+                        ::testing::Values(apply_selfguided_restoration_avx2));
 #endif
 
 #if CONFIG_HIGHBITDEPTH
 
-typedef tuple<int> HighbdFilterTestParam;
+typedef tuple<SgrFunc, int> HighbdFilterTestParam;
 
 class AV1HighbdSelfguidedFilterTest
     : public ::testing::TestWithParam<HighbdFilterTestParam> {
  public:
   virtual ~AV1HighbdSelfguidedFilterTest() {}
-  virtual void SetUp() {}
+  virtual void SetUp() { tst_fun_ = GET_PARAM(0); }
 
   virtual void TearDown() { libaom_test::ClearSystemState(); }
 
@@ -198,7 +208,7 @@ class AV1HighbdSelfguidedFilterTest
     const int width = 256, height = 256, stride = 288, out_stride = 288;
     const int NUM_ITERS = 2000;
     int i, j, k;
-    int bit_depth = GET_PARAM(0);
+    int bit_depth = GET_PARAM(1);
     int mask = (1 << bit_depth) - 1;
 
     uint16_t *input_ =
@@ -236,9 +246,9 @@ class AV1HighbdSelfguidedFilterTest
           int h = AOMMIN(pu_height, height - k);
           uint16_t *input_p = input + k * stride + j;
           uint16_t *output_p = output + k * out_stride + j;
-          apply_selfguided_restoration(
-              CONVERT_TO_BYTEPTR(input_p), w, h, stride, eps, xqd,
-              CONVERT_TO_BYTEPTR(output_p), out_stride, tmpbuf, bit_depth, 1);
+          tst_fun_(CONVERT_TO_BYTEPTR(input_p), w, h, stride, eps, xqd,
+                   CONVERT_TO_BYTEPTR(output_p), out_stride, tmpbuf, bit_depth,
+                   1);
         }
     }
     aom_usec_timer_mark(&timer);
@@ -261,7 +271,7 @@ class AV1HighbdSelfguidedFilterTest
     const int max_w = 260, max_h = 260, stride = 672, out_stride = 672;
     const int NUM_ITERS = 81;
     int i, j, k;
-    int bit_depth = GET_PARAM(0);
+    int bit_depth = GET_PARAM(1);
     int mask = (1 << bit_depth) - 1;
 
     uint16_t *input_ =
@@ -304,9 +314,9 @@ class AV1HighbdSelfguidedFilterTest
           uint16_t *input_p = input + k * stride + j;
           uint16_t *output_p = output + k * out_stride + j;
           uint16_t *output2_p = output2 + k * out_stride + j;
-          apply_selfguided_restoration(
-              CONVERT_TO_BYTEPTR(input_p), w, h, stride, eps, xqd,
-              CONVERT_TO_BYTEPTR(output_p), out_stride, tmpbuf, bit_depth, 1);
+          tst_fun_(CONVERT_TO_BYTEPTR(input_p), w, h, stride, eps, xqd,
+                   CONVERT_TO_BYTEPTR(output_p), out_stride, tmpbuf, bit_depth,
+                   1);
           apply_selfguided_restoration_c(
               CONVERT_TO_BYTEPTR(input_p), w, h, stride, eps, xqd,
               CONVERT_TO_BYTEPTR(output2_p), out_stride, tmpbuf, bit_depth, 1);
@@ -330,16 +340,29 @@ class AV1HighbdSelfguidedFilterTest
     aom_free(output2_);
     aom_free(tmpbuf);
   }
+
+  SgrFunc tst_fun_;
 };
 
 TEST_P(AV1HighbdSelfguidedFilterTest, SpeedTest) { RunSpeedTest(); }
 TEST_P(AV1HighbdSelfguidedFilterTest, CorrectnessTest) { RunCorrectnessTest(); }
 
+#if HAVE_SSE4_1 || HAVE_AVX2
+const int highbd_params[] = { 8, 10, 12 };
+#endif
+
 #if HAVE_SSE4_1
-const HighbdFilterTestParam highbd_params[] = { make_tuple(8), make_tuple(10),
-                                                make_tuple(12) };
-INSTANTIATE_TEST_CASE_P(SSE4_1, AV1HighbdSelfguidedFilterTest,
-                        ::testing::ValuesIn(highbd_params));
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, AV1HighbdSelfguidedFilterTest,
+    ::testing::Combine(::testing::Values(apply_selfguided_restoration_sse4_1),
+                       ::testing::ValuesIn(highbd_params)));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AV1HighbdSelfguidedFilterTest,
+    ::testing::Combine(::testing::Values(apply_selfguided_restoration_avx2),
+                       ::testing::ValuesIn(highbd_params)));
 #endif
 #endif
 
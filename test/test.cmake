@@ -207,6 +207,7 @@ if (CONFIG_AV1_ENCODER)
     set(AOM_UNIT_TEST_ENCODER_SOURCES
         ${AOM_UNIT_TEST_ENCODER_SOURCES}
         "${AOM_ROOT}/test/arf_freq_test.cc"
+        "${AOM_ROOT}/test/recode_partition_test.cc"
         "${AOM_ROOT}/test/av1_dct_test.cc"
         "${AOM_ROOT}/test/av1_fht16x16_test.cc"
         "${AOM_ROOT}/test/av1_fht32x32_test.cc"
@@ -216,6 +217,8 @@ if (CONFIG_AV1_ENCODER)
         "${AOM_ROOT}/test/av1_inv_txfm1d_test.cc"
         "${AOM_ROOT}/test/av1_inv_txfm2d_test.cc"
         "${AOM_ROOT}/test/av1_inv_txfm_test.cc"
+        "${AOM_ROOT}/test/av1_nn_predict_test.cc"
+        "${AOM_ROOT}/test/av1_partition_prune_test.cc"
         "${AOM_ROOT}/test/av1_wedge_utils_test.cc"
         "${AOM_ROOT}/test/avg_test.cc"
         "${AOM_ROOT}/test/blend_a64_mask_1d_test.cc"
@@ -291,9 +294,15 @@ if (NOT BUILD_SHARED_LIBS)
         "${AOM_ROOT}/test/divu_small_test.cc"
         "${AOM_ROOT}/test/ethread_test.cc"
         "${AOM_ROOT}/test/coding_path_sync.cc"
+        "${AOM_ROOT}/test/decode_region_test.cc"
+        "${AOM_ROOT}/test/decode_timing_test.cc"
+        "${AOM_ROOT}/test/frame_context_pool_test.cc"
+        "${AOM_ROOT}/test/frame_parallel_test.cc"
         "${AOM_ROOT}/test/idct8x8_test.cc"
+        "${AOM_ROOT}/test/lf_thread_test.cc"
         "${AOM_ROOT}/test/partial_idct_test.cc"
         "${AOM_ROOT}/test/superframe_test.cc"
+        "${AOM_ROOT}/test/tile_group_output_test.cc"
         "${AOM_ROOT}/test/tile_independence_test.cc")
 
     set(AOM_UNIT_TEST_COMMON_SOURCES
@@ -857,7 +857,9 @@ HIGHBD_INTRA_PRED_TEST(
     aom_highbd_d45e_predictor_4x4_sse2, aom_highbd_d135_predictor_4x4_sse2,
     aom_highbd_d117_predictor_4x4_sse2, aom_highbd_d153_predictor_4x4_sse2,
     aom_highbd_d207e_predictor_4x4_sse2, aom_highbd_d63e_predictor_4x4_sse2,
-    NULL, NULL, NULL, NULL)
+    NULL, aom_highbd_smooth_predictor_4x4_sse2,
+    aom_highbd_smooth_v_predictor_4x4_sse2,
+    aom_highbd_smooth_h_predictor_4x4_sse2)
 
 HIGHBD_INTRA_PRED_TEST(
     SSE2_2, TestHighbdIntraPred4, "Hbd Intra4x8",
@@ -866,7 +868,20 @@ HIGHBD_INTRA_PRED_TEST(
     aom_highbd_v_predictor_4x8_sse2, aom_highbd_h_predictor_4x8_sse2,
     aom_highbd_d45e_predictor_4x8_sse2, NULL, NULL, NULL,
     aom_highbd_d207e_predictor_4x8_sse2, aom_highbd_d63e_predictor_4x8_sse2,
-    NULL, NULL, NULL, NULL)
+    NULL, aom_highbd_smooth_predictor_4x8_sse2,
+    aom_highbd_smooth_v_predictor_4x8_sse2,
+    aom_highbd_smooth_h_predictor_4x8_sse2)
+#endif
+
+#if HAVE_SSSE3
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_1, TestHighbdIntraPred4, "Hbd Intra4x4", NULL, NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_paeth_predictor_4x4_ssse3, NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_2, TestHighbdIntraPred4, "Hbd Intra4x8", NULL, NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_paeth_predictor_4x8_ssse3, NULL, NULL, NULL)
 #endif
 
 HIGHBD_INTRA_PRED_TEST(
@@ -902,7 +917,9 @@ HIGHBD_INTRA_PRED_TEST(
     aom_highbd_v_predictor_8x8_sse2, aom_highbd_h_predictor_8x8_sse2,
     aom_highbd_d45e_predictor_8x8_sse2, NULL, NULL, NULL,
     aom_highbd_d207e_predictor_8x8_sse2, aom_highbd_d63e_predictor_8x8_sse2,
-    NULL, NULL, NULL, NULL)
+    NULL, aom_highbd_smooth_predictor_8x8_sse2,
+    aom_highbd_smooth_v_predictor_8x8_sse2,
+    aom_highbd_smooth_h_predictor_8x8_sse2)
 HIGHBD_INTRA_PRED_TEST(
     SSE2_2, TestHighbdIntraPred8, "Hbd Intra8x4",
     aom_highbd_dc_predictor_8x4_sse2, aom_highbd_dc_left_predictor_8x4_sse2,
@@ -910,7 +927,9 @@ HIGHBD_INTRA_PRED_TEST(
     aom_highbd_v_predictor_8x4_sse2, aom_highbd_h_predictor_8x4_sse2,
     aom_highbd_d45e_predictor_8x4_sse2, NULL, NULL, NULL,
     aom_highbd_d207e_predictor_8x4_sse2, aom_highbd_d63e_predictor_8x4_sse2,
-    NULL, NULL, NULL, NULL)
+    NULL, aom_highbd_smooth_predictor_8x4_sse2,
+    aom_highbd_smooth_v_predictor_8x4_sse2,
+    aom_highbd_smooth_h_predictor_8x4_sse2)
 HIGHBD_INTRA_PRED_TEST(
     SSE2_3, TestHighbdIntraPred8, "Hbd Intra8x16",
     aom_highbd_dc_predictor_8x16_sse2, aom_highbd_dc_left_predictor_8x16_sse2,
@@ -918,16 +937,26 @@ HIGHBD_INTRA_PRED_TEST(
     aom_highbd_dc_128_predictor_8x16_sse2, aom_highbd_v_predictor_8x16_sse2,
     aom_highbd_h_predictor_8x16_sse2, aom_highbd_d45e_predictor_8x16_sse2, NULL,
     NULL, NULL, aom_highbd_d207e_predictor_8x16_sse2,
-    aom_highbd_d63e_predictor_8x16_sse2, NULL, NULL, NULL, NULL)
+    aom_highbd_d63e_predictor_8x16_sse2, NULL,
+    aom_highbd_smooth_predictor_8x16_sse2,
+    aom_highbd_smooth_v_predictor_8x16_sse2,
+    aom_highbd_smooth_h_predictor_8x16_sse2)
 #endif
 
 #if HAVE_SSSE3
-HIGHBD_INTRA_PRED_TEST(SSSE3, TestHighbdIntraPred8, "Hbd Intra8x8", NULL, NULL,
-                       NULL, NULL, NULL, NULL, NULL,
-                       aom_highbd_d135_predictor_8x8_ssse3,
-                       aom_highbd_d117_predictor_8x8_ssse3,
-                       aom_highbd_d153_predictor_8x8_ssse3, NULL, NULL, NULL,
-                       NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3, TestHighbdIntraPred8, "Hbd Intra8x8", NULL, NULL, NULL, NULL, NULL,
+    NULL, NULL, aom_highbd_d135_predictor_8x8_ssse3,
+    aom_highbd_d117_predictor_8x8_ssse3, aom_highbd_d153_predictor_8x8_ssse3,
+    NULL, NULL, aom_highbd_paeth_predictor_8x8_ssse3, NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_2, TestHighbdIntraPred8, "Hbd Intra8x4", NULL, NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_paeth_predictor_8x4_ssse3, NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_3, TestHighbdIntraPred8, "Hbd Intra8x16", NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_paeth_predictor_8x16_ssse3, NULL, NULL, NULL)
 #endif
 
 HIGHBD_INTRA_PRED_TEST(
@@ -968,62 +997,73 @@ HIGHBD_INTRA_PRED_TEST(
     aom_highbd_smooth_h_predictor_16x16_c)
 
 #if HAVE_SSE2
-HIGHBD_INTRA_PRED_TEST(SSE2_1, TestHighbdIntraPred16, "Hbd Intra16x16",
-                       aom_highbd_dc_predictor_16x16_sse2,
-                       aom_highbd_dc_left_predictor_16x16_sse2,
-                       aom_highbd_dc_top_predictor_16x16_sse2,
-                       aom_highbd_dc_128_predictor_16x16_sse2,
-                       aom_highbd_v_predictor_16x16_sse2,
-                       aom_highbd_h_predictor_16x16_sse2, NULL, NULL, NULL,
-                       NULL, aom_highbd_d207e_predictor_16x16_sse2, NULL, NULL,
-                       NULL, NULL, NULL)
-HIGHBD_INTRA_PRED_TEST(SSE2_2, TestHighbdIntraPred16, "Hbd Intra16x8",
-                       aom_highbd_dc_predictor_16x8_sse2,
-                       aom_highbd_dc_left_predictor_16x8_sse2,
-                       aom_highbd_dc_top_predictor_16x8_sse2,
-                       aom_highbd_dc_128_predictor_16x8_sse2,
-                       aom_highbd_v_predictor_16x8_sse2,
-                       aom_highbd_h_predictor_16x8_sse2, NULL, NULL, NULL, NULL,
-                       aom_highbd_d207e_predictor_16x8_sse2, NULL, NULL, NULL,
-                       NULL, NULL)
-HIGHBD_INTRA_PRED_TEST(SSE2_3, TestHighbdIntraPred16, "Hbd Intra16x32",
-                       aom_highbd_dc_predictor_16x32_sse2,
-                       aom_highbd_dc_left_predictor_16x32_sse2,
-                       aom_highbd_dc_top_predictor_16x32_sse2,
-                       aom_highbd_dc_128_predictor_16x32_sse2,
-                       aom_highbd_v_predictor_16x32_sse2,
-                       aom_highbd_h_predictor_16x32_sse2, NULL, NULL, NULL,
-                       NULL, aom_highbd_d207e_predictor_16x32_sse2, NULL, NULL,
-                       NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSE2_1, TestHighbdIntraPred16, "Hbd Intra16x16",
+    aom_highbd_dc_predictor_16x16_sse2, aom_highbd_dc_left_predictor_16x16_sse2,
+    aom_highbd_dc_top_predictor_16x16_sse2,
+    aom_highbd_dc_128_predictor_16x16_sse2, aom_highbd_v_predictor_16x16_sse2,
+    aom_highbd_h_predictor_16x16_sse2, NULL, NULL, NULL, NULL,
+    aom_highbd_d207e_predictor_16x16_sse2, NULL, NULL,
+    aom_highbd_smooth_predictor_16x16_sse2,
+    aom_highbd_smooth_v_predictor_16x16_sse2,
+    aom_highbd_smooth_h_predictor_16x16_sse2)
+HIGHBD_INTRA_PRED_TEST(
+    SSE2_2, TestHighbdIntraPred16, "Hbd Intra16x8",
+    aom_highbd_dc_predictor_16x8_sse2, aom_highbd_dc_left_predictor_16x8_sse2,
+    aom_highbd_dc_top_predictor_16x8_sse2,
+    aom_highbd_dc_128_predictor_16x8_sse2, aom_highbd_v_predictor_16x8_sse2,
+    aom_highbd_h_predictor_16x8_sse2, NULL, NULL, NULL, NULL,
+    aom_highbd_d207e_predictor_16x8_sse2, NULL, NULL,
+    aom_highbd_smooth_predictor_16x8_sse2,
+    aom_highbd_smooth_v_predictor_16x8_sse2,
+    aom_highbd_smooth_h_predictor_16x8_sse2)
+HIGHBD_INTRA_PRED_TEST(
+    SSE2_3, TestHighbdIntraPred16, "Hbd Intra16x32",
+    aom_highbd_dc_predictor_16x32_sse2, aom_highbd_dc_left_predictor_16x32_sse2,
+    aom_highbd_dc_top_predictor_16x32_sse2,
+    aom_highbd_dc_128_predictor_16x32_sse2, aom_highbd_v_predictor_16x32_sse2,
+    aom_highbd_h_predictor_16x32_sse2, NULL, NULL, NULL, NULL,
+    aom_highbd_d207e_predictor_16x32_sse2, NULL, NULL,
+    aom_highbd_smooth_predictor_16x32_sse2,
+    aom_highbd_smooth_v_predictor_16x32_sse2,
+    aom_highbd_smooth_h_predictor_16x32_sse2)
 #endif
 
 #if HAVE_SSSE3
-HIGHBD_INTRA_PRED_TEST(SSSE3_1, TestHighbdIntraPred16, "Hbd Intra16x16", NULL,
-                       NULL, NULL, NULL, NULL, NULL, NULL,
-                       aom_highbd_d135_predictor_16x16_ssse3,
-                       aom_highbd_d117_predictor_16x16_ssse3,
-                       aom_highbd_d153_predictor_16x16_ssse3, NULL, NULL, NULL,
-                       NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_1, TestHighbdIntraPred16, "Hbd Intra16x16", NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, aom_highbd_d135_predictor_16x16_ssse3,
+    aom_highbd_d117_predictor_16x16_ssse3,
+    aom_highbd_d153_predictor_16x16_ssse3, NULL, NULL,
+    aom_highbd_paeth_predictor_16x16_ssse3, NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_2, TestHighbdIntraPred16, "Hbd Intra16x8", NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_paeth_predictor_16x8_ssse3, NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_3, TestHighbdIntraPred16, "Hbd Intra16x32", NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_paeth_predictor_16x32_ssse3, NULL, NULL, NULL)
 #endif
 
 #if HAVE_AVX2
-HIGHBD_INTRA_PRED_TEST(AVX2_1, TestHighbdIntraPred16, "Hbd Intra16x16", NULL,
-                       NULL, NULL, NULL, NULL, NULL,
-                       aom_highbd_d45e_predictor_16x16_avx2, NULL, NULL, NULL,
-                       NULL, aom_highbd_d63e_predictor_16x16_avx2, NULL, NULL,
-                       NULL, NULL)
-
-HIGHBD_INTRA_PRED_TEST(AVX2_2, TestHighbdIntraPred16, "Hbd Intra16x8", NULL,
-                       NULL, NULL, NULL, NULL, NULL,
-                       aom_highbd_d45e_predictor_16x8_avx2, NULL, NULL, NULL,
-                       NULL, aom_highbd_d63e_predictor_16x8_avx2, NULL, NULL,
-                       NULL, NULL)
-
-HIGHBD_INTRA_PRED_TEST(AVX2_3, TestHighbdIntraPred16, "Hbd Intra16x32", NULL,
-                       NULL, NULL, NULL, NULL, NULL,
-                       aom_highbd_d45e_predictor_16x32_avx2, NULL, NULL, NULL,
-                       NULL, aom_highbd_d63e_predictor_16x32_avx2, NULL, NULL,
-                       NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    AVX2_1, TestHighbdIntraPred16, "Hbd Intra16x16", NULL, NULL, NULL, NULL,
+    NULL, NULL, aom_highbd_d45e_predictor_16x16_avx2, NULL, NULL, NULL, NULL,
+    aom_highbd_d63e_predictor_16x16_avx2, aom_highbd_paeth_predictor_16x16_avx2,
+    NULL, NULL, NULL)
+
+HIGHBD_INTRA_PRED_TEST(
+    AVX2_2, TestHighbdIntraPred16, "Hbd Intra16x8", NULL, NULL, NULL, NULL,
+    NULL, NULL, aom_highbd_d45e_predictor_16x8_avx2, NULL, NULL, NULL, NULL,
+    aom_highbd_d63e_predictor_16x8_avx2, aom_highbd_paeth_predictor_16x8_avx2,
+    NULL, NULL, NULL)
+
+HIGHBD_INTRA_PRED_TEST(
+    AVX2_3, TestHighbdIntraPred16, "Hbd Intra16x32", NULL, NULL, NULL, NULL,
+    NULL, NULL, aom_highbd_d45e_predictor_16x32_avx2, NULL, NULL, NULL, NULL,
+    aom_highbd_d63e_predictor_16x32_avx2, aom_highbd_paeth_predictor_16x32_avx2,
+    NULL, NULL, NULL)
 #endif
 
 HIGHBD_INTRA_PRED_TEST(
@@ -1065,47 +1105,51 @@ HIGHBD_INTRA_PRED_TEST(
     aom_highbd_smooth_h_predictor_32x32_c)
 
 #if HAVE_SSE2
-HIGHBD_INTRA_PRED_TEST(SSE2_1, TestHighbdIntraPred32, "Hbd Intra32x32",
-                       aom_highbd_dc_predictor_32x32_sse2,
-                       aom_highbd_dc_left_predictor_32x32_sse2,
-                       aom_highbd_dc_top_predictor_32x32_sse2,
-                       aom_highbd_dc_128_predictor_32x32_sse2,
-                       aom_highbd_v_predictor_32x32_sse2,
-                       aom_highbd_h_predictor_32x32_sse2, NULL, NULL, NULL,
-                       NULL, NULL, NULL, NULL, NULL, NULL, NULL)
-HIGHBD_INTRA_PRED_TEST(SSE2_2, TestHighbdIntraPred32, "Hbd Intra32x16",
-                       aom_highbd_dc_predictor_32x16_sse2,
-                       aom_highbd_dc_left_predictor_32x16_sse2,
-                       aom_highbd_dc_top_predictor_32x16_sse2,
-                       aom_highbd_dc_128_predictor_32x16_sse2,
-                       aom_highbd_v_predictor_32x16_sse2,
-                       aom_highbd_h_predictor_32x16_sse2, NULL, NULL, NULL,
-                       NULL, NULL, NULL, NULL, NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSE2_1, TestHighbdIntraPred32, "Hbd Intra32x32",
+    aom_highbd_dc_predictor_32x32_sse2, aom_highbd_dc_left_predictor_32x32_sse2,
+    aom_highbd_dc_top_predictor_32x32_sse2,
+    aom_highbd_dc_128_predictor_32x32_sse2, aom_highbd_v_predictor_32x32_sse2,
+    aom_highbd_h_predictor_32x32_sse2, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_smooth_predictor_32x32_sse2,
+    aom_highbd_smooth_v_predictor_32x32_sse2,
+    aom_highbd_smooth_h_predictor_32x32_sse2)
+HIGHBD_INTRA_PRED_TEST(
+    SSE2_2, TestHighbdIntraPred32, "Hbd Intra32x16",
+    aom_highbd_dc_predictor_32x16_sse2, aom_highbd_dc_left_predictor_32x16_sse2,
+    aom_highbd_dc_top_predictor_32x16_sse2,
+    aom_highbd_dc_128_predictor_32x16_sse2, aom_highbd_v_predictor_32x16_sse2,
+    aom_highbd_h_predictor_32x16_sse2, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_smooth_predictor_32x16_sse2,
+    aom_highbd_smooth_v_predictor_32x16_sse2,
+    aom_highbd_smooth_h_predictor_32x16_sse2)
 #endif
 
 #if HAVE_SSSE3
-HIGHBD_INTRA_PRED_TEST(SSSE3_1, TestHighbdIntraPred32, "Hbd Intra32x32", NULL,
-                       NULL, NULL, NULL, NULL, NULL, NULL,
-                       aom_highbd_d135_predictor_32x32_ssse3,
-                       aom_highbd_d117_predictor_32x32_ssse3,
-                       aom_highbd_d153_predictor_32x32_ssse3, NULL, NULL, NULL,
-                       NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_1, TestHighbdIntraPred32, "Hbd Intra32x32", NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, aom_highbd_d135_predictor_32x32_ssse3,
+    aom_highbd_d117_predictor_32x32_ssse3,
+    aom_highbd_d153_predictor_32x32_ssse3, NULL, NULL,
+    aom_highbd_paeth_predictor_32x32_ssse3, NULL, NULL, NULL)
+HIGHBD_INTRA_PRED_TEST(
+    SSSE3_2, TestHighbdIntraPred32, "Hbd Intra32x16", NULL, NULL, NULL, NULL,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    aom_highbd_paeth_predictor_32x16_ssse3, NULL, NULL, NULL)
 #endif
 
 #if HAVE_AVX2
-HIGHBD_INTRA_PRED_TEST(AVX2_1, TestHighbdIntraPred32, "Hbd Intra32x32", NULL,
-                       NULL, NULL, NULL, NULL, NULL,
-                       aom_highbd_d45e_predictor_32x32_avx2, NULL, NULL, NULL,
-                       aom_highbd_d207e_predictor_32x32_avx2,
-                       aom_highbd_d63e_predictor_32x32_avx2, NULL, NULL, NULL,
-                       NULL)
-
-HIGHBD_INTRA_PRED_TEST(AVX2_2, TestHighbdIntraPred32, "Hbd Intra32x16", NULL,
-                       NULL, NULL, NULL, NULL, NULL,
-                       aom_highbd_d45e_predictor_32x16_avx2, NULL, NULL, NULL,
-                       aom_highbd_d207e_predictor_32x16_avx2,
-                       aom_highbd_d63e_predictor_32x16_avx2, NULL, NULL, NULL,
-                       NULL)
+HIGHBD_INTRA_PRED_TEST(
+    AVX2_1, TestHighbdIntraPred32, "Hbd Intra32x32", NULL, NULL, NULL, NULL,
+    NULL, NULL, aom_highbd_d45e_predictor_32x32_avx2, NULL, NULL, NULL,
+    aom_highbd_d207e_predictor_32x32_avx2, aom_highbd_d63e_predictor_32x32_avx2,
+    aom_highbd_paeth_predictor_32x32_avx2, NULL, NULL, NULL)
+
+HIGHBD_INTRA_PRED_TEST(
+    AVX2_2, TestHighbdIntraPred32, "Hbd Intra32x16", NULL, NULL, NULL, NULL,
+    NULL, NULL, aom_highbd_d45e_predictor_32x16_avx2, NULL, NULL, NULL,
+    aom_highbd_d207e_predictor_32x16_avx2, aom_highbd_d63e_predictor_32x16_avx2,
+    aom_highbd_paeth_predictor_32x16_avx2, NULL, NULL, NULL)
 #endif
 
 HIGHBD_INTRA_PRED_TEST(
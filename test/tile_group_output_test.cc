@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/googletest/include/gtest/gtest.h"
+#include "aom/aomdx.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+
+namespace {
+
+const int kNumFrames = 5;
+const int kHeight = 288;
+
+// Encodes with tile groups returned as separate packets and checks that the
+// packets put back together give the same frames as a normal encode. The
+// packets are also decoded one at a time as they come out.
+class TileGroupOutputTest
+    : public ::libaom_test::CodecTestWith2Params<int, int>,
+      public ::libaom_test::EncoderTest {
+ protected:
+  TileGroupOutputTest()
+      : EncoderTest(GET_PARAM(0)), num_tg_(GET_PARAM(1)), mtu_(GET_PARAM(2)),
+        max_partitions_(0), is_fragment_(false), partial_rows_(0),
+        in_frame_(false), frame_tile_us_(0) {}
+
+  virtual ~TileGroupOutputTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libaom_test::kOnePassGood);
+  }
+
+  virtual void PreEncodeFrameHook(::libaom_test::VideoSource *video,
+                                  ::libaom_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(AOME_SET_CPUUSED, 8);
+      encoder->Control(AOME_SET_ENABLEAUTOALTREF, 1);
+      encoder->Control(AV1E_SET_TILE_COLUMNS, 1);
+      encoder->Control(AV1E_SET_TILE_ROWS, 1);
+      encoder->Control(AV1E_SET_NUM_TG, num_tg_);
+      encoder->Control(AV1E_SET_MTU, mtu_);
+    }
+  }
+
+  virtual const aom_codec_cx_pkt_t *MutateEncoderOutputHook(
+      const aom_codec_cx_pkt_t *pkt) {
+    is_fragment_ = pkt->kind == AOM_CODEC_CX_FRAME_PKT &&
+                   (pkt->data.frame.flags & AOM_FRAME_IS_FRAGMENT);
+    return pkt;
+  }
+
+  // Checks how much of the frame is reconstructed after each packet.
+  virtual bool HandleDecodeResult(const aom_codec_err_t res_dec,
+                                  ::libaom_test::Decoder *decoder) {
+    EXPECT_EQ(AOM_CODEC_OK, res_dec) << decoder->DecodeError();
+    if (res_dec != AOM_CODEC_OK) return false;
+    int rows = -1;
+    EXPECT_EQ(AOM_CODEC_OK, aom_codec_control(decoder->GetDecoder(),
+                                              AV1D_GET_DECODED_ROWS, &rows));
+    if (is_fragment_) {
+      EXPECT_LT(rows, kHeight);
+      partial_rows_ = std::max(partial_rows_, rows);
+    } else {
+      EXPECT_EQ(kHeight, rows);
+    }
+
+    // The tile timings of a frame add up over all its fragments.
+    aom_frame_timing_t timing;
+    EXPECT_EQ(AOM_CODEC_OK, aom_codec_control(decoder->GetDecoder(),
+                                              AV1D_GET_FRAME_TIMING, &timing));
+    int64_t tile_us = 0;
+    for (int i = 0; i < timing.tile_rows * timing.tile_cols; ++i)
+      tile_us += timing.tile_us[i];
+    if (in_frame_) EXPECT_GE(tile_us, frame_tile_us_);
+    frame_tile_us_ = tile_us;
+    in_frame_ = is_fragment_;
+    return true;
+  }
+
+  virtual void FramePktHook(const aom_codec_cx_pkt_t *pkt) {
+    const std::string data(reinterpret_cast<const char *>(pkt->data.frame.buf),
+                           pkt->data.frame.sz);
+    if (!(init_flags_ & AOM_CODEC_USE_OUTPUT_PARTITION)) {
+      EXPECT_EQ(-1, pkt->data.frame.partition_id);
+      frames_.push_back(data);
+      return;
+    }
+    if (pkt->data.frame.partition_id == 0) {
+      joined_.push_back(data);
+      partition_count_.push_back(1);
+    } else {
+      ASSERT_FALSE(joined_.empty());
+      EXPECT_EQ(partition_count_.back(), pkt->data.frame.partition_id);
+      joined_.back() += data;
+      ++partition_count_.back();
+    }
+    if (!(pkt->data.frame.flags & AOM_FRAME_IS_FRAGMENT))
+      max_partitions_ = std::max(max_partitions_, partition_count_.back());
+  }
+
+  int num_tg_;
+  int mtu_;
+  int max_partitions_;
+  bool is_fragment_;
+  int partial_rows_;
+  bool in_frame_;
+  int64_t frame_tile_us_;
+  std::vector<std::string> frames_;
+  std::vector<std::string> joined_;
+  std::vector<int> partition_count_;
+};
+
+TEST_P(TileGroupOutputTest, PartitionsRebuildFrames) {
+  cfg_.rc_target_bitrate = 500;
+  cfg_.g_lag_in_frames = 4;
+
+  ::libaom_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352,
+                                       kHeight, 30, 1, 0, kNumFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+  set_init_flags(AOM_CODEC_USE_OUTPUT_PARTITION);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+  ASSERT_EQ(frames_.size(), joined_.size());
+  for (size_t i = 0; i < frames_.size(); ++i)
+    EXPECT_TRUE(frames_[i] == joined_[i]) << "frame: " << i;
+  // The frame has more than one tile, so it is split into several groups.
+  EXPECT_GT(max_partitions_, 1);
+  if (!mtu_) {
+    EXPECT_LE(max_partitions_, num_tg_);
+  }
+  // The tile groups are decoded before the whole frame has arrived.
+  EXPECT_GT(partial_rows_, 0);
+}
+
+AV1_INSTANTIATE_TEST_CASE(TileGroupOutputTest,
+                          ::testing::Values(2, 4),  // tile groups
+                          ::testing::Values(0, 400));  // MTU size
+
+}  // namespace
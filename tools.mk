@@ -15,6 +15,12 @@ TOOLS-$(CONFIG_AV1_ENCODER)      += aom_entropy_optimizer.c
 aom_entropy_optimizer.GUID        = 3afa9b05-940b-4d68-b5aa-55157d8ed7b4
 aom_entropy_optimizer.DESCRIPTION = Offline default probability optimizer
 endif
+ifeq ($(CONFIG_AV1_ENCODER)$(CONFIG_AV1_DECODER),yesyes)
+TOOLS-yes                        += aom_benchmark.c
+aom_benchmark.SRCS               += args.c args.h tools_common.c tools_common.h
+aom_benchmark.GUID                = 6e1e5d6b-58a7-4c3b-9c0e-2b8b8e0d5f1a
+aom_benchmark.DESCRIPTION         = Synthetic encode/decode benchmark
+endif
 
 #
 # End of specified files. The rest of the build rules should happen
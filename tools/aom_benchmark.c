@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+// Reproducible encode/decode benchmark.
+//
+// This tool generates deterministic synthetic content in memory (no test
+// vectors need to be downloaded), then sweeps over a set of resolutions,
+// encoder speeds, tile configurations and thread counts. For every
+// configuration the clip is encoded and the resulting bitstream is decoded
+// several times, and the throughput of each run is recorded. The results are
+// written as JSON so that they can be compared between builds.
+//
+// Command line: ./aom_benchmark [options]
+// Run with --help for the list of options.
+//
+// The synthetic content is a mix of a slowly panning gradient background,
+// textured moving objects and low-level noise, which exercises intra and
+// inter prediction, motion search and the loop filters in a way that is
+// closer to natural content than flat or purely random frames.
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./aom_config.h"
+#include "./aom_version.h"
+#include "aom/aom_decoder.h"
+#include "aom/aom_encoder.h"
+#include "aom/aomcx.h"
+#include "aom/aomdx.h"
+#include "aom_dsp/aom_dsp_common.h"
+#include "aom_ports/aom_timer.h"
+
+#include "./args.h"
+#include "./tools_common.h"
+
+#define MAX_SWEEP 16
+
+static const char *exec_name;
+
+static const arg_def_t help_arg =
+    ARG_DEF("h", "help", 0, "Show usage options and exit");
+static const arg_def_t sizes_arg = ARG_DEF(
+    NULL, "sizes", 1, "Comma separated list of WxH resolutions to test");
+static const arg_def_t speeds_arg =
+    ARG_DEF(NULL, "speeds", 1, "Comma separated list of encoder speeds");
+static const arg_def_t tile_cols_arg = ARG_DEF(
+    NULL, "tile-columns", 1, "Comma separated list of log2 tile columns");
+static const arg_def_t tile_rows_arg =
+    ARG_DEF(NULL, "tile-rows", 1, "Comma separated list of log2 tile rows");
+static const arg_def_t threads_arg =
+    ARG_DEF(NULL, "threads", 1, "Comma separated list of thread counts");
+static const arg_def_t frames_arg =
+    ARG_DEF(NULL, "limit", 1, "Number of frames to encode per configuration");
+static const arg_def_t runs_arg =
+    ARG_DEF(NULL, "runs", 1, "Number of timed runs per configuration");
+static const arg_def_t bitrate_arg =
+    ARG_DEF(NULL, "target-bitrate", 1, "Bitrate (kbps) at 640x360");
+static const arg_def_t output_arg =
+    ARG_DEF("o", "output", 1, "JSON output file (default: stdout)");
+
+static const arg_def_t *main_args[] = {
+  &help_arg,   &sizes_arg,  &speeds_arg,  &tile_cols_arg, &tile_rows_arg,
+  &threads_arg, &frames_arg, &runs_arg,   &bitrate_arg,   &output_arg,
+  NULL
+};
+
+void usage_exit(void) {
+  fprintf(stderr, "Usage: %s [options]\n\nOptions:\n", exec_name);
+  arg_show_usage(stderr, main_args);
+  exit(EXIT_FAILURE);
+}
+
+typedef struct {
+  int width;
+  int height;
+} BenchSize;
+
+typedef struct {
+  BenchSize sizes[MAX_SWEEP];
+  int num_sizes;
+  int speeds[MAX_SWEEP];
+  int num_speeds;
+  int tile_cols[MAX_SWEEP];
+  int num_tile_cols;
+  int tile_rows[MAX_SWEEP];
+  int num_tile_rows;
+  int threads[MAX_SWEEP];
+  int num_threads;
+  int frames;
+  int runs;
+  int bitrate;
+} BenchConfig;
+
+// Compressed output of one encode, kept in memory so that decode timing does
+// not include any file I/O.
+typedef struct {
+  uint8_t **data;
+  size_t *sizes;
+  int count;
+  int capacity;
+  size_t total_bytes;
+} BenchStream;
+
+// Summary statistics over the runs of one measurement.
+typedef struct {
+  double mean;
+  double stddev;
+  double min;
+  double max;
+} BenchStats;
+
+static int parse_sizes(const char *val, BenchSize *sizes, int max) {
+  int n = 0;
+  const char *p = val;
+  while (*p != '\0') {
+    char *end;
+    if (n >= max) die("Too many sizes (max %d)\n", max);
+    sizes[n].width = (int)strtol(p, &end, 10);
+    if (*end != 'x') die("Bad size '%s', expected WxH\n", p);
+    sizes[n].height = (int)strtol(end + 1, &end, 10);
+    if (sizes[n].width <= 0 || sizes[n].height <= 0)
+      die("Bad size '%s'\n", p);
+    ++n;
+    if (*end == ',') ++end;
+    p = end;
+  }
+  return n;
+}
+
+// Simple deterministic PRNG, so that the content is identical between runs,
+// builds and platforms.
+static unsigned int lcg_rand(unsigned int *state) {
+  *state = *state * 1103515245u + 12345u;
+  return (*state >> 16) & 0x7fff;
+}
+
+static uint8_t clamp_u8(int v) {
+  return (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+// Fill img with frame number frame_idx of the synthetic sequence.
+static void generate_frame(aom_image_t *img, int frame_idx) {
+  const int w = (int)img->d_w;
+  const int h = (int)img->d_h;
+  unsigned int seed = 0x9e3779b9u ^ (unsigned int)frame_idx;
+  int plane, x, y, k;
+
+  // Luma: panning diagonal gradient with a low frequency ripple.
+  for (y = 0; y < h; ++y) {
+    uint8_t *row = img->planes[AOM_PLANE_Y] + y * img->stride[AOM_PLANE_Y];
+    for (x = 0; x < w; ++x) {
+      const int px = x + 2 * frame_idx;
+      const int py = y + frame_idx;
+      const int ramp = ((px + py) * 160) / (w + h);
+      const int ripple = (int)(24.0 * sin(px * 0.02) * cos(py * 0.03));
+      row[x] = clamp_u8(48 + ramp + ripple);
+    }
+  }
+
+  // Moving textured objects with different motion, so that the encoder sees
+  // a mix of smooth and detailed areas and non-uniform motion.
+  for (k = 0; k < 6; ++k) {
+    const int ow = w / 6 + 8 * k;
+    const int oh = h / 6 + 4 * k;
+    const int ox = ((k * w) / 6 + frame_idx * (k + 1) * ((k & 1) ? 1 : -1)) %
+                   AOMMAX(w - ow, 1);
+    const int oy = ((k * h) / 7 + frame_idx * (3 - k % 3)) % AOMMAX(h - oh, 1);
+    const int x0 = ox < 0 ? ox + AOMMAX(w - ow, 1) : ox;
+    const int y0 = oy < 0 ? oy + AOMMAX(h - oh, 1) : oy;
+    for (y = 0; y < oh && y0 + y < h; ++y) {
+      uint8_t *row =
+          img->planes[AOM_PLANE_Y] + (y0 + y) * img->stride[AOM_PLANE_Y];
+      for (x = 0; x < ow && x0 + x < w; ++x) {
+        const int checker = (((x >> (k + 1)) ^ (y >> (k + 1))) & 1) ? 40 : -40;
+        row[x0 + x] = clamp_u8(128 + checker + 16 * k - 40);
+      }
+    }
+  }
+
+  // Low amplitude noise, similar to sensor noise in real captures.
+  for (y = 0; y < h; ++y) {
+    uint8_t *row = img->planes[AOM_PLANE_Y] + y * img->stride[AOM_PLANE_Y];
+    for (x = 0; x < w; ++x)
+      row[x] = clamp_u8(row[x] + (int)(lcg_rand(&seed) % 7) - 3);
+  }
+
+  // Chroma: smooth gradients moving in opposite directions.
+  for (plane = AOM_PLANE_U; plane <= AOM_PLANE_V; ++plane) {
+    const int cw = (w + img->x_chroma_shift) >> img->x_chroma_shift;
+    const int ch = (h + img->y_chroma_shift) >> img->y_chroma_shift;
+    const int dir = plane == AOM_PLANE_U ? 1 : -1;
+    for (y = 0; y < ch; ++y) {
+      uint8_t *row = img->planes[plane] + y * img->stride[plane];
+      for (x = 0; x < cw; ++x) {
+        const int v = ((x + dir * frame_idx) * 64) / AOMMAX(cw, 1) +
+                      (y * 32) / AOMMAX(ch, 1);
+        row[x] = clamp_u8(96 + v);
+      }
+    }
+  }
+}
+
+static void stream_append(BenchStream *stream, const void *buf, size_t sz) {
+  if (stream->count == stream->capacity) {
+    const int new_cap = stream->capacity ? 2 * stream->capacity : 64;
+    stream->data =
+        (uint8_t **)realloc(stream->data, new_cap * sizeof(*stream->data));
+    stream->sizes =
+        (size_t *)realloc(stream->sizes, new_cap * sizeof(*stream->sizes));
+    if (!stream->data || !stream->sizes) die("Failed to allocate stream\n");
+    stream->capacity = new_cap;
+  }
+  stream->data[stream->count] = (uint8_t *)malloc(sz);
+  if (!stream->data[stream->count]) die("Failed to allocate packet\n");
+  memcpy(stream->data[stream->count], buf, sz);
+  stream->sizes[stream->count] = sz;
+  stream->total_bytes += sz;
+  ++stream->count;
+}
+
+static void stream_free(BenchStream *stream) {
+  int i;
+  for (i = 0; i < stream->count; ++i) free(stream->data[i]);
+  free(stream->data);
+  free(stream->sizes);
+  memset(stream, 0, sizeof(*stream));
+}
+
+static void compute_stats(const double *vals, int n, BenchStats *stats) {
+  int i;
+  double sum = 0, sum_sq = 0;
+  stats->min = stats->max = vals[0];
+  for (i = 0; i < n; ++i) {
+    sum += vals[i];
+    stats->min = AOMMIN(stats->min, vals[i]);
+    stats->max = AOMMAX(stats->max, vals[i]);
+  }
+  stats->mean = sum / n;
+  for (i = 0; i < n; ++i)
+    sum_sq += (vals[i] - stats->mean) * (vals[i] - stats->mean);
+  stats->stddev = n > 1 ? sqrt(sum_sq / (n - 1)) : 0.0;
+}
+
+static void drain_encoder(aom_codec_ctx_t *encoder, BenchStream *stream) {
+  aom_codec_iter_t iter = NULL;
+  const aom_codec_cx_pkt_t *pkt;
+  while ((pkt = aom_codec_get_cx_data(encoder, &iter)) != NULL) {
+    if (pkt->kind == AOM_CODEC_CX_FRAME_PKT && stream)
+      stream_append(stream, pkt->data.frame.buf, pkt->data.frame.sz);
+  }
+}
+
+// Add the per-stage statistics of the last aom_codec_encode() call to sum.
+static void accumulate_enc_stages(aom_codec_ctx_t *encoder,
+                                  aom_frame_stats_t *sum) {
+  aom_frame_stats_t stats;
+  if (aom_codec_control(encoder, AV1E_GET_FRAME_STATS, &stats))
+    die_codec(encoder, "Failed to get frame stats");
+  sum->frames += stats.frames;
+  sum->encode_passes += stats.encode_passes;
+  sum->total_us += stats.total_us;
+  sum->temporal_filter_us += stats.temporal_filter_us;
+  sum->global_motion_us += stats.global_motion_us;
+  sum->partition_search_us += stats.partition_search_us;
+  sum->loop_filter_search_us += stats.loop_filter_search_us;
+  sum->cdef_search_us += stats.cdef_search_us;
+  sum->restoration_search_us += stats.restoration_search_us;
+  sum->pack_bitstream_us += stats.pack_bitstream_us;
+  sum->partition_evals += stats.partition_evals;
+  sum->mode_evals += stats.mode_evals;
+  sum->tx_search_evals += stats.tx_search_evals;
+  sum->tx_cache_lookups += stats.tx_cache_lookups;
+  sum->tx_cache_hits += stats.tx_cache_hits;
+  sum->mv_cache_lookups += stats.mv_cache_lookups;
+  sum->mv_cache_hits += stats.mv_cache_hits;
+}
+
+// Encode the synthetic clip once. Returns the elapsed encode time in
+// microseconds, excluding content generation. If stream is non-NULL the
+// compressed frames are appended to it, and the encoder's per-stage
+// statistics are summed into stages.
+static int64_t encode_clip(const BenchConfig *bench, const BenchSize *size,
+                           int speed, int tile_cols, int tile_rows,
+                           int threads, BenchStream *stream,
+                           aom_frame_stats_t *stages) {
+  aom_codec_ctx_t encoder;
+  aom_codec_enc_cfg_t cfg;
+  aom_image_t img;
+  struct aom_usec_timer timer;
+  int64_t elapsed = 0;
+  int i;
+
+  if (aom_codec_enc_config_default(aom_codec_av1_cx(), &cfg, 0))
+    die("Failed to get default encoder config\n");
+  cfg.g_w = size->width;
+  cfg.g_h = size->height;
+  cfg.g_timebase.num = 1;
+  cfg.g_timebase.den = 30;
+  cfg.g_threads = threads;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_end_usage = AOM_VBR;
+  cfg.rc_target_bitrate = (unsigned int)((int64_t)bench->bitrate *
+                                         size->width * size->height /
+                                         (640 * 360));
+  cfg.kf_max_dist = bench->frames;
+
+  if (!aom_img_alloc(&img, AOM_IMG_FMT_I420, size->width, size->height, 32))
+    die("Failed to allocate image\n");
+  if (aom_codec_enc_init(&encoder, aom_codec_av1_cx(), &cfg, 0))
+    die_codec(&encoder, "Failed to initialize encoder");
+  if (aom_codec_control(&encoder, AOME_SET_CPUUSED, speed))
+    die_codec(&encoder, "Failed to set cpu-used");
+  if (aom_codec_control(&encoder, AV1E_SET_TILE_COLUMNS, tile_cols))
+    die_codec(&encoder, "Failed to set tile columns");
+  if (aom_codec_control(&encoder, AV1E_SET_TILE_ROWS, tile_rows))
+    die_codec(&encoder, "Failed to set tile rows");
+
+  for (i = 0; i < bench->frames; ++i) {
+    generate_frame(&img, i);
+    aom_usec_timer_start(&timer);
+    if (aom_codec_encode(&encoder, &img, i, 1, 0, AOM_DL_GOOD_QUALITY))
+      die_codec(&encoder, "Failed to encode frame");
+    aom_usec_timer_mark(&timer);
+    elapsed += aom_usec_timer_elapsed(&timer);
+    if (stages) accumulate_enc_stages(&encoder, stages);
+    drain_encoder(&encoder, stream);
+  }
+
+  // Flush the encoder.
+  aom_usec_timer_start(&timer);
+  if (aom_codec_encode(&encoder, NULL, -1, 1, 0, AOM_DL_GOOD_QUALITY))
+    die_codec(&encoder, "Failed to flush encoder");
+  aom_usec_timer_mark(&timer);
+  elapsed += aom_usec_timer_elapsed(&timer);
+  if (stages) accumulate_enc_stages(&encoder, stages);
+  drain_encoder(&encoder, stream);
+
+  if (aom_codec_destroy(&encoder)) die_codec(&encoder, "Failed to destroy");
+  aom_img_free(&img);
+  return elapsed;
+}
+
+// Add the per-stage timing of the last aom_codec_decode() call to sum. The
+// slowest tile of each frame is summed into max_tile_us, which bounds the
+// achievable speedup from decoding tiles in parallel.
+static void accumulate_dec_stages(aom_codec_ctx_t *decoder,
+                                  aom_frame_timing_t *sum,
+                                  int64_t *max_tile_us) {
+  aom_frame_timing_t timing;
+  int64_t max_tile = 0;
+  int i;
+  if (aom_codec_control(decoder, AV1D_GET_FRAME_TIMING, &timing))
+    die_codec(decoder, "Failed to get frame timing");
+  sum->frames += timing.frames;
+  sum->total_us += timing.total_us;
+  sum->header_us += timing.header_us;
+  sum->tile_decode_us += timing.tile_decode_us;
+  sum->deblock_us += timing.deblock_us;
+  sum->cdef_us += timing.cdef_us;
+  sum->superres_us += timing.superres_us;
+  sum->restoration_us += timing.restoration_us;
+  sum->extend_borders_us += timing.extend_borders_us;
+  sum->tile_rows = timing.tile_rows;
+  sum->tile_cols = timing.tile_cols;
+  for (i = 0; i < timing.tile_rows * timing.tile_cols; ++i)
+    max_tile = AOMMAX(max_tile, timing.tile_us[i]);
+  *max_tile_us += max_tile;
+}
+
+// Decode the stream once. Returns the elapsed time in microseconds. If
+// stages is non-NULL the decoder's per-stage timing is summed into it.
+static int64_t decode_stream(const BenchStream *stream, int threads,
+                             int *frames_out, aom_frame_timing_t *stages,
+                             int64_t *max_tile_us) {
+  aom_codec_ctx_t decoder;
+  aom_codec_dec_cfg_t cfg = { 0, 0, 0, CONFIG_LOWBITDEPTH, 0 };
+  struct aom_usec_timer timer;
+  int i;
+
+  cfg.threads = threads;
+  *frames_out = 0;
+  if (aom_codec_dec_init(&decoder, aom_codec_av1_dx(), &cfg, 0))
+    die_codec(&decoder, "Failed to initialize decoder");
+
+  aom_usec_timer_start(&timer);
+  for (i = 0; i < stream->count; ++i) {
+    aom_codec_iter_t iter = NULL;
+    if (aom_codec_decode(&decoder, stream->data[i],
+                         (unsigned int)stream->sizes[i], NULL, 0))
+      die_codec(&decoder, "Failed to decode frame");
+    if (stages) accumulate_dec_stages(&decoder, stages, max_tile_us);
+    while (aom_codec_get_frame(&decoder, &iter) != NULL) ++*frames_out;
+  }
+  aom_usec_timer_mark(&timer);
+
+  if (aom_codec_destroy(&decoder)) die_codec(&decoder, "Failed to destroy");
+  return aom_usec_timer_elapsed(&timer);
+}
+
+static void print_stats(FILE *out, const char *name, const BenchStats *stats) {
+  fprintf(out,
+          "      \"%s\": { \"mean\": %.3f, \"stddev\": %.3f, \"min\": %.3f, "
+          "\"max\": %.3f }",
+          name, stats->mean, stats->stddev, stats->min, stats->max);
+}
+
+static void print_enc_stages(FILE *out, const aom_frame_stats_t *stages) {
+  fprintf(out,
+          "      \"encode_stages_us\": { \"total\": %" PRId64
+          ", \"temporal_filter\": %" PRId64 ", \"global_motion\": %" PRId64
+          ", \"partition_search\": %" PRId64
+          ", \"loop_filter_search\": %" PRId64 ", \"cdef_search\": %" PRId64
+          ", \"restoration_search\": %" PRId64
+          ", \"pack_bitstream\": %" PRId64 " },\n",
+          stages->total_us, stages->temporal_filter_us,
+          stages->global_motion_us, stages->partition_search_us,
+          stages->loop_filter_search_us, stages->cdef_search_us,
+          stages->restoration_search_us, stages->pack_bitstream_us);
+  fprintf(out,
+          "      \"encode_counters\": { \"frames\": %u, "
+          "\"encode_passes\": %u, \"partition_evals\": %" PRIu64
+          ", \"mode_evals\": %" PRIu64 ", \"tx_search_evals\": %" PRIu64
+          ", \"tx_cache_lookups\": %" PRIu64 ", \"tx_cache_hits\": %" PRIu64
+          ", \"mv_cache_lookups\": %" PRIu64 ", \"mv_cache_hits\": %" PRIu64
+          " },\n",
+          stages->frames, stages->encode_passes, stages->partition_evals,
+          stages->mode_evals, stages->tx_search_evals,
+          stages->tx_cache_lookups, stages->tx_cache_hits,
+          stages->mv_cache_lookups, stages->mv_cache_hits);
+}
+
+static void print_dec_stages(FILE *out, const aom_frame_timing_t *stages,
+                             int64_t max_tile_us) {
+  fprintf(out,
+          "      \"decode_stages_us\": { \"total\": %" PRId64
+          ", \"header\": %" PRId64 ", \"tile_decode\": %" PRId64
+          ", \"max_tile\": %" PRId64 ", \"deblock\": %" PRId64
+          ", \"cdef\": %" PRId64 ", \"superres\": %" PRId64
+          ", \"restoration\": %" PRId64 ", \"extend_borders\": %" PRId64
+          " },\n",
+          stages->total_us, stages->header_us, stages->tile_decode_us,
+          max_tile_us, stages->deblock_us, stages->cdef_us,
+          stages->superres_us, stages->restoration_us,
+          stages->extend_borders_us);
+}
+
+static void run_config(FILE *out, const BenchConfig *bench,
+                       const BenchSize *size, int speed, int tile_cols,
+                       int tile_rows, int threads, int first) {
+  BenchStream stream;
+  double enc_fps[MAX_SWEEP * 4], dec_fps[MAX_SWEEP * 4];
+  BenchStats enc_stats, dec_stats;
+  aom_frame_stats_t enc_stages;
+  aom_frame_timing_t dec_stages;
+  int64_t max_tile_us = 0;
+  int run, dec_frames = 0;
+
+  memset(&stream, 0, sizeof(stream));
+  memset(&enc_stages, 0, sizeof(enc_stages));
+  memset(&dec_stages, 0, sizeof(dec_stages));
+  for (run = 0; run < bench->runs; ++run) {
+    // Only keep the bitstream and stage breakdown of the first run; the
+    // encoder is deterministic so every run produces the same output.
+    const int64_t us =
+        encode_clip(bench, size, speed, tile_cols, tile_rows, threads,
+                    run == 0 ? &stream : NULL, run == 0 ? &enc_stages : NULL);
+    enc_fps[run] = bench->frames * 1000000.0 / AOMMAX(us, 1);
+  }
+  for (run = 0; run < bench->runs; ++run) {
+    const int64_t us =
+        decode_stream(&stream, threads, &dec_frames,
+                      run == 0 ? &dec_stages : NULL, &max_tile_us);
+    dec_fps[run] = dec_frames * 1000000.0 / AOMMAX(us, 1);
+  }
+  compute_stats(enc_fps, bench->runs, &enc_stats);
+  compute_stats(dec_fps, bench->runs, &dec_stats);
+
+  fprintf(out, "%s    {\n", first ? "" : ",\n");
+  fprintf(out,
+          "      \"width\": %d, \"height\": %d, \"speed\": %d, "
+          "\"tile_columns_log2\": %d, \"tile_rows_log2\": %d, "
+          "\"threads\": %d,\n",
+          size->width, size->height, speed, tile_cols, tile_rows, threads);
+  fprintf(out,
+          "      \"frames\": %d, \"decoded_frames\": %d, \"bytes\": %zu,\n",
+          bench->frames, dec_frames, stream.total_bytes);
+  print_enc_stages(out, &enc_stages);
+  print_dec_stages(out, &dec_stages, max_tile_us);
+  print_stats(out, "encode_fps", &enc_stats);
+  fprintf(out, ",\n");
+  print_stats(out, "decode_fps", &dec_stats);
+  fprintf(out, "\n    }");
+  fflush(out);
+
+  fprintf(stderr,
+          "%dx%d speed %d tiles %dx%d threads %d: encode %.2f fps, decode "
+          "%.2f fps\n",
+          size->width, size->height, speed, 1 << tile_cols, 1 << tile_rows,
+          threads, enc_stats.mean, dec_stats.mean);
+  stream_free(&stream);
+}
+
+int main(int argc, const char **argv_) {
+  BenchConfig bench;
+  FILE *out = stdout;
+  const char *out_fn = NULL;
+  struct arg arg;
+  char **argv, **argi, **argj;
+  int s, sp, tc, tr, t, first = 1;
+
+  exec_name = argv_[0];
+  memset(&bench, 0, sizeof(bench));
+  bench.sizes[0].width = 352;
+  bench.sizes[0].height = 288;
+  bench.sizes[1].width = 640;
+  bench.sizes[1].height = 360;
+  bench.num_sizes = 2;
+  bench.speeds[0] = 4;
+  bench.speeds[1] = 8;
+  bench.num_speeds = 2;
+  bench.num_tile_cols = bench.num_tile_rows = 1;
+  bench.threads[0] = 1;
+  bench.num_threads = 1;
+  bench.frames = 10;
+  bench.runs = 3;
+  bench.bitrate = 500;
+
+  argv = argv_dup(argc - 1, argv_ + 1);
+  for (argi = argj = argv; (*argj = *argi); argi += arg.argv_step) {
+    arg.argv_step = 1;
+    if (arg_match(&arg, &help_arg, argi)) {
+      usage_exit();
+    } else if (arg_match(&arg, &sizes_arg, argi)) {
+      bench.num_sizes = parse_sizes(arg.val, bench.sizes, MAX_SWEEP);
+    } else if (arg_match(&arg, &speeds_arg, argi)) {
+      bench.num_speeds = arg_parse_list(&arg, bench.speeds, MAX_SWEEP);
+    } else if (arg_match(&arg, &tile_cols_arg, argi)) {
+      bench.num_tile_cols = arg_parse_list(&arg, bench.tile_cols, MAX_SWEEP);
+    } else if (arg_match(&arg, &tile_rows_arg, argi)) {
+      bench.num_tile_rows = arg_parse_list(&arg, bench.tile_rows, MAX_SWEEP);
+    } else if (arg_match(&arg, &threads_arg, argi)) {
+      bench.num_threads = arg_parse_list(&arg, bench.threads, MAX_SWEEP);
+    } else if (arg_match(&arg, &frames_arg, argi)) {
+      bench.frames = arg_parse_int(&arg);
+    } else if (arg_match(&arg, &runs_arg, argi)) {
+      bench.runs = arg_parse_int(&arg);
+    } else if (arg_match(&arg, &bitrate_arg, argi)) {
+      bench.bitrate = arg_parse_int(&arg);
+    } else if (arg_match(&arg, &output_arg, argi)) {
+      out_fn = arg.val;
+    } else {
+      argj++;
+    }
+  }
+  if (argv[0] != NULL) {
+    fprintf(stderr, "Unrecognized option: %s\n", argv[0]);
+    usage_exit();
+  }
+  free(argv);
+
+  if (bench.frames <= 0) die("--limit must be positive\n");
+  if (bench.runs <= 0 || bench.runs > MAX_SWEEP * 4)
+    die("--runs must be in [1, %d]\n", MAX_SWEEP * 4);
+
+  if (out_fn) {
+    out = fopen(out_fn, "w");
+    if (!out) die("Failed to open %s for writing\n", out_fn);
+  }
+
+  fprintf(out, "{\n");
+  fprintf(out, "  \"version\": \"%s\",\n", VERSION_STRING_NOSP);
+  fprintf(out, "  \"frames\": %d,\n  \"runs\": %d,\n", bench.frames,
+          bench.runs);
+  fprintf(out, "  \"results\": [\n");
+  for (s = 0; s < bench.num_sizes; ++s)
+    for (sp = 0; sp < bench.num_speeds; ++sp)
+      for (tc = 0; tc < bench.num_tile_cols; ++tc)
+        for (tr = 0; tr < bench.num_tile_rows; ++tr)
+          for (t = 0; t < bench.num_threads; ++t) {
+            run_config(out, &bench, &bench.sizes[s], bench.speeds[sp],
+                       bench.tile_cols[tc], bench.tile_rows[tr],
+                       bench.threads[t], first);
+            first = 0;
+          }
+  fprintf(out, "\n  ]\n}\n");
+
+  if (out != stdout) fclose(out);
+  return EXIT_SUCCESS;
+}